@@ -90,17 +90,20 @@ def main():
     results = []
     # transverse_h - n_qubits
     # n_qubits = 2^5 - 2^9
+    # Compares the scalar and the block based SIMD paths
     for qubit_exp in range(5, 9):
-        time_total = 0
+        time_scalar = 0
+        time_simd = 0
         
         for i in range(0, n_iterations):
-            time_total += run_benchmark("transverse_h.out", str(2 ** qubit_exp), seed)
+            time_scalar += run_benchmark("transverse_h.out", str(2 ** qubit_exp), seed, "0")
+            time_simd += run_benchmark("transverse_h.out", str(2 ** qubit_exp), seed, "1")
 
-        results.append((2 ** qubit_exp, time_total / n_iterations))
+        results.append((2 ** qubit_exp, time_scalar / n_iterations, time_simd / n_iterations))
 
     print("-----===[ transverse_h ]===-----")
     for res in results:
-        print(f"{res[0]:<5} | {res[1]}")
+        print(f"{res[0]:<5} | {res[1]} | {res[2]}")
     print()
 
 
@@ -0,0 +1,72 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "tableau.h"
+#include "tableau_operations.h"
+#include "threadpool.h"
+
+static const char* POLICY_NAMES[TABLEAU_N_ALLOC_POLICIES] = {
+    "aligned", "mmap", "huge", "hugetlb", "first_touch"
+};
+
+double benchmark_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * benchmark_alloc
+ * Times tableau construction and the first pass over every slice
+ * Lazily zeroed policies move page faults from construction into the first pass, so both are reported
+ * :: n_qubits : const size_t :: Number of qubits
+ * :: alloc_policy : const uint8_t :: TABLEAU_ALLOC_* policy
+ */
+void benchmark_alloc(const size_t n_qubits, const uint8_t alloc_policy)
+{
+    double start = benchmark_now();
+    tableau_t* tab = tableau_create_alloc(n_qubits, alloc_policy);
+    double created = benchmark_now();
+
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        tableau_H(tab, i);
+    }
+    double touched = benchmark_now();
+
+    const uint8_t policy = tab->alloc_policy;
+    tableau_destroy(tab);
+    double destroyed = benchmark_now();
+
+    printf("%s %zu qubits: create %.6fs first pass %.6fs destroy %.6fs\n",
+        POLICY_NAMES[policy], n_qubits, created - start, touched - created, destroyed - touched);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        printf("Insufficient parameters, requires <n_qubits> <policy> [n_threads]\n");
+        return 0;
+    }
+
+    size_t n_qubits = atoi(argv[1]);
+    uint8_t alloc_policy = atoi(argv[2]);
+    assert(alloc_policy < TABLEAU_N_ALLOC_POLICIES);
+
+    // First touch only spreads pages when there is a pool to spread them over
+    if (argc > 3)
+    {
+        threadpool_init(atoi(argv[3]), THREADPOOL_PIN_WORKERS);
+    }
+
+    benchmark_alloc(n_qubits, alloc_policy);
+
+    if (argc > 3)
+    {
+        threadpool_destroy();
+    }
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "widget_binary.h"
+#include "input_stream.h"
+#include "instructions.h"
+
+double benchmark_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * benchmark_binary
+ * Writes a decomposed widget to a container and reads its graph back
+ * :: n_qubits : const size_t :: Width of the widget
+ * :: n_gates : const size_t :: Random two qubit gates, each followed by an rz
+ * :: path : const char* :: Container to write
+ */
+void benchmark_binary(const size_t n_qubits, const size_t n_gates, const char* path)
+{
+    widget_t* wid = widget_create(n_qubits, 2 * n_qubits + n_gates);
+    teleport_input(wid, n_qubits);
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        instruction_stream_u inst[2];
+        inst[0].multi.opcode = _CNOT_;
+        inst[0].multi.ctrl = rand() % n_qubits;
+        inst[0].multi.targ = (inst[0].multi.ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+        inst[1].rz.opcode = _RZ_;
+        inst[1].rz.arg = rand() % n_qubits;
+        inst[1].rz.tag = 1;
+        parse_instruction_block(wid, inst, 2);
+    }
+    widget_decompose(wid);
+
+    const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    assert(fd >= 0);
+    double start = benchmark_now();
+    widget_binary_writer_t* writer = widget_binary_writer_open(fd);
+    widget_binary_write(writer, wid, NULL);
+    const size_t n_bytes = writer->n_bytes;
+    widget_binary_writer_close(writer);
+    close(fd);
+    double written = benchmark_now();
+
+    widget_binary_reader_t* reader = widget_binary_reader_open(path);
+    widget_binary_info_t info;
+    widget_binary_read_info(reader, 0, &info);
+    size_t* offsets = (size_t*)malloc((info.n_qubits + 1) * sizeof(size_t));
+    uint32_t* neighbours = (uint32_t*)malloc((2 * info.n_edges + 1) * sizeof(uint32_t));
+    widget_binary_read_graph(reader, 0, offsets, neighbours, false);
+    widget_binary_reader_close(reader);
+    double read = benchmark_now();
+
+    printf("%zu qubits %zu edges: %zu bytes, write %.6fs read %.6fs\n",
+        info.n_qubits, info.n_edges, n_bytes, written - start, read - written);
+
+    free(offsets);
+    free(neighbours);
+    widget_destroy(wid);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        printf("Insufficient parameters, requires <n_qubits> <n_gates> <path>\n");
+        return 0;
+    }
+
+    srand(0);
+    benchmark_binary(atoi(argv[1]), atoi(argv[2]), argv[3]);
+    return 0;
+}
@@ -0,0 +1,69 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "input_stream.h"
+#include "instructions.h"
+
+/*
+ * benchmark_grow
+ * Teleports a stream of rz gates through a widget
+ * Run once with a guessed capacity and once starting from the initial width to compare time and peak RSS
+ * :: n_qubits : const size_t :: Initial qubits
+ * :: n_rz : const size_t :: Number of rz gates, each allocates a qubit
+ * :: max_qubits : const size_t :: Initial capacity of the widget
+ */
+void benchmark_grow(const size_t n_qubits, const size_t n_rz, const size_t max_qubits)
+{
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(2 * n_rz * sizeof(instruction_stream_u));
+    for (size_t i = 0; i < n_rz; i++)
+    {
+        inst[2 * i].rz.opcode = _RZ_;
+        inst[2 * i].rz.arg = rand() % n_qubits;
+        inst[2 * i].rz.tag = 1;
+        inst[2 * i + 1].multi.opcode = _CNOT_;
+        inst[2 * i + 1].multi.ctrl = rand() % n_qubits;
+        inst[2 * i + 1].multi.targ = (inst[2 * i + 1].multi.ctrl + 1) % n_qubits;
+    }
+
+    struct timespec start, stop;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    parse_instruction_block(wid, inst, 2 * n_rz);
+
+    clock_gettime(CLOCK_MONOTONIC, &stop);
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    printf("%zu qubits %zu rz initial capacity %zu final capacity %zu: %.6fs peak rss %ld kB\n",
+        n_qubits, n_rz, max_qubits, wid->max_qubits,
+        (stop.tv_sec - start.tv_sec) + (stop.tv_nsec - start.tv_nsec) * 1e-9,
+        usage.ru_maxrss);
+
+    widget_destroy(wid);
+    free(inst);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        printf("Insufficient parameters, requires <n_qubits> <n_rz> <max_qubits>\n");
+        return 0;
+    }
+
+    size_t n_qubits = atoi(argv[1]);
+    size_t n_rz = atoi(argv[2]);
+    size_t max_qubits = atoi(argv[3]);
+
+    srand(0);
+    benchmark_grow(n_qubits, n_rz, max_qubits);
+
+    return 0;
+}
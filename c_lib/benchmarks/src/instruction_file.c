@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "instruction_file.h"
+#include "input_stream.h"
+#include "instructions.h"
+
+#define BENCHMARK_CHUNK (1 << 16)
+
+double benchmark_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * benchmark_instruction_file
+ * Writes a random circuit to an instruction file, then compiles it as a widget sequence straight from the file
+ * The circuit is generated in chunks, so neither pass holds the whole stream
+ * :: n_qubits : const size_t :: Width of each widget
+ * :: max_qubits : const size_t :: Capacity of each widget
+ * :: n_instructions : const size_t :: Length of the circuit
+ * :: path : const char* :: Instruction file to write
+ */
+void benchmark_instruction_file(const size_t n_qubits, const size_t max_qubits, const size_t n_instructions, const char* path)
+{
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(BENCHMARK_CHUNK * sizeof(instruction_stream_u));
+    const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    assert(fd >= 0);
+
+    double start = benchmark_now();
+    instruction_file_writer_t* writer = instruction_file_writer_open(fd, 0);
+    for (size_t pos = 0; pos < n_instructions; pos += BENCHMARK_CHUNK)
+    {
+        const size_t chunk = (pos + BENCHMARK_CHUNK > n_instructions) ? n_instructions - pos : BENCHMARK_CHUNK;
+        for (size_t i = 0; i < chunk; i++)
+        {
+            if (rand() % 2)
+            {
+                inst[i].multi.opcode = _CNOT_;
+                inst[i].multi.ctrl = rand() % n_qubits;
+                inst[i].multi.targ = (inst[i].multi.ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+            }
+            else
+            {
+                inst[i].rz.opcode = _RZ_;
+                inst[i].rz.arg = rand() % n_qubits;
+                inst[i].rz.tag = 1;
+            }
+        }
+        instruction_file_write(writer, inst, chunk);
+    }
+    const size_t n_bytes = instruction_file_writer_close(writer);
+    close(fd);
+    double written = benchmark_now();
+
+    instruction_file_reader_t* reader = instruction_file_reader_open(path);
+    assert(NULL != reader);
+    instruction_file_sequence_t* seq = instruction_file_sequence_create(reader, n_qubits, max_qubits, true);
+    widget_t* wid = NULL;
+    while (NULL != (wid = instruction_file_sequence_next(seq, wid)))
+    {
+        if (instruction_file_sequence_done(seq))
+        {
+            widget_destroy(wid);
+            break;
+        }
+    }
+    const size_t n_widgets = seq->n_widgets;
+    instruction_file_sequence_destroy(seq);
+    instruction_file_reader_close(reader);
+    double compiled = benchmark_now();
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    printf("%zu instructions: %zu bytes (%.2f per instruction, %zu unpacked), write %.6fs, %zu widgets compiled in %.6fs, peak rss %ld kB\n",
+        n_instructions, n_bytes, (double)n_bytes / (n_instructions ? n_instructions : 1),
+        n_instructions * sizeof(instruction_stream_u),
+        written - start, n_widgets, compiled - written, usage.ru_maxrss);
+
+    free(inst);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 5)
+    {
+        printf("Insufficient parameters, requires <n_qubits> <max_qubits> <n_instructions> <path>\n");
+        return 0;
+    }
+
+    size_t n_qubits = atoi(argv[1]);
+    size_t max_qubits = atoi(argv[2]);
+    size_t n_instructions = atol(argv[3]);
+
+    srand(0);
+    benchmark_instruction_file(n_qubits, max_qubits, n_instructions, argv[4]);
+
+    return 0;
+}
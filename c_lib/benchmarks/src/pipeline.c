@@ -0,0 +1,105 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget_sequence.h"
+#include "widget_pipeline.h"
+#include "threadpool.h"
+
+double benchmark_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+ * benchmark_pipeline
+ * Splits a random stream into widgets, serially and then through the pipeline
+ * Reading the local Clifford queue of each widget stands in for the output stage
+ * :: n_qubits : const size_t :: Width of each widget
+ * :: max_qubits : const size_t :: Capacity of each widget
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: depth : const size_t :: Widgets in flight
+ */
+void benchmark_pipeline(const size_t n_qubits, const size_t max_qubits, const size_t n_instructions, const size_t depth)
+{
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(n_instructions * sizeof(instruction_stream_u));
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        if (rand() % 2)
+        {
+            inst[i].rz.opcode = _RZ_;
+            inst[i].rz.arg = rand() % n_qubits;
+            inst[i].rz.tag = 1;
+        }
+        else
+        {
+            inst[i].multi.opcode = _CNOT_;
+            inst[i].multi.ctrl = rand() % n_qubits;
+            inst[i].multi.targ = (inst[i].multi.ctrl + 1) % n_qubits;
+        }
+    }
+
+    size_t checksum = 0;
+    double start = benchmark_now();
+    widget_sequence_t* seq = widget_sequence_create(inst, n_instructions, n_qubits, max_qubits, true);
+    widget_t* wid = NULL;
+    while (NULL != (wid = widget_sequence_next(seq, wid)))
+    {
+        for (size_t i = 0; i < wid->n_qubits; i++)
+        {
+            checksum += wid->queue->table[i];
+        }
+    }
+    const size_t n_widgets = seq->n_widgets;
+    widget_sequence_destroy(seq);
+    double serial = benchmark_now();
+
+    widget_pipeline_t* pipe = widget_pipeline_create(inst, n_instructions, n_qubits, max_qubits, true, depth);
+    while (NULL != (wid = widget_pipeline_next(pipe)))
+    {
+        for (size_t i = 0; i < wid->n_qubits; i++)
+        {
+            checksum -= wid->queue->table[i];
+        }
+        widget_pipeline_release(pipe, wid);
+    }
+    widget_pipeline_destroy(pipe);
+    double piped = benchmark_now();
+    assert(0 == checksum);
+
+    printf("%zu widgets of %zu qubits: serial %.6fs pipeline depth %zu %.6fs\n",
+        n_widgets, max_qubits, serial - start, depth, piped - serial);
+    free(inst);
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        printf("Insufficient parameters, requires <n_qubits> <max_qubits> <n_instructions> [depth] [n_threads]\n");
+        return 0;
+    }
+
+    size_t n_qubits = atoi(argv[1]);
+    size_t max_qubits = atoi(argv[2]);
+    size_t n_instructions = atoi(argv[3]);
+    size_t depth = (argc > 4) ? atoi(argv[4]) : WIDGET_PIPELINE_DEFAULT_DEPTH;
+
+    if (argc > 5)
+    {
+        threadpool_init(atoi(argv[5]), 0);
+    }
+
+    srand(0);
+    benchmark_pipeline(n_qubits, max_qubits, n_instructions, depth);
+
+    if (argc > 5)
+    {
+        threadpool_destroy();
+    }
+    return 0;
+}
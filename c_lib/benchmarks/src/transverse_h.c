@@ -2,6 +2,7 @@
 #include <string.h>
 
 #include "tableau.h"
+#include "transverse_hadamard.h"
 
 
 /*
@@ -48,7 +49,7 @@ tableau_t* tableau_copy(tableau_t* const tab)
 }
 
 
-void benchmark_transposed_hadamard(size_t n_qubits)
+void benchmark_transposed_hadamard(size_t n_qubits, const uint8_t simd)
 {
     tableau_t* tab = tableau_random_create(n_qubits); 
     tableau_t* tab_cmp = tableau_copy(tab);  
@@ -56,7 +57,14 @@ void benchmark_transposed_hadamard(size_t n_qubits)
 
     for (size_t i = 0; i < tab->n_qubits; i++)
     {
-        tableau_transverse_hadamard(tab, i); 
+        if (simd)
+        {
+            simd_tableau_transverse_hadamard(tab, i); 
+        }
+        else
+        {
+            tableau_transverse_hadamard(tab, i); 
+        }
     }
     tableau_destroy(tab);
     tableau_destroy(tab_cmp);
@@ -66,16 +74,23 @@ int main(int argc, char** argv)
 {
     if (argc < 3)
     {
-        printf("Insufficient parameters, requires <n_qubits> <seed>\n");
+        printf("Insufficient parameters, requires <n_qubits> <seed> [simd]\n");
     return 0;
     }
 
     size_t tableau_size = atoi(argv[1]);
     uint32_t seed = atoi(argv[2]);
+
+    // Block based SIMD path by default, 0 selects the scalar path
+    uint8_t simd = 1;
+    if (argc > 3)
+    {
+        simd = atoi(argv[3]);
+    }
      
     srand(seed);
 
-    benchmark_transposed_hadamard(tableau_size);
+    benchmark_transposed_hadamard(tableau_size, simd);
 
     return 0;
 }
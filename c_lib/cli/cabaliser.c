@@ -0,0 +1,427 @@
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <unistd.h>
+#include <sys/resource.h>
+
+#include "widget.h"
+#include "threadpool.h"
+#include "input_stream_par.h"
+#include "instruction_file.h"
+#include "qasm.h"
+#include "widget_binary.h"
+
+#define CLI_DEFAULT_MAX_QUBITS (2000)
+
+/*
+ * cli_phases_t
+ * Wall time spent in each phase, summed over widgets
+ */
+struct cli_phases_t
+{
+    double convert;
+    double ingestion;
+    double decomposition;
+    double schedule;
+    double output;
+};
+typedef struct cli_phases_t cli_phases_t;
+
+/*
+ * cli_stats_add
+ * Accumulates the stats of one widget
+ * :: total : widget_stats_t* :: Running totals
+ * :: stats : const widget_stats_t* :: Stats of a widget
+ */
+void cli_stats_add(widget_stats_t* total, const widget_stats_t* stats)
+{
+    total->enabled = stats->enabled;
+    total->ingestion_ns += stats->ingestion_ns;
+    total->queue_flush_ns += stats->queue_flush_ns;
+    total->remove_zero_x_columns_ns += stats->remove_zero_x_columns_ns;
+    total->transpose_ns += stats->transpose_ns;
+    total->elim_ns += stats->elim_ns;
+    total->zero_diagonal_ns += stats->zero_diagonal_ns;
+    total->pauli_tracker_ns += stats->pauli_tracker_ns;
+    total->partial_order_ns += stats->partial_order_ns;
+    for (size_t i = 0; i < WIDGET_STATS_N_GATE_TYPES; i++)
+    {
+        total->n_gates[i] += stats->n_gates[i];
+    }
+    total->n_rowsums += stats->n_rowsums;
+    total->n_local_elim += stats->n_local_elim;
+    total->n_local_search += stats->n_local_search;
+    total->n_non_local_search += stats->n_non_local_search;
+    total->n_hadamard += stats->n_hadamard;
+    total->n_z_search += stats->n_z_search;
+}
+
+/*
+ * cli_stats_print
+ * Prints stats summed over every widget
+ * :: stats : const widget_stats_t* :: Totals
+ */
+void cli_stats_print(const widget_stats_t* stats)
+{
+    printf("  ingestion             %.6fs\n", stats->ingestion_ns * 1e-9);
+    printf("    pauli tracker       %.6fs\n", stats->pauli_tracker_ns * 1e-9);
+    printf("  queue flush           %.6fs\n", stats->queue_flush_ns * 1e-9);
+    printf("  remove zero x columns %.6fs\n", stats->remove_zero_x_columns_ns * 1e-9);
+    printf("  transpose             %.6fs\n", stats->transpose_ns * 1e-9);
+    printf("  elimination           %.6fs\n", stats->elim_ns * 1e-9);
+    printf("  zero diagonal         %.6fs\n", stats->zero_diagonal_ns * 1e-9);
+    printf("  partial order         %.6fs\n", stats->partial_order_ns * 1e-9);
+    printf("  gates                 %llu local, %llu non-local, %llu rz, %llu conditional\n",
+        (unsigned long long)stats->n_gates[INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK)],
+        (unsigned long long)stats->n_gates[INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK)],
+        (unsigned long long)stats->n_gates[INSTRUCTION_TYPE(RZ_MASK)],
+        (unsigned long long)stats->n_gates[INSTRUCTION_TYPE(MEASUREMENT_CONDITIONED_MASK)]);
+    printf("  rowsums               %llu\n", (unsigned long long)stats->n_rowsums);
+    printf("  pivots                %llu local elim, %llu local search, %llu non-local search, %llu hadamard, %llu z search\n",
+        (unsigned long long)stats->n_local_elim,
+        (unsigned long long)stats->n_local_search,
+        (unsigned long long)stats->n_non_local_search,
+        (unsigned long long)stats->n_hadamard,
+        (unsigned long long)stats->n_z_search);
+}
+
+double cli_now()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void cli_usage(const char* name)
+{
+    fprintf(stderr,
+        "Usage: %s [options] <input>\n"
+        "Compiles an instruction file, or an OpenQASM 2 file ending in .qasm, to a sequence of widgets\n"
+        "  -w, --width <n>       Qubits per widget, defaults to the qubits declared by a QASM input\n"
+        "  -m, --max-qubits <n>  Qubit capacity of each widget, defaults to %d\n"
+        "  -t, --threads <n>     Worker threads, 0 reads " THREADPOOL_ENV_N_WORKERS " and falls back to the number of CPUs\n"
+        "  -o, --output <path>   Widget binary container to write, nothing is written if omitted\n"
+        "  -h, --help            Print this message\n",
+        name, CLI_DEFAULT_MAX_QUBITS);
+}
+
+/*
+ * cli_convert_qasm
+ * Converts a QASM file to an unlinked temporary instruction file
+ * :: path : const char* :: QASM file
+ * :: width : size_t* :: Set to the number of declared qubits
+ * Returns the reader over the converted file, or NULL on failure
+ * The temporary file is created under TMPDIR, or /tmp if it is unset,
+ * and removed once it is mapped, so it does not outlive the process
+ */
+instruction_file_reader_t* cli_convert_qasm(const char* path, size_t* width)
+{
+    qasm_parser_t* parser = qasm_parser_open(path);
+    if (NULL == parser)
+    {
+        fprintf(stderr, "Could not open %s\n", path);
+        return NULL;
+    }
+
+    const char* tmp_dir = getenv("TMPDIR");
+    if (NULL == tmp_dir || '\0' == *tmp_dir)
+    {
+        tmp_dir = "/tmp";
+    }
+    char tmp_path[PATH_MAX];
+    const int tmp_len = snprintf(tmp_path, sizeof(tmp_path), "%s/cabaliser_XXXXXX", tmp_dir);
+    const int fd = (tmp_len > 0 && (size_t)tmp_len < sizeof(tmp_path)) ? mkstemp(tmp_path) : -1;
+    if (fd < 0)
+    {
+        fprintf(stderr, "Could not create a temporary instruction file\n");
+        qasm_parser_destroy(parser);
+        return NULL;
+    }
+
+    instruction_file_writer_t* writer = instruction_file_writer_open(fd, 0);
+    bool written = (NULL != writer);
+    if (written)
+    {
+        qasm_write_instruction_file(parser, writer);
+        written = (0 != instruction_file_writer_close(writer));
+    }
+    close(fd);
+
+    instruction_file_reader_t* reader = NULL;
+    if (!written)
+    {
+        fprintf(stderr, "Could not write the temporary instruction file\n");
+    }
+    else if (NULL != qasm_parser_error(parser))
+    {
+        fprintf(stderr, "%s:%zu: %s\n", path, qasm_parser_line(parser), qasm_parser_error(parser));
+    }
+    else
+    {
+        *width = parser->n_qubits;
+        reader = instruction_file_reader_open(tmp_path);
+    }
+    unlink(tmp_path);
+    qasm_parser_destroy(parser);
+    return reader;
+}
+
+/*
+ * cli_parse_size
+ * Parses a whole decimal argument
+ * :: str : const char* :: Argument
+ * :: val : size_t* :: Written with the value on success
+ * Returns false for empty, signed, partly numeric or out of range arguments
+ */
+bool cli_parse_size(const char* str, size_t* val)
+{
+    // strtoull skips leading whitespace and negates a leading minus, neither is a size
+    if (*str < '0' || *str > '9')
+    {
+        return false;
+    }
+    char* end;
+    errno = 0;
+    const unsigned long long parsed = strtoull(str, &end, 10);
+    if (0 != errno || '\0' != *end || parsed > SIZE_MAX)
+    {
+        return false;
+    }
+    *val = parsed;
+    return true;
+}
+
+/*
+ * cli_ends_with
+ * Whether a string ends with a suffix
+ */
+bool cli_ends_with(const char* str, const char* suffix)
+{
+    const size_t len = strlen(str);
+    const size_t suffix_len = strlen(suffix);
+    return len >= suffix_len && 0 == strcmp(str + len - suffix_len, suffix);
+}
+
+int main(int argc, char** argv)
+{
+    size_t width = 0;
+    size_t max_qubits = CLI_DEFAULT_MAX_QUBITS;
+    size_t n_threads = 0;
+    const char* output = NULL;
+
+    static const struct option options[] = {
+        {"width", required_argument, NULL, 'w'},
+        {"max-qubits", required_argument, NULL, 'm'},
+        {"threads", required_argument, NULL, 't'},
+        {"output", required_argument, NULL, 'o'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0}
+    };
+
+    int opt;
+    while (-1 != (opt = getopt_long(argc, argv, "w:m:t:o:h", options, NULL)))
+    {
+        bool valid = true;
+        switch (opt)
+        {
+            case 'w':
+                valid = cli_parse_size(optarg, &width);
+                break;
+            case 'm':
+                valid = cli_parse_size(optarg, &max_qubits);
+                break;
+            case 't':
+                valid = cli_parse_size(optarg, &n_threads);
+                break;
+            case 'o':
+                output = optarg;
+                break;
+            case 'h':
+                cli_usage(argv[0]);
+                return 0;
+            default:
+                cli_usage(argv[0]);
+                return 1;
+        }
+        if (!valid)
+        {
+            fprintf(stderr, "-%c expects a non-negative integer, got '%s'\n", opt, optarg);
+            return 1;
+        }
+    }
+    if (optind + 1 != argc)
+    {
+        cli_usage(argv[0]);
+        return 1;
+    }
+    const char* input = argv[optind];
+
+    cli_phases_t phases = {0};
+    double start = cli_now();
+
+    instruction_file_reader_t* reader = NULL;
+    if (cli_ends_with(input, ".qasm"))
+    {
+        size_t declared = 0;
+        reader = cli_convert_qasm(input, &declared);
+        if (0 == width)
+        {
+            width = declared;
+        }
+    }
+    else
+    {
+        reader = instruction_file_reader_open(input);
+        if (NULL == reader)
+        {
+            fprintf(stderr, "%s is not an instruction file\n", input);
+        }
+    }
+    if (NULL == reader)
+    {
+        return 1;
+    }
+    phases.convert = cli_now() - start;
+
+    if (0 == width)
+    {
+        fprintf(stderr, "--width is required for instruction files\n");
+        instruction_file_reader_close(reader);
+        return 1;
+    }
+    // Each widget teleports its inputs and needs room for at least one rz
+    if (max_qubits <= 2 * width)
+    {
+        fprintf(stderr, "--max-qubits must exceed twice the width of %zu\n", width);
+        instruction_file_reader_close(reader);
+        return 1;
+    }
+
+    int fd = -1;
+    widget_binary_writer_t* writer = NULL;
+    if (NULL != output)
+    {
+        fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0)
+        {
+            fprintf(stderr, "Could not open %s\n", output);
+            instruction_file_reader_close(reader);
+            return 1;
+        }
+        writer = widget_binary_writer_open(fd);
+        if (NULL == writer)
+        {
+            fprintf(stderr, "Could not write to %s\n", output);
+            close(fd);
+            instruction_file_reader_close(reader);
+            return 1;
+        }
+    }
+
+    threadpool_init(n_threads, 0);
+    n_threads = threadpool_n_workers();
+
+    instruction_file_sequence_t* seq = instruction_file_sequence_create(reader, width, max_qubits, true);
+    widget_t* wid = NULL;
+    size_t n_output_bytes = 0;
+    widget_stats_t stats = {0};
+    bool write_failed = false;
+    while (!instruction_file_sequence_done(seq))
+    {
+        double phase = cli_now();
+        widget_t* filled = instruction_file_sequence_fill(seq, wid, parse_instruction_block_par);
+        if (NULL == filled)
+        {
+            break;
+        }
+        wid = filled;
+        double ingested = cli_now();
+        widget_decompose(wid);
+        double decomposed = cli_now();
+        widget_binary_schedule_t* schedule = widget_binary_schedule_create(wid);
+        double scheduled = cli_now();
+        if (NULL != writer)
+        {
+            const size_t n_bytes = widget_binary_write(writer, wid, schedule);
+            write_failed = (0 == n_bytes);
+            n_output_bytes += n_bytes;
+        }
+        widget_binary_schedule_destroy(schedule);
+        if (write_failed)
+        {
+            break;
+        }
+        double written = cli_now();
+
+        const widget_stats_t widget_stats = widget_get_stats(wid);
+        cli_stats_add(&stats, &widget_stats);
+
+        phases.ingestion += ingested - phase;
+        phases.decomposition += decomposed - ingested;
+        phases.schedule += scheduled - decomposed;
+        phases.output += written - scheduled;
+    }
+    if (NULL != wid)
+    {
+        widget_destroy(wid);
+    }
+
+    // Corrupt blocks and qubits past the width are caught before they reach the widget
+    const bool failed = instruction_file_sequence_failed(seq);
+    if (failed)
+    {
+        fprintf(stderr, "%s is corrupt or addresses qubits past the width of %zu\n", input, width);
+    }
+    if (write_failed)
+    {
+        fprintf(stderr, "Could not write to %s\n", output);
+    }
+    const size_t n_widgets = seq->n_widgets;
+    const size_t n_instructions = reader->n_instructions;
+    instruction_file_sequence_destroy(seq);
+    instruction_file_reader_close(reader);
+
+    double closing = cli_now();
+    if (NULL != writer)
+    {
+        widget_binary_writer_close(writer);
+        close(fd);
+    }
+    phases.output += cli_now() - closing;
+
+    threadpool_destroy();
+    if (failed || write_failed)
+    {
+        return 1;
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    printf("%zu instructions, %zu widgets of width %zu, %zu threads\n",
+        n_instructions, n_widgets, width, n_threads);
+    printf("convert       %.6fs\n", phases.convert);
+    printf("ingestion     %.6fs\n", phases.ingestion);
+    printf("decomposition %.6fs\n", phases.decomposition);
+    printf("schedule      %.6fs\n", phases.schedule);
+    printf("output        %.6fs", phases.output);
+    if (NULL != output)
+    {
+        printf(" (%zu bytes to %s)", n_output_bytes, output);
+    }
+    printf("\n");
+    printf("total         %.6fs\n", cli_now() - start);
+    printf("peak rss      %ld kB\n", usage.ru_maxrss);
+    if (stats.enabled)
+    {
+        printf("widget stats\n");
+        cli_stats_print(&stats);
+    }
+
+    return 0;
+}
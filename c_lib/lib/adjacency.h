@@ -2,10 +2,22 @@
 #define ADJACENT_H
 
 #include <stdint.h>
+#include <stddef.h>
 
 struct adjacency_obj {
     uint32_t targ; // Target qubit for the adjacencies
     uint32_t n_adjacent; // Number of elements in the array
     uint32_t* adjacencies; // Array of adjacent objects
 };
+
+/*
+ * adjacency_csr_t
+ * Whole graph in compressed sparse row form
+ * The neighbours of vertex i are neighbours[offsets[i]] to neighbours[offsets[i + 1] - 1], in ascending order
+ */
+struct adjacency_csr_t {
+    size_t n_vertices;
+    size_t* offsets; // n_vertices + 1 entries
+    uint32_t* neighbours;
+};
 #endif
@@ -0,0 +1,102 @@
+#ifndef BINARY_IO_H
+#define BINARY_IO_H
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <unistd.h>
+
+/*
+ * Shared helpers for the on disk formats
+ * Integers are unsigned LEB128 varints, seven bits per byte with the high bit marking continuation
+ */
+#define BINARY_VARINT_MAX (10) // Bytes in the longest uint64 varint
+
+/*
+ * __inline_binary_put_varint
+ * Writes an unsigned LEB128 varint
+ * :: dst : uint8_t* :: Destination, at least BINARY_VARINT_MAX bytes
+ * :: val : uint64_t :: Value
+ * Returns the number of bytes written
+ */
+static inline
+size_t __inline_binary_put_varint(uint8_t* dst, uint64_t val)
+{
+    size_t len = 0;
+    while (val >= 0x80)
+    {
+        dst[len++] = (uint8_t)(val | 0x80);
+        val >>= 7;
+    }
+    dst[len++] = (uint8_t)val;
+    return len;
+}
+
+/*
+ * __inline_binary_read_varint
+ * Reads an unsigned LEB128 varint that must end before a bound and advances the cursor
+ * :: src : const uint8_t** :: Cursor, left in place on failure
+ * :: end : const uint8_t* :: One past the last readable byte
+ * :: val : uint64_t* :: Written with the value on success
+ * Returns false if the varint runs past end or does not fit in 64 bits
+ */
+static inline
+bool __inline_binary_read_varint(const uint8_t** src, const uint8_t* end, uint64_t* val)
+{
+    uint64_t acc = 0;
+    size_t shift = 0;
+    const uint8_t* ptr = *src;
+    while (true)
+    {
+        if (ptr == end)
+        {
+            return false;
+        }
+        const uint8_t byte = *ptr++;
+        // The tenth byte holds the top bit only
+        if (63 == shift && byte > 1)
+        {
+            return false;
+        }
+        acc |= (uint64_t)(byte & 0x7f) << shift;
+        if (0 == (byte & 0x80))
+        {
+            break;
+        }
+        shift += 7;
+    }
+    *val = acc;
+    *src = ptr;
+    return true;
+}
+
+/*
+ * __inline_binary_write_all
+ * Writes a whole buffer, retrying short and interrupted writes
+ * :: fd : const int :: File descriptor
+ * :: buf : const uint8_t* :: Bytes to write
+ * :: len : size_t :: Number of bytes
+ * Returns false if the descriptor stops accepting bytes, the amount already written is unknown
+ */
+static inline
+bool __inline_binary_write_all(const int fd, const uint8_t* buf, size_t len)
+{
+    while (len > 0)
+    {
+        const ssize_t n_written = write(fd, buf, len);
+        if (n_written < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        if (n_written <= 0)
+        {
+            return false;
+        }
+        buf += n_written;
+        len -= n_written;
+    }
+    return true;
+}
+
+#endif
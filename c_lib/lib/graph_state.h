@@ -0,0 +1,454 @@
+#ifndef GRAPH_STATE_H
+#define GRAPH_STATE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "instructions.h"
+#include "tableau.h"
+#include "adjacency.h"
+
+#define GRAPH_STATE_INITIAL_DEGREE (4) // Neighbour slots allocated when a vertex gains its first edge
+
+#define GRAPH_STATE_STEP_NONE (0) // Vertex operator is the identity
+#define GRAPH_STATE_STEP_VERTEX (1) // Complement around the vertex itself
+#define GRAPH_STATE_STEP_NEIGHBOUR (2) // Complement around a neighbour other than the operand
+
+// Vertex operators that commute with CZ, a vertex with neighbours outside the gate must hold one of these
+#define GRAPH_STATE_DIAGONAL(vop) (((vop) == _I_) | ((vop) == _Z_) | ((vop) == _S_) | ((vop) == _R_))
+
+/*
+ * graph_state_cz_t
+ * Edge and vertex operators of a two vertex subgraph after a CZ
+ */
+struct graph_state_cz_t
+{
+    uint8_t edge;
+    instruction_t ctrl;
+    instruction_t targ;
+};
+
+
+/*
+ * graph_state_t
+ * Anders-Briegel graph state representation of a stabiliser state
+ * The state is the product of the vertex operators applied to the graph state |G>
+ * Vertex operators use the same local Clifford opcodes as the clifford queue
+ * Edges are kept as unsorted neighbour lists, gates act through local complementation
+ */
+struct graph_state_t
+{
+    size_t n_qubits;
+    instruction_t* vops; // Vertex operators
+    uint32_t** neighbours; // Neighbour list for each vertex
+    uint32_t* degree; // Number of neighbours of each vertex
+    uint32_t* capacity; // Allocated length of each neighbour list
+    size_t n_edges;
+    size_t max_degree; // Largest degree seen since creation
+    size_t n_toggles; // Edge toggles performed, a running measure of the work done
+};
+typedef struct graph_state_t graph_state_t;
+
+
+/*
+ * graph_state_create
+ * Constructor for a graph state
+ * :: n_qubits : const size_t :: Number of vertices
+ * All qubits start in the zero state, matching a freshly created tableau
+ */
+graph_state_t* graph_state_create(const size_t n_qubits);
+
+/*
+ * graph_state_destroy
+ * Destructor for a graph state
+ * :: gs : graph_state_t* :: Graph state to free
+ */
+void graph_state_destroy(graph_state_t* gs);
+
+/*
+ * graph_state_reset
+ * Returns a graph state to all zeros, keeping its neighbour lists allocated
+ * :: gs : graph_state_t* :: Graph state
+ * :: n_qubits : const size_t :: Number of vertices that may have been touched
+ */
+void graph_state_reset(graph_state_t* gs, const size_t n_qubits);
+
+/*
+ * graph_state_grow
+ * Adds vertices to a graph state
+ * :: gs : graph_state_t* :: Graph state
+ * :: n_qubits : const size_t :: New number of vertices
+ * New vertices are isolated and in the zero state
+ */
+void graph_state_grow(graph_state_t* gs, const size_t n_qubits);
+
+/*
+ * graph_state_local_clifford
+ * Applies a local Clifford to a vertex
+ * :: gs : graph_state_t* :: The graph state
+ * :: opcode : const instruction_t :: Local Clifford opcode, any of the 24
+ * :: targ : const size_t :: Target qubit
+ * Only updates the vertex operator
+ */
+void graph_state_local_clifford(graph_state_t* gs, const instruction_t opcode, const size_t targ);
+
+/*
+ * graph_state_CZ
+ * graph_state_CNOT
+ * Applies a two qubit gate
+ * :: gs : graph_state_t* :: The graph state
+ * :: ctrl : const size_t :: Control qubit
+ * :: targ : const size_t :: Target qubit
+ * Local complementations clear non-diagonal vertex operators on qubits with other neighbours,
+ * the remaining two vertex subgraph is updated from a lookup table
+ */
+void graph_state_CZ(graph_state_t* gs, const size_t ctrl, const size_t targ);
+void graph_state_CNOT(graph_state_t* gs, const size_t ctrl, const size_t targ);
+
+/*
+ * graph_state_non_local_clifford
+ * Applies local Cliffords on both qubits followed by a two qubit gate
+ * :: gs : graph_state_t* :: The graph state
+ * :: opcode : const instruction_t :: Two qubit opcode
+ * :: ctrl_clifford : const instruction_t :: Local Clifford on the control
+ * :: ctrl : const size_t :: Control qubit
+ * :: targ_clifford : const instruction_t :: Local Clifford on the target
+ * :: targ : const size_t :: Target qubit
+ * Mirrors the fused tableau kernels
+ */
+void graph_state_non_local_clifford(
+    graph_state_t* gs,
+    const instruction_t opcode,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ);
+
+/*
+ * graph_state_local_complementation
+ * Complements the neighbourhood of a vertex
+ * :: gs : graph_state_t* :: The graph state
+ * :: targ : const size_t :: Vertex to complement around
+ * The vertex operators absorb the inverse Cliffords, so the state is unchanged
+ */
+void graph_state_local_complementation(graph_state_t* gs, const size_t targ);
+
+/*
+ * graph_state_get_adjacencies
+ * Lists the neighbours of a vertex in ascending order
+ * :: gs : const graph_state_t* :: The graph state
+ * :: targ : const size_t :: The vertex
+ * Returns an adjacency object with a heap allocated array, NULL when there are no neighbours
+ */
+struct adjacency_obj graph_state_get_adjacencies(const graph_state_t* gs, const size_t targ);
+
+/*
+ * graph_state_get_neighbours
+ * Copies the neighbours of a vertex in ascending order into a caller provided array
+ * :: gs : const graph_state_t* :: The graph state
+ * :: targ : const size_t :: The vertex
+ * :: upper_triangle : const bool :: Only report neighbours above the vertex
+ * :: neighbours : uint32_t* :: Destination, NULL to only count
+ * Returns the number of neighbours reported
+ */
+size_t graph_state_get_neighbours(const graph_state_t* gs, const size_t targ, const bool upper_triangle, uint32_t* neighbours);
+
+/*
+ * graph_state_to_tableau
+ * Writes the stabilisers of the graph state to a tableau
+ * :: gs : const graph_state_t* :: The graph state
+ * :: tab : tableau_t* :: Freshly created tableau with at least as many qubits
+ * Used for printing and for comparing against the tableau engine
+ */
+void graph_state_to_tableau(const graph_state_t* gs, tableau_t* tab);
+
+// Only applies to the graph state src file
+#ifdef GRAPH_STATE_SRC
+
+/*
+ * Local complementation steps that reduce a vertex operator to the identity
+ * A vertex step right multiplies the operator by HSH, a neighbour step right multiplies it by R
+ */
+const uint8_t GRAPH_STATE_REMOVE_VOP_STEP[N_LOCAL_CLIFFORDS] = {
+    GRAPH_STATE_STEP_NONE, // _I_
+    GRAPH_STATE_STEP_VERTEX, // _X_
+    GRAPH_STATE_STEP_VERTEX, // _Y_
+    GRAPH_STATE_STEP_NEIGHBOUR, // _Z_
+    GRAPH_STATE_STEP_VERTEX, // _H_
+    GRAPH_STATE_STEP_NEIGHBOUR, // _S_
+    GRAPH_STATE_STEP_NEIGHBOUR, // _R_
+    GRAPH_STATE_STEP_VERTEX, // _HX_
+    GRAPH_STATE_STEP_VERTEX, // _SX_
+    GRAPH_STATE_STEP_NEIGHBOUR, // _RX_
+    GRAPH_STATE_STEP_VERTEX, // _HY_
+    GRAPH_STATE_STEP_VERTEX, // _HZ_
+    GRAPH_STATE_STEP_NEIGHBOUR, // _SH_
+    GRAPH_STATE_STEP_NEIGHBOUR, // _RH_
+    GRAPH_STATE_STEP_VERTEX, // _HS_
+    GRAPH_STATE_STEP_VERTEX, // _HR_
+    GRAPH_STATE_STEP_VERTEX, // _HSX_
+    GRAPH_STATE_STEP_VERTEX, // _HRX_
+    GRAPH_STATE_STEP_VERTEX, // _SHY_
+    GRAPH_STATE_STEP_NEIGHBOUR, // _RHY_
+    GRAPH_STATE_STEP_VERTEX, // _HSH_
+    GRAPH_STATE_STEP_VERTEX, // _HRH_
+    GRAPH_STATE_STEP_VERTEX, // _RHS_
+    GRAPH_STATE_STEP_NEIGHBOUR // _SHR_
+};
+
+/*
+ * CZ on an isolated pair, indexed by edge, control vertex operator then target vertex operator
+ * Entries for diagonal vertex operators also hold when the vertex has other neighbours
+ */
+const struct graph_state_cz_t GRAPH_STATE_CZ_TABLE[2 * N_LOCAL_CLIFFORDS * N_LOCAL_CLIFFORDS] = {
+    /* no edge, _I_ */
+    {1, _I_, _I_},    {1, _I_, _I_},    {1, _I_, _Z_},    {1, _I_, _Z_},    {0, _I_, _H_},    {1, _I_, _S_},
+    {1, _I_, _R_},    {0, _I_, _H_},    {1, _I_, _S_},    {1, _I_, _R_},    {0, _Z_, _HY_},   {0, _Z_, _HY_},
+    {0, _I_, _H_},    {0, _I_, _H_},    {1, _I_, _R_},    {1, _I_, _S_},    {1, _I_, _R_},    {1, _I_, _S_},
+    {0, _Z_, _HY_},   {0, _Z_, _HY_},   {1, _I_, _I_},    {1, _I_, _I_},    {1, _I_, _Z_},    {1, _I_, _Z_},
+    /* no edge, _X_ */
+    {1, _I_, _I_},    {1, _I_, _I_},    {1, _I_, _Z_},    {1, _I_, _Z_},    {0, _I_, _H_},    {1, _I_, _S_},
+    {1, _I_, _R_},    {0, _I_, _H_},    {1, _I_, _S_},    {1, _I_, _R_},    {0, _Y_, _HY_},   {0, _Y_, _HY_},
+    {0, _I_, _H_},    {0, _I_, _H_},    {1, _I_, _R_},    {1, _I_, _S_},    {1, _I_, _R_},    {1, _I_, _S_},
+    {0, _Y_, _HY_},   {0, _Y_, _HY_},   {1, _I_, _I_},    {1, _I_, _I_},    {1, _I_, _Z_},    {1, _I_, _Z_},
+    /* no edge, _Y_ */
+    {1, _Y_, _Z_},    {1, _I_, _X_},    {1, _I_, _Y_},    {1, _Y_, _I_},    {0, _Y_, _H_},    {1, _Y_, _R_},
+    {1, _Y_, _S_},    {0, _Y_, _H_},    {1, _I_, _SX_},   {1, _I_, _RX_},   {0, _I_, _HY_},   {0, _I_, _HY_},
+    {0, _Y_, _H_},    {0, _Y_, _H_},    {1, _I_, _RX_},   {1, _I_, _SX_},   {1, _I_, _RX_},   {1, _I_, _SX_},
+    {0, _I_, _HY_},   {0, _I_, _HY_},   {1, _I_, _X_},    {1, _I_, _X_},    {1, _I_, _Y_},    {1, _I_, _Y_},
+    /* no edge, _Z_ */
+    {1, _Z_, _I_},    {1, _I_, _X_},    {1, _I_, _Y_},    {1, _Z_, _Z_},    {0, _Z_, _H_},    {1, _Z_, _S_},
+    {1, _Z_, _R_},    {0, _Z_, _H_},    {1, _I_, _SX_},   {1, _I_, _RX_},   {0, _I_, _HY_},   {0, _I_, _HY_},
+    {0, _Z_, _H_},    {0, _Z_, _H_},    {1, _I_, _RX_},   {1, _I_, _SX_},   {1, _I_, _RX_},   {1, _I_, _SX_},
+    {0, _I_, _HY_},   {0, _I_, _HY_},   {1, _I_, _X_},    {1, _I_, _X_},    {1, _I_, _Y_},    {1, _I_, _Y_},
+    /* no edge, _H_ */
+    {0, _H_, _I_},    {0, _H_, _I_},    {0, _H_, _Y_},    {0, _H_, _Z_},    {0, _H_, _H_},    {0, _H_, _S_},
+    {0, _H_, _R_},    {0, _H_, _H_},    {0, _H_, _S_},    {0, _H_, _R_},    {0, _H_, _HY_},   {0, _H_, _HY_},
+    {0, _H_, _H_},    {0, _H_, _H_},    {0, _H_, _R_},    {0, _H_, _S_},    {0, _H_, _R_},    {0, _H_, _S_},
+    {0, _H_, _HY_},   {0, _H_, _HY_},   {0, _H_, _I_},    {0, _H_, _I_},    {0, _H_, _Y_},    {0, _H_, _Y_},
+    /* no edge, _S_ */
+    {1, _S_, _I_},    {1, _I_, _HSH_},  {1, _I_, _SHR_},  {1, _S_, _Z_},    {0, _S_, _H_},    {1, _S_, _S_},
+    {1, _S_, _R_},    {0, _S_, _H_},    {1, _I_, _HR_},   {1, _I_, _HSX_},  {0, _R_, _HY_},   {0, _R_, _HY_},
+    {0, _S_, _H_},    {0, _S_, _H_},    {1, _I_, _HSX_},  {1, _I_, _HR_},   {1, _I_, _HSX_},  {1, _I_, _HR_},
+    {0, _R_, _HY_},   {0, _R_, _HY_},   {1, _I_, _HSH_},  {1, _I_, _HSH_},  {1, _I_, _SHR_},  {1, _I_, _SHR_},
+    /* no edge, _R_ */
+    {1, _R_, _I_},    {1, _I_, _HRH_},  {1, _I_, _RHS_},  {1, _R_, _Z_},    {0, _R_, _H_},    {1, _R_, _S_},
+    {1, _R_, _R_},    {0, _R_, _H_},    {1, _I_, _HRX_},  {1, _I_, _HS_},   {0, _S_, _HY_},   {0, _S_, _HY_},
+    {0, _R_, _H_},    {0, _R_, _H_},    {1, _I_, _HS_},   {1, _I_, _HRX_},  {1, _I_, _HS_},   {1, _I_, _HRX_},
+    {0, _S_, _HY_},   {0, _S_, _HY_},   {1, _I_, _HRH_},  {1, _I_, _HRH_},  {1, _I_, _RHS_},  {1, _I_, _RHS_},
+    /* no edge, _HX_ */
+    {0, _H_, _I_},    {0, _H_, _I_},    {0, _H_, _Y_},    {0, _H_, _Z_},    {0, _H_, _H_},    {0, _H_, _S_},
+    {0, _H_, _R_},    {0, _H_, _H_},    {0, _H_, _S_},    {0, _H_, _R_},    {0, _H_, _HY_},   {0, _H_, _HY_},
+    {0, _H_, _H_},    {0, _H_, _H_},    {0, _H_, _R_},    {0, _H_, _S_},    {0, _H_, _R_},    {0, _H_, _S_},
+    {0, _H_, _HY_},   {0, _H_, _HY_},   {0, _H_, _I_},    {0, _H_, _I_},    {0, _H_, _Y_},    {0, _H_, _Y_},
+    /* no edge, _SX_ */
+    {1, _S_, _I_},    {1, _I_, _HSH_},  {1, _I_, _SHR_},  {1, _S_, _Z_},    {0, _S_, _H_},    {1, _S_, _S_},
+    {1, _S_, _R_},    {0, _S_, _H_},    {1, _I_, _HR_},   {1, _I_, _HSX_},  {0, _R_, _HY_},   {0, _R_, _HY_},
+    {0, _S_, _H_},    {0, _S_, _H_},    {1, _I_, _HSX_},  {1, _I_, _HR_},   {1, _I_, _HSX_},  {1, _I_, _HR_},
+    {0, _R_, _HY_},   {0, _R_, _HY_},   {1, _I_, _HSH_},  {1, _I_, _HSH_},  {1, _I_, _SHR_},  {1, _I_, _SHR_},
+    /* no edge, _RX_ */
+    {1, _R_, _I_},    {1, _I_, _HRH_},  {1, _I_, _RHS_},  {1, _R_, _Z_},    {0, _R_, _H_},    {1, _R_, _S_},
+    {1, _R_, _R_},    {0, _R_, _H_},    {1, _I_, _HRX_},  {1, _I_, _HS_},   {0, _S_, _HY_},   {0, _S_, _HY_},
+    {0, _R_, _H_},    {0, _R_, _H_},    {1, _I_, _HS_},   {1, _I_, _HRX_},  {1, _I_, _HS_},   {1, _I_, _HRX_},
+    {0, _S_, _HY_},   {0, _S_, _HY_},   {1, _I_, _HRH_},  {1, _I_, _HRH_},  {1, _I_, _RHS_},  {1, _I_, _RHS_},
+    /* no edge, _HY_ */
+    {0, _HY_, _Z_},   {0, _HY_, _Y_},   {0, _HY_, _I_},   {0, _HY_, _I_},   {0, _HY_, _H_},   {0, _HY_, _R_},
+    {0, _HY_, _S_},   {0, _HY_, _H_},   {0, _HY_, _R_},   {0, _HY_, _S_},   {0, _HY_, _HY_},  {0, _HY_, _HY_},
+    {0, _HY_, _H_},   {0, _HY_, _H_},   {0, _HY_, _S_},   {0, _HY_, _R_},   {0, _HY_, _S_},   {0, _HY_, _R_},
+    {0, _HY_, _HY_},  {0, _HY_, _HY_},  {0, _HY_, _Y_},   {0, _HY_, _Y_},   {0, _HY_, _I_},   {0, _HY_, _I_},
+    /* no edge, _HZ_ */
+    {0, _HY_, _Z_},   {0, _HY_, _Y_},   {0, _HY_, _I_},   {0, _HY_, _I_},   {0, _HY_, _H_},   {0, _HY_, _R_},
+    {0, _HY_, _S_},   {0, _HY_, _H_},   {0, _HY_, _R_},   {0, _HY_, _S_},   {0, _HY_, _HY_},  {0, _HY_, _HY_},
+    {0, _HY_, _H_},   {0, _HY_, _H_},   {0, _HY_, _S_},   {0, _HY_, _R_},   {0, _HY_, _S_},   {0, _HY_, _R_},
+    {0, _HY_, _HY_},  {0, _HY_, _HY_},  {0, _HY_, _Y_},   {0, _HY_, _Y_},   {0, _HY_, _I_},   {0, _HY_, _I_},
+    /* no edge, _SH_ */
+    {0, _H_, _I_},    {0, _H_, _I_},    {0, _H_, _Y_},    {0, _H_, _Z_},    {0, _H_, _H_},    {0, _H_, _S_},
+    {0, _H_, _R_},    {0, _H_, _H_},    {0, _H_, _S_},    {0, _H_, _R_},    {0, _H_, _HY_},   {0, _H_, _HY_},
+    {0, _H_, _H_},    {0, _H_, _H_},    {0, _H_, _R_},    {0, _H_, _S_},    {0, _H_, _R_},    {0, _H_, _S_},
+    {0, _H_, _HY_},   {0, _H_, _HY_},   {0, _H_, _I_},    {0, _H_, _I_},    {0, _H_, _Y_},    {0, _H_, _Y_},
+    /* no edge, _RH_ */
+    {0, _H_, _I_},    {0, _H_, _I_},    {0, _H_, _Y_},    {0, _H_, _Z_},    {0, _H_, _H_},    {0, _H_, _S_},
+    {0, _H_, _R_},    {0, _H_, _H_},    {0, _H_, _S_},    {0, _H_, _R_},    {0, _H_, _HY_},   {0, _H_, _HY_},
+    {0, _H_, _H_},    {0, _H_, _H_},    {0, _H_, _R_},    {0, _H_, _S_},    {0, _H_, _R_},    {0, _H_, _S_},
+    {0, _H_, _HY_},   {0, _H_, _HY_},   {0, _H_, _I_},    {0, _H_, _I_},    {0, _H_, _Y_},    {0, _H_, _Y_},
+    /* no edge, _HS_ */
+    {1, _R_, _I_},    {1, _I_, _HRH_},  {1, _I_, _RHS_},  {1, _R_, _Z_},    {0, _R_, _H_},    {1, _R_, _S_},
+    {1, _R_, _R_},    {0, _R_, _H_},    {1, _I_, _HRX_},  {1, _I_, _HS_},   {0, _S_, _HY_},   {0, _S_, _HY_},
+    {0, _R_, _H_},    {0, _R_, _H_},    {1, _I_, _HS_},   {1, _I_, _HRX_},  {1, _I_, _HS_},   {1, _I_, _HRX_},
+    {0, _S_, _HY_},   {0, _S_, _HY_},   {1, _I_, _HRH_},  {1, _I_, _HRH_},  {1, _I_, _RHS_},  {1, _I_, _RHS_},
+    /* no edge, _HR_ */
+    {1, _S_, _I_},    {1, _I_, _HSH_},  {1, _I_, _SHR_},  {1, _S_, _Z_},    {0, _S_, _H_},    {1, _S_, _S_},
+    {1, _S_, _R_},    {0, _S_, _H_},    {1, _I_, _HR_},   {1, _I_, _HSX_},  {0, _R_, _HY_},   {0, _R_, _HY_},
+    {0, _S_, _H_},    {0, _S_, _H_},    {1, _I_, _HSX_},  {1, _I_, _HR_},   {1, _I_, _HSX_},  {1, _I_, _HR_},
+    {0, _R_, _HY_},   {0, _R_, _HY_},   {1, _I_, _HSH_},  {1, _I_, _HSH_},  {1, _I_, _SHR_},  {1, _I_, _SHR_},
+    /* no edge, _HSX_ */
+    {1, _R_, _I_},    {1, _I_, _HRH_},  {1, _I_, _RHS_},  {1, _R_, _Z_},    {0, _R_, _H_},    {1, _R_, _S_},
+    {1, _R_, _R_},    {0, _R_, _H_},    {1, _I_, _HRX_},  {1, _I_, _HS_},   {0, _S_, _HY_},   {0, _S_, _HY_},
+    {0, _R_, _H_},    {0, _R_, _H_},    {1, _I_, _HS_},   {1, _I_, _HRX_},  {1, _I_, _HS_},   {1, _I_, _HRX_},
+    {0, _S_, _HY_},   {0, _S_, _HY_},   {1, _I_, _HRH_},  {1, _I_, _HRH_},  {1, _I_, _RHS_},  {1, _I_, _RHS_},
+    /* no edge, _HRX_ */
+    {1, _S_, _I_},    {1, _I_, _HSH_},  {1, _I_, _SHR_},  {1, _S_, _Z_},    {0, _S_, _H_},    {1, _S_, _S_},
+    {1, _S_, _R_},    {0, _S_, _H_},    {1, _I_, _HR_},   {1, _I_, _HSX_},  {0, _R_, _HY_},   {0, _R_, _HY_},
+    {0, _S_, _H_},    {0, _S_, _H_},    {1, _I_, _HSX_},  {1, _I_, _HR_},   {1, _I_, _HSX_},  {1, _I_, _HR_},
+    {0, _R_, _HY_},   {0, _R_, _HY_},   {1, _I_, _HSH_},  {1, _I_, _HSH_},  {1, _I_, _SHR_},  {1, _I_, _SHR_},
+    /* no edge, _SHY_ */
+    {0, _HY_, _Z_},   {0, _HY_, _Y_},   {0, _HY_, _I_},   {0, _HY_, _I_},   {0, _HY_, _H_},   {0, _HY_, _R_},
+    {0, _HY_, _S_},   {0, _HY_, _H_},   {0, _HY_, _R_},   {0, _HY_, _S_},   {0, _HY_, _HY_},  {0, _HY_, _HY_},
+    {0, _HY_, _H_},   {0, _HY_, _H_},   {0, _HY_, _S_},   {0, _HY_, _R_},   {0, _HY_, _S_},   {0, _HY_, _R_},
+    {0, _HY_, _HY_},  {0, _HY_, _HY_},  {0, _HY_, _Y_},   {0, _HY_, _Y_},   {0, _HY_, _I_},   {0, _HY_, _I_},
+    /* no edge, _RHY_ */
+    {0, _HY_, _Z_},   {0, _HY_, _Y_},   {0, _HY_, _I_},   {0, _HY_, _I_},   {0, _HY_, _H_},   {0, _HY_, _R_},
+    {0, _HY_, _S_},   {0, _HY_, _H_},   {0, _HY_, _R_},   {0, _HY_, _S_},   {0, _HY_, _HY_},  {0, _HY_, _HY_},
+    {0, _HY_, _H_},   {0, _HY_, _H_},   {0, _HY_, _S_},   {0, _HY_, _R_},   {0, _HY_, _S_},   {0, _HY_, _R_},
+    {0, _HY_, _HY_},  {0, _HY_, _HY_},  {0, _HY_, _Y_},   {0, _HY_, _Y_},   {0, _HY_, _I_},   {0, _HY_, _I_},
+    /* no edge, _HSH_ */
+    {1, _I_, _I_},    {1, _I_, _I_},    {1, _I_, _Z_},    {1, _I_, _Z_},    {0, _I_, _H_},    {1, _I_, _S_},
+    {1, _I_, _R_},    {0, _I_, _H_},    {1, _I_, _S_},    {1, _I_, _R_},    {0, _Y_, _HY_},   {0, _Y_, _HY_},
+    {0, _I_, _H_},    {0, _I_, _H_},    {1, _I_, _R_},    {1, _I_, _S_},    {1, _I_, _R_},    {1, _I_, _S_},
+    {0, _Y_, _HY_},   {0, _Y_, _HY_},   {1, _I_, _I_},    {1, _I_, _I_},    {1, _I_, _Z_},    {1, _I_, _Z_},
+    /* no edge, _HRH_ */
+    {1, _I_, _I_},    {1, _I_, _I_},    {1, _I_, _Z_},    {1, _I_, _Z_},    {0, _I_, _H_},    {1, _I_, _S_},
+    {1, _I_, _R_},    {0, _I_, _H_},    {1, _I_, _S_},    {1, _I_, _R_},    {0, _Y_, _HY_},   {0, _Y_, _HY_},
+    {0, _I_, _H_},    {0, _I_, _H_},    {1, _I_, _R_},    {1, _I_, _S_},    {1, _I_, _R_},    {1, _I_, _S_},
+    {0, _Y_, _HY_},   {0, _Y_, _HY_},   {1, _I_, _I_},    {1, _I_, _I_},    {1, _I_, _Z_},    {1, _I_, _Z_},
+    /* no edge, _RHS_ */
+    {1, _Y_, _Z_},    {1, _I_, _X_},    {1, _I_, _Y_},    {1, _Y_, _I_},    {0, _Y_, _H_},    {1, _Y_, _R_},
+    {1, _Y_, _S_},    {0, _Y_, _H_},    {1, _I_, _SX_},   {1, _I_, _RX_},   {0, _I_, _HY_},   {0, _I_, _HY_},
+    {0, _Y_, _H_},    {0, _Y_, _H_},    {1, _I_, _RX_},   {1, _I_, _SX_},   {1, _I_, _RX_},   {1, _I_, _SX_},
+    {0, _I_, _HY_},   {0, _I_, _HY_},   {1, _I_, _X_},    {1, _I_, _X_},    {1, _I_, _Y_},    {1, _I_, _Y_},
+    /* no edge, _SHR_ */
+    {1, _Y_, _Z_},    {1, _I_, _X_},    {1, _I_, _Y_},    {1, _Y_, _I_},    {0, _Y_, _H_},    {1, _Y_, _R_},
+    {1, _Y_, _S_},    {0, _Y_, _H_},    {1, _I_, _SX_},   {1, _I_, _RX_},   {0, _I_, _HY_},   {0, _I_, _HY_},
+    {0, _Y_, _H_},    {0, _Y_, _H_},    {1, _I_, _RX_},   {1, _I_, _SX_},   {1, _I_, _RX_},   {1, _I_, _SX_},
+    {0, _I_, _HY_},   {0, _I_, _HY_},   {1, _I_, _X_},    {1, _I_, _X_},    {1, _I_, _Y_},    {1, _I_, _Y_},
+    /* edge, _I_ */
+    {0, _I_, _I_},    {0, _Z_, _I_},    {0, _Z_, _Y_},    {0, _I_, _Z_},    {1, _I_, _HX_},   {0, _I_, _S_},
+    {0, _I_, _R_},    {1, _I_, _H_},    {0, _Z_, _S_},    {0, _Z_, _R_},    {1, _I_, _HY_},   {1, _I_, _HZ_},
+    {1, _I_, _RH_},   {1, _I_, _SH_},   {0, _R_, _R_},    {0, _S_, _S_},    {0, _S_, _R_},    {0, _R_, _S_},
+    {1, _I_, _SHY_},  {1, _I_, _RHY_},  {0, _S_, _I_},    {0, _R_, _I_},    {0, _R_, _Y_},    {0, _S_, _Y_},
+    /* edge, _X_ */
+    {0, _I_, _Z_},    {0, _Y_, _Y_},    {0, _Y_, _I_},    {0, _I_, _I_},    {1, _I_, _HZ_},   {0, _I_, _R_},
+    {0, _I_, _S_},    {1, _I_, _HY_},   {0, _Y_, _R_},    {0, _Y_, _S_},    {1, _I_, _H_},    {1, _I_, _HX_},
+    {1, _I_, _RHY_},  {1, _I_, _SHY_},  {0, _S_, _S_},    {0, _R_, _R_},    {0, _R_, _S_},    {0, _S_, _R_},
+    {1, _I_, _SH_},   {1, _I_, _RH_},   {0, _R_, _Y_},    {0, _S_, _Y_},    {0, _S_, _I_},    {0, _R_, _I_},
+    /* edge, _Y_ */
+    {0, _Y_, _Z_},    {0, _I_, _Y_},    {0, _I_, _I_},    {0, _Y_, _I_},    {1, _I_, _HY_},   {0, _Y_, _R_},
+    {0, _Y_, _S_},    {1, _I_, _HZ_},   {0, _I_, _R_},    {0, _I_, _S_},    {1, _I_, _HX_},   {1, _I_, _H_},
+    {1, _I_, _SHY_},  {1, _I_, _RHY_},  {0, _R_, _S_},    {0, _S_, _R_},    {0, _S_, _S_},    {0, _R_, _R_},
+    {1, _I_, _RH_},   {1, _I_, _SH_},   {0, _S_, _Y_},    {0, _R_, _Y_},    {0, _R_, _I_},    {0, _S_, _I_},
+    /* edge, _Z_ */
+    {0, _Z_, _I_},    {0, _I_, _I_},    {0, _I_, _Y_},    {0, _Z_, _Z_},    {1, _I_, _H_},    {0, _Z_, _S_},
+    {0, _Z_, _R_},    {1, _I_, _HX_},   {0, _I_, _S_},    {0, _I_, _R_},    {1, _I_, _HZ_},   {1, _I_, _HY_},
+    {1, _I_, _SH_},   {1, _I_, _RH_},   {0, _S_, _R_},    {0, _R_, _S_},    {0, _R_, _R_},    {0, _S_, _S_},
+    {1, _I_, _RHY_},  {1, _I_, _SHY_},  {0, _R_, _I_},    {0, _S_, _I_},    {0, _S_, _Y_},    {0, _R_, _Y_},
+    /* edge, _H_ */
+    {1, _H_, _Z_},    {1, _I_, _HZ_},   {1, _I_, _HY_},   {1, _H_, _I_},    {0, _I_, _I_},    {1, _H_, _R_},
+    {1, _H_, _S_},    {0, _I_, _Y_},    {1, _I_, _RHY_},  {1, _I_, _SHY_},  {0, _Y_, _Y_},    {0, _Y_, _I_},
+    {0, _I_, _S_},    {0, _I_, _R_},    {0, _S_, _I_},    {0, _R_, _I_},    {0, _R_, _Y_},    {0, _S_, _Y_},
+    {0, _Y_, _R_},    {0, _Y_, _S_},    {0, _R_, _R_},    {0, _S_, _S_},    {0, _S_, _R_},    {0, _R_, _S_},
+    /* edge, _S_ */
+    {0, _S_, _I_},    {0, _R_, _I_},    {0, _R_, _Y_},    {0, _S_, _Z_},    {1, _I_, _RH_},   {0, _S_, _S_},
+    {0, _S_, _R_},    {1, _I_, _SH_},   {0, _R_, _S_},    {0, _R_, _R_},    {1, _I_, _RHY_},  {1, _I_, _SHY_},
+    {1, _I_, _H_},    {1, _I_, _HX_},   {0, _I_, _R_},    {0, _Z_, _S_},    {0, _Z_, _R_},    {0, _I_, _S_},
+    {1, _I_, _HY_},   {1, _I_, _HZ_},   {0, _Z_, _I_},    {0, _I_, _I_},    {0, _I_, _Y_},    {0, _Z_, _Y_},
+    /* edge, _R_ */
+    {0, _R_, _I_},    {0, _S_, _I_},    {0, _S_, _Y_},    {0, _R_, _Z_},    {1, _I_, _SH_},   {0, _R_, _S_},
+    {0, _R_, _R_},    {1, _I_, _RH_},   {0, _S_, _S_},    {0, _S_, _R_},    {1, _I_, _SHY_},  {1, _I_, _RHY_},
+    {1, _I_, _HX_},   {1, _I_, _H_},    {0, _Z_, _R_},    {0, _I_, _S_},    {0, _I_, _R_},    {0, _Z_, _S_},
+    {1, _I_, _HZ_},   {1, _I_, _HY_},   {0, _I_, _I_},    {0, _Z_, _I_},    {0, _Z_, _Y_},    {0, _I_, _Y_},
+    /* edge, _HX_ */
+    {1, _H_, _I_},    {1, _I_, _HY_},   {1, _I_, _HZ_},   {1, _H_, _Z_},    {0, _Y_, _I_},    {1, _H_, _S_},
+    {1, _H_, _R_},    {0, _Y_, _Y_},    {1, _I_, _SHY_},  {1, _I_, _RHY_},  {0, _I_, _Y_},    {0, _I_, _I_},
+    {0, _Y_, _S_},    {0, _Y_, _R_},    {0, _R_, _I_},    {0, _S_, _I_},    {0, _S_, _Y_},    {0, _R_, _Y_},
+    {0, _I_, _R_},    {0, _I_, _S_},    {0, _S_, _R_},    {0, _R_, _S_},    {0, _R_, _R_},    {0, _S_, _S_},
+    /* edge, _SX_ */
+    {0, _S_, _Z_},    {0, _R_, _Y_},    {0, _R_, _I_},    {0, _S_, _I_},    {1, _I_, _SHY_},  {0, _S_, _R_},
+    {0, _S_, _S_},    {1, _I_, _RHY_},  {0, _R_, _R_},    {0, _R_, _S_},    {1, _I_, _SH_},   {1, _I_, _RH_},
+    {1, _I_, _HZ_},   {1, _I_, _HY_},   {0, _Y_, _S_},    {0, _I_, _R_},    {0, _I_, _S_},    {0, _Y_, _R_},
+    {1, _I_, _HX_},   {1, _I_, _H_},    {0, _I_, _Y_},    {0, _Y_, _Y_},    {0, _Y_, _I_},    {0, _I_, _I_},
+    /* edge, _RX_ */
+    {0, _R_, _Z_},    {0, _S_, _Y_},    {0, _S_, _I_},    {0, _R_, _I_},    {1, _I_, _RHY_},  {0, _R_, _R_},
+    {0, _R_, _S_},    {1, _I_, _SHY_},  {0, _S_, _R_},    {0, _S_, _S_},    {1, _I_, _RH_},   {1, _I_, _SH_},
+    {1, _I_, _HY_},   {1, _I_, _HZ_},   {0, _I_, _S_},    {0, _Y_, _R_},    {0, _Y_, _S_},    {0, _I_, _R_},
+    {1, _I_, _H_},    {1, _I_, _HX_},   {0, _Y_, _Y_},    {0, _I_, _Y_},    {0, _I_, _I_},    {0, _Y_, _I_},
+    /* edge, _HY_ */
+    {1, _HY_, _I_},   {1, _I_, _H_},    {1, _I_, _HX_},   {1, _HY_, _Z_},   {0, _Y_, _Y_},    {1, _HY_, _S_},
+    {1, _HY_, _R_},   {0, _Y_, _I_},    {1, _I_, _SH_},   {1, _I_, _RH_},   {0, _I_, _I_},    {0, _I_, _Y_},
+    {0, _Y_, _R_},    {0, _Y_, _S_},    {0, _S_, _Y_},    {0, _R_, _Y_},    {0, _R_, _I_},    {0, _S_, _I_},
+    {0, _I_, _S_},    {0, _I_, _R_},    {0, _R_, _S_},    {0, _S_, _R_},    {0, _S_, _S_},    {0, _R_, _R_},
+    /* edge, _HZ_ */
+    {1, _HY_, _Z_},   {1, _I_, _HX_},   {1, _I_, _H_},    {1, _HY_, _I_},   {0, _I_, _Y_},    {1, _HY_, _R_},
+    {1, _HY_, _S_},   {0, _I_, _I_},    {1, _I_, _RH_},   {1, _I_, _SH_},   {0, _Y_, _I_},    {0, _Y_, _Y_},
+    {0, _I_, _R_},    {0, _I_, _S_},    {0, _R_, _Y_},    {0, _S_, _Y_},    {0, _S_, _I_},    {0, _R_, _I_},
+    {0, _Y_, _S_},    {0, _Y_, _R_},    {0, _S_, _S_},    {0, _R_, _R_},    {0, _R_, _S_},    {0, _S_, _R_},
+    /* edge, _SH_ */
+    {1, _H_, _R_},    {1, _I_, _SHY_},  {1, _I_, _RHY_},  {1, _H_, _S_},    {0, _S_, _I_},    {1, _H_, _I_},
+    {1, _H_, _Z_},    {0, _S_, _Y_},    {1, _I_, _HZ_},   {1, _I_, _HY_},   {0, _R_, _Y_},    {0, _R_, _I_},
+    {0, _S_, _S_},    {0, _S_, _R_},    {0, _Y_, _I_},    {0, _I_, _I_},    {0, _I_, _Y_},    {0, _Y_, _Y_},
+    {0, _R_, _R_},    {0, _R_, _S_},    {0, _I_, _R_},    {0, _Y_, _S_},    {0, _Y_, _R_},    {0, _I_, _S_},
+    /* edge, _RH_ */
+    {1, _H_, _S_},    {1, _I_, _RHY_},  {1, _I_, _SHY_},  {1, _H_, _R_},    {0, _R_, _I_},    {1, _H_, _Z_},
+    {1, _H_, _I_},    {0, _R_, _Y_},    {1, _I_, _HY_},   {1, _I_, _HZ_},   {0, _S_, _Y_},    {0, _S_, _I_},
+    {0, _R_, _S_},    {0, _R_, _R_},    {0, _I_, _I_},    {0, _Y_, _I_},    {0, _Y_, _Y_},    {0, _I_, _Y_},
+    {0, _S_, _R_},    {0, _S_, _S_},    {0, _Y_, _R_},    {0, _I_, _S_},    {0, _I_, _R_},    {0, _Y_, _S_},
+    /* edge, _HS_ */
+    {0, _R_, _R_},    {0, _S_, _S_},    {0, _S_, _R_},    {0, _R_, _S_},    {0, _I_, _S_},    {0, _R_, _I_},
+    {0, _R_, _Z_},    {0, _I_, _R_},    {0, _S_, _Y_},    {0, _S_, _I_},    {0, _Y_, _S_},    {0, _Y_, _R_},
+    {0, _I_, _Y_},    {0, _I_, _I_},    {1, _I_, _SH_},   {1, _I_, _RHY_},  {1, _I_, _SHY_},  {1, _I_, _RH_},
+    {0, _Y_, _Y_},    {0, _Y_, _I_},    {1, _I_, _HZ_},   {1, _I_, _HX_},   {1, _I_, _H_},    {1, _I_, _HY_},
+    /* edge, _HR_ */
+    {0, _S_, _S_},    {0, _R_, _R_},    {0, _R_, _S_},    {0, _S_, _R_},    {0, _I_, _R_},    {0, _S_, _Z_},
+    {0, _S_, _I_},    {0, _I_, _S_},    {0, _R_, _I_},    {0, _R_, _Y_},    {0, _Y_, _R_},    {0, _Y_, _S_},
+    {0, _I_, _I_},    {0, _I_, _Y_},    {1, _I_, _SHY_},  {1, _I_, _RH_},   {1, _I_, _SH_},   {1, _I_, _RHY_},
+    {0, _Y_, _I_},    {0, _Y_, _Y_},    {1, _I_, _HX_},   {1, _I_, _HZ_},   {1, _I_, _HY_},   {1, _I_, _H_},
+    /* edge, _HSX_ */
+    {0, _R_, _S_},    {0, _S_, _R_},    {0, _S_, _S_},    {0, _R_, _R_},    {0, _Y_, _R_},    {0, _R_, _Z_},
+    {0, _R_, _I_},    {0, _Y_, _S_},    {0, _S_, _I_},    {0, _S_, _Y_},    {0, _I_, _R_},    {0, _I_, _S_},
+    {0, _Y_, _I_},    {0, _Y_, _Y_},    {1, _I_, _RHY_},  {1, _I_, _SH_},   {1, _I_, _RH_},   {1, _I_, _SHY_},
+    {0, _I_, _I_},    {0, _I_, _Y_},    {1, _I_, _H_},    {1, _I_, _HY_},   {1, _I_, _HZ_},   {1, _I_, _HX_},
+    /* edge, _HRX_ */
+    {0, _S_, _R_},    {0, _R_, _S_},    {0, _R_, _R_},    {0, _S_, _S_},    {0, _Y_, _S_},    {0, _S_, _I_},
+    {0, _S_, _Z_},    {0, _Y_, _R_},    {0, _R_, _Y_},    {0, _R_, _I_},    {0, _I_, _S_},    {0, _I_, _R_},
+    {0, _Y_, _Y_},    {0, _Y_, _I_},    {1, _I_, _RH_},   {1, _I_, _SHY_},  {1, _I_, _RHY_},  {1, _I_, _SH_},
+    {0, _I_, _Y_},    {0, _I_, _I_},    {1, _I_, _HY_},   {1, _I_, _H_},    {1, _I_, _HX_},   {1, _I_, _HZ_},
+    /* edge, _SHY_ */
+    {1, _HY_, _R_},   {1, _I_, _SH_},   {1, _I_, _RH_},   {1, _HY_, _S_},   {0, _R_, _Y_},    {1, _HY_, _I_},
+    {1, _HY_, _Z_},   {0, _R_, _I_},    {1, _I_, _HX_},   {1, _I_, _H_},    {0, _S_, _I_},    {0, _S_, _Y_},
+    {0, _R_, _R_},    {0, _R_, _S_},    {0, _Y_, _Y_},    {0, _I_, _Y_},    {0, _I_, _I_},    {0, _Y_, _I_},
+    {0, _S_, _S_},    {0, _S_, _R_},    {0, _I_, _S_},    {0, _Y_, _R_},    {0, _Y_, _S_},    {0, _I_, _R_},
+    /* edge, _RHY_ */
+    {1, _HY_, _S_},   {1, _I_, _RH_},   {1, _I_, _SH_},   {1, _HY_, _R_},   {0, _S_, _Y_},    {1, _HY_, _Z_},
+    {1, _HY_, _I_},   {0, _S_, _I_},    {1, _I_, _H_},    {1, _I_, _HX_},   {0, _R_, _I_},    {0, _R_, _Y_},
+    {0, _S_, _R_},    {0, _S_, _S_},    {0, _I_, _Y_},    {0, _Y_, _Y_},    {0, _Y_, _I_},    {0, _I_, _I_},
+    {0, _R_, _S_},    {0, _R_, _R_},    {0, _Y_, _S_},    {0, _I_, _R_},    {0, _I_, _S_},    {0, _Y_, _R_},
+    /* edge, _HSH_ */
+    {0, _I_, _S_},    {0, _Y_, _R_},    {0, _Y_, _S_},    {0, _I_, _R_},    {0, _R_, _R_},    {0, _I_, _Z_},
+    {0, _I_, _I_},    {0, _R_, _S_},    {0, _Y_, _I_},    {0, _Y_, _Y_},    {0, _S_, _R_},    {0, _S_, _S_},
+    {0, _R_, _I_},    {0, _R_, _Y_},    {1, _I_, _HZ_},   {1, _I_, _HX_},   {1, _I_, _H_},    {1, _I_, _HY_},
+    {0, _S_, _I_},    {0, _S_, _Y_},    {1, _I_, _SH_},   {1, _I_, _RHY_},  {1, _I_, _SHY_},  {1, _I_, _RH_},
+    /* edge, _HRH_ */
+    {0, _I_, _R_},    {0, _Y_, _S_},    {0, _Y_, _R_},    {0, _I_, _S_},    {0, _S_, _S_},    {0, _I_, _I_},
+    {0, _I_, _Z_},    {0, _S_, _R_},    {0, _Y_, _Y_},    {0, _Y_, _I_},    {0, _R_, _S_},    {0, _R_, _R_},
+    {0, _S_, _Y_},    {0, _S_, _I_},    {1, _I_, _HX_},   {1, _I_, _HZ_},   {1, _I_, _HY_},   {1, _I_, _H_},
+    {0, _R_, _Y_},    {0, _R_, _I_},    {1, _I_, _SHY_},  {1, _I_, _RH_},   {1, _I_, _SH_},   {1, _I_, _RHY_},
+    /* edge, _RHS_ */
+    {0, _Y_, _R_},    {0, _I_, _S_},    {0, _I_, _R_},    {0, _Y_, _S_},    {0, _R_, _S_},    {0, _Y_, _I_},
+    {0, _Y_, _Z_},    {0, _R_, _R_},    {0, _I_, _Y_},    {0, _I_, _I_},    {0, _S_, _S_},    {0, _S_, _R_},
+    {0, _R_, _Y_},    {0, _R_, _I_},    {1, _I_, _H_},    {1, _I_, _HY_},   {1, _I_, _HZ_},   {1, _I_, _HX_},
+    {0, _S_, _Y_},    {0, _S_, _I_},    {1, _I_, _RHY_},  {1, _I_, _SH_},   {1, _I_, _RH_},   {1, _I_, _SHY_},
+    /* edge, _SHR_ */
+    {0, _Y_, _S_},    {0, _I_, _R_},    {0, _I_, _S_},    {0, _Y_, _R_},    {0, _S_, _R_},    {0, _Y_, _Z_},
+    {0, _Y_, _I_},    {0, _S_, _S_},    {0, _I_, _I_},    {0, _I_, _Y_},    {0, _R_, _R_},    {0, _R_, _S_},
+    {0, _S_, _I_},    {0, _S_, _Y_},    {1, _I_, _HY_},   {1, _I_, _H_},    {1, _I_, _HX_},   {1, _I_, _HZ_},
+    {0, _R_, _I_},    {0, _R_, _Y_},    {1, _I_, _RH_},   {1, _I_, _SHY_},  {1, _I_, _RHY_},  {1, _I_, _SH_}
+};
+
+#else
+extern const uint8_t GRAPH_STATE_REMOVE_VOP_STEP[N_LOCAL_CLIFFORDS];
+extern const struct graph_state_cz_t GRAPH_STATE_CZ_TABLE[2 * N_LOCAL_CLIFFORDS * N_LOCAL_CLIFFORDS];
+#endif
+
+#endif
@@ -7,6 +7,8 @@
 #include "conditional_operations.h"
 #include "widget.h"
 
+// Table of indirections indexed by instruction type
+extern void (*instruction_switch[])(widget_t*, void*);
 
 /*
  * parse_instruction_block
@@ -30,6 +32,15 @@ void parse_instruction_block(
  */
 void apply_local_cliffords(widget_t* wid);
 
+/*
+ * widget_permute_qubits
+ * Permutes the logical qubits of the widget
+ * :: wid : widget_t* :: Current widget
+ * :: perm : const uint32_t* :: Permutation over the initial qubits, logical qubit i moves to perm[i]
+ * Acts on the qubit map only, the same as a sequence of swap gates
+ */
+void widget_permute_qubits(widget_t* wid, const uint32_t* perm);
+
 /*
  * teleport_input
  * Sets the widget up to accept teleported inputs
@@ -1,28 +1,68 @@
-#ifndef INPUT_STREAM_H
-#define INPUT_STREAM_H
+#ifndef INPUT_STREAM_PAR_H
+#define INPUT_STREAM_PAR_H
 
 #include "threadpool.h"
 #include "instructions.h"
-#include "tableau_operations_par.h"
+#include "input_stream.h"
 #include "widget.h"
 
+// Below this many bytes of live rows the serial path is used
+#define INPUT_STREAM_PAR_MIN_BYTES (2 * CACHE_SIZE)
+
+/*
+ * Non-local Clifford log entry
+ * Carries the local Cliffords flushed from both qubits so the replay makes one pass
+ */
+struct fused_two_qubit_op
+{
+    instruction_t opcode;
+    instruction_t ctrl_clifford;
+    instruction_t targ_clifford;
+    uint32_t ctrl;
+    uint32_t targ;
+};
+
+/*
+ * Log entries, distinguished by the opcode in the first field
+ */
+union tableau_op
+{
+    instruction_t opcode;
+    struct single_qubit_instruction single;
+    struct fused_two_qubit_op fused;
+};
+typedef union tableau_op tableau_op_u;
+
+/*
+ * Log of tableau operations emitted by a block of instructions
+ * Local Clifford entries use the single variant with a physical target
+ * Non-local Clifford entries use the fused variant with physical qubits
+ */
+struct tableau_op_log_t
+{
+    size_t n_ops;
+    tableau_op_u* ops;
+};
+
 /*
- * parse_instruction_block
- * Parses a block of instructions 
- * :: wid : widget_t* :: Current widget 
- * :: instructions : instruction_stream_u* :: Array of instructions 
- * :: n_instructions : const size_t :: Number of instructions in the stream 
- * This implementation may be replaced with a thread pool dispatcher
+ * parse_instruction_block_par
+ * Parses a block of instructions over the threadpool
+ * :: wid : widget_t* :: Current widget
+ * :: instructions : instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the stream
+ * The clifford queue, qubit map and Pauli tracker are updated once on the calling thread
+ * The resulting tableau operations are then replayed by each worker over its own byte stripe
+ * Falls back to parse_instruction_block if the pool is not running or the tableau is small
  */
-void parse_instruction_block(
+void parse_instruction_block_par(
     widget_t* wid,
     instruction_stream_u* instructions,
     const size_t n_instructions);
 
 
 /*
- * apply_local_cliffords
- * Empties the local clifford table and applies the local cliffords
+ * apply_local_cliffords_par
+ * Empties the local clifford table and applies the local cliffords over the threadpool
  * :: wid : widget_t* :: The widget
  * Acts in place over the tableau and the clifford table
  */
@@ -0,0 +1,245 @@
+#ifndef INSTRUCTION_FILE_H
+#define INSTRUCTION_FILE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "widget.h"
+#include "input_stream.h"
+#include "input_stream_par.h"
+#include "binary_io.h"
+
+/*
+ * Packed instruction file
+ * File header: magic, then a little endian uint32 version
+ * Instructions follow in blocks, each a one byte opcode then its operands as uint32 varints:
+ *   local Clifford                       : qubit
+ *   rz                                   : qubit, tag
+ *   two qubit, qubit map and conditional : ctrl, targ
+ * The index follows the last block, per block a little endian uint64 offset, byte length, instruction count and rz count
+ * The file ends with a uint64 block count, the uint64 offset of the index and the magic again
+ * A file without this trailer was never closed and is rejected
+ */
+#define INSTRUCTION_FILE_MAGIC "CABI"
+#define INSTRUCTION_FILE_MAGIC_LEN (4)
+#define INSTRUCTION_FILE_VERSION (1)
+#define INSTRUCTION_FILE_HEADER_LEN (INSTRUCTION_FILE_MAGIC_LEN + sizeof(uint32_t))
+#define INSTRUCTION_FILE_INDEX_ENTRY_LEN (4 * sizeof(uint64_t))
+#define INSTRUCTION_FILE_TRAILER_LEN (2 * sizeof(uint64_t) + INSTRUCTION_FILE_MAGIC_LEN)
+#define INSTRUCTION_FILE_ENCODED_MAX (1 + 2 * 5) // Opcode and two uint32 varints
+#define INSTRUCTION_FILE_DEFAULT_BLOCK (1 << 16) // Instructions per block
+
+/*
+ * instruction_file_block_t
+ * Index entry of one block
+ */
+struct instruction_file_block_t
+{
+    size_t offset;
+    size_t len; // Bytes
+    size_t n_instructions;
+    size_t n_rz;
+};
+typedef struct instruction_file_block_t instruction_file_block_t;
+
+/*
+ * instruction_file_writer_t
+ * Streams instructions to a file descriptor
+ * Instructions are encoded into the current block, which is written once full
+ */
+struct instruction_file_writer_t
+{
+    int fd;
+    size_t block_size; // Instructions per block
+    uint8_t* buffer; // Current block, block_size * INSTRUCTION_FILE_ENCODED_MAX bytes
+    size_t buffer_len;
+    instruction_file_block_t current;
+    instruction_file_block_t* blocks;
+    size_t n_blocks;
+    size_t capacity;
+    size_t n_bytes; // Written so far, including the file header
+    bool failed; // The file descriptor stopped accepting bytes, later writes are dropped
+};
+typedef struct instruction_file_writer_t instruction_file_writer_t;
+
+/*
+ * instruction_file_reader_t
+ * Maps an instruction file and reads its index
+ * Decoded blocks are dropped from the mapping, so a pass over the file runs in memory bounded by one block
+ */
+struct instruction_file_reader_t
+{
+    const uint8_t* map;
+    size_t len;
+    size_t n_blocks;
+    size_t n_instructions;
+    size_t n_rz;
+    size_t max_block; // Instructions in the largest block
+    instruction_file_block_t* blocks;
+};
+typedef struct instruction_file_reader_t instruction_file_reader_t;
+
+/*
+ * instruction_file_sequence_t
+ * Splits the instructions of a file into a sequence of widgets as widget_sequence_t does
+ * Blocks are decoded one at a time into a reused buffer
+ */
+struct instruction_file_sequence_t
+{
+    const instruction_file_reader_t* reader; // Borrowed, must outlive the sequence
+    instruction_stream_u* buffer; // Decoded block, max_block entries
+    size_t n_decoded;
+    size_t position; // Next instruction in the buffer
+    size_t next_block;
+    size_t qubit_width;
+    size_t max_qubits;
+    size_t rz_budget;
+    bool teleport_input;
+    size_t n_widgets;
+    bool failed; // Stopped at a corrupt block or an instruction outside qubit_width
+};
+typedef struct instruction_file_sequence_t instruction_file_sequence_t;
+
+/*
+ * instruction_file_writer_open
+ * Starts an instruction file on a file descriptor and writes its header
+ * :: fd : const int :: Open, writable file descriptor, not closed by the writer
+ * :: block_size : const size_t :: Instructions per block, 0 for INSTRUCTION_FILE_DEFAULT_BLOCK
+ * Returns NULL if the header cannot be written
+ */
+instruction_file_writer_t* instruction_file_writer_open(const int fd, const size_t block_size);
+
+/*
+ * instruction_file_write
+ * Appends instructions to the file
+ * :: writer : instruction_file_writer_t* :: Writer
+ * :: instructions : const instruction_stream_u* :: Instructions
+ * :: n_instructions : const size_t :: Number of instructions
+ */
+void instruction_file_write(
+    instruction_file_writer_t* writer,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions);
+
+/*
+ * instruction_file_writer_close
+ * Writes the last block, the index and the trailer then frees the writer
+ * :: writer : instruction_file_writer_t* :: Writer
+ * Returns the size of the file in bytes, 0 if any write failed, the file descriptor stays open
+ */
+size_t instruction_file_writer_close(instruction_file_writer_t* writer);
+
+/*
+ * instruction_file_reader_open
+ * Maps an instruction file read only and reads its index
+ * :: path : const char* :: Path to the file
+ * Returns NULL if the file cannot be mapped, is not of this version or was not closed
+ */
+instruction_file_reader_t* instruction_file_reader_open(const char* path);
+
+/*
+ * instruction_file_reader_close
+ * Unmaps the file
+ * :: reader : instruction_file_reader_t* :: Reader
+ */
+void instruction_file_reader_close(instruction_file_reader_t* reader);
+
+/*
+ * instruction_file_n_instructions
+ * Number of instructions in the file
+ * :: reader : const instruction_file_reader_t* :: Reader
+ */
+size_t instruction_file_n_instructions(const instruction_file_reader_t* reader);
+
+/*
+ * instruction_file_read_block
+ * Decodes one block
+ * :: reader : const instruction_file_reader_t* :: Reader
+ * :: idx : const size_t :: Block index
+ * :: dst : instruction_stream_u* :: At least the block's instruction count, max_block always suffices
+ * Returns the number of instructions decoded, 0 if the block is corrupt as blocks are never empty
+ */
+size_t instruction_file_read_block(const instruction_file_reader_t* reader, const size_t idx, instruction_stream_u* dst);
+
+/*
+ * instruction_file_read
+ * Decodes the whole file
+ * :: reader : const instruction_file_reader_t* :: Reader
+ * :: dst : instruction_stream_u* :: instruction_file_n_instructions entries
+ * Returns false if a block is corrupt, blocks before it are decoded
+ */
+bool instruction_file_read(const instruction_file_reader_t* reader, instruction_stream_u* dst);
+
+/*
+ * instruction_file_parse
+ * Parses every instruction of the file into a widget, one block at a time
+ * :: reader : const instruction_file_reader_t* :: Reader
+ * :: wid : widget_t* :: Widget
+ * :: parse : parser :: parse_instruction_block or parse_instruction_block_par
+ * Returns false if a block is corrupt or addresses a qubit past the widget's initial qubits
+ * Blocks before it have been parsed
+ */
+bool instruction_file_parse(
+    const instruction_file_reader_t* reader,
+    widget_t* wid,
+    void (*parse)(widget_t*, instruction_stream_u*, const size_t));
+
+/*
+ * instruction_file_sequence_create
+ * Constructor for a widget sequence over a file
+ * :: reader : const instruction_file_reader_t* :: Reader, not copied
+ * :: qubit_width : const size_t :: Initial qubits of each widget
+ * :: max_qubits : const size_t :: Qubits per widget, the rz budget is what remains after the inputs are teleported
+ * :: teleport_input : const bool :: Whether each widget teleports its inputs
+ */
+instruction_file_sequence_t* instruction_file_sequence_create(
+    const instruction_file_reader_t* reader,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const bool teleport_input);
+
+/*
+ * instruction_file_sequence_destroy
+ * Destructor for a widget sequence over a file
+ * :: seq : instruction_file_sequence_t* :: Sequence to free, the reader is left alone
+ */
+void instruction_file_sequence_destroy(instruction_file_sequence_t* seq);
+
+/*
+ * instruction_file_sequence_done
+ * Whether every widget of the sequence has been filled, or the sequence failed
+ * :: seq : const instruction_file_sequence_t* :: Sequence
+ */
+bool instruction_file_sequence_done(const instruction_file_sequence_t* seq);
+
+/*
+ * instruction_file_sequence_failed
+ * Whether the sequence stopped at a corrupt block or at an instruction outside qubit_width
+ * :: seq : const instruction_file_sequence_t* :: Sequence
+ */
+bool instruction_file_sequence_failed(const instruction_file_sequence_t* seq);
+
+/*
+ * instruction_file_sequence_fill
+ * Parses the next widget of the file without decomposing it
+ * :: seq : instruction_file_sequence_t* :: Sequence, must not be done
+ * :: wid : widget_t* :: Widget to reset and reuse, NULL to allocate a new one
+ * :: parse : parser :: parse_instruction_block or parse_instruction_block_par
+ * Returns the filled widget, or NULL if the sequence failed
+ * On failure a widget passed in stays with the caller and one allocated here is freed
+ */
+widget_t* instruction_file_sequence_fill(
+    instruction_file_sequence_t* seq,
+    widget_t* wid,
+    void (*parse)(widget_t*, instruction_stream_u*, const size_t));
+
+/*
+ * instruction_file_sequence_next
+ * Builds and decomposes the next widget of the file
+ * :: seq : instruction_file_sequence_t* :: Sequence
+ * :: wid : widget_t* :: Widget from an earlier call to reset and reuse, NULL to allocate a new one
+ * Returns the decomposed widget, owned by the caller, or NULL once the file is consumed or the sequence failed
+ */
+widget_t* instruction_file_sequence_next(instruction_file_sequence_t* seq, widget_t* wid);
+
+#endif
@@ -9,6 +9,7 @@
 #define RZ_MASK ((uint8_t)(1 << 7)) 
 
 #define MEASUREMENT_CONDITIONED_MASK ((uint8_t)((1 << 6) | (1 << 7)))    
+#define QUBIT_MAP_MASK ((uint8_t)((1 << 5) | (1 << 6))) // Relabels logical qubits without touching the tableau
 
 #define N_LOCAL_CLIFFORDS 24 
 #define N_NON_LOCAL_CLIFFORDS 2 
@@ -54,10 +55,13 @@
 
 #define _NOP_ (0xff) 
 
+#define _MEAS_ (0x00 | MEASUREMENT_CONDITIONED_MASK) // Measurement conditioned identity, a bare measurement
 #define _MCX_ (0x01 | MEASUREMENT_CONDITIONED_MASK)
 #define _MCY_ (0x02 | MEASUREMENT_CONDITIONED_MASK)
 #define _MCZ_ (0x03 | MEASUREMENT_CONDITIONED_MASK)
 
+#define _SWAP_ (0x00 | QUBIT_MAP_MASK)
+
 
 /*
  * instruction_struct
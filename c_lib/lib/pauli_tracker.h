@@ -36,6 +36,23 @@ void* pauli_tracker_create(size_t n_qubits);
  */
 void pauli_tracker_destroy(void* tracker);
 
+/*
+ * pauli_tracker_clear
+ * Empties the tracker for reuse
+ * :: tracker : void* :: Opaque pointer to rust tracker object
+ * :: n_qubits : size_t :: Number of qubits in the cleared tracker
+ */
+void pauli_tracker_clear(void* tracker, size_t n_qubits);
+
+/*
+ * pauli_tracker_grow
+ * Adds qubits to the tracker
+ * :: tracker : void* :: Opaque pointer to rust tracker object
+ * :: n_qubits : size_t :: Current number of qubits in the tracker
+ * :: new_qubits : size_t :: Number of qubits after growing
+ */
+void pauli_tracker_grow(void* tracker, size_t n_qubits, size_t new_qubits);
+
 /*
  * pauli_track_x
  * :: tracker : void* :: Opaque pointer to rust tracker object 
@@ -0,0 +1,158 @@
+#ifndef QASM_H
+#define QASM_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "widget.h"
+#include "input_stream.h"
+#include "input_stream_par.h"
+#include "instruction_file.h"
+
+/*
+ * OpenQASM 2 front end
+ * Supports the Clifford+RZ subset:
+ *   OPENQASM, include, qreg, creg, barrier
+ *   id, h, s, sdg, x, y, z, t, tdg, rz(angle), cx, cz, swap, measure
+ * Gates applied to whole registers are broadcast as in OpenQASM 2
+ * Registers share one flat index space in the order they are declared
+ * Angles are expressions over numbers and pi with + - * / and parentheses
+ * An angle is interned as the bits of its float, as angle_to_tag does in cabaliser.gate_constructors
+ */
+#define QASM_ANGLE_EPS (1e-12) // Angles below this are the identity, matching angle_to_tag
+#define QASM_MAX_OPERANDS (2)
+#define QASM_DEFAULT_BLOCK (1 << 16) // Instructions per block when parsing into a widget
+
+/*
+ * qasm_register_t
+ * Declared quantum register
+ */
+struct qasm_register_t
+{
+    char* name;
+    size_t offset; // First flat qubit index
+    size_t len;
+};
+typedef struct qasm_register_t qasm_register_t;
+
+/*
+ * qasm_operand_t
+ * One operand of a statement, a single qubit has a length of one
+ */
+struct qasm_operand_t
+{
+    size_t offset;
+    size_t len;
+    bool broadcast; // Whole register
+};
+typedef struct qasm_operand_t qasm_operand_t;
+
+/*
+ * qasm_parser_t
+ * Streaming parser state
+ * Statements are read one at a time, a broadcast statement may be spread over several reads
+ */
+struct qasm_parser_t
+{
+    FILE* stream;
+    bool owned; // Whether the stream is closed with the parser
+    char* statement; // Current statement, without comments
+    size_t statement_len;
+    size_t statement_cap;
+    size_t line; // Line of the current statement
+    size_t next_line; // Line of the stream position
+    qasm_register_t* qregs;
+    size_t n_qregs;
+    size_t n_qubits;
+    // Pending statement
+    instruction_t opcode;
+    non_clifford_tag_t tag;
+    qasm_operand_t operands[QASM_MAX_OPERANDS];
+    size_t n_operands;
+    size_t n_pending;
+    size_t emitted;
+    size_t n_instructions; // Emitted so far
+    const char* error; // NULL unless parsing failed
+};
+typedef struct qasm_parser_t qasm_parser_t;
+
+/*
+ * qasm_parser_create
+ * Constructor for a parser over an open stream
+ * :: stream : FILE* :: Readable stream, not closed by the parser
+ */
+qasm_parser_t* qasm_parser_create(FILE* stream);
+
+/*
+ * qasm_parser_open
+ * Constructor for a parser over a file
+ * :: path : const char* :: Path to the file
+ * Returns NULL if the file cannot be opened
+ */
+qasm_parser_t* qasm_parser_open(const char* path);
+
+/*
+ * qasm_parser_destroy
+ * Destructor for a parser
+ * :: parser : qasm_parser_t* :: Parser to free, closes the stream if it was opened by the parser
+ */
+void qasm_parser_destroy(qasm_parser_t* parser);
+
+/*
+ * qasm_angle_to_tag
+ * Interns an angle as a tag
+ * :: angle : const double :: Angle in radians
+ * Returns the bits of the angle as a float, or 0 for angles within QASM_ANGLE_EPS of 0
+ * The angle must be finite and fit in a float, the parser rejects any other
+ */
+non_clifford_tag_t qasm_angle_to_tag(const double angle);
+
+/*
+ * qasm_parser_read
+ * Parses the next instructions from the stream
+ * :: parser : qasm_parser_t* :: Parser
+ * :: dst : instruction_stream_u* :: Destination
+ * :: max_instructions : const size_t :: Capacity of the destination
+ * Returns the number of instructions written, 0 once the stream is consumed or parsing fails
+ */
+size_t qasm_parser_read(qasm_parser_t* parser, instruction_stream_u* dst, const size_t max_instructions);
+
+/*
+ * qasm_parser_error
+ * Describes why parsing failed
+ * :: parser : const qasm_parser_t* :: Parser
+ * Returns NULL if it has not, see qasm_parser_line for where
+ */
+const char* qasm_parser_error(const qasm_parser_t* parser);
+
+/*
+ * qasm_parser_line
+ * Line of the statement being parsed, which is the failing statement after an error
+ * :: parser : const qasm_parser_t* :: Parser
+ */
+size_t qasm_parser_line(const qasm_parser_t* parser);
+
+/*
+ * qasm_parse
+ * Parses the whole stream into a widget in blocks
+ * :: parser : qasm_parser_t* :: Parser
+ * :: wid : widget_t* :: Widget with at least as many initial qubits as the circuit declares
+ * :: parse : parser :: parse_instruction_block or parse_instruction_block_par
+ * Returns the number of instructions parsed, check qasm_parser_error
+ */
+size_t qasm_parse(
+    qasm_parser_t* parser,
+    widget_t* wid,
+    void (*parse)(widget_t*, instruction_stream_u*, const size_t));
+
+/*
+ * qasm_write_instruction_file
+ * Converts the whole stream to an instruction file, which instruction_file_sequence_t splits into widgets
+ * :: parser : qasm_parser_t* :: Parser
+ * :: writer : instruction_file_writer_t* :: Open writer, left open
+ * Returns the number of instructions written, check qasm_parser_error
+ */
+size_t qasm_write_instruction_file(qasm_parser_t* parser, instruction_file_writer_t* writer);
+
+#endif
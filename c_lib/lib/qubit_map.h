@@ -15,6 +15,15 @@ typedef size_t qubit_map_t;
  */
 qubit_map_t* qubit_map_create(const size_t initial_qubits, const size_t max_qubits);
 
+/*
+ * qubit_map_grow
+ * Extends a qubit map
+ * :: q_map : qubit_map_t* :: The qubit map
+ * :: max_qubits : const size_t :: New maximum number of qubits in the map
+ * Returns the map, which may have moved
+ */
+qubit_map_t* qubit_map_grow(qubit_map_t* q_map, const size_t max_qubits);
+
 /*
  * qubit_map_destroy
  * Destructor for the qubit map
@@ -4,11 +4,27 @@
 
 #include "widget.h"
 #include "tableau_operations.h"
+#include "threadpool.h"
 
 #include "simd_headers.h"
 
 typedef struct widget_t widget_t;
 
+// Parallel block elimination
+#define DECOMP_PAR_TASKS_PER_WORKER (4) // Extra tasks per worker help balance uneven blocks
+#define DECOMP_PAR_MAX_TASKS (256)
+#define DECOMP_PAR_MIN_ROWS (256) // Smaller tableaux are eliminated serially
+
+// Method of Four Russians elimination of the X block
+#define DECOMP_M4RI_GROUP_BITS (8) // Pivot rows per table
+#define DECOMP_M4RI_GROUPS (64 / DECOMP_M4RI_GROUP_BITS)
+#define DECOMP_M4RI_TABLE_SIZE (1ull << DECOMP_M4RI_GROUP_BITS)
+#define DECOMP_M4RI_MIN_BITS (4 * DECOMP_M4RI_GROUPS * DECOMP_M4RI_TABLE_SIZE) // Automatic mode only builds tables for denser pivot columns
+
+#define DECOMP_MODE_ROWSUM (0) // One rowsum per set bit
+#define DECOMP_MODE_M4RI (1) // One table rowsum per group of set bits 
+#define DECOMP_MODE_AUTO (2) // Picks on the number of bits to clear in each pivot block
+
 /*
  * simd_widget_decompose
  * Decomposes the stabiliser tableau into a graph state plus local Cliffords 
@@ -40,6 +56,14 @@ size_t simd_tableau_X_diag_element(tableau_t* tab, clifford_queue_t* queue, cons
 
 void simd_tableau_elim(widget_t* wid);
 
+/*
+ * simd_tableau_elim_set_mode
+ * Selects how simd_tableau_elim clears the columns of each pivot block
+ * :: mode : const uint8_t :: One of DECOMP_MODE_ROWSUM, DECOMP_MODE_M4RI or DECOMP_MODE_AUTO
+ * The setting is process wide, both modes produce identical tableaux
+ */
+void simd_tableau_elim_set_mode(const uint8_t mode);
+
 void tableau_elim_upper(widget_t* wid);
 void tableau_elim_lower(widget_t* wid);
 
@@ -4,6 +4,13 @@
 #include "tableau.h"
 #include "simd_headers.h"
 
+/*
+ * simd_tableau_transverse_hadamard
+ * Applies a hadamard to a column of a transposed tableau
+ * :: tab : tableau_t*  :: Tableau object
+ * :: targ : const size_t :: Index to target 
+ * Acts on 64 row tiles of the chunk containing the target
+ */
 void simd_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ);
 
 #endif
@@ -21,6 +21,16 @@ typedef struct tableau_t tableau_t;
 
 #define CTZ_SENTINEL (~0ll)
 
+#define TABLEAU_ALLOC_ALIGNED (0) // posix_memalign followed by a serial memset of the bitmap
+#define TABLEAU_ALLOC_MMAP (1) // Anonymous mapping, the kernel zero fills pages on first touch
+#define TABLEAU_ALLOC_HUGE (2) // Anonymous mapping advised for transparent huge pages
+#define TABLEAU_ALLOC_HUGETLB (3) // Explicit huge pages, falls back to TABLEAU_ALLOC_HUGE when none are reserved
+#define TABLEAU_ALLOC_FIRST_TOUCH (4) // Anonymous mapping, each threadpool worker faults in the stripe it operates on
+#define TABLEAU_N_ALLOC_POLICIES (5)
+#define TABLEAU_ALLOC_DEFAULT TABLEAU_ALLOC_MMAP
+
+#define TABLEAU_HUGE_PAGE_SIZE (1ull << 21) // Explicit huge page mappings must be a multiple of this
+
 #define SLICE_LEN_BYTES(n_qubits, stride_bytes) (size_t)(((n_qubits) / 8) + (!!(n_qubits % (stride_bytes * 8))) * ((stride_bytes) - (n_qubits / 8) % (stride_bytes)))
 
 #define SLICE_LEN(n_qubits, stride_bytes) (SLICE_LEN_BYTES(n_qubits, stride_bytes) / (stride_bytes))
@@ -61,6 +71,10 @@ typedef struct tableau_t tableau_t;
 #define TABLEAU_SIMD_STRIDE (TABLEAU_SIMD_LANE_SIZE) 
 #define TABLEAU_STRIDE(tab) (SLICE_LEN_CACHE(tab->n_qubits) * CACHE_SIZE)
 
+// Number of bytes of each slice that hold live rows, rounded up to a cache line
+// A cache line is the widest stride of any of the dispatched kernels
+#define TABLEAU_ACTIVE_LEN_BYTES(n_active) (SLICE_LEN(n_active, CACHE_SIZE) * CACHE_SIZE)
+
 #define CACHE_CHUNKS (CACHE_SIZE / CHUNK_SIZE_BYTES)
 
 struct aligned_chunk {
@@ -73,11 +87,15 @@ typedef CHUNK_OBJ* tableau_slice_p;
 struct tableau_t {
     size_t n_qubits; // Number of qubits
     size_t slice_len; // Number of bytes
+    size_t active_start; // First byte touched by gate kernels, only non-zero for stripe views
+    size_t active_len; // Number of bytes touched by gate kernels
     void* chunks; // Pointer to allocated chunks
     tableau_slice_p* slices_x; // Slice representation pointers 
     tableau_slice_p* slices_z; // Slice representation pointers 
     tableau_slice_p phases; // Phase terms
     bool orientation; // Row or column major order
+    uint8_t alloc_policy; // Policy used for the bitmap, may differ from the one requested after a fallback
+    size_t alloc_bytes; // Size of the bitmap allocation
 };
 
 /*
@@ -88,6 +106,37 @@ struct tableau_t {
  */
 tableau_t* tableau_create(const size_t n_qubits);
 
+/*
+ * tableau_create_alloc
+ * Constructor for tableau with a choice of allocation policy for the bitmap
+ * :: n_qubits : const size_t :: Number of qubits
+ * :: alloc_policy : const uint8_t :: One of the TABLEAU_ALLOC_* policies
+ * Mapped policies skip the memset, untouched pages read as zero
+ * First touch distributes the zeroing over the threadpool so each page lands on the node of the worker that owns its stripe
+ */
+tableau_t* tableau_create_alloc(const size_t n_qubits, const uint8_t alloc_policy);
+
+
+/*
+ * tableau_reset
+ * Returns a tableau to the all zero state without reallocating
+ * :: tab : tableau_t* :: Tableau to reset
+ * :: n_dirty : const size_t :: Number of qubits that gates or a decomposition have acted on
+ * Columns below n_dirty are cleared over the live region, past it only the diagonal word can have changed
+ * Leaves the live region covering n_dirty qubits
+ */
+void tableau_reset(tableau_t* tab, const size_t n_dirty);
+
+/*
+ * tableau_grow
+ * Moves a column major tableau into a larger allocation
+ * :: tab : tableau_t* :: Tableau to grow, freed by this call
+ * :: n_qubits : const size_t :: New number of qubits
+ * :: alloc_policy : const uint8_t :: TABLEAU_ALLOC_* policy for the new bitmap
+ * Only the live region of each slice is copied, rows and columns past it are still in the identity state
+ * Returns the new tableau with the same live region
+ */
+tableau_t* tableau_grow(tableau_t* tab, const size_t n_qubits, const uint8_t alloc_policy);
 
 /*
  * tableau_destroy 
@@ -184,10 +233,8 @@ void tableau_transpose_naive(tableau_t* tab);
 
 /*
  * tableau_rowsum
- * tableau_rowsum_offset 
  * Performs a rowsum between two rows of stabilisers 
- * The offset version of the function starts
- * from an offset bit index 
+ * Sums the whole row, the Z block of a pivot row is dense even where its X block is zero
  * :: tab : tableau_t const* :: Tableau object
  * :: ctrl : const size_t :: Control of the rowsum
  * :: targ : const size_t :: Target of the rowsum
@@ -196,10 +243,6 @@ void tableau_rowsum(
     tableau_t* tab,
     const size_t ctrl,
     const size_t targ);
-void tableau_rowsum_offset(tableau_t* tab,
-    const size_t ctrl,
-    const size_t targ,
-    const size_t offset);
 
 /*
  * tableau_slice_empty_x
@@ -259,4 +302,32 @@ void tableau_idx_swap_transverse(tableau_t* tab, const size_t i, const size_t j)
  */
 void tableau_set_n_qubits(tableau_t* tab, const size_t n_qubits);
 
+/*
+ * tableau_set_active_qubits
+ * Sets the high water mark of live rows in the tableau
+ * :: tab : tableau_t* :: The tableau
+ * :: n_active : const size_t :: Number of live rows
+ * Gate kernels only act on the first active_len bytes of each slice
+ * Rows past the high water mark must still be in their initial identity state
+ */
+void tableau_set_active_qubits(tableau_t* tab, const size_t n_active);
+
+/*
+ * tableau_stripe_view
+ * Shallow copy of a tableau restricted to a byte stripe of each slice
+ * :: tab : const tableau_t* :: The tableau
+ * :: start : const size_t :: First byte of the stripe, a multiple of the simd stride
+ * :: stop : const size_t :: One past the last byte of the stripe
+ * The view shares the slices of the original tableau
+ * Gate kernels acting on the view only touch bytes [start, stop) of each slice and of the phases
+ */
+static inline
+tableau_t tableau_stripe_view(const tableau_t* tab, const size_t start, const size_t stop)
+{
+    tableau_t view = *tab;
+    view.active_start = start;
+    view.active_len = stop;
+    return view;
+}
+
 #endif 
@@ -0,0 +1,213 @@
+#ifndef TABLEAU_KERNELS_H
+#define TABLEAU_KERNELS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "tableau.h"
+#include "instruction_table.h"
+
+// Kernel sets, picked at load time from the host CPU
+#define TABLEAU_KERNELS_SCALAR (0)
+#define TABLEAU_KERNELS_AVX2 (1)
+#define TABLEAU_KERNELS_AVX512 (2)
+#define TABLEAU_KERNELS_NEON (3)
+#define TABLEAU_KERNELS_N_BACKENDS (4)
+
+#define TABLEAU_KERNELS_ENV_BACKEND "CABALISER_BACKEND" // One of scalar, avx2, avx512 or neon
+
+/*
+ * Truth tables for the local Clifford gates
+ * Each gate maps (x, z, r) to (x', z', r') where every output is a boolean function of the inputs
+ * Functions are written as ternary logic immediates over the three input patterns below
+ * so that the AVX-512 kernels can evaluate each output with a single vpternlog
+ * Order matches the opcodes in instructions.h
+ */
+#define TL_X (0xf0)
+#define TL_Z (0xcc)
+#define TL_R (0xaa)
+#define TL_IMM(f) ((f) & 0xff)
+
+#define LOCAL_CLIFFORD_TRUTH_TABLES(GATE) \
+    GATE(I, TL_X, TL_Z, TL_R) \
+    GATE(X, TL_X, TL_Z, TL_R ^ TL_Z) \
+    GATE(Y, TL_X, TL_Z, TL_R ^ TL_X ^ TL_Z) \
+    GATE(Z, TL_X, TL_Z, TL_R ^ TL_X) \
+    GATE(H, TL_Z, TL_X, TL_R ^ (TL_X & TL_Z)) \
+    GATE(S, TL_X, TL_X ^ TL_Z, TL_R ^ (TL_X & TL_Z)) \
+    GATE(R, TL_X, TL_X ^ TL_Z, TL_R ^ (TL_X & ~TL_Z)) \
+    GATE(HX, TL_Z, TL_X, TL_R ^ (~TL_X & TL_Z)) \
+    GATE(SX, TL_X, TL_X ^ TL_Z, TL_R ^ (~TL_X & TL_Z)) \
+    GATE(RX, TL_X, TL_X ^ TL_Z, TL_R ^ (TL_X | TL_Z)) \
+    GATE(HY, TL_Z, TL_X, TL_R ^ (TL_X | TL_Z)) \
+    GATE(HZ, TL_Z, TL_X, TL_R ^ (TL_X & ~TL_Z)) \
+    GATE(SH, TL_Z, TL_X ^ TL_Z, TL_R) \
+    GATE(RH, TL_Z, TL_X ^ TL_Z, TL_R ^ TL_Z) \
+    GATE(HS, TL_X ^ TL_Z, TL_X, TL_R ^ TL_X) \
+    GATE(HR, TL_X ^ TL_Z, TL_X, TL_R) \
+    GATE(HSX, TL_X ^ TL_Z, TL_X, TL_R ^ TL_X ^ TL_Z) \
+    GATE(HRX, TL_X ^ TL_Z, TL_X, TL_R ^ TL_Z) \
+    GATE(SHY, TL_Z, TL_X ^ TL_Z, TL_R ^ TL_X ^ TL_Z) \
+    GATE(RHY, TL_Z, TL_X ^ TL_Z, TL_R ^ TL_X) \
+    GATE(HSH, TL_X ^ TL_Z, TL_Z, TL_R ^ (~TL_X & TL_Z)) \
+    GATE(HRH, TL_X ^ TL_Z, TL_Z, TL_R ^ (TL_X & TL_Z)) \
+    GATE(RHS, TL_X ^ TL_Z, TL_Z, TL_R ^ (TL_X | TL_Z)) \
+    GATE(SHR, TL_X ^ TL_Z, TL_Z, TL_R ^ (TL_X & ~TL_Z))
+
+/*
+ * Local Cliffords in symplectic form
+ * x' = (x & xx) ^ (z & xz)
+ * z' = (x & zx) ^ (z & zz)
+ * r' = r ^ (x & rx) ^ (z & rz) ^ (x & z & ry)
+ * Each field is either all ones or all zeros so kernels can broadcast it
+ * Lets one kernel apply any pair of queued Cliffords alongside a two qubit gate
+ */
+struct local_clifford_masks_t
+{
+    uint64_t xx, xz;
+    uint64_t zx, zz;
+    uint64_t rx, rz, ry;
+};
+
+// Truth table bits for x only, z only and both, with the phase clear
+#define TL_IDX_X (4)
+#define TL_IDX_Z (2)
+#define TL_IDX_Y (6)
+#define TL_MASK(f, idx) (((TL_IMM(f) >> (idx)) & 1) ? ~0ull : 0ull)
+
+#define LOCAL_CLIFFORD_MASKS_ENTRY(gate, f_x, f_z, f_r) { \
+    .xx = TL_MASK(f_x, TL_IDX_X), .xz = TL_MASK(f_x, TL_IDX_Z), \
+    .zx = TL_MASK(f_z, TL_IDX_X), .zz = TL_MASK(f_z, TL_IDX_Z), \
+    .rx = TL_MASK(f_r, TL_IDX_X), .rz = TL_MASK(f_r, TL_IDX_Z), \
+    .ry = TL_MASK(f_r, TL_IDX_X) ^ TL_MASK(f_r, TL_IDX_Z) ^ TL_MASK(f_r, TL_IDX_Y)},
+
+#ifdef TABLEAU_KERNELS_SRC
+    const struct local_clifford_masks_t LOCAL_CLIFFORD_MASKS[N_LOCAL_CLIFFORDS] = {
+        LOCAL_CLIFFORD_TRUTH_TABLES(LOCAL_CLIFFORD_MASKS_ENTRY)
+    };
+#else
+    extern const struct local_clifford_masks_t LOCAL_CLIFFORD_MASKS[N_LOCAL_CLIFFORDS];
+#endif
+
+typedef void (*single_qubit_kernel_t)(tableau_t*, const size_t targ);
+typedef void (*two_qubit_kernel_t)(tableau_t*, const size_t ctrl, const size_t targ);
+typedef void (*fused_two_qubit_kernel_t)(tableau_t*, const instruction_t ctrl_clifford, const size_t ctrl, const instruction_t targ_clifford, const size_t targ);
+typedef int8_t (*rowsum_kernel_t)(const size_t, void* restrict, void* restrict, void* restrict, void* restrict);
+typedef void (*row_swap_kernel_t)(const size_t, void* restrict, void* restrict, void* restrict, void* restrict);
+
+/*
+ * Kernel set
+ * Every backend provides the full set, falling back to a narrower set's kernels where
+ * a wider implementation would not help
+ */
+struct tableau_kernels_t
+{
+    uint8_t backend;
+    const char* name;
+    single_qubit_kernel_t single_qubit[N_LOCAL_CLIFFORDS];
+    two_qubit_kernel_t two_qubit[N_NON_LOCAL_CLIFFORDS];
+    fused_two_qubit_kernel_t fused_two_qubit[N_NON_LOCAL_CLIFFORDS];
+    rowsum_kernel_t rowsum_cnf;
+    row_swap_kernel_t row_swap;
+    void (*transpose_64x64)(uint64_t* restrict src[64], uint64_t* restrict targ[64]);
+    void (*transpose_64x64_inplace)(uint64_t* src[64]);
+    void (*transverse_hadamard)(tableau_t const* tab, const size_t targ);
+};
+
+#ifdef TABLEAU_KERNELS_SRC
+    struct tableau_kernels_t TABLEAU_KERNELS_g;
+#else
+    extern struct tableau_kernels_t TABLEAU_KERNELS_g;
+#endif
+
+/*
+ * tableau_kernels_init
+ * Selects the kernel set for the host
+ * The environment override is checked first, then the CPU features
+ * Called on library load and from widget_create, only the first call has an effect
+ */
+void tableau_kernels_init(void);
+
+/*
+ * tableau_kernels_set_backend
+ * Forces a kernel set
+ * :: backend : const uint8_t :: One of the TABLEAU_KERNELS_* backends
+ * Returns 1 on success, 0 if the host cannot run the backend
+ * Must not be called while the tableau is being operated on
+ */
+uint8_t tableau_kernels_set_backend(const uint8_t backend);
+
+/*
+ * tableau_kernels_backend
+ * Gets the active kernel set
+ */
+uint8_t tableau_kernels_backend(void);
+
+/*
+ * tableau_kernels_backend_supported
+ * Checks whether the host can run a kernel set
+ * :: backend : const uint8_t :: One of the TABLEAU_KERNELS_* backends
+ */
+uint8_t tableau_kernels_backend_supported(const uint8_t backend);
+
+/*
+ * tableau_kernels_backend_name
+ * Name of a backend as accepted by the environment override
+ * :: backend : const uint8_t :: One of the TABLEAU_KERNELS_* backends
+ */
+const char* tableau_kernels_backend_name(const uint8_t backend);
+
+// Per backend kernels
+#define DECLARE_BACKEND_KERNELS(prefix) \
+    void prefix##_tableau_I(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_X(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_Y(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_Z(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_H(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_S(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_R(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_HX(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_SX(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_RX(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_HY(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_HZ(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_SH(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_RH(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_HS(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_HR(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_HSX(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_HRX(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_SHY(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_RHY(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_HSH(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_HRH(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_RHS(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_SHR(tableau_t* tab, const size_t targ); \
+    void prefix##_tableau_CNOT(tableau_t* tab, const size_t ctrl, const size_t targ); \
+    void prefix##_tableau_CZ(tableau_t* tab, const size_t ctrl, const size_t targ); \
+    void prefix##_tableau_fused_CNOT(tableau_t* tab, const instruction_t ctrl_clifford, const size_t ctrl, const instruction_t targ_clifford, const size_t targ); \
+    void prefix##_tableau_fused_CZ(tableau_t* tab, const instruction_t ctrl_clifford, const size_t ctrl, const instruction_t targ_clifford, const size_t targ); \
+    int8_t prefix##_rowsum_cnf(const size_t n_bytes, void* restrict ctrl_x, void* restrict ctrl_z, void* restrict targ_x, void* restrict targ_z); \
+    void prefix##_row_swap(const size_t n_bytes, void* restrict ctrl_x, void* restrict ctrl_z, void* restrict targ_x, void* restrict targ_z);
+
+DECLARE_BACKEND_KERNELS(scalar)
+void scalar_transpose_64x64(uint64_t* restrict src[64], uint64_t* restrict targ[64]);
+void scalar_transpose_64x64_inplace(uint64_t* src[64]);
+void scalar_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ);
+
+#if defined(__x86_64__)
+DECLARE_BACKEND_KERNELS(avx2)
+void avx2_transpose_64x64(uint64_t* restrict src[64], uint64_t* restrict targ[64]);
+void avx2_transpose_64x64_inplace(uint64_t* src[64]);
+void avx2_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ);
+
+DECLARE_BACKEND_KERNELS(avx512)
+#elif defined(__arm__) || defined(__aarch64__)
+DECLARE_BACKEND_KERNELS(neon)
+void neon_transpose_64x64(uint64_t* restrict src[64], uint64_t* restrict targ[64]);
+void neon_transpose_64x64_inplace(uint64_t* src[64]);
+void neon_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ);
+#endif
+
+#endif
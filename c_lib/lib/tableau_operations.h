@@ -7,6 +7,7 @@
 #include "tableau.h"
 #include "instructions.h"
 #include "debug.h"
+#include "tableau_kernels.h"
 
 /*
 #define OPT_PRAGMA
@@ -98,44 +99,95 @@ void tableau_SHR(tableau_t* tab, const size_t targ);
 void tableau_CNOT(tableau_t* tab, const size_t ctrl, const size_t targ);
 void tableau_CZ(tableau_t* tab, const size_t ctrl, const size_t targ);
 
+
+/*
+ * tableau_fused_<clifford>
+ * Applies a local Clifford to each qubit followed by a two qubit Clifford in one pass
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: ctrl_clifford : const instruction_t :: Local Clifford opcode applied to the control first
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ_clifford : const instruction_t :: Local Clifford opcode applied to the target first
+ * :: targ : const size_t :: The target qubit
+ * Acts in place on the tableau
+ */
+void tableau_fused_CNOT(tableau_t* tab, const instruction_t ctrl_clifford, const size_t ctrl, const instruction_t targ_clifford, const size_t targ);
+void tableau_fused_CZ(tableau_t* tab, const instruction_t ctrl_clifford, const size_t ctrl, const instruction_t targ_clifford, const size_t targ);
+
 #ifdef TABLEAU_OPERATIONS_SRC
 
-  void (*SINGLE_QUBIT_OPERATIONS[N_LOCAL_CLIFFORDS])(tableau_t*, const size_t targ) = {
-        tableau_I, 
-        tableau_X, 
-        tableau_Y, 
-        tableau_Z, 
-        tableau_H, 
-        tableau_S, 
-        tableau_R, 
-        tableau_HX,
-        tableau_SX,
-        tableau_RX,
-        tableau_HY,
-        tableau_HZ,
-        tableau_SH,
-        tableau_RH,
-        tableau_HS,
-        tableau_HR,
-        tableau_HSX,
-        tableau_HRX,
-        tableau_SHY,
-        tableau_RHY,
-        tableau_HSH,
-        tableau_HRH,
-        tableau_RHS,
-        tableau_SHR};
+    // Scalar kernels until tableau_kernels_init picks the kernel set for the host
+
+    void (*SINGLE_QUBIT_OPERATIONS[N_LOCAL_CLIFFORDS])(tableau_t*, const size_t targ) = {
+        scalar_tableau_I, 
+        scalar_tableau_X, 
+        scalar_tableau_Y, 
+        scalar_tableau_Z, 
+        scalar_tableau_H, 
+        scalar_tableau_S, 
+        scalar_tableau_R, 
+        scalar_tableau_HX,
+        scalar_tableau_SX,
+        scalar_tableau_RX,
+        scalar_tableau_HY,
+        scalar_tableau_HZ,
+        scalar_tableau_SH,
+        scalar_tableau_RH,
+        scalar_tableau_HS,
+        scalar_tableau_HR,
+        scalar_tableau_HSX,
+        scalar_tableau_HRX,
+        scalar_tableau_SHY,
+        scalar_tableau_RHY,
+        scalar_tableau_HSH,
+        scalar_tableau_HRH,
+        scalar_tableau_RHS,
+        scalar_tableau_SHR};
 
     void (*TWO_QUBIT_OPERATIONS[N_LOCAL_CLIFFORDS])(tableau_t*, const size_t ctrl, const size_t targ) = {
-        tableau_CNOT,
-        tableau_CZ
+        scalar_tableau_CNOT,
+        scalar_tableau_CZ
+};
+
+    void (*FUSED_TWO_QUBIT_OPERATIONS[N_NON_LOCAL_CLIFFORDS])(tableau_t*, const instruction_t, const size_t, const instruction_t, const size_t) = {
+        scalar_tableau_fused_CNOT,
+        scalar_tableau_fused_CZ
 };
 
 #else
     extern void (*SINGLE_QUBIT_OPERATIONS[])(tableau_t*, const size_t targ);
     extern void (*TWO_QUBIT_OPERATIONS[])(tableau_t*, const size_t ctrl, const size_t targ);
+    extern void (*FUSED_TWO_QUBIT_OPERATIONS[])(tableau_t*, const instruction_t, const size_t, const instruction_t, const size_t);
 #endif
 
 
+/*
+ * __inline_tableau_fused_non_local_clifford
+ * Applies queued local Cliffords on both qubits and then a two qubit Clifford
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: opcode : const instruction_t :: Two qubit opcode
+ * :: ctrl_clifford : const instruction_t :: Local Clifford opcode on the control
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ_clifford : const instruction_t :: Local Clifford opcode on the target
+ * :: targ : const size_t :: The target qubit
+ * Falls through to the plain gate when nothing is queued, as it does less work per vector
+ */
+static inline
+void __inline_tableau_fused_non_local_clifford(
+    tableau_t* tab,
+    const instruction_t opcode,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ)
+{
+    if (_I_ == ctrl_clifford && _I_ == targ_clifford)
+    {
+        TWO_QUBIT_OPERATIONS[opcode & INSTRUCTION_OPERATOR_MASK](tab, ctrl, targ);
+        return;
+    }
+    FUSED_TWO_QUBIT_OPERATIONS[opcode & INSTRUCTION_OPERATOR_MASK](tab, ctrl_clifford, ctrl, targ_clifford, targ);
+}
+
+
 
 #endif
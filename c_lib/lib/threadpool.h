@@ -3,23 +3,67 @@
 
 #include <pthread.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <unistd.h>
 #include <errno.h>
 
-#include "tableau.h" 
-#include "linked_list.h"
+#include "tableau.h"
 
-#define N_WORKERS (2)
+#define THREADPOOL_MAX_WORKERS (256)
+#define THREADPOOL_DEQUE_SIZE (1024) // Must be a power of two
+#define THREADPOOL_DEQUE_MASK (THREADPOOL_DEQUE_SIZE - 1)
+#define THREADPOOL_SPIN_ITERS (4096) // Polls before an idle worker sleeps
+#define THREADPOOL_ENV_N_WORKERS "CABALISER_N_THREADS"
 #define NULL_TARG (~(0ull))  // Null target
 
+// Flags for threadpool_init
+#define THREADPOOL_PIN_WORKERS (1u << 0) // Pin worker i to CPU i
+
+/*
+ * Completion counter for a group of jobs
+ * Waiting on a batch only waits on the jobs submitted to it,
+ * so batches may be waited on from inside pool jobs and from several threads at once
+ */
+struct threadpool_batch_t
+{
+    size_t n_pending; // Jobs in the batch either queued or running
+};
+typedef struct threadpool_batch_t threadpool_batch_t;
+#define THREADPOOL_BATCH_INIT {.n_pending = 0}
+
+struct threadpool_job
+{
+    void (*fn)(void*);
+    void* args;
+    threadpool_batch_t* batch; // NULL for jobs outside any batch
+};
+
+/*
+ * Per worker double ended queue
+ * The owner pushes and pops from the bottom, thieves steal from the top
+ * Deques are padded to a cache line to avoid false sharing between workers
+ */
+struct threadpool_deque_t
+{
+    struct threadpool_job jobs[THREADPOOL_DEQUE_SIZE];
+    size_t top;
+    size_t bottom;
+    volatile int lock;
+} __attribute__((aligned(CACHE_SIZE)));
+
 struct threadpool_t {
     size_t n_workers;
     size_t active_workers;
-    pthread_t workers[N_WORKERS]; 
-    struct linked_list_t* job_queue; 
-    pthread_mutex_t queue_lock;  
-    bool alive; // Set to false to kill workers 
-    __uint128_t dependent_qubits; // Tracks qubits under operation
+    uint32_t flags;
+    pthread_t workers[THREADPOOL_MAX_WORKERS];
+    struct threadpool_deque_t* deques;
+    size_t n_queued; // Jobs sitting in a deque
+    size_t n_pending; // Jobs either queued or running
+    size_t n_sleeping; // Workers blocked on the wake condition
+    size_t next_deque; // Round robin target for submissions from outside the pool
+    pthread_mutex_t sleep_lock;
+    pthread_cond_t wake;
+    bool alive; // Set to false to kill workers
 };
 typedef struct threadpool_t threadpool_t;
 
@@ -28,59 +72,77 @@ typedef struct threadpool_t threadpool_t;
     bool THREADPOOL_INITIALISED = 0;
 #else
     extern threadpool_t THREADPOOL_g;
-#endif 
-
+    extern bool THREADPOOL_INITIALISED;
+#endif
 
-struct threadpool_job
-{
-    void (*fn)(void*);
-    void* args;
-};
 
 struct threadpool_arg
 {
     size_t thread_id;
-    void* job;
-}; 
-
-struct threadpool_barrier_t
-{
-    pthread_barrier_t barrier;         
-    uint32_t thread_count;
 };
 
+/*
+ * Arguments handed to each stripe of a distributed tableau operation
+ * [start, stop) is a byte range of the tableau slices
+ */
 struct distributed_tableau_op
 {
     tableau_t* tab;
     size_t ctrl;
-    size_t targ; 
+    size_t targ;
     size_t start;
     size_t stop;
+    void* args; // Shared by all stripes
 };
 
 /*
  * threadpool_worker
  * Threadpool worker function
- * :: args : void* ::
- * Polls the queue and pops items from it
- * Queue items should be function pointers and associated arguments  
- * Args are NULL
+ * :: args : void* :: struct threadpool_arg* owned by the worker
+ * Pops jobs from its own deque and steals from the other workers when empty
+ * Idle workers spin briefly before sleeping on the wake condition
  * Returns NULL
  */
 void* threadpool_worker(void* args);
 
 /*
+ * threadpool_add_task
  * Adds a job to the threadpool
+ * :: fn : void (*)(void*) :: Job function
+ * :: args : void* :: Arguments to the job, owned by the caller
+ * Jobs submitted from a worker land on that worker's deque
+ * If the target deque is full the job is run inline
  */
 void threadpool_add_task(void (*fn)(void*), void* args);
 
 /*
- * threadpool_distribute_tableau_operation_single
- * Distributes a tableau operation over the workers 
+ * threadpool_batch_add_task
+ * Adds a job to the threadpool as part of a batch
+ * :: batch : threadpool_batch_t* :: Batch to count the job against, must outlive the job
+ * :: fn : void (*)(void*) :: Job function
+ * :: args : void* :: Arguments to the job, owned by the caller
+ * Otherwise as threadpool_add_task
+ */
+void threadpool_batch_add_task(threadpool_batch_t* batch, void (*fn)(void*), void* args);
+
+/*
+ * threadpool_batch_wait
+ * Blocks until every job in the batch has completed
+ * :: batch : threadpool_batch_t* :: Batch to wait on
+ * The calling thread runs queued jobs while it waits
+ * Safe to call from inside a pool job
+ */
+void threadpool_batch_wait(threadpool_batch_t* batch);
+
+/*
+ * threadpool_distribute_tableau_operation
+ * Distributes a tableau operation over the workers
  * :: tab : tableau_t* :: Tableau to operate over
- * :: fn : void* (*)(void*) :: Function to distriute
- * :: ctrl : const size_t :: First qubit 
+ * :: fn : void (*)(void*) :: Function to distribute, receives a struct distributed_tableau_op*
+ * :: ctrl : const size_t :: First qubit
  * :: targ : const size_t :: Second qubit, set to NULL_TARG to null
+ * Splits the live region of the tableau into one stripe per worker
+ * Returns once all stripes have completed, stripes are waited on as their own batch
  */
 void threadpool_distribute_tableau_operation(
     tableau_t* tab,
@@ -89,27 +151,51 @@ void threadpool_distribute_tableau_operation(
     const size_t targ);
 
 /*
- * threadpool_barrier 
- * Adds a task to the threadpool that is just a barrier
- * This forces threads to complete before the next task may resume 
- * :: 
+ * threadpool_distribute_tableau_operation_args
+ * As threadpool_distribute_tableau_operation, with extra arguments shared by every stripe
+ * :: args : void* :: Passed through as the args member of each struct distributed_tableau_op
+ */
+void threadpool_distribute_tableau_operation_args(
+    tableau_t* tab,
+    void (*fn)(void*),
+    const size_t ctrl,
+    const size_t targ,
+    void* args);
+
+/*
+ * threadpool_barrier
+ * Blocks until every submitted job has completed, including jobs in other threads' batches
+ * The calling thread runs queued jobs while it waits
+ * Only for draining the pool, code that waits on its own jobs should use a batch
  */
 void threadpool_barrier();
 
 /*
  * threadpool_join
+ * Waits for outstanding jobs, stops the workers and joins their threads
  */
 void threadpool_join();
 
 /*
- * threadpool_join
+ * threadpool_destroy
+ * Joins the workers and releases the pool
+ * The pool may be initialised again afterwards
  */
 void threadpool_destroy();
 
 /*
  * threadpool_init
+ * Starts the pool
+ * :: n_workers : const size_t :: Number of worker threads, 0 reads CABALISER_N_THREADS and falls back to the number of online CPUs
+ * :: flags : const uint32_t :: THREADPOOL_PIN_WORKERS to pin workers to CPUs
+ * Calling init on a running pool restarts it with the new configuration
  */
-void threadpool_init();
+void threadpool_init(const size_t n_workers, const uint32_t flags);
 
+/*
+ * threadpool_n_workers
+ * Number of workers in the pool, 1 if the pool is not running
+ */
+size_t threadpool_n_workers();
 
 #endif
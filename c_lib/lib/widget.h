@@ -10,21 +10,63 @@
 
 #include "qubit_map.h"
 #include "adjacency.h"
+#include "graph_state.h"
 
 #include "pauli_tracker.h"
+#include "widget_stats.h"
 
 
 #define WMAP_LOOKUP(widget, idx) (widget->q_map[idx])
 
+#define WIDGET_ENGINE_TABLEAU (0) // Dense stabiliser tableau, decomposed by elimination
+#define WIDGET_ENGINE_GRAPH (1) // Graph state with vertex operators, no decomposition step
+#define WIDGET_ENGINE_AUTO (2) // Starts on the graph engine, converts to the tableau once the graph is dense
+
+#define WIDGET_AUTO_WINDOW (64) // Two qubit gates between density checks
+#define WIDGET_AUTO_DEFAULT_THRESHOLD (2.0) // Conversion costs a full pass over the tableau, so stay sparse a little past break even
+#define WIDGET_AUTO_TOGGLE_QUBITS (4096) // Tableau width at which one gate costs about one edge toggle
+
+// Capacity grows by half again, so the tableau grows by 2.25x and each growth copies under half of the new tableau
+#define WIDGET_GROWTH_NUMERATOR (3)
+#define WIDGET_GROWTH_DENOMINATOR (2)
+
+#define WIDGET_CSR_ROWS_PER_TASK (256) // Rows handed to each threadpool task when exporting the graph
+
+/*
+ * widget_engine_stats_t
+ * Engine choice and graph density, reported by widget_get_engine_stats
+ * Graph fields are frozen at the conversion point once the widget moves to the tableau
+ */
+struct widget_engine_stats_t
+{
+    uint8_t requested_engine;
+    uint8_t engine; // Engine currently in use
+    uint8_t converted;
+    size_t n_gates; // Two qubit gates applied, including rz teleportation
+    size_t conversion_gate; // Gate count at the conversion
+    size_t conversion_qubits; // Qubits in use at the conversion
+    size_t n_edges;
+    size_t max_degree;
+    size_t n_toggles; // Edge toggles, the graph engine's work
+};
+
 struct widget_t {
     size_t n_qubits;
     size_t n_initial_qubits;
-    size_t max_qubits; // Should be a multiple of 64
+    size_t max_qubits; // Current capacity, grown by widget_reserve
     struct tableau_t* tableau;
     struct clifford_queue_t* queue;
     qubit_map_t* q_map;
     void* pauli_tracker;
     struct clifford_queue_t* decomp_queue;
+    struct graph_state_t* graph; // Only allocated by the graph engine, the tableau is then NULL
+    uint8_t engine;
+    struct widget_engine_stats_t engine_stats;
+    double auto_threshold; // Graph work per gate relative to a tableau gate before converting
+    size_t auto_window_toggles; // Toggle count at the start of the current window
+    uint8_t alloc_policy; // Allocation policy for the tableau
+    struct adjacency_csr_t* csr; // Set by widget_finalise, which frees the tableau or graph
+    struct widget_stats_t stats; // Only written when built with WIDGET_STATS
 };
 typedef struct widget_t widget_t;
 
@@ -42,6 +84,96 @@ typedef struct widget_t widget_t;
 widget_t* widget_create(const size_t initial_qubits, const size_t max_qubits);
 
 
+/*
+ * widget_create_engine
+ * Constructor for widget object with a choice of simulation engine
+ * :: initial_qubits : const size_t :: Initial number of allocated qubits for the widget
+ * :: max_qubits : const size_t :: Maximum number of qubits that may be allocated
+ * :: engine : const uint8_t :: WIDGET_ENGINE_TABLEAU, WIDGET_ENGINE_GRAPH or WIDGET_ENGINE_AUTO
+ * The graph engine stores O(n + edges) rather than O(n^2) and never eliminates,
+ * its output is the same state as the tableau engine but may differ by local complementation
+ */
+widget_t* widget_create_engine(const size_t initial_qubits, const size_t max_qubits, const uint8_t engine);
+
+
+/*
+ * widget_create_alloc
+ * Constructor for widget object with a choice of engine and tableau allocation policy
+ * :: initial_qubits : const size_t :: Initial number of allocated qubits for the widget
+ * :: max_qubits : const size_t :: Maximum number of qubits that may be allocated
+ * :: engine : const uint8_t :: WIDGET_ENGINE_TABLEAU, WIDGET_ENGINE_GRAPH or WIDGET_ENGINE_AUTO
+ * :: alloc_policy : const uint8_t :: TABLEAU_ALLOC_* policy, also used when an automatic widget converts
+ */
+widget_t* widget_create_alloc(const size_t initial_qubits, const size_t max_qubits, const uint8_t engine, const uint8_t alloc_policy);
+
+
+/*
+ * widget_reset
+ * Returns a widget to the state widget_create would give it, reusing its allocations
+ * :: wid : widget_t* :: Widget to reset, decomposed or not
+ * :: initial_qubits : const size_t :: Initial number of qubits for the next use
+ * Only the tableau columns of qubits the widget has allocated are cleared, the linear sized queues are cleared in full
+ * The Pauli tracker is emptied
+ * An automatic widget that converted to the tableau goes back to the graph engine
+ */
+void widget_reset(widget_t* wid, const size_t initial_qubits);
+
+
+/*
+ * widget_reserve
+ * Ensures the widget has room for a number of qubits
+ * :: wid : widget_t* :: Widget to grow
+ * :: n_qubits : const size_t :: Number of qubits the widget must be able to hold
+ * Capacity grows geometrically, moving the tableau or graph, clifford queue, qubit map and Pauli tracker together
+ * Growth copies the live region of the old tableau, summed over every growth this is under 0.8 times the final tableau
+ * The old and new tableaus coexist during the copy, the old one being about 0.44 times the size of the new one
+ */
+void widget_reserve(widget_t* wid, const size_t n_qubits);
+
+
+/*
+ * widget_convert_to_tableau
+ * Moves a graph engine widget onto a dense tableau
+ * :: wid : widget_t* :: Widget on the graph engine
+ * Writes the graph state to a new tableau and frees the graph, the clifford queue is untouched
+ */
+void widget_convert_to_tableau(widget_t* wid);
+
+
+/*
+ * widget_set_auto_threshold
+ * Sets how dense the graph may get before an automatic widget converts
+ * :: wid : widget_t* :: The widget
+ * :: threshold : const double :: Ratio of the graph engine's cost per gate to the tableau's
+ * Graph cost is the edge toggle rate, tableau cost grows with the qubits in use, 1.0 converts near the break even point
+ */
+void widget_set_auto_threshold(widget_t* wid, const double threshold);
+
+
+/*
+ * widget_get_engine_stats
+ * Reports the engine in use and the graph density
+ * :: wid : const widget_t* :: The widget
+ */
+struct widget_engine_stats_t widget_get_engine_stats(const widget_t* wid);
+
+/*
+ * widget_get_stats
+ * Reports the phase timings and counters of the widget
+ * :: wid : const widget_t* :: The widget
+ * Everything is zero, including the enabled flag, unless the library was built with WIDGET_STATS
+ */
+struct widget_stats_t widget_get_stats(const widget_t* wid);
+
+/*
+ * widget_partial_order_graph
+ * Builds the partial order graph of the measurements from the Pauli tracker
+ * :: wid : widget_t* :: The widget
+ * Free with lib_pauli_tracker_graph_destroy
+ */
+void* widget_partial_order_graph(widget_t* wid);
+
+
 /*
  * widget_get_clifford_from_table
  * Retrieves a clifford byte from the table attached to queue
@@ -65,6 +197,16 @@ void widget_destroy(widget_t* wid);
  */
 void widget_decompose(widget_t* wid);
 
+/*
+ * widget_finalise
+ * Keeps only the compact result of a decomposed widget
+ * :: wid : widget_t* :: Decomposed widget
+ * Copies the graph into a CSR structure and frees the tableau or graph state
+ * Adjacency accessors then read the CSR, the queue, qubit map and Pauli tracker are kept
+ * widget_reset brings back the simulation state, nothing else may apply gates to a finalised widget
+ */
+void widget_finalise(widget_t* wid);
+
 /*
  * widget_get_n_qubits
  * widget_get_n_initial_qubits
@@ -86,5 +228,18 @@ size_t widget_get_max_qubits(const widget_t* wid);
 size_t* widget_get_io_map(const widget_t* wid);
 struct adjacency_obj widget_get_adjacencies(const widget_t* wid, const size_t target_qubit);
 
+/*
+ * widget_get_graph_csr
+ * Exports the whole graph in compressed sparse row form
+ * :: wid : const widget_t* :: Decomposed widget
+ * :: offsets : size_t* :: Caller provided, n_qubits + 1 entries, row i spans [offsets[i], offsets[i + 1])
+ * :: neighbours : uint32_t* :: Caller provided, offsets[n_qubits] entries, NULL to only fill the offsets
+ * :: upper_triangle : const bool :: Only report each edge from its lower vertex
+ * Call once with NULL neighbours to size the array, then again with the same offsets to fill it
+ * Rows are in ascending order, and are split over the threadpool
+ * Returns the number of neighbour entries
+ */
+size_t widget_get_graph_csr(const widget_t* wid, size_t* offsets, uint32_t* neighbours, const bool upper_triangle);
+
 
 #endif
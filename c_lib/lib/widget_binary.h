@@ -0,0 +1,224 @@
+#ifndef WIDGET_BINARY_H
+#define WIDGET_BINARY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "widget.h"
+#include "binary_io.h"
+#include "lib_pauli_tracker_graph.h"
+
+/*
+ * Binary widget container
+ * File header: magic, then a little endian uint32 version
+ * Each widget is a record, a little endian uint64 byte length followed by the body
+ * The body holds eight varint counts, six varint section lengths and then the sections:
+ *   graph       : upper triangle rows, each a varint length then delta varint neighbours
+ *   cliffords   : local Clifford operator indices packed five bits per qubit
+ *   tags        : varint measurement tag per qubit
+ *   io map      : varint output qubit per input
+ *   schedule    : per layer a varint node count, each node a varint qubit, count and dependencies
+ *   corrections : per correction a varint qubit then the Paulis packed two bits each
+ * Records are self delimiting, so a writer can stream them and a reader can skip them
+ */
+#define WIDGET_BINARY_MAGIC "CABW"
+#define WIDGET_BINARY_MAGIC_LEN (4)
+#define WIDGET_BINARY_VERSION (1)
+#define WIDGET_BINARY_HEADER_LEN (WIDGET_BINARY_MAGIC_LEN + sizeof(uint32_t))
+#define WIDGET_BINARY_VARINT_MAX (BINARY_VARINT_MAX)
+
+#define WIDGET_BINARY_CLIFFORD_BITS (5)
+#define WIDGET_BINARY_PAULI_BITS (2) // I, X, Y, Z as 0 to 3
+
+#define WIDGET_BINARY_N_SECTIONS (6)
+#define WIDGET_BINARY_GRAPH (0)
+#define WIDGET_BINARY_CLIFFORDS (1)
+#define WIDGET_BINARY_TAGS (2)
+#define WIDGET_BINARY_IO_MAP (3)
+#define WIDGET_BINARY_SCHEDULE (4)
+#define WIDGET_BINARY_CORRECTIONS (5)
+
+/*
+ * widget_binary_schedule_t
+ * Measurement schedule and Pauli corrections of one widget as flat arrays
+ * widget_binary_schedule_create builds them from the widget's Pauli tracker, callers may also fill them directly
+ * Layer i holds nodes [layer_offsets[i], layer_offsets[i + 1]), node j depends on [dep_offsets[j], dep_offsets[j + 1])
+ * Correction i applies paulis[i * correction_width, (i + 1) * correction_width) to correction_qubits[i]
+ */
+struct widget_binary_schedule_t
+{
+    size_t n_layers;
+    size_t n_nodes;
+    size_t n_deps;
+    size_t* layer_offsets; // n_layers + 1 entries
+    uint32_t* nodes; // Qubit of each node
+    size_t* dep_offsets; // n_nodes + 1 entries
+    uint32_t* deps;
+    size_t n_corrections;
+    size_t correction_width;
+    uint32_t* correction_qubits;
+    uint8_t* paulis; // WIDGET_BINARY_PAULI_BITS per entry
+};
+typedef struct widget_binary_schedule_t widget_binary_schedule_t;
+
+/*
+ * widget_binary_info_t
+ * Counts of one record, enough to size every array its readers fill
+ */
+struct widget_binary_info_t
+{
+    size_t n_qubits;
+    size_t n_initial_qubits;
+    size_t n_edges; // Each edge once
+    size_t n_layers;
+    size_t n_nodes;
+    size_t n_deps;
+    size_t n_corrections;
+    size_t correction_width;
+};
+typedef struct widget_binary_info_t widget_binary_info_t;
+
+/*
+ * widget_binary_writer_t
+ * Streams records to a file descriptor
+ * Each record is encoded into a reused buffer and written in one go
+ */
+struct widget_binary_writer_t
+{
+    int fd;
+    uint8_t* buffer;
+    size_t capacity;
+    size_t n_widgets;
+    size_t n_bytes; // Written so far, including the file header
+};
+typedef struct widget_binary_writer_t widget_binary_writer_t;
+
+/*
+ * widget_binary_reader_t
+ * Maps a container and indexes its records
+ */
+struct widget_binary_reader_t
+{
+    const uint8_t* map;
+    size_t len;
+    size_t n_widgets;
+    size_t* records; // Offset of each record body
+};
+typedef struct widget_binary_reader_t widget_binary_reader_t;
+
+/*
+ * widget_binary_writer_open
+ * Starts a container on a file descriptor and writes its header
+ * :: fd : const int :: Open, writable file descriptor, not closed by the writer
+ * Returns NULL if the header cannot be written
+ */
+widget_binary_writer_t* widget_binary_writer_open(const int fd);
+
+/*
+ * widget_binary_write
+ * Appends one decomposed widget to the container
+ * :: writer : widget_binary_writer_t* :: Writer
+ * :: wid : const widget_t* :: Decomposed widget
+ * :: schedule : const widget_binary_schedule_t* :: Schedule and corrections, NULL writes empty sections
+ * Returns the number of bytes written, 0 if the file descriptor failed part way through the record
+ */
+size_t widget_binary_write(widget_binary_writer_t* writer, const widget_t* wid, const widget_binary_schedule_t* schedule);
+
+/*
+ * widget_binary_writer_close
+ * Frees the writer, the file descriptor stays open
+ * :: writer : widget_binary_writer_t* :: Writer
+ */
+void widget_binary_writer_close(widget_binary_writer_t* writer);
+
+/*
+ * widget_binary_schedule_create
+ * Runs the Pauli tracker scheduler over a decomposed widget
+ * :: wid : widget_t* :: Decomposed widget, the graph build is added to its stats
+ * Nodes are limited to the widget's qubits, as Widget.get_schedule does
+ * Corrections are truncated to the widget's qubits, as Widget.get_pauli_corrections does
+ * Free the result with widget_binary_schedule_destroy
+ */
+widget_binary_schedule_t* widget_binary_schedule_create(widget_t* wid);
+
+/*
+ * widget_binary_schedule_destroy
+ * Frees a schedule from widget_binary_schedule_create
+ * :: schedule : widget_binary_schedule_t* :: Schedule
+ */
+void widget_binary_schedule_destroy(widget_binary_schedule_t* schedule);
+
+/*
+ * widget_binary_reader_open
+ * Maps a container read only and indexes its records
+ * :: path : const char* :: Path to the container
+ * Returns NULL if the file cannot be mapped, is not a container of this version, or holds a malformed record or trailing bytes
+ */
+widget_binary_reader_t* widget_binary_reader_open(const char* path);
+
+/*
+ * widget_binary_reader_close
+ * Unmaps the container
+ * :: reader : widget_binary_reader_t* :: Reader
+ */
+void widget_binary_reader_close(widget_binary_reader_t* reader);
+
+/*
+ * widget_binary_n_widgets
+ * Number of records in the container
+ * :: reader : const widget_binary_reader_t* :: Reader
+ */
+size_t widget_binary_n_widgets(const widget_binary_reader_t* reader);
+
+/*
+ * widget_binary_read_info
+ * Reads the counts of a record
+ * :: reader : const widget_binary_reader_t* :: Reader
+ * :: idx : const size_t :: Record index
+ * :: info : widget_binary_info_t* :: Written to
+ */
+void widget_binary_read_info(const widget_binary_reader_t* reader, const size_t idx, widget_binary_info_t* info);
+
+/*
+ * widget_binary_read_graph
+ * Decodes the graph of a record in compressed sparse row form
+ * :: reader : const widget_binary_reader_t* :: Reader
+ * :: idx : const size_t :: Record index
+ * :: offsets : size_t* :: n_qubits + 1 entries
+ * :: neighbours : uint32_t* :: n_edges entries for the upper triangle, otherwise 2 * n_edges
+ * :: upper_triangle : const bool :: Only report each edge from its lower vertex
+ * Rows are in ascending order, matching widget_get_graph_csr
+ */
+void widget_binary_read_graph(
+    const widget_binary_reader_t* reader,
+    const size_t idx,
+    size_t* offsets,
+    uint32_t* neighbours,
+    const bool upper_triangle);
+
+/*
+ * widget_binary_read_qubits
+ * Decodes the per qubit sections of a record
+ * :: reader : const widget_binary_reader_t* :: Reader
+ * :: idx : const size_t :: Record index
+ * :: local_cliffords : instruction_t* :: n_qubits entries, NULL to skip
+ * :: measurement_tags : non_clifford_tag_t* :: n_qubits entries, NULL to skip
+ * :: io_map : size_t* :: n_initial_qubits entries, NULL to skip
+ */
+void widget_binary_read_qubits(
+    const widget_binary_reader_t* reader,
+    const size_t idx,
+    instruction_t* local_cliffords,
+    non_clifford_tag_t* measurement_tags,
+    size_t* io_map);
+
+/*
+ * widget_binary_read_schedule
+ * Decodes the schedule and corrections of a record
+ * :: reader : const widget_binary_reader_t* :: Reader
+ * :: idx : const size_t :: Record index
+ * :: schedule : widget_binary_schedule_t* :: Arrays sized from widget_binary_read_info, the counts are written
+ */
+void widget_binary_read_schedule(const widget_binary_reader_t* reader, const size_t idx, widget_binary_schedule_t* schedule);
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef WIDGET_PIPELINE_H
+#define WIDGET_PIPELINE_H
+
+#include <pthread.h>
+#include <stdbool.h>
+
+#include "widget_sequence.h"
+
+#define WIDGET_PIPELINE_DEFAULT_DEPTH (2) // Double buffered, one widget filling while the other decomposes
+#define WIDGET_PIPELINE_MAX_DEPTH (64)
+
+/*
+ * widget_pipeline_queue_t
+ * Bounded first in first out queue of widgets between two stages
+ * Guarded by the pipeline lock
+ */
+struct widget_pipeline_queue_t
+{
+    widget_t* slots[WIDGET_PIPELINE_MAX_DEPTH];
+    size_t head; // Next slot to pop
+    size_t count;
+};
+
+/*
+ * widget_pipeline_t
+ * Runs a widget sequence as three stages
+ * The ingestion thread fills widgets, the decomposition thread decomposes them and the caller consumes them
+ * Every stage handles widgets in sequence order, so outputs arrive in order
+ * The depth bounds the number of widgets in flight, released widgets are reset and refilled
+ */
+struct widget_pipeline_t
+{
+    widget_sequence_t* seq;
+    size_t depth;
+    size_t n_widgets; // Widgets allocated so far, at most depth
+    widget_t* widgets[WIDGET_PIPELINE_MAX_DEPTH]; // Every widget owned by the pipeline
+    struct widget_pipeline_queue_t free; // Released, waiting to be refilled
+    struct widget_pipeline_queue_t filled; // Waiting to be decomposed
+    struct widget_pipeline_queue_t decomposed; // Waiting for the caller
+    bool filling; // Cleared once the ingestion stage has run out of instructions
+    bool decomposing; // Cleared once the decomposition stage has drained
+    bool alive; // Cleared to stop both stages early
+    pthread_mutex_t lock;
+    pthread_cond_t changed;
+    pthread_t ingest_thread;
+    pthread_t decompose_thread;
+};
+typedef struct widget_pipeline_t widget_pipeline_t;
+
+/*
+ * widget_pipeline_create
+ * Starts a pipelined widget sequence
+ * :: instructions : instruction_stream_u* :: Instruction stream, not copied, must outlive the pipeline
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: qubit_width : const size_t :: Initial qubits of each widget
+ * :: max_qubits : const size_t :: Qubits per widget, as for widget_sequence_create
+ * :: teleport_input : const bool :: Whether each widget teleports its inputs
+ * :: depth : const size_t :: Widgets in flight, 0 selects WIDGET_PIPELINE_DEFAULT_DEPTH
+ * Ingestion and decomposition each run on their own thread and share the threadpool
+ */
+widget_pipeline_t* widget_pipeline_create(
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const bool teleport_input,
+    const size_t depth);
+
+/*
+ * widget_pipeline_next
+ * Waits for the next decomposed widget
+ * :: pipe : widget_pipeline_t* :: Pipeline
+ * Returns the widget, still owned by the pipeline, or NULL once the sequence is exhausted
+ * The widget must be handed back with widget_pipeline_release once it has been read
+ */
+widget_t* widget_pipeline_next(widget_pipeline_t* pipe);
+
+/*
+ * widget_pipeline_release
+ * Hands a widget back to the pipeline for reuse
+ * :: pipe : widget_pipeline_t* :: Pipeline
+ * :: wid : widget_t* :: Widget from widget_pipeline_next
+ */
+void widget_pipeline_release(widget_pipeline_t* pipe, widget_t* wid);
+
+/*
+ * widget_pipeline_destroy
+ * Stops both stages, joins their threads and frees every widget
+ * :: pipe : widget_pipeline_t* :: Pipeline, may be destroyed before it is exhausted
+ */
+void widget_pipeline_destroy(widget_pipeline_t* pipe);
+
+#endif
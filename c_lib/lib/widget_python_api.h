@@ -55,5 +55,21 @@ void widget_get_pauli_tracker_api(
  */
 void widget_print_tableau_api(const widget_t* wid);
 
+/*
+ * widget_get_engine_stats_api
+ * Writes the engine statistics of the widget
+ * :: wid : const widget_t* :: The widget
+ * :: stats : struct widget_engine_stats_t* :: Object to write to
+ */
+void widget_get_engine_stats_api(const widget_t* wid, struct widget_engine_stats_t* stats);
+
+/*
+ * widget_get_stats_api
+ * Writes the phase timings and counters of the widget
+ * :: wid : const widget_t* :: The widget
+ * :: stats : struct widget_stats_t* :: Object to write to
+ */
+void widget_get_stats_api(const widget_t* wid, struct widget_stats_t* stats);
+
 
 #endif
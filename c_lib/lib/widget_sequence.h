@@ -0,0 +1,96 @@
+#ifndef WIDGET_SEQUENCE_H
+#define WIDGET_SEQUENCE_H
+
+#include <stdbool.h>
+
+#include "widget.h"
+#include "input_stream.h"
+#include "input_stream_par.h"
+
+/*
+ * widget_sequence_t
+ * Splits one instruction stream into a sequence of widgets
+ * Each widget closes once its rz budget is spent, the next starts at the rz that would have exceeded it
+ */
+struct widget_sequence_t
+{
+    instruction_stream_u* instructions; // Borrowed, must outlive the sequence
+    size_t n_instructions;
+    size_t position; // First instruction of the next widget
+    size_t qubit_width; // Initial qubits of every widget
+    size_t max_qubits; // Capacity of every widget
+    size_t rz_budget; // Rz gates per widget
+    bool teleport_input;
+    size_t n_widgets; // Widgets emitted so far
+};
+typedef struct widget_sequence_t widget_sequence_t;
+
+/*
+ * widget_sequence_create
+ * Constructor for a widget sequence
+ * :: instructions : instruction_stream_u* :: Instruction stream, not copied
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: qubit_width : const size_t :: Initial qubits of each widget
+ * :: max_qubits : const size_t :: Qubits per widget, the rz budget is what remains after the inputs are teleported
+ * :: teleport_input : const bool :: Whether each widget teleports its inputs
+ */
+widget_sequence_t* widget_sequence_create(
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const bool teleport_input);
+
+/*
+ * widget_sequence_destroy
+ * Destructor for a widget sequence
+ * :: seq : widget_sequence_t* :: Sequence to free, the instruction stream is left alone
+ */
+void widget_sequence_destroy(widget_sequence_t* seq);
+
+/*
+ * widget_sequence_split
+ * Finds the end of the next widget
+ * :: instructions : const instruction_stream_u* :: Instruction stream
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: start : const size_t :: First instruction of the widget
+ * :: rz_budget : const size_t :: Rz gates allowed in the widget
+ * Returns one past the last instruction of the widget
+ */
+size_t widget_sequence_split(
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const size_t start,
+    const size_t rz_budget);
+
+/*
+ * widget_sequence_done
+ * Whether every widget of the sequence has been filled
+ * :: seq : const widget_sequence_t* :: Sequence
+ */
+bool widget_sequence_done(const widget_sequence_t* seq);
+
+/*
+ * widget_sequence_fill
+ * Parses the next chunk of the sequence into a widget without decomposing it
+ * :: seq : widget_sequence_t* :: Sequence, must not be done
+ * :: wid : widget_t* :: Widget to reset and reuse, NULL to allocate a new one
+ * :: parse : parser :: parse_instruction_block or parse_instruction_block_par
+ * Returns the filled widget
+ */
+widget_t* widget_sequence_fill(
+    widget_sequence_t* seq,
+    widget_t* wid,
+    void (*parse)(widget_t*, instruction_stream_u*, const size_t));
+
+/*
+ * widget_sequence_next
+ * Builds and decomposes the next widget of the sequence
+ * :: seq : widget_sequence_t* :: Sequence
+ * :: wid : widget_t* :: Widget from an earlier call to reset and reuse, NULL to allocate a new one
+ * Returns the decomposed widget, owned by the caller, or NULL once the stream is consumed
+ * A reused widget is left alone once the stream is consumed, the caller still owns it
+ */
+widget_t* widget_sequence_next(widget_sequence_t* seq, widget_t* wid);
+
+#endif
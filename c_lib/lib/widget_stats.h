@@ -0,0 +1,84 @@
+#ifndef WIDGET_STATS_H
+#define WIDGET_STATS_H
+
+#include <stdint.h>
+#include <time.h>
+
+/*
+ * Per widget timings and counters
+ * Built with -DWIDGET_STATS, see the stats target in the Makefile
+ * Without it every macro below expands to its bare statement or to nothing,
+ * the struct stays on widget_t so the layout seen from Python does not change
+ */
+
+#define WIDGET_STATS_N_GATE_TYPES (8) // Matches N_INSTRUCTION_TYPES, indexed by INSTRUCTION_TYPE
+
+/*
+ * widget_stats_t
+ * Nanoseconds spent in each phase and counts of the work done, reset with the widget
+ */
+struct widget_stats_t
+{
+    uint8_t enabled; // Whether the library was built with WIDGET_STATS
+    // Phases in nanoseconds
+    uint64_t ingestion_ns; // Parsing instruction blocks, including Pauli tracking
+    uint64_t queue_flush_ns; // Applying the local clifford queue to the tableau
+    uint64_t remove_zero_x_columns_ns;
+    uint64_t transpose_ns;
+    uint64_t elim_ns; // simd_tableau_elim
+    uint64_t zero_diagonal_ns; // zero_z_diagonal and zero_phases
+    uint64_t pauli_tracker_ns; // Calls into the Pauli tracker during ingestion
+    uint64_t partial_order_ns; // Building the partial order graph of the measurements
+    // Counters
+    uint64_t n_gates[WIDGET_STATS_N_GATE_TYPES]; // Instructions parsed by type
+    uint64_t n_rowsums; // Row operations during elimination
+    uint64_t n_local_elim;
+    uint64_t n_local_search;
+    uint64_t n_non_local_search;
+    uint64_t n_hadamard;
+    uint64_t n_z_search;
+};
+typedef struct widget_stats_t widget_stats_t;
+
+#ifdef WIDGET_STATS
+
+    #define WIDGET_STATS_ENABLED (1)
+
+    /*
+     * widget_stats_now
+     * Monotonic clock in nanoseconds
+     */
+    static inline
+    uint64_t widget_stats_now()
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+    }
+
+    #define WIDGET_STATS_ONLY(...) __VA_ARGS__
+
+    // Adds the wall time of a statement to a phase
+    #define WIDGET_STATS_TIME(wid, field, ...) do { \
+        const uint64_t __stats_start = widget_stats_now(); \
+        __VA_ARGS__; \
+        (wid)->stats.field += widget_stats_now() - __stats_start; \
+    } while (0)
+
+    // For phases with more than one exit
+    #define WIDGET_STATS_START(name) const uint64_t name = widget_stats_now()
+    #define WIDGET_STATS_STOP(wid, field, name) ((wid)->stats.field += widget_stats_now() - (name))
+
+#else
+
+    #define WIDGET_STATS_ENABLED (0)
+    #define WIDGET_STATS_ONLY(...)
+    #define WIDGET_STATS_TIME(wid, field, ...) do { __VA_ARGS__; } while (0)
+    #define WIDGET_STATS_START(name)
+    #define WIDGET_STATS_STOP(wid, field, name)
+
+#endif
+
+#define WIDGET_STATS_COUNT(wid, field, n) WIDGET_STATS_ONLY((wid)->stats.field += (n))
+
+#endif
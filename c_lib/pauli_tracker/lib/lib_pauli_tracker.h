@@ -23,6 +23,25 @@ MappedPauliTracker* lib_pauli_tracker_create(uintptr_t n_qubits);
  */
 void lib_pauli_tracker_destroy(MappedPauliTracker *pauli_tracker);
 
+/*
+ * lib_pauli_tracker_clear
+ * Empties the tracker for reuse
+ * :: lib_pauli_tracker : &mut MappedPauliTracker :: Pauli tracker object
+ * :: n_qubits : usize :: Number of initialised qubits in the cleared tracker
+ * The mapper keeps its capacity, the frames are rebuilt
+ */
+void lib_pauli_tracker_clear(MappedPauliTracker *pauli_tracker, uintptr_t n_qubits);
+
+/*
+ * lib_pauli_tracker_new_qubits
+ * Adds qubits to the tracker
+ * :: lib_pauli_tracker : &mut MappedPauliTracker :: Pauli tracker object
+ * :: start : usize :: First qubit to add
+ * :: stop : usize :: One past the last qubit to add
+ * Qubits that are already tracked are left as they are
+ */
+void lib_pauli_tracker_new_qubits(MappedPauliTracker *pauli_tracker, uintptr_t start, uintptr_t stop);
+
 /*
  * lib_pauli_tracker_graph_destroy
  * Destructor for the graph object
@@ -2,7 +2,127 @@
 #define PAULI_TRACKER_GRAPH_H
 
 #include <stddef.h>
+#include <stdint.h>
 
+#include "lib_pauli_tracker.h"
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * PauliConstVec
+ * Borrowed view of a rust Vec, mirrors ConstVec
+ * Only the view is freed by its destructor, the data belongs to the rust object it came from
+ */
+typedef struct PauliConstVec
+{
+    const void* ptr;
+    uintptr_t len;
+    uintptr_t cap;
+} PauliConstVec;
+
+/*
+ * lib_pauli_n_layers
+ * Number of layers in a partial order graph
+ * :: graph : *mut PartialOrderGraph :: Graph from lib_pauli_tracker_partial_order_graph
+ */
+uintptr_t lib_pauli_n_layers(void* graph);
+
+/*
+ * lib_pauli_graph_to_layer
+ * Borrows one layer of a partial order graph
+ * :: graph : &mut PartialOrderGraph :: Graph
+ * :: index : usize :: Layer index
+ */
+void* lib_pauli_graph_to_layer(void* graph, uintptr_t index);
+
+/*
+ * lib_pauli_n_dependents
+ * Number of nodes in a layer
+ * :: layer : *mut Layer :: Layer
+ */
+uintptr_t lib_pauli_n_dependents(void* layer);
+
+/*
+ * lib_pauli_dependent_qubit_idx
+ * Qubit measured by a node
+ * :: layer : *mut Layer :: Layer
+ * :: index : usize :: Node index
+ */
+uintptr_t lib_pauli_dependent_qubit_idx(void* layer, uintptr_t index);
+
+/*
+ * lib_pauli_layer_to_dependent_node
+ * Dependencies of a node as usize entries
+ * :: layer : *mut Layer :: Layer
+ * :: idx : usize :: Node index
+ * Free the view with lib_pauli_tracker_const_vec_destroy
+ */
+PauliConstVec* lib_pauli_layer_to_dependent_node(void* layer, uintptr_t idx);
+
+/*
+ * lib_pauli_tracker_const_vec_destroy
+ * Frees a view returned by lib_pauli_layer_to_dependent_node
+ */
+void lib_pauli_tracker_const_vec_destroy(PauliConstVec* obj);
+
+/*
+ * lib_pauli_tracker_create_pauli_corrections
+ * Transposes the tracker into one Pauli string per correction
+ * :: tracker : *const MappedPauliTracker :: Tracker
+ * Free with lib_pauli_tracker_corrections_destroy
+ */
+void* lib_pauli_tracker_create_pauli_corrections(const MappedPauliTracker* tracker);
+
+/*
+ * lib_pauli_tracker_get_correction_table_len
+ * Number of corrections
+ */
+uintptr_t lib_pauli_tracker_get_correction_table_len(void* corrections);
+
+/*
+ * lib_pauli_tracker_get_pauli_corrections
+ * One correction as dense Pauli bytes, 0 to 3 for I, Z, X and Y
+ * Free the view with lib_pauli_tracker_destroy_corrections
+ */
+PauliConstVec* lib_pauli_tracker_get_pauli_corrections(void* corrections, uintptr_t index);
+
+/*
+ * lib_pauli_tracker_destroy_corrections
+ * Frees a view returned by lib_pauli_tracker_get_pauli_corrections
+ */
+void lib_pauli_tracker_destroy_corrections(PauliConstVec* vec);
+
+/*
+ * lib_pauli_tracker_corrections_destroy
+ * Frees the corrections returned by lib_pauli_tracker_create_pauli_corrections
+ */
+void lib_pauli_tracker_corrections_destroy(void* corrections);
+
+/*
+ * lib_pauli_tracker_get_inv_mapper
+ * Measured qubit of each correction, usize::MAX past the end of the mapper
+ * :: tracker : *mut MappedPauliTracker :: Tracker
+ * :: n_qubits : usize :: Length of the map
+ * Free with lib_pauli_tracker_destroy_inv_map
+ */
+void* lib_pauli_tracker_get_inv_mapper(MappedPauliTracker* tracker, uintptr_t n_qubits);
+
+/*
+ * lib_pauli_mapper_to_const_vec
+ * View of an inverse map as usize entries
+ */
+PauliConstVec* lib_pauli_mapper_to_const_vec(void* mapper);
+
+/*
+ * lib_pauli_tracker_destroy_inv_map
+ * Frees an inverse map and its view
+ */
+void lib_pauli_tracker_destroy_inv_map(void* mapper, PauliConstVec* view);
+
+#ifdef __cplusplus
+}
+#endif
 
 #endif
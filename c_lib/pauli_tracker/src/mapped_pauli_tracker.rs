@@ -105,6 +105,38 @@ extern "C" fn lib_pauli_tracker_destroy(pauli_tracker: *mut MappedPauliTracker)
     }
 }
 
+/*
+ * pauli_tracker_clear
+ * Empties the tracker for reuse
+ * :: pauli_tracker : &mut MappedPauliTracker :: Pauli tracker object
+ * :: n_qubits : usize :: Number of initialised qubits in the cleared tracker
+ * The mapper keeps its capacity, the frames are rebuilt
+ */
+#[no_mangle]
+extern "C" fn lib_pauli_tracker_clear(mapped_pauli_tracker: &mut MappedPauliTracker, n_qubits: usize) {
+    mapped_pauli_tracker.mapper.clear();
+    mapped_pauli_tracker.pauli_tracker = PauliTracker::init(n_qubits);
+}
+
+/*
+ * pauli_tracker_new_qubits
+ * Adds qubits to the tracker
+ * :: pauli_tracker : &mut MappedPauliTracker :: Pauli tracker object
+ * :: start : usize :: First qubit to add
+ * :: stop : usize :: One past the last qubit to add
+ * Qubits that are already tracked are left as they are
+ */
+#[no_mangle]
+extern "C" fn lib_pauli_tracker_new_qubits(
+    mapped_pauli_tracker: &mut MappedPauliTracker,
+    start: usize,
+    stop: usize,
+) {
+    for qubit in start..stop {
+        let _ = mapped_pauli_tracker.pauli_tracker.new_qubit(qubit);
+    }
+}
+
 /*
  * pauli_track_x
  * Add a row to the pauli tracker object with an 'X' at the target qubit
@@ -69,3 +69,17 @@ extern "C" fn lib_pauli_tracker_destroy_corrections(
 {
     const_vec_destroy::<PauliDense>(vec);
 }
+
+/*
+ * lib_pauli_tracker_corrections_destroy
+ * Destructor for the corrections from lib_pauli_tracker_create_pauli_corrections
+ */
+#[no_mangle]
+extern "C" fn lib_pauli_tracker_corrections_destroy(
+    corrections: *mut PauliVec
+)
+{
+    unsafe {
+        let _ = Box::from_raw(corrections);
+    }
+}
@@ -48,26 +48,29 @@ void zero_phases(widget_t* wid);
  */
 void simd_widget_decompose(widget_t* wid)
 {
+    // Qubits that were never allocated are still acted on by the decomposition
+    tableau_set_active_qubits(wid->tableau, wid->tableau->n_qubits);
+
     // Remove zero X columns
     // It's faster to do this prior to transposing as Hadamards are
     // Cache line aligned at this point 
-    tableau_remove_zero_X_columns(
-        wid->tableau,
-        wid->queue
-    );
+    WIDGET_STATS_TIME(wid, remove_zero_x_columns_ns,
+        tableau_remove_zero_X_columns(
+            wid->tableau,
+            wid->queue
+        ));
 
     // Transpose the tableau for aligned rowsum operations 
 
-    tableau_transpose(wid->tableau);
+    WIDGET_STATS_TIME(wid, transpose_ns, tableau_transpose(wid->tableau));
 
     // Perform the elimination
-    simd_tableau_elim(wid);
+    WIDGET_STATS_TIME(wid, elim_ns, simd_tableau_elim(wid));
 
-    // Zero the Z diagonal
-    zero_z_diagonal(wid);
-
-    // Zero phases
-    zero_phases(wid);
+    // Zero the Z diagonal and the phases
+    WIDGET_STATS_TIME(wid, zero_diagonal_ns,
+        zero_z_diagonal(wid);
+        zero_phases(wid));
 
     return;
 }
@@ -117,6 +120,8 @@ void tableau_elim_lower(widget_t* wid)
  */
 void naive_widget_decompose(widget_t* wid)
 {
+    tableau_set_active_qubits(wid->tableau, wid->tableau->n_qubits);
+
     tableau_remove_zero_X_columns(
         wid->tableau,
         wid->queue
@@ -232,11 +237,11 @@ void decomp_local_elim_upper(
                 i, ctrl);
 
             ctrl_block[i] ^= ctrl_block[ctrl];
-            tableau_rowsum_offset(
+            tableau_rowsum(
                     wid->tableau,
                     ctrl + offset,
-                    i + offset,
-                    offset);
+                    i + offset);
+            WIDGET_STATS_COUNT(wid, n_rowsums, 1);
         }
     }
 
@@ -249,11 +254,11 @@ void decomp_local_elim_upper(
         {
             ctrl_block[i] ^= ctrl_block[ctrl];
 
-            tableau_rowsum_offset(
+            tableau_rowsum(
                     wid->tableau,
                     ctrl + offset,
-                    i + offset,
-                    offset); 
+                    i + offset); 
+            WIDGET_STATS_COUNT(wid, n_rowsums, 1);
         }
     }
 }
@@ -313,11 +318,11 @@ void decomp_local_elim_lower(
                 i, ctrl);
 
             ctrl_block[i] ^= ctrl_block[ctrl];
-            tableau_rowsum_offset(
+            tableau_rowsum(
                     wid->tableau,
                     ctrl + offset,
-                    i + offset,
-                    offset);
+                    i + offset);
+            WIDGET_STATS_COUNT(wid, n_rowsums, 1);
 
             ctrl = 63 - __builtin_clzll(mask & ctrl_block[i]);
 
@@ -380,35 +385,79 @@ size_t decomp_local_search(
 }
 
 /*
- * Performs a search and progressive elimination as one step 
- * This search is non-local, it begins on the tile subsequent to the diagonal 
- * TODO: comment header
+ * Arguments for tasks that sweep a range of target row blocks against the pivot block
+ * Every target block owns a whole word of the phases, so tasks over disjoint blocks never race
+ */
+struct decomp_block_task_t
+{
+    widget_t* wid;
+    void* slices;
+    size_t slice_len_bytes;
+    size_t offset; // First row of the pivot block
+    size_t index; // Pivot column for the non-local search
+    size_t start; // First target row
+    size_t stop; // End of the target rows
+    size_t* found; // Lowest candidate row for the non-local search
+    size_t n_rowsums; // Only counted when built with WIDGET_STATS, summed by the caller after the barrier
+    struct decomp_m4ri_table_t* table; // Pivot combinations, NULL to clear bits with single rowsums
+};
+
+/*
+ * decomp_split_blocks
+ * Splits the target blocks in [start, stop) into tasks
+ * :: task : struct decomp_block_task_t* :: Template task, copied into each entry
+ * :: tasks : struct decomp_block_task_t* :: Array of at least DECOMP_PAR_MAX_TASKS tasks
+ * Returns the number of tasks
  */
 static inline
-size_t decomp_non_local_search_and_elim(
-    widget_t* wid,
-    void* slices,
-    const size_t slice_len_bytes,
-    const size_t offset,
-    const size_t index)
+size_t decomp_split_blocks(
+    struct decomp_block_task_t* task,
+    struct decomp_block_task_t* tasks,
+    const size_t start,
+    const size_t stop)
 {
-    const uint64_t mask = (1ull << index);
-    const size_t column = offset / 64;
-    const size_t block_end = (wid->tableau->n_qubits / 64) * 64;
-    const size_t block_tail = 64 - (wid->tableau->n_qubits % 64);
+    const size_t n_blocks = (stop - start + 63) / 64;
+    size_t n_tasks = threadpool_n_workers() * DECOMP_PAR_TASKS_PER_WORKER;
+    n_tasks = (n_tasks < n_blocks) ? n_tasks : n_blocks;
+    n_tasks = (n_tasks < DECOMP_PAR_MAX_TASKS) ? n_tasks : DECOMP_PAR_MAX_TASKS;
 
-    // Triggers if block is very small
-    if (__builtin_expect(block_end == 0, 0))
+    for (size_t i = 0; i < n_tasks; i++)
     {
-        return SENTINEL;
+        tasks[i] = *task;
+        tasks[i].start = start + ((n_blocks * i) / n_tasks) * 64;
+        tasks[i].stop = start + ((n_blocks * (i + 1)) / n_tasks) * 64;
     }
+    tasks[n_tasks - 1].stop = stop;
+    return n_tasks;
+}
 
-    uint64_t targ_block[64];
+/*
+ * __inline_decomp_non_local_search_range
+ * Clears bits below the pivot index over a range of target blocks,
+ * stopping at the first row with the pivot bit set
+ * :: task : struct decomp_block_task_t* :: Range to search
+ * Lowers task->found to the candidate row
+ * Exits early once a lower candidate is known, so the result matches a serial scan
+ */
+static inline
+void __inline_decomp_non_local_search_range(struct decomp_block_task_t* task)
+{
+    widget_t* wid = task->wid;
+    void* slices = task->slices;
+    const size_t slice_len_bytes = task->slice_len_bytes;
+    const size_t offset = task->offset;
+    const size_t index = task->index;
+    const uint64_t mask = (1ull << index);
 
-    uint64_t ctrl_block[64];
+    uint64_t targ_block[64];
 
-    for (size_t i = offset + 64; i < block_end; i += 64) 
+    for (size_t i = task->start; i < task->stop; i += 64) 
     {
+        if (__atomic_load_n(task->found, __ATOMIC_RELAXED) < i)
+        {
+            return;
+        }
+
         uint64_t ctrl;
         
         decomp_load_block(targ_block, slices, slice_len_bytes, offset, i);
@@ -421,11 +470,11 @@ size_t decomp_non_local_search_and_elim(
             {
 
                 // Rowsum to unset bit
-                tableau_rowsum_offset(
+                tableau_rowsum(
                     wid->tableau,
                     ctrl + offset,
-                    i + j,
-                    offset); 
+                    i + j); 
+                WIDGET_STATS_ONLY(task->n_rowsums++);
                 
                 // Reload block
                 targ_block[j] = GET_CHUNK(slices, slice_len_bytes, offset, i + j); 
@@ -433,11 +482,75 @@ size_t decomp_non_local_search_and_elim(
 
             if (__builtin_expect(targ_block[j] & mask, 0))
             {
-                return i + j; 
+                size_t found = __atomic_load_n(task->found, __ATOMIC_RELAXED);
+                while (i + j < found && !__atomic_compare_exchange_n(
+                    task->found, &found, i + j, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)){};
+                return; 
             }
         }
     }
-    return SENTINEL;
+}
+
+static
+void decomp_non_local_search_task(void* args)
+{
+    __inline_decomp_non_local_search_range((struct decomp_block_task_t*)args);
+}
+
+/*
+ * Performs a search and progressive elimination as one step 
+ * This search is non-local, it begins on the tile subsequent to the diagonal 
+ * Target blocks are distributed over the threadpool when it is running
+ * Returns the first row with the pivot bit set, or SENTINEL
+ */
+static inline
+size_t decomp_non_local_search_and_elim(
+    widget_t* wid,
+    void* slices,
+    const size_t slice_len_bytes,
+    const size_t offset,
+    const size_t index)
+{
+    const size_t block_end = (wid->tableau->n_qubits / 64) * 64;
+
+    // Triggers if block is very small
+    if (__builtin_expect(block_end <= offset + 64, 0))
+    {
+        return SENTINEL;
+    }
+
+    size_t found = SENTINEL;
+    struct decomp_block_task_t task = {
+        .wid = wid,
+        .slices = slices,
+        .slice_len_bytes = slice_len_bytes,
+        .offset = offset,
+        .index = index,
+        .start = offset + 64,
+        .stop = block_end,
+        .found = &found,
+        .table = NULL};
+
+    if (1 == threadpool_n_workers() || block_end - offset < DECOMP_PAR_MIN_ROWS)
+    {
+        __inline_decomp_non_local_search_range(&task);
+        WIDGET_STATS_COUNT(wid, n_rowsums, task.n_rowsums);
+        return found;
+    }
+
+    struct decomp_block_task_t tasks[DECOMP_PAR_MAX_TASKS];
+    const size_t n_tasks = decomp_split_blocks(&task, tasks, offset + 64, block_end);
+    threadpool_batch_t batch = THREADPOOL_BATCH_INIT;
+    for (size_t i = 0; i < n_tasks; i++)
+    {
+        threadpool_batch_add_task(&batch, decomp_non_local_search_task, tasks + i);
+    }
+    threadpool_batch_wait(&batch);
+    for (size_t i = 0; i < n_tasks; i++)
+    {
+        WIDGET_STATS_COUNT(wid, n_rowsums, tasks[i].n_rowsums);
+    }
+    return found;
 }
  
 /*
@@ -483,21 +596,289 @@ size_t decomp_z_search(
 }
 
 
+static uint8_t DECOMP_MODE = DECOMP_MODE_AUTO;
+
 /*
- * Zeros block if previous elements are set 
- * This search is non-local, it begins on the tile subsequent to the diagonal 
- * TODO: comment header
+ * simd_tableau_elim_set_mode
+ * Selects how simd_tableau_elim clears the columns of each pivot block
+ * :: mode : const uint8_t :: One of DECOMP_MODE_ROWSUM, DECOMP_MODE_M4RI or DECOMP_MODE_AUTO
+ */
+void simd_tableau_elim_set_mode(const uint8_t mode)
+{
+    assert(mode <= DECOMP_MODE_AUTO);
+    DECOMP_MODE = mode;
+}
+
+/*
+ * Gray code tables for the Method of Four Russians
+ * For each group of DECOMP_M4RI_GROUP_BITS pivot rows, entry b holds the product of the rows selected by b
+ * Entries are full rows of the transposed tableau, with their phase
+ */
+struct decomp_m4ri_table_t
+{
+    size_t slice_len;
+    void* slices_x;
+    void* slices_z;
+    uint8_t* phases;
+};
+
+#define M4RI_ENTRY(table, slices, group, entry) ((slices) + (((group) * DECOMP_M4RI_TABLE_SIZE) + (entry)) * (table)->slice_len)
+#define M4RI_PHASE(table, group, entry) ((table)->phases[((group) * DECOMP_M4RI_TABLE_SIZE) + (entry)])
+
+/*
+ * decomp_m4ri_table_create
+ * Constructor for the M4RI tables
+ * :: slice_len : const size_t :: Length of each row in bytes
+ */
+static
+struct decomp_m4ri_table_t* decomp_m4ri_table_create(const size_t slice_len)
+{
+    const size_t n_entries = DECOMP_M4RI_GROUPS * DECOMP_M4RI_TABLE_SIZE;
+    struct decomp_m4ri_table_t* table = malloc(sizeof(struct decomp_m4ri_table_t));
+    table->slice_len = slice_len;
+
+    int err_code = posix_memalign(&table->slices_x, CACHE_SIZE, n_entries * slice_len);
+    assert(0 == err_code);
+    err_code = posix_memalign(&table->slices_z, CACHE_SIZE, n_entries * slice_len);
+    assert(0 == err_code);
+    table->phases = malloc(n_entries);
+
+    // Entry zero of each group is the identity and is never rewritten
+    for (size_t group = 0; group < DECOMP_M4RI_GROUPS; group++)
+    {
+        memset(M4RI_ENTRY(table, table->slices_x, group, 0), 0, slice_len);
+        memset(M4RI_ENTRY(table, table->slices_z, group, 0), 0, slice_len);
+        M4RI_PHASE(table, group, 0) = 0;
+    }
+    return table;
+}
+
+static
+void decomp_m4ri_table_destroy(struct decomp_m4ri_table_t* table)
+{
+    free(table->slices_x);
+    free(table->slices_z);
+    free(table->phases);
+    free(table);
+}
+
+/*
+ * __inline_decomp_m4ri_phase
+ * Combines the phase terms of a rowsum
+ * Matches the phase update in tableau_rowsum
+ */
+static inline
+uint8_t __inline_decomp_m4ri_phase(int8_t phase, const uint8_t ctrl_phase, const uint8_t targ_phase)
+{
+    phase = (((ctrl_phase << 1) + (targ_phase << 1) + phase) % 4) >> 1;
+    return phase & 1;
+}
+
+/*
+ * __inline_decomp_m4ri_build_group
+ * Fills the table for one group of pivot rows
+ * :: table : struct decomp_m4ri_table_t* :: The tables
+ * :: tab : tableau_t* :: Transposed tableau
+ * :: offset : const size_t :: First row of the pivot block
+ * :: group : const size_t :: Group within the pivot block
+ * Entries are visited in Gray code order so that each costs a single rowsum
+ */
+static inline
+void __inline_decomp_m4ri_build_group(
+    struct decomp_m4ri_table_t* table,
+    tableau_t* tab,
+    const size_t offset,
+    const size_t group)
+{
+    const size_t slice_len = table->slice_len;
+    size_t prev = 0;
+    for (size_t i = 1; i < DECOMP_M4RI_TABLE_SIZE; i++)
+    {
+        const size_t entry = i ^ (i >> 1);
+        const size_t row = offset + group * DECOMP_M4RI_GROUP_BITS + __builtin_ctzll(entry ^ prev);
+
+        void* entry_x = M4RI_ENTRY(table, table->slices_x, group, entry);
+        void* entry_z = M4RI_ENTRY(table, table->slices_z, group, entry);
+        memcpy(entry_x, M4RI_ENTRY(table, table->slices_x, group, prev), slice_len);
+        memcpy(entry_z, M4RI_ENTRY(table, table->slices_z, group, prev), slice_len);
+        M4RI_PHASE(table, group, entry) = M4RI_PHASE(table, group, prev);
+
+        // Past the end of the tableau there is no pivot row, and no target has the bit set
+        if (row >= tab->n_qubits)
+        {
+            prev = entry;
+            continue;
+        }
+
+        int8_t phase = simd_rowsum_cnf(
+            slice_len,
+            tab->slices_x[row],
+            tab->slices_z[row],
+            entry_x,
+            entry_z);
+
+        M4RI_PHASE(table, group, entry) = __inline_decomp_m4ri_phase(
+            phase,
+            __inline_slice_get_bit(tab->phases, row),
+            M4RI_PHASE(table, group, prev));
+        prev = entry;
+    }
+}
+
+struct decomp_m4ri_build_task_t
+{
+    struct decomp_m4ri_table_t* table;
+    tableau_t* tab;
+    size_t offset;
+    size_t group;
+};
+
+static
+void decomp_m4ri_build_task(void* args)
+{
+    struct decomp_m4ri_build_task_t* task = (struct decomp_m4ri_build_task_t*)args;
+    __inline_decomp_m4ri_build_group(task->table, task->tab, task->offset, task->group);
+}
+
+/*
+ * decomp_m4ri_build
+ * Builds the tables for every group of a pivot block
+ * :: table : struct decomp_m4ri_table_t* :: The tables
+ * :: tab : tableau_t* :: Transposed tableau
+ * :: offset : const size_t :: First row of the pivot block
+ * Groups are independent and are built over the threadpool when it is running
  */
 static inline
-void decomp_col_elim_upper(
+void decomp_m4ri_build(
+    struct decomp_m4ri_table_t* table,
+    tableau_t* tab,
+    const size_t offset)
+{
+    struct decomp_m4ri_build_task_t tasks[DECOMP_M4RI_GROUPS];
+    threadpool_batch_t batch = THREADPOOL_BATCH_INIT;
+    for (size_t group = 0; group < DECOMP_M4RI_GROUPS; group++)
+    {
+        tasks[group].table = table;
+        tasks[group].tab = tab;
+        tasks[group].offset = offset;
+        tasks[group].group = group;
+        threadpool_batch_add_task(&batch, decomp_m4ri_build_task, tasks + group);
+    }
+    threadpool_batch_wait(&batch);
+}
+
+/*
+ * __inline_decomp_m4ri_clear_row
+ * Clears the pivot columns of a row using the tables
+ * :: table : struct decomp_m4ri_table_t* :: The tables
+ * :: tab : tableau_t* :: Transposed tableau
+ * :: bits : const uint64_t :: Pivot columns of the row
+ * :: targ : const size_t :: Row to clear
+ * The pivot block is diagonal, so each group only clears its own bits
+ * Returns the number of table entries applied
+ */
+static inline
+size_t __inline_decomp_m4ri_clear_row(
+    struct decomp_m4ri_table_t* table,
+    tableau_t* tab,
+    const uint64_t bits,
+    const size_t targ)
+{
+    size_t n_rowsums = 0;
+    for (size_t group = 0; group < DECOMP_M4RI_GROUPS; group++)
+    {
+        const size_t entry = (bits >> (group * DECOMP_M4RI_GROUP_BITS)) & (DECOMP_M4RI_TABLE_SIZE - 1);
+        if (0 == entry)
+        {
+            continue;
+        }
+        n_rowsums++;
+
+        int8_t phase = simd_rowsum_cnf(
+            table->slice_len,
+            M4RI_ENTRY(table, table->slices_x, group, entry),
+            M4RI_ENTRY(table, table->slices_z, group, entry),
+            tab->slices_x[targ],
+            tab->slices_z[targ]);
+
+        __inline_slice_set_bit(
+            tab->phases,
+            targ,
+            __inline_decomp_m4ri_phase(
+                phase,
+                M4RI_PHASE(table, group, entry),
+                __inline_slice_get_bit(tab->phases, targ)));
+    }
+    return n_rowsums;
+}
+
+/*
+ * decomp_m4ri_select
+ * Picks between single rowsums and tables for clearing a pivot block
+ * :: table : struct decomp_m4ri_table_t** :: Tables, allocated on first use
+ * :: wid : widget_t* :: Widget object
+ * :: slices : void* :: X slices of the transposed tableau
+ * :: slice_len_bytes : const size_t :: Length of each slice
+ * :: offset : const size_t :: First row of the pivot block
+ * Building the tables costs a fixed number of rowsums, so sparse pivot columns are cleared directly
+ * Returns NULL when single rowsums should be used
+ */
+static inline
+struct decomp_m4ri_table_t* decomp_m4ri_select(
+    struct decomp_m4ri_table_t** table,
     widget_t* wid,
     void* slices,
     const size_t slice_len_bytes,
-    const size_t offset
-    )
+    const size_t offset)
+{
+    if (DECOMP_MODE_ROWSUM == DECOMP_MODE)
+    {
+        return NULL;
+    }
+
+    if (DECOMP_MODE_AUTO == DECOMP_MODE)
+    {
+        size_t n_bits = 0;
+        for (size_t i = 0; i < wid->tableau->n_qubits; i++)
+        {
+            n_bits += __builtin_popcountll(GET_CHUNK(slices, slice_len_bytes, offset, i));
+        }
+
+        // The pivot block contributes its own diagonal
+        if (n_bits < DECOMP_M4RI_MIN_BITS + 64)
+        {
+            return NULL;
+        }
+    }
+
+    if (NULL == *table)
+    {
+        *table = decomp_m4ri_table_create(slice_len_bytes);
+    }
+    return *table;
+}
+
+/*
+ * __inline_decomp_col_elim_range
+ * Zeros the pivot columns over a range of target blocks
+ * :: task : struct decomp_block_task_t* :: Range of target rows
+ * The pivot block itself is skipped
+ */
+static inline
+void __inline_decomp_col_elim_range(struct decomp_block_task_t* task)
 {
-    for (size_t i = offset + 64; i < wid->tableau->n_qubits; i += 64) 
+    widget_t* wid = task->wid;
+    void* slices = task->slices;
+    const size_t slice_len_bytes = task->slice_len_bytes;
+    const size_t offset = task->offset;
+
+    for (size_t i = task->start; i < task->stop; i += 64) 
     {
+        if (i == offset)
+        {
+            continue;
+        }
+
         uint64_t targ_block[64];
         uint64_t ctrl;
     
@@ -506,18 +887,25 @@ void decomp_col_elim_upper(
         #pragma GCC unroll 8 
         for (size_t j = 0; j < 64; j++)
         {
-            // While not all bits unset
+            if (NULL != task->table && targ_block[j])
+            {
+                const size_t n_rowsums = __inline_decomp_m4ri_clear_row(task->table, wid->tableau, targ_block[j], i + j);
+                WIDGET_STATS_ONLY(task->n_rowsums += n_rowsums);
+                targ_block[j] = GET_CHUNK(slices, slice_len_bytes, offset, i + j); 
+            }
 
+            // While not all bits unset
+            // TODO: merge this line with the ctzll call, odd infinite loop earlier
             while (targ_block[j])
             {
                 ctrl = __builtin_ctzll(targ_block[j]);
 
                 // Rowsum to unset bit
-                tableau_rowsum_offset(
+                tableau_rowsum(
                     wid->tableau,
                     ctrl + offset,
-                    i + j,
-                    offset); 
+                    i + j); 
+                WIDGET_STATS_ONLY(task->n_rowsums++);
                 
                 targ_block[j] = GET_CHUNK(slices, slice_len_bytes, offset, i + j); 
             }
@@ -527,44 +915,66 @@ void decomp_col_elim_upper(
     return;
 }
 
+static
+void decomp_col_elim_task(void* args)
+{
+    __inline_decomp_col_elim_range((struct decomp_block_task_t*)args);
+}
 
+/*
+ * decomp_col_elim
+ * Zeros the pivot columns in every block above and below the pivot block
+ * :: wid : widget_t* :: Widget object
+ * :: slices : void* :: X slices of the transposed tableau
+ * :: slice_len_bytes : const size_t :: Length of each slice
+ * :: offset : const size_t :: First row of the pivot block
+ * :: table : struct decomp_m4ri_table_t* :: Pivot block combinations, NULL to clear bits with single rowsums
+ * Target blocks are distributed over the threadpool when it is running
+ * The pivot rows are only read, so the only synchronisation is the barrier at the end
+ */
 static inline
-void decomp_col_elim_lower(
+void decomp_col_elim(
     widget_t* wid,
     void* slices,
     const size_t slice_len_bytes,
-    const size_t offset
+    const size_t offset,
+    struct decomp_m4ri_table_t* table
     )
 {
-    for (size_t i = 0; i < offset; i += 64) 
+    if (NULL != table)
     {
-        uint64_t targ_block[64];
-        uint64_t ctrl;
-        
-        decomp_load_block(targ_block, slices, slice_len_bytes, offset, i);
+        decomp_m4ri_build(table, wid->tableau, offset);
+        WIDGET_STATS_COUNT(wid, n_rowsums, DECOMP_M4RI_GROUPS * (DECOMP_M4RI_TABLE_SIZE - 1));
+    }
 
-        #pragma GCC unroll 8 
-        for (size_t j = 0; j < 64; j++)
-        {
-            // While not all bits unset
-            // TODO: merge this line with the ctzll call, odd infinite loop earlier
-            while (targ_block[j])
-            {
-                ctrl = __builtin_ctzll(targ_block[j]);
+    struct decomp_block_task_t task = {
+        .wid = wid,
+        .slices = slices,
+        .slice_len_bytes = slice_len_bytes,
+        .offset = offset,
+        .start = 0,
+        .stop = wid->tableau->n_qubits,
+        .table = table};
 
-                // Rowsum to unset bit
-                tableau_rowsum_offset(
-                    wid->tableau,
-                    ctrl + offset,
-                    i + j,
-                    offset); 
-                
-                targ_block[j] = GET_CHUNK(slices, slice_len_bytes, offset, i + j); 
-            }
-        }
+    if (1 == threadpool_n_workers() || wid->tableau->n_qubits < DECOMP_PAR_MIN_ROWS)
+    {
+        __inline_decomp_col_elim_range(&task);
+        WIDGET_STATS_COUNT(wid, n_rowsums, task.n_rowsums);
+        return;
     }
 
-    return;
+    struct decomp_block_task_t tasks[DECOMP_PAR_MAX_TASKS];
+    const size_t n_tasks = decomp_split_blocks(&task, tasks, 0, wid->tableau->n_qubits);
+    threadpool_batch_t batch = THREADPOOL_BATCH_INIT;
+    for (size_t i = 0; i < n_tasks; i++)
+    {
+        threadpool_batch_add_task(&batch, decomp_col_elim_task, tasks + i);
+    }
+    threadpool_batch_wait(&batch);
+    for (size_t i = 0; i < n_tasks; i++)
+    {
+        WIDGET_STATS_COUNT(wid, n_rowsums, tasks[i].n_rowsums);
+    }
 }
 
 void simd_tableau_elim(widget_t* wid)
@@ -583,6 +993,9 @@ void simd_tableau_elim(widget_t* wid)
     // Stride through the tableau in chunks of 64 elements
     const size_t end_stride = tab->n_qubits - (tab->n_qubits % 64); 
 
+    // Only allocated once a pivot block needs it
+    struct decomp_m4ri_table_t* table = NULL;
+
     // TODO set offset to end at end stride
     for (size_t offset = 0;
          offset < tab->n_qubits;
@@ -619,6 +1032,7 @@ void simd_tableau_elim(widget_t* wid)
                 // TODO: Try to avoid a hard switch here  
                 if (__builtin_ctzll(ctrl_block[j]) == j)
                 {
+                    WIDGET_STATS_COUNT(wid, n_local_elim, 1);
                     continue;
                 }
 
@@ -636,6 +1050,7 @@ void simd_tableau_elim(widget_t* wid)
 
                 if (prog < 64)  // Found row, perform swap  
                 {
+                    WIDGET_STATS_COUNT(wid, n_local_search, 1);
                     continue;
                 }
 
@@ -662,6 +1077,7 @@ void simd_tableau_elim(widget_t* wid)
                             offset + j); 
 
                         DPRINT(DEBUG_3, "Strategy 2 Succeeded\n");
+                    WIDGET_STATS_COUNT(wid, n_non_local_search, 1);
 
                     continue;
                 }
@@ -685,6 +1101,7 @@ void simd_tableau_elim(widget_t* wid)
                         j,
                         ctrl_block); 
                     
+                    WIDGET_STATS_COUNT(wid, n_hadamard, 1);
                     continue;
                 }
 
@@ -702,6 +1119,7 @@ void simd_tableau_elim(widget_t* wid)
 
                     clifford_queue_local_clifford_right(wid->queue, _H_, offset + j);
 
+                    WIDGET_STATS_COUNT(wid, n_z_search, 1);
                     continue;
                 }
                 else
@@ -723,11 +1141,20 @@ void simd_tableau_elim(widget_t* wid)
             64,
             ctrl_block); 
 
-        decomp_col_elim_upper(wid, slices, slice_len_bytes, offset);
-        decomp_col_elim_lower(wid, slices, slice_len_bytes, offset);
+        decomp_col_elim(
+            wid,
+            slices,
+            slice_len_bytes,
+            offset,
+            decomp_m4ri_select(&table, wid, slices, slice_len_bytes, offset));
     }
 
 
+    if (NULL != table)
+    {
+        decomp_m4ri_table_destroy(table);
+    }
+
     // TODO: Debug info
     for (size_t i = 0; i < tab->n_qubits; i += 64)
     {
@@ -1011,7 +1438,7 @@ void simd_tableau_X_diag_col_upper(tableau_t* tab, const size_t idx)
             if (dst[chunk])
             {
                 DPRINT(DEBUG_3, "Slice XOR Upper: %lu %lu\n", idx, j + chunk);
-                tableau_rowsum_offset(tab, idx, j + chunk, j);
+                tableau_rowsum(tab, idx, j + chunk);
             }
         }
 
@@ -1022,7 +1449,7 @@ void simd_tableau_X_diag_col_upper(tableau_t* tab, const size_t idx)
     {
         if (1 == __inline_slice_get_bit(tab->slices_x[j], idx))
         {
-            tableau_rowsum_offset(tab, idx, j, j);
+            tableau_rowsum(tab, idx, j);
         }
     }
     return;
@@ -1038,7 +1465,7 @@ void simd_tableau_X_diag_col_lower(tableau_t* tab, const size_t idx)
         if (1 == __inline_slice_get_bit(tab->slices_x[j], idx))
         {
             DPRINT(DEBUG_3, "Slice XOR Lower: %lu %lu\n", idx, j);
-            tableau_rowsum_offset(tab, idx, j, j);
+            tableau_rowsum(tab, idx, j);
         }
     }
     return;
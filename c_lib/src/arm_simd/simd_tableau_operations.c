@@ -1,9 +1,8 @@
 #define INSTRUCTIONS_TABLE
-#define TABLEAU_OPERATIONS_SRC 
 
 #include "tableau_operations.h"
 
-void tableau_H(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_H(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * x -> z
@@ -14,7 +13,7 @@ void tableau_H(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);   
         uint8x16_t z = vld1q_u8(slice_z + i);   
@@ -27,7 +26,7 @@ void tableau_H(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_S(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_S(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * x -> x  
@@ -38,7 +37,7 @@ void tableau_S(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -53,7 +52,7 @@ void tableau_S(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_Z(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_Z(tableau_t* restrict tab, const size_t targ)
 {
 /*
  * Doubled S gate
@@ -67,7 +66,7 @@ void tableau_Z(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -81,7 +80,7 @@ void tableau_Z(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_R(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_R(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * Triple S gate
@@ -102,7 +101,7 @@ void tableau_R(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -119,12 +118,12 @@ void tableau_R(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_I(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_I(tableau_t* restrict tab, const size_t targ)
 {
     return;
 }
 
-void tableau_X(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_X(tableau_t* restrict tab, const size_t targ)
 {
 /*
  * HZH Gate
@@ -148,7 +147,7 @@ void tableau_X(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t z = vld1q_u8(slice_z + i);
         uint8x16_t r = vld1q_u8(slice_r + i);
@@ -157,7 +156,7 @@ void tableau_X(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_Y(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_Y(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * Y = XZ
@@ -175,7 +174,7 @@ void tableau_Y(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -189,7 +188,7 @@ void tableau_Y(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HX(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_HX(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * X : (r ^= z)
@@ -206,7 +205,7 @@ void tableau_HX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -222,7 +221,7 @@ void tableau_HX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_SX(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_SX(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * X : (r ^= z)
@@ -238,7 +237,7 @@ void tableau_SX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -256,7 +255,7 @@ void tableau_SX(tableau_t* restrict tab, const size_t targ)
 
 
 
-void tableau_RX(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_RX(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * X : (r ^= z)
@@ -273,7 +272,7 @@ void tableau_RX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -289,7 +288,7 @@ void tableau_RX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HZ(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_HZ(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * Z : (r ^= x)
@@ -307,7 +306,7 @@ void tableau_HZ(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -325,7 +324,7 @@ void tableau_HZ(tableau_t* restrict tab, const size_t targ)
 
 
 
-void tableau_HY(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_HY(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * Y : r ^= x ^ z
@@ -343,7 +342,7 @@ void tableau_HY(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -362,7 +361,7 @@ void tableau_HY(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_SH(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_SH(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * H : (r ^= x.z; x <-> z) 
@@ -382,7 +381,7 @@ void tableau_SH(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);   
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -396,7 +395,7 @@ void tableau_SH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_RH(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_RH(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -417,7 +416,7 @@ void tableau_RH(tableau_t* restrict tab, const size_t targ)
      *
      */
     // DONE
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);   
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -430,7 +429,7 @@ void tableau_RH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_HS(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_HS(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -453,7 +452,7 @@ void tableau_HS(tableau_t* restrict tab, const size_t targ)
      * x_2 = z_1 = z ^ x  
      *
      */
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);   
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -465,7 +464,7 @@ void tableau_HS(tableau_t* restrict tab, const size_t targ)
     }  
 }
 
-void tableau_HR(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_HR(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -488,7 +487,7 @@ void tableau_HR(tableau_t* restrict tab, const size_t targ)
      *
      */
     // DONE
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);   
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -498,7 +497,7 @@ void tableau_HR(tableau_t* restrict tab, const size_t targ)
     }  
 }
 
-void tableau_HSX(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_HSX(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * X : (r ^= z)
@@ -524,7 +523,7 @@ void tableau_HSX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -540,7 +539,7 @@ void tableau_HSX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HRX(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_HRX(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * X : (r ^= z)
@@ -565,7 +564,7 @@ void tableau_HRX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -577,13 +576,13 @@ void tableau_HRX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_SHY(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_SHY(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -595,13 +594,13 @@ void tableau_SHY(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_RHY(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_RHY(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -613,14 +612,14 @@ void tableau_RHY(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HSH(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_HSH(tableau_t* restrict tab, const size_t targ)
 {
 
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -636,13 +635,13 @@ void tableau_HSH(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HRH(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_HRH(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -659,13 +658,13 @@ void tableau_HRH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_RHS(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_RHS(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -682,13 +681,13 @@ void tableau_RHS(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_SHR(tableau_t* restrict tab, const size_t targ)
+void neon_tableau_SHR(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t x = vld1q_u8(slice_x + i);
         uint8x16_t z = vld1q_u8(slice_z + i);
@@ -704,7 +703,7 @@ void tableau_SHR(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+void neon_tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
 {
     /*
      * CNOT a, b: ( 
@@ -720,7 +719,7 @@ void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t ctrl_x = vld1q_u8(ctrl_slice_x + i);
         uint8x16_t ctrl_z = vld1q_u8(ctrl_slice_z + i);
@@ -741,7 +740,7 @@ void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     }
 }
 
-void tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+void neon_tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
 {
     /* CZ = H_b CNOT H_b 
      * H : (r ^= x.z; x <-> z) 
@@ -785,7 +784,7 @@ void tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         uint8x16_t ctrl_x = vld1q_u8(ctrl_slice_x + i);
         uint8x16_t ctrl_z = vld1q_u8(ctrl_slice_z + i);
@@ -808,3 +807,143 @@ void tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
         );
     }
 }
+
+
+/*
+ * Broadcast form of struct local_clifford_masks_t
+ */
+struct neon_local_clifford_t
+{
+    uint8x16_t xx, xz, zx, zz, rx, rz, ry;
+};
+
+static inline
+struct neon_local_clifford_t __inline_neon_local_clifford_load(const instruction_t clifford)
+{
+    struct local_clifford_masks_t const* m = LOCAL_CLIFFORD_MASKS + (clifford & INSTRUCTION_OPERATOR_MASK);
+    struct neon_local_clifford_t v = {
+        vdupq_n_u8((uint8_t)m->xx), vdupq_n_u8((uint8_t)m->xz),
+        vdupq_n_u8((uint8_t)m->zx), vdupq_n_u8((uint8_t)m->zz),
+        vdupq_n_u8((uint8_t)m->rx), vdupq_n_u8((uint8_t)m->rz), vdupq_n_u8((uint8_t)m->ry)
+    };
+    return v;
+}
+
+/*
+ * __inline_neon_local_clifford
+ * Applies a local Clifford in symplectic form to one vector of a qubit
+ * :: c : struct neon_local_clifford_t const* :: The Clifford
+ * :: x : uint8x16_t* :: X vector, updated in place
+ * :: z : uint8x16_t* :: Z vector, updated in place
+ * :: r : uint8x16_t* :: Phase vector, updated in place
+ */
+static inline
+void __inline_neon_local_clifford(struct neon_local_clifford_t const* c, uint8x16_t* x, uint8x16_t* z, uint8x16_t* r)
+{
+    const uint8x16_t x_0 = *x;
+    const uint8x16_t z_0 = *z;
+
+    *r = veorq_u8(*r,
+        veorq_u8(
+            vandq_u8(x_0, c->rx),
+            veorq_u8(
+                vandq_u8(z_0, c->rz),
+                vandq_u8(vandq_u8(x_0, z_0), c->ry))));
+    *x = veorq_u8(vandq_u8(x_0, c->xx), vandq_u8(z_0, c->xz));
+    *z = veorq_u8(vandq_u8(x_0, c->zx), vandq_u8(z_0, c->zz));
+}
+
+
+/*
+ * neon_tableau_fused_<clifford>
+ * Queued local Cliffords on both qubits followed by a two qubit gate, in one pass
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: ctrl_clifford : const instruction_t :: Local Clifford on the control
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ_clifford : const instruction_t :: Local Clifford on the target
+ * :: targ : const size_t :: The target qubit
+ */
+void neon_tableau_fused_CNOT(
+    tableau_t* restrict tab,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ)
+{
+    const struct neon_local_clifford_t ctrl_c = __inline_neon_local_clifford_load(ctrl_clifford);
+    const struct neon_local_clifford_t targ_c = __inline_neon_local_clifford_load(targ_clifford);
+
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]);
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]);
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]);
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]);
+    void* restrict slice_r = (void*)(tab->phases);
+
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
+    {
+        uint8x16_t ctrl_x = vld1q_u8(ctrl_slice_x + i);
+        uint8x16_t ctrl_z = vld1q_u8(ctrl_slice_z + i);
+        uint8x16_t targ_x = vld1q_u8(targ_slice_x + i);
+        uint8x16_t targ_z = vld1q_u8(targ_slice_z + i);
+        uint8x16_t r = vld1q_u8(slice_r + i);
+
+        __inline_neon_local_clifford(&ctrl_c, &ctrl_x, &ctrl_z, &r);
+        __inline_neon_local_clifford(&targ_c, &targ_x, &targ_z, &r);
+
+        vst1q_u8(ctrl_slice_x + i, ctrl_x);
+        vst1q_u8(targ_slice_z + i, targ_z);
+        vst1q_u8(targ_slice_x + i, veorq_u8(ctrl_x, targ_x));
+        vst1q_u8(ctrl_slice_z + i, veorq_u8(ctrl_z, targ_z));
+        vst1q_u8(slice_r + i,
+            veorq_u8(r,
+                vbicq_u8(
+                    vandq_u8(ctrl_x, targ_z),
+                    veorq_u8(targ_x, ctrl_z)
+                )
+            )
+        );
+    }
+}
+
+
+void neon_tableau_fused_CZ(
+    tableau_t* restrict tab,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ)
+{
+    const struct neon_local_clifford_t ctrl_c = __inline_neon_local_clifford_load(ctrl_clifford);
+    const struct neon_local_clifford_t targ_c = __inline_neon_local_clifford_load(targ_clifford);
+
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]);
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]);
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]);
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]);
+    void* restrict slice_r = (void*)(tab->phases);
+
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
+    {
+        uint8x16_t ctrl_x = vld1q_u8(ctrl_slice_x + i);
+        uint8x16_t ctrl_z = vld1q_u8(ctrl_slice_z + i);
+        uint8x16_t targ_x = vld1q_u8(targ_slice_x + i);
+        uint8x16_t targ_z = vld1q_u8(targ_slice_z + i);
+        uint8x16_t r = vld1q_u8(slice_r + i);
+
+        __inline_neon_local_clifford(&ctrl_c, &ctrl_x, &ctrl_z, &r);
+        __inline_neon_local_clifford(&targ_c, &targ_x, &targ_z, &r);
+
+        vst1q_u8(ctrl_slice_x + i, ctrl_x);
+        vst1q_u8(targ_slice_x + i, targ_x);
+        vst1q_u8(targ_slice_z + i, veorq_u8(ctrl_x, targ_z));
+        vst1q_u8(ctrl_slice_z + i, veorq_u8(ctrl_z, targ_x));
+        vst1q_u8(slice_r + i,
+            veorq_u8(r,
+                vandq_u8(
+                    vandq_u8(ctrl_x, targ_x),
+                    veorq_u8(ctrl_z, targ_z)
+                )
+            )
+        );
+    }
+}
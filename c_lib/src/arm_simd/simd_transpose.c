@@ -1,4 +1,5 @@
 #include "simd_transpose.h"
+#include "tableau_kernels.h"
 
 /*
  * Interal bit manipulation functions (naive)
@@ -550,7 +551,7 @@ void simd_transpose_2x16(uint8_t** src, uint8_t** targ)
 }
 
 
-void simd_transpose_64x64(uint64_t* restrict block_a[64], uint64_t* restrict block_b[64])
+void neon_transpose_64x64(uint64_t* restrict block_a[64], uint64_t* restrict block_b[64])
 {
      uint64_t src_block[64] = {0};
      uint64_t targ_block[64] = {0};
@@ -594,7 +595,7 @@ void simd_transpose_64x64(uint64_t* restrict block_a[64], uint64_t* restrict blo
  
     return;
 }
-void simd_transpose_64x64_inplace(uint64_t* block_a[64])
+void neon_transpose_64x64_inplace(uint64_t* block_a[64])
 {
      uint64_t targ_block[64] = {0};
     
@@ -1,59 +1,66 @@
 #include "transverse_hadamard.h"
 
 /*
- * simd_tableau_transverse_hadamard
+ * neon_tableau_transverse_hadamard
  * Applies a hadamard when transposed 
  * :: tab : tableau_t*  :: Tableau object
  * :: c_que :  clifford_queue_t* :: Clifford queue 
  * :: i : const size_t :: Index to target 
  *
+ * Walks 64 row tiles of the chunk holding the target column, two rows at a time
+ * The X and Z bits are swapped with masked xors and the phase contributions
+ * are shifted into place lane by lane
  */
-void simd_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ)
+void neon_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ)
 { 
-    const size_t stride = 64;
-    uint8_t bit_x[64] = {0};
-    uint8_t bit_z[64] = {0};
-    uint64_t* bit_phase;
-  
     // Number of bytes between transverseally adjacent bytes  
     const size_t row_bytes = tab->slice_len;
     const size_t offset = targ / 64 * 8; // Aligned offset load  
 
-    // TODO Vectorise this
-    // Use the strided load to do this faster
-    // Unfortunately scatter operations are avx512 :(
+    void* slices_x = (void*)(tab->slices_x[0]) + offset;
+    void* slices_z = (void*)(tab->slices_z[0]) + offset;
+    uint64_t* bit_phase = (uint64_t*)(tab->phases); 
 
-    // Gathers 8 values
-    //__m256i gathered = _mm256_i32gather_epi64(
-    //    base_address
-    //    __m128i vindex,
-    //    1
-    //); 
+    const uint64x2_t mask = vdupq_n_u64(1ull << (targ % 64));
 
-    // TODO SIMD this by chunks
-    // Otherwise we're trying to pipeline this
-    for (size_t i = 0; i < tab->n_qubits; i += stride)
+    // Shifts the target bit of lane k down to bit k
+    const int64_t lane_shift[2] = {-(int64_t)(targ % 64), 1 - (int64_t)(targ % 64)};
+    const int64x2_t shift = vld1q_s64(lane_shift);
+
+    // Slices are padded to a multiple of 64, so every tile is in bounds
+    for (size_t i = 0; i < tab->n_qubits; i += 64)
     {
-        bit_phase = (uint64_t*)(tab->phases) + i / stride; 
-        #pragma GCC unroll 64 
-        for (size_t j = 0; j < stride; j++)
-        {
-            bit_z[j] = __inline_slice_get_bit(tab->slices_z[i + j], targ); 
-            bit_x[j] = __inline_slice_get_bit(tab->slices_x[i + j], targ); 
-        }
+        uint64_t phase = 0;
 
-        #pragma GCC unroll 64 
-        for (size_t j = 0; j < stride; j++)
-        {
-            *bit_phase ^= ((uint64_t)bit_z[j] & (uint64_t)bit_x[j]) << j;
-        }
-       
-        #pragma GCC unroll 64 
-        for (size_t j = 0; j < stride; j++)
+        // Loading whole tiles before storing them evicts the rows from L1,
+        // so each pair of rows is written back as soon as it is updated
+        #pragma GCC unroll 4 
+        for (size_t j = 0; j < 64; j += 2)
         {
-            __inline_slice_set_bit(tab->slices_z[i + j], targ, bit_x[j]); 
-            __inline_slice_set_bit(tab->slices_x[i + j], targ, bit_z[j]); 
+            uint64_t* row_x = (uint64_t*)(slices_x + (i + j) * row_bytes);
+            uint64_t* row_z = (uint64_t*)(slices_z + (i + j) * row_bytes);
+            uint64_t* next_x = (uint64_t*)((void*)row_x + row_bytes);
+            uint64_t* next_z = (uint64_t*)((void*)row_z + row_bytes);
+
+            uint64x2_t x = vcombine_u64(vld1_u64(row_x), vld1_u64(next_x));
+            uint64x2_t z = vcombine_u64(vld1_u64(row_z), vld1_u64(next_z));
+
+            // Y terms pick up a phase
+            uint64x2_t y = vshlq_u64(vandq_u64(vandq_u64(x, z), mask), shift);
+            phase |= (vgetq_lane_u64(y, 0) | vgetq_lane_u64(y, 1)) << j;
+
+            // Bits that differ between X and Z are flipped in both
+            uint64x2_t swap = vandq_u64(veorq_u64(x, z), mask);
+            x = veorq_u64(x, swap);
+            z = veorq_u64(z, swap);
+
+            vst1_u64(row_x, vget_low_u64(x));
+            vst1_u64(next_x, vget_high_u64(x));
+            vst1_u64(row_z, vget_low_u64(z));
+            vst1_u64(next_z, vget_high_u64(z));
         }
+
+        bit_phase[i / 64] ^= phase;
     }
     return;
 }
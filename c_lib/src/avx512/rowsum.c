@@ -0,0 +1,125 @@
+#include "tableau_kernels.h"
+#include "simd_headers.h"
+
+#define AVX512_STRIDE (sizeof(__m512i))
+
+// Operands of each vpternlog are ordered (a, b, c) to match the (TL_X, TL_Z, TL_R) patterns
+#define TL_A TL_X
+#define TL_B TL_Z
+#define TL_C TL_R
+
+#define TL_SELECT TL_IMM((TL_A & TL_B) | (~TL_A & TL_C)) // a ? b : c
+#define TL_AND_XOR TL_IMM(TL_C & (TL_A ^ TL_B)) // c & (a ^ b)
+#define TL_AND_ANDNOT TL_IMM(TL_A & TL_B & ~TL_C) // a & b & ~c
+#define TL_XOR_AND TL_IMM(TL_A ^ (TL_B & TL_C)) // a ^ (b & c)
+
+
+/*
+ * __inline_avx512_popcnt
+ * Population count of a vector
+ * :: v : const __m512i :: Vector to count
+ */
+static inline
+uint64_t __inline_avx512_popcnt(const __m512i v)
+{
+    uint64_t lanes[8];
+    _mm512_storeu_si512((void*)lanes, v);
+
+    uint64_t total = 0;
+    #pragma GCC unroll 8
+    for (size_t i = 0; i < 8; i++)
+    {
+        total += __builtin_popcountll(lanes[i]);
+    }
+    return total;
+}
+
+
+/*
+ * __inline_avx512_rowsum_step
+ * Rowsum over one vector of each row
+ * :: mask : const __mmask8 :: Lanes to act on, masked lanes are left untouched and add no phase
+ * :: ctrl_x, ctrl_z, targ_x, targ_z :: void* :: Row pointers at the current offset
+ * :: pos, neg, acc :: __m512i* :: Bit sliced phase counters
+ */
+static inline
+void __inline_avx512_rowsum_step(
+    const __mmask8 mask,
+    void* restrict ctrl_x,
+    void* restrict ctrl_z,
+    void* restrict targ_x,
+    void* restrict targ_z,
+    __m512i* pos,
+    __m512i* neg,
+    __m512i* acc)
+{
+    __m512i v_ctrl_x = _mm512_maskz_loadu_epi64(mask, ctrl_x);
+    __m512i v_ctrl_z = _mm512_maskz_loadu_epi64(mask, ctrl_z);
+    __m512i v_targ_x = _mm512_maskz_loadu_epi64(mask, targ_x);
+    __m512i v_targ_z = _mm512_maskz_loadu_epi64(mask, targ_z);
+
+    // plus = x_c ? z_t & (z_c ^ x_t) : z_c & x_t & ~z_t
+    __m512i plus = _mm512_ternarylogic_epi64(
+        v_ctrl_x,
+        _mm512_ternarylogic_epi64(v_ctrl_z, v_targ_x, v_targ_z, TL_AND_XOR),
+        _mm512_ternarylogic_epi64(v_ctrl_z, v_targ_x, v_targ_z, TL_AND_ANDNOT),
+        TL_SELECT);
+
+    // minus = z_c ? x_t & (x_c ^ z_t) : x_c & z_t & ~x_t
+    __m512i minus = _mm512_ternarylogic_epi64(
+        v_ctrl_z,
+        _mm512_ternarylogic_epi64(v_ctrl_x, v_targ_z, v_targ_x, TL_AND_XOR),
+        _mm512_ternarylogic_epi64(v_ctrl_x, v_targ_z, v_targ_x, TL_AND_ANDNOT),
+        TL_SELECT);
+
+    _mm512_mask_storeu_epi64(targ_x, mask, _mm512_xor_si512(v_ctrl_x, v_targ_x));
+    _mm512_mask_storeu_epi64(targ_z, mask, _mm512_xor_si512(v_ctrl_z, v_targ_z));
+
+    *acc = _mm512_ternarylogic_epi64(*acc, *pos, plus, TL_XOR_AND);
+    *acc = _mm512_ternarylogic_epi64(*acc, *neg, minus, TL_XOR_AND);
+
+    *pos = _mm512_xor_si512(*pos, plus);
+    *neg = _mm512_xor_si512(*neg, minus);
+}
+
+
+/*
+ * avx512_rowsum_cnf
+ * CNF rowsum with each term reduced to vpternlogs
+ * :: n_bytes : size_t :: Length of the chunk, a multiple of 8
+ * :: ctrl_x :: void* :: Control X vec
+ * :: ctrl_z :: void* :: Control Z vec
+ * :: targ_x :: void* :: Target X vec
+ * :: targ_z :: void* :: Target Z vec
+ * Returns the phase term
+ */
+int8_t avx512_rowsum_cnf(
+    const size_t n_bytes,
+    void* restrict ctrl_x,
+    void* restrict ctrl_z,
+    void* restrict targ_x,
+    void* restrict targ_z)
+{
+    __m512i pos = _mm512_setzero_si512();
+    __m512i neg = _mm512_setzero_si512();
+    __m512i acc = _mm512_setzero_si512();
+
+    size_t i = 0;
+    for (; i + AVX512_STRIDE <= n_bytes; i += AVX512_STRIDE)
+    {
+        __inline_avx512_rowsum_step(0xff, ctrl_x + i, ctrl_z + i, targ_x + i, targ_z + i, &pos, &neg, &acc);
+    }
+
+    // Tableau rows are whole vectors, shorter buffers finish with a masked step
+    if (i < n_bytes)
+    {
+        const __mmask8 mask = (1u << ((n_bytes - i) / sizeof(uint64_t))) - 1;
+        __inline_avx512_rowsum_step(mask, ctrl_x + i, ctrl_z + i, targ_x + i, targ_z + i, &pos, &neg, &acc);
+    }
+
+    uint64_t total = __inline_avx512_popcnt(pos);
+    total -= __inline_avx512_popcnt(neg);
+    total += __inline_avx512_popcnt(acc) << 1;
+
+    return ((total + 2) % 4) - 2;
+}
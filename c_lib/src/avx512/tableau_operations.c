@@ -0,0 +1,235 @@
+#include "tableau_kernels.h"
+#include "simd_headers.h"
+
+#define AVX512_STRIDE (sizeof(__m512i))
+
+/*
+ * Operands of every vpternlog below are ordered (a, b, c) to match the (TL_X, TL_Z, TL_R) patterns
+ * so immediates are written as expressions over those patterns
+ */
+#define TL_A TL_X
+#define TL_B TL_Z
+#define TL_C TL_R
+
+
+/*
+ * avx512_tableau_<clifford>
+ * Single qubit clifford operations, one vpternlog per modified output
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: targ : const size_t :: The target qubit
+ * Generated from LOCAL_CLIFFORD_TRUTH_TABLES, outputs that are unchanged are not stored
+ */
+#define AVX512_LOCAL_CLIFFORD(gate, f_x, f_z, f_r) \
+void avx512_tableau_##gate(tableau_t* restrict tab, const size_t targ) \
+{ \
+    void* restrict slice_x = (void*)(tab->slices_x[targ]); \
+    void* restrict slice_z = (void*)(tab->slices_z[targ]); \
+    void* restrict slice_r = (void*)(tab->phases); \
+    for (size_t i = tab->active_start; i < tab->active_len; i += AVX512_STRIDE) \
+    { \
+        const __m512i x = _mm512_load_si512(slice_x + i); \
+        const __m512i z = _mm512_load_si512(slice_z + i); \
+        const __m512i r = _mm512_load_si512(slice_r + i); \
+        if (TL_X != TL_IMM(f_x)) { _mm512_store_si512(slice_x + i, _mm512_ternarylogic_epi64(x, z, r, TL_IMM(f_x))); } \
+        if (TL_Z != TL_IMM(f_z)) { _mm512_store_si512(slice_z + i, _mm512_ternarylogic_epi64(x, z, r, TL_IMM(f_z))); } \
+        if (TL_R != TL_IMM(f_r)) { _mm512_store_si512(slice_r + i, _mm512_ternarylogic_epi64(x, z, r, TL_IMM(f_r))); } \
+    } \
+}
+
+LOCAL_CLIFFORD_TRUTH_TABLES(AVX512_LOCAL_CLIFFORD)
+
+
+void avx512_tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+{
+    /*
+     * CNOT a, b: (
+     *     r ^= x_a & z_b & (1 ^ x_b ^ z_a);
+     *     x_b ^= x_a;
+     *     z_a ^= z_b)
+     */
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]);
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]);
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]);
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]);
+    void* restrict slice_r = (void*)(tab->phases);
+
+    for (size_t i = tab->active_start; i < tab->active_len; i += AVX512_STRIDE)
+    {
+        __m512i ctrl_x = _mm512_load_si512(ctrl_slice_x + i);
+        __m512i ctrl_z = _mm512_load_si512(ctrl_slice_z + i);
+        __m512i targ_x = _mm512_load_si512(targ_slice_x + i);
+        __m512i targ_z = _mm512_load_si512(targ_slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        // x_a & ~(x_b ^ z_a)
+        __m512i term = _mm512_ternarylogic_epi64(targ_x, ctrl_z, ctrl_x, TL_IMM(~(TL_A ^ TL_B) & TL_C));
+
+        _mm512_store_si512(targ_slice_x + i, _mm512_xor_si512(ctrl_x, targ_x));
+        _mm512_store_si512(ctrl_slice_z + i, _mm512_xor_si512(ctrl_z, targ_z));
+        _mm512_store_si512(slice_r + i, _mm512_ternarylogic_epi64(r, term, targ_z, TL_IMM(TL_A ^ (TL_B & TL_C))));
+    }
+}
+
+
+void avx512_tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+{
+    /*
+     * CZ a, b: (
+     *     r ^= x_a & x_b & (z_a ^ z_b);
+     *     z_b ^= x_a;
+     *     z_a ^= x_b)
+     */
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]);
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]);
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]);
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]);
+    void* restrict slice_r = (void*)(tab->phases);
+
+    for (size_t i = tab->active_start; i < tab->active_len; i += AVX512_STRIDE)
+    {
+        __m512i ctrl_x = _mm512_load_si512(ctrl_slice_x + i);
+        __m512i ctrl_z = _mm512_load_si512(ctrl_slice_z + i);
+        __m512i targ_x = _mm512_load_si512(targ_slice_x + i);
+        __m512i targ_z = _mm512_load_si512(targ_slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        // x_a & (z_a ^ z_b)
+        __m512i term = _mm512_ternarylogic_epi64(ctrl_z, targ_z, ctrl_x, TL_IMM((TL_A ^ TL_B) & TL_C));
+
+        _mm512_store_si512(targ_slice_z + i, _mm512_xor_si512(ctrl_x, targ_z));
+        _mm512_store_si512(ctrl_slice_z + i, _mm512_xor_si512(ctrl_z, targ_x));
+        _mm512_store_si512(slice_r + i, _mm512_ternarylogic_epi64(r, term, targ_x, TL_IMM(TL_A ^ (TL_B & TL_C))));
+    }
+}
+
+
+/*
+ * Broadcast form of struct local_clifford_masks_t
+ */
+struct avx512_local_clifford_t
+{
+    __m512i xx, xz, zx, zz, rx, rz, ry;
+};
+
+static inline
+struct avx512_local_clifford_t __inline_avx512_local_clifford_load(const instruction_t clifford)
+{
+    struct local_clifford_masks_t const* m = LOCAL_CLIFFORD_MASKS + (clifford & INSTRUCTION_OPERATOR_MASK);
+    struct avx512_local_clifford_t v = {
+        _mm512_set1_epi64(m->xx), _mm512_set1_epi64(m->xz),
+        _mm512_set1_epi64(m->zx), _mm512_set1_epi64(m->zz),
+        _mm512_set1_epi64(m->rx), _mm512_set1_epi64(m->rz), _mm512_set1_epi64(m->ry)
+    };
+    return v;
+}
+
+/*
+ * __inline_avx512_local_clifford
+ * Applies a local Clifford in symplectic form to one vector of a qubit
+ * :: c : struct avx512_local_clifford_t const* :: The Clifford
+ * :: x : __m512i* :: X vector, updated in place
+ * :: z : __m512i* :: Z vector, updated in place
+ * :: r : __m512i* :: Phase vector, updated in place
+ */
+static inline
+void __inline_avx512_local_clifford(struct avx512_local_clifford_t const* c, __m512i* x, __m512i* z, __m512i* r)
+{
+    const __m512i x_0 = *x;
+    const __m512i z_0 = *z;
+
+    // r ^= (x & rx) ^ (z & rz) ^ (x & z & ry)
+    __m512i phase = _mm512_ternarylogic_epi64(x_0, z_0, c->ry, TL_IMM(TL_A & TL_B & TL_C));
+    phase = _mm512_ternarylogic_epi64(phase, x_0, c->rx, TL_IMM(TL_A ^ (TL_B & TL_C)));
+    phase = _mm512_ternarylogic_epi64(phase, z_0, c->rz, TL_IMM(TL_A ^ (TL_B & TL_C)));
+    *r = _mm512_xor_si512(*r, phase);
+
+    *x = _mm512_xor_si512(_mm512_and_si512(x_0, c->xx), _mm512_and_si512(z_0, c->xz));
+    *z = _mm512_xor_si512(_mm512_and_si512(x_0, c->zx), _mm512_and_si512(z_0, c->zz));
+}
+
+
+/*
+ * avx512_tableau_fused_<clifford>
+ * Queued local Cliffords on both qubits followed by a two qubit gate, in one pass
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: ctrl_clifford : const instruction_t :: Local Clifford on the control
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ_clifford : const instruction_t :: Local Clifford on the target
+ * :: targ : const size_t :: The target qubit
+ */
+void avx512_tableau_fused_CNOT(
+    tableau_t* restrict tab,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ)
+{
+    const struct avx512_local_clifford_t ctrl_c = __inline_avx512_local_clifford_load(ctrl_clifford);
+    const struct avx512_local_clifford_t targ_c = __inline_avx512_local_clifford_load(targ_clifford);
+
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]);
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]);
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]);
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]);
+    void* restrict slice_r = (void*)(tab->phases);
+
+    for (size_t i = tab->active_start; i < tab->active_len; i += AVX512_STRIDE)
+    {
+        __m512i ctrl_x = _mm512_load_si512(ctrl_slice_x + i);
+        __m512i ctrl_z = _mm512_load_si512(ctrl_slice_z + i);
+        __m512i targ_x = _mm512_load_si512(targ_slice_x + i);
+        __m512i targ_z = _mm512_load_si512(targ_slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        __inline_avx512_local_clifford(&ctrl_c, &ctrl_x, &ctrl_z, &r);
+        __inline_avx512_local_clifford(&targ_c, &targ_x, &targ_z, &r);
+
+        // x_a & ~(x_b ^ z_a)
+        __m512i term = _mm512_ternarylogic_epi64(targ_x, ctrl_z, ctrl_x, TL_IMM(~(TL_A ^ TL_B) & TL_C));
+
+        _mm512_store_si512(ctrl_slice_x + i, ctrl_x);
+        _mm512_store_si512(targ_slice_z + i, targ_z);
+        _mm512_store_si512(targ_slice_x + i, _mm512_xor_si512(ctrl_x, targ_x));
+        _mm512_store_si512(ctrl_slice_z + i, _mm512_xor_si512(ctrl_z, targ_z));
+        _mm512_store_si512(slice_r + i, _mm512_ternarylogic_epi64(r, term, targ_z, TL_IMM(TL_A ^ (TL_B & TL_C))));
+    }
+}
+
+
+void avx512_tableau_fused_CZ(
+    tableau_t* restrict tab,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ)
+{
+    const struct avx512_local_clifford_t ctrl_c = __inline_avx512_local_clifford_load(ctrl_clifford);
+    const struct avx512_local_clifford_t targ_c = __inline_avx512_local_clifford_load(targ_clifford);
+
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]);
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]);
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]);
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]);
+    void* restrict slice_r = (void*)(tab->phases);
+
+    for (size_t i = tab->active_start; i < tab->active_len; i += AVX512_STRIDE)
+    {
+        __m512i ctrl_x = _mm512_load_si512(ctrl_slice_x + i);
+        __m512i ctrl_z = _mm512_load_si512(ctrl_slice_z + i);
+        __m512i targ_x = _mm512_load_si512(targ_slice_x + i);
+        __m512i targ_z = _mm512_load_si512(targ_slice_z + i);
+        __m512i r = _mm512_load_si512(slice_r + i);
+
+        __inline_avx512_local_clifford(&ctrl_c, &ctrl_x, &ctrl_z, &r);
+        __inline_avx512_local_clifford(&targ_c, &targ_x, &targ_z, &r);
+
+        // x_a & (z_a ^ z_b)
+        __m512i term = _mm512_ternarylogic_epi64(ctrl_z, targ_z, ctrl_x, TL_IMM((TL_A ^ TL_B) & TL_C));
+
+        _mm512_store_si512(ctrl_slice_x + i, ctrl_x);
+        _mm512_store_si512(targ_slice_x + i, targ_x);
+        _mm512_store_si512(targ_slice_z + i, _mm512_xor_si512(ctrl_x, targ_z));
+        _mm512_store_si512(ctrl_slice_z + i, _mm512_xor_si512(ctrl_z, targ_x));
+        _mm512_store_si512(slice_r + i, _mm512_ternarylogic_epi64(r, term, targ_x, TL_IMM(TL_A ^ (TL_B & TL_C))));
+    }
+}
@@ -0,0 +1,28 @@
+#include "tableau_kernels.h"
+#include "simd_headers.h"
+
+void avx512_row_swap(
+    const size_t n_bytes,
+    void* restrict ctrl_x,
+    void* restrict ctrl_z,
+    void* restrict targ_x,
+    void* restrict targ_z
+)
+{
+    for (size_t i = 0; i < n_bytes; i += sizeof(__m512i))
+    {
+        // Partial final vector for rows that are not a multiple of 64 bytes
+        const size_t n_lanes = (n_bytes - i) / sizeof(uint64_t);
+        const __mmask8 mask = (n_lanes >= 8) ? 0xff : (1u << n_lanes) - 1;
+
+        __m512i v_targ_x = _mm512_maskz_loadu_epi64(mask, targ_x + i);
+        __m512i v_ctrl_x = _mm512_maskz_loadu_epi64(mask, ctrl_x + i);
+        __m512i v_targ_z = _mm512_maskz_loadu_epi64(mask, targ_z + i);
+        __m512i v_ctrl_z = _mm512_maskz_loadu_epi64(mask, ctrl_z + i);
+
+        _mm512_mask_storeu_epi64(targ_x + i, mask, v_ctrl_x);
+        _mm512_mask_storeu_epi64(targ_z + i, mask, v_ctrl_z);
+        _mm512_mask_storeu_epi64(ctrl_x + i, mask, v_targ_x);
+        _mm512_mask_storeu_epi64(ctrl_z + i, mask, v_targ_z);
+    }
+}
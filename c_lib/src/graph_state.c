@@ -0,0 +1,492 @@
+#define GRAPH_STATE_SRC
+
+#include "graph_state.h"
+#include "tableau_operations.h"
+
+
+/*
+ * graph_state_create
+ * Constructor for a graph state
+ * :: n_qubits : const size_t :: Number of vertices
+ * All qubits start in the zero state, matching a freshly created tableau
+ */
+graph_state_t* graph_state_create(const size_t n_qubits)
+{
+    graph_state_t* gs = (graph_state_t*)malloc(sizeof(graph_state_t));
+    assert(NULL != gs);
+
+    gs->n_qubits = n_qubits;
+
+    // H|+> = |0>, one spare entry of each array so an empty graph state does not allocate zero bytes
+    gs->vops = (instruction_t*)malloc((n_qubits + 1) * sizeof(instruction_t));
+    assert(NULL != gs->vops);
+    memset(gs->vops, _H_, n_qubits);
+
+    // Neighbour lists are only allocated once a vertex gains an edge
+    gs->neighbours = (uint32_t**)calloc(n_qubits + 1, sizeof(uint32_t*));
+    gs->degree = (uint32_t*)calloc(n_qubits + 1, sizeof(uint32_t));
+    gs->capacity = (uint32_t*)calloc(n_qubits + 1, sizeof(uint32_t));
+    assert(NULL != gs->neighbours);
+    assert(NULL != gs->degree);
+    assert(NULL != gs->capacity);
+
+    gs->n_edges = 0;
+    gs->max_degree = 0;
+    gs->n_toggles = 0;
+
+    return gs;
+}
+
+
+/*
+ * graph_state_reset
+ * Returns a graph state to all zeros, keeping its neighbour lists allocated
+ * :: gs : graph_state_t* :: Graph state
+ * :: n_qubits : const size_t :: Number of vertices that may have been touched
+ */
+void graph_state_reset(graph_state_t* gs, const size_t n_qubits)
+{
+    assert(n_qubits <= gs->n_qubits);
+    memset(gs->vops, _H_, n_qubits);
+    memset(gs->degree, 0, n_qubits * sizeof(uint32_t));
+
+    gs->n_edges = 0;
+    gs->max_degree = 0;
+    gs->n_toggles = 0;
+}
+
+
+/*
+ * graph_state_grow
+ * Adds vertices to a graph state
+ * :: gs : graph_state_t* :: Graph state
+ * :: n_qubits : const size_t :: New number of vertices
+ * New vertices are isolated and in the zero state
+ */
+void graph_state_grow(graph_state_t* gs, const size_t n_qubits)
+{
+    assert(n_qubits >= gs->n_qubits);
+    const size_t n_new = n_qubits - gs->n_qubits;
+
+    gs->vops = (instruction_t*)realloc(gs->vops, (n_qubits + 1) * sizeof(instruction_t));
+    gs->neighbours = (uint32_t**)realloc(gs->neighbours, (n_qubits + 1) * sizeof(uint32_t*));
+    gs->degree = (uint32_t*)realloc(gs->degree, (n_qubits + 1) * sizeof(uint32_t));
+    gs->capacity = (uint32_t*)realloc(gs->capacity, (n_qubits + 1) * sizeof(uint32_t));
+    assert(NULL != gs->vops);
+    assert(NULL != gs->neighbours);
+    assert(NULL != gs->degree);
+    assert(NULL != gs->capacity);
+
+    memset(gs->vops + gs->n_qubits, _H_, n_new);
+    memset(gs->neighbours + gs->n_qubits, 0, n_new * sizeof(uint32_t*));
+    memset(gs->degree + gs->n_qubits, 0, n_new * sizeof(uint32_t));
+    memset(gs->capacity + gs->n_qubits, 0, n_new * sizeof(uint32_t));
+
+    gs->n_qubits = n_qubits;
+}
+
+
+/*
+ * graph_state_destroy
+ * Destructor for a graph state
+ * :: gs : graph_state_t* :: Graph state to free
+ */
+void graph_state_destroy(graph_state_t* gs)
+{
+    for (size_t i = 0; i < gs->n_qubits; i++)
+    {
+        free(gs->neighbours[i]);
+    }
+    free(gs->neighbours);
+    free(gs->degree);
+    free(gs->capacity);
+    free(gs->vops);
+    free(gs);
+}
+
+
+/*
+ * __inline_graph_state_find
+ * Finds a neighbour in a vertex's neighbour list
+ * :: gs : const graph_state_t* :: The graph state
+ * :: vertex : const size_t :: Vertex owning the list
+ * :: neighbour : const size_t :: Neighbour to find
+ * Returns the position in the list, or the degree of the vertex when absent
+ */
+static inline
+uint32_t __inline_graph_state_find(const graph_state_t* gs, const size_t vertex, const size_t neighbour)
+{
+    const uint32_t* list = gs->neighbours[vertex];
+    uint32_t i = 0;
+    while (i < gs->degree[vertex] && list[i] != neighbour)
+    {
+        i++;
+    }
+    return i;
+}
+
+
+/*
+ * __inline_graph_state_has_edge
+ * Checks for an edge, searching the shorter of the two lists
+ * :: gs : const graph_state_t* :: The graph state
+ * :: a : const size_t :: First vertex
+ * :: b : const size_t :: Second vertex
+ */
+static inline
+bool __inline_graph_state_has_edge(const graph_state_t* gs, const size_t a, const size_t b)
+{
+    if (gs->degree[a] > gs->degree[b])
+    {
+        return __inline_graph_state_find(gs, b, a) < gs->degree[b];
+    }
+    return __inline_graph_state_find(gs, a, b) < gs->degree[a];
+}
+
+
+/*
+ * __inline_graph_state_toggle_half_edge
+ * Adds or removes a neighbour from one vertex's list
+ * :: gs : graph_state_t* :: The graph state
+ * :: vertex : const size_t :: Vertex owning the list
+ * :: neighbour : const size_t :: Neighbour to toggle
+ * Removal swaps the last entry into the gap, lists grow by doubling
+ * Returns true if the neighbour was added
+ */
+static inline
+bool __inline_graph_state_toggle_half_edge(graph_state_t* gs, const size_t vertex, const size_t neighbour)
+{
+    const uint32_t idx = __inline_graph_state_find(gs, vertex, neighbour);
+    if (idx < gs->degree[vertex])
+    {
+        gs->degree[vertex]--;
+        gs->neighbours[vertex][idx] = gs->neighbours[vertex][gs->degree[vertex]];
+        return false;
+    }
+
+    if (gs->degree[vertex] == gs->capacity[vertex])
+    {
+        gs->capacity[vertex] = gs->capacity[vertex] ? 2 * gs->capacity[vertex] : GRAPH_STATE_INITIAL_DEGREE;
+        gs->neighbours[vertex] = (uint32_t*)realloc(gs->neighbours[vertex], gs->capacity[vertex] * sizeof(uint32_t));
+        assert(NULL != gs->neighbours[vertex]);
+    }
+    gs->neighbours[vertex][gs->degree[vertex]] = neighbour;
+    gs->degree[vertex]++;
+    if (gs->degree[vertex] > gs->max_degree)
+    {
+        gs->max_degree = gs->degree[vertex];
+    }
+    return true;
+}
+
+
+/*
+ * __inline_graph_state_toggle_edge
+ * Adds an edge if absent, otherwise removes it
+ * :: gs : graph_state_t* :: The graph state
+ * :: a : const size_t :: First vertex
+ * :: b : const size_t :: Second vertex
+ */
+static inline
+void __inline_graph_state_toggle_edge(graph_state_t* gs, const size_t a, const size_t b)
+{
+    __inline_graph_state_toggle_half_edge(gs, b, a);
+    if (__inline_graph_state_toggle_half_edge(gs, a, b))
+    {
+        gs->n_edges++;
+    }
+    else
+    {
+        gs->n_edges--;
+    }
+    gs->n_toggles++;
+}
+
+
+/*
+ * __inline_graph_state_has_other_neighbours
+ * Checks if a vertex has a neighbour other than the second operand of a gate
+ * :: gs : const graph_state_t* :: The graph state
+ * :: vertex : const size_t :: The vertex
+ * :: other : const size_t :: The other operand
+ */
+static inline
+bool __inline_graph_state_has_other_neighbours(const graph_state_t* gs, const size_t vertex, const size_t other)
+{
+    if (gs->degree[vertex] > 1)
+    {
+        return true;
+    }
+    return (gs->degree[vertex] == 1) && (gs->neighbours[vertex][0] != other);
+}
+
+
+/*
+ * graph_state_local_clifford
+ * Applies a local Clifford to a vertex
+ * :: gs : graph_state_t* :: The graph state
+ * :: opcode : const instruction_t :: Local Clifford opcode, any of the 24
+ * :: targ : const size_t :: Target qubit
+ * Only updates the vertex operator
+ */
+void graph_state_local_clifford(graph_state_t* gs, const instruction_t opcode, const size_t targ)
+{
+    gs->vops[targ] = LOCAL_CLIFFORD_LEFT(opcode, gs->vops[targ]);
+}
+
+
+/*
+ * graph_state_local_complementation
+ * Complements the neighbourhood of a vertex
+ * :: gs : graph_state_t* :: The graph state
+ * :: targ : const size_t :: Vertex to complement around
+ * The vertex operators absorb the inverse Cliffords, so the state is unchanged
+ */
+void graph_state_local_complementation(graph_state_t* gs, const size_t targ)
+{
+    // Toggling edges between neighbours never changes the neighbour list of the target
+    const uint32_t* list = gs->neighbours[targ];
+    const uint32_t degree = gs->degree[targ];
+    for (uint32_t i = 0; i < degree; i++)
+    {
+        for (uint32_t j = i + 1; j < degree; j++)
+        {
+            __inline_graph_state_toggle_edge(gs, list[i], list[j]);
+        }
+        gs->vops[list[i]] = LOCAL_CLIFFORD_LEFT(gs->vops[list[i]], _R_);
+    }
+    gs->vops[targ] = LOCAL_CLIFFORD_LEFT(gs->vops[targ], _HSH_);
+}
+
+
+/*
+ * __inline_graph_state_remove_vop
+ * Reduces a vertex operator to the identity with local complementations
+ * :: gs : graph_state_t* :: The graph state
+ * :: vertex : const size_t :: The vertex to clear
+ * :: avoid : const size_t :: The other gate operand, never used as the neighbour to complement around
+ * The vertex must have a neighbour other than avoid, at most five complementations are needed
+ */
+static inline
+void __inline_graph_state_remove_vop(graph_state_t* gs, const size_t vertex, const size_t avoid)
+{
+    uint8_t step;
+    while (GRAPH_STATE_STEP_NONE != (step = GRAPH_STATE_REMOVE_VOP_STEP[gs->vops[vertex] & INSTRUCTION_OPERATOR_MASK]))
+    {
+        if (GRAPH_STATE_STEP_VERTEX == step)
+        {
+            graph_state_local_complementation(gs, vertex);
+            continue;
+        }
+
+        uint32_t swap = gs->neighbours[vertex][0];
+        if (swap == avoid)
+        {
+            assert(gs->degree[vertex] > 1);
+            swap = gs->neighbours[vertex][1];
+        }
+        graph_state_local_complementation(gs, swap);
+    }
+}
+
+
+/*
+ * graph_state_CZ
+ * Applies a CZ gate
+ * :: gs : graph_state_t* :: The graph state
+ * :: ctrl : const size_t :: Control qubit
+ * :: targ : const size_t :: Target qubit
+ * Local complementations clear non-diagonal vertex operators on qubits with other neighbours,
+ * the remaining two vertex subgraph is updated from a lookup table
+ */
+void graph_state_CZ(graph_state_t* gs, const size_t ctrl, const size_t targ)
+{
+    // Clearing one operand may hand the other new neighbours, three passes always suffice
+    for (size_t pass = 0; pass < 3; pass++)
+    {
+        if (__inline_graph_state_has_other_neighbours(gs, ctrl, targ) && !GRAPH_STATE_DIAGONAL(gs->vops[ctrl]))
+        {
+            __inline_graph_state_remove_vop(gs, ctrl, targ);
+        }
+        else if (__inline_graph_state_has_other_neighbours(gs, targ, ctrl) && !GRAPH_STATE_DIAGONAL(gs->vops[targ]))
+        {
+            __inline_graph_state_remove_vop(gs, targ, ctrl);
+        }
+    }
+    assert(!__inline_graph_state_has_other_neighbours(gs, ctrl, targ) || GRAPH_STATE_DIAGONAL(gs->vops[ctrl]));
+    assert(!__inline_graph_state_has_other_neighbours(gs, targ, ctrl) || GRAPH_STATE_DIAGONAL(gs->vops[targ]));
+
+    const uint8_t edge = __inline_graph_state_has_edge(gs, ctrl, targ);
+    const struct graph_state_cz_t* entry = GRAPH_STATE_CZ_TABLE
+        + edge * N_LOCAL_CLIFFORDS * N_LOCAL_CLIFFORDS
+        + (gs->vops[ctrl] & INSTRUCTION_OPERATOR_MASK) * N_LOCAL_CLIFFORDS
+        + (gs->vops[targ] & INSTRUCTION_OPERATOR_MASK);
+
+    if (entry->edge != edge)
+    {
+        __inline_graph_state_toggle_edge(gs, ctrl, targ);
+    }
+    gs->vops[ctrl] = entry->ctrl;
+    gs->vops[targ] = entry->targ;
+}
+
+
+/*
+ * graph_state_CNOT
+ * Applies a CNOT gate as a CZ conjugated by Hadamards on the target
+ * :: gs : graph_state_t* :: The graph state
+ * :: ctrl : const size_t :: Control qubit
+ * :: targ : const size_t :: Target qubit
+ */
+void graph_state_CNOT(graph_state_t* gs, const size_t ctrl, const size_t targ)
+{
+    graph_state_local_clifford(gs, _H_, targ);
+    graph_state_CZ(gs, ctrl, targ);
+    graph_state_local_clifford(gs, _H_, targ);
+}
+
+
+/*
+ * graph_state_non_local_clifford
+ * Applies local Cliffords on both qubits followed by a two qubit gate
+ * :: gs : graph_state_t* :: The graph state
+ * :: opcode : const instruction_t :: Two qubit opcode
+ * :: ctrl_clifford : const instruction_t :: Local Clifford on the control
+ * :: ctrl : const size_t :: Control qubit
+ * :: targ_clifford : const instruction_t :: Local Clifford on the target
+ * :: targ : const size_t :: Target qubit
+ * Mirrors the fused tableau kernels
+ */
+void graph_state_non_local_clifford(
+    graph_state_t* gs,
+    const instruction_t opcode,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ)
+{
+    graph_state_local_clifford(gs, ctrl_clifford, ctrl);
+    graph_state_local_clifford(gs, targ_clifford, targ);
+    switch (opcode)
+    {
+        case _CNOT_:
+            graph_state_CNOT(gs, ctrl, targ);
+            break;
+        case _CZ_:
+            graph_state_CZ(gs, ctrl, targ);
+            break;
+        default:
+            assert(0);
+    }
+}
+
+
+/*
+ * __inline_graph_state_cmp
+ * Comparator for sorting neighbour lists
+ */
+static inline
+int __inline_graph_state_cmp(const void* a, const void* b)
+{
+    const uint32_t x = *(const uint32_t*)a;
+    const uint32_t y = *(const uint32_t*)b;
+    return (x > y) - (x < y);
+}
+
+
+/*
+ * graph_state_get_adjacencies
+ * Lists the neighbours of a vertex in ascending order
+ * :: gs : const graph_state_t* :: The graph state
+ * :: targ : const size_t :: The vertex
+ * Returns an adjacency object with a heap allocated array, NULL when there are no neighbours
+ */
+struct adjacency_obj graph_state_get_adjacencies(const graph_state_t* gs, const size_t targ)
+{
+    struct adjacency_obj adj = {
+        .targ = targ,
+        .n_adjacent = gs->degree[targ],
+        .adjacencies = NULL
+    };
+
+    if (0 == adj.n_adjacent)
+    {
+        return adj;
+    }
+
+    adj.adjacencies = (uint32_t*)malloc(adj.n_adjacent * sizeof(uint32_t));
+    assert(NULL != adj.adjacencies);
+    memcpy(adj.adjacencies, gs->neighbours[targ], adj.n_adjacent * sizeof(uint32_t));
+    qsort(adj.adjacencies, adj.n_adjacent, sizeof(uint32_t), __inline_graph_state_cmp);
+
+    return adj;
+}
+
+
+/*
+ * graph_state_get_neighbours
+ * Copies the neighbours of a vertex in ascending order into a caller provided array
+ * :: gs : const graph_state_t* :: The graph state
+ * :: targ : const size_t :: The vertex
+ * :: upper_triangle : const bool :: Only report neighbours above the vertex
+ * :: neighbours : uint32_t* :: Destination, NULL to only count
+ * Returns the number of neighbours reported
+ */
+size_t graph_state_get_neighbours(const graph_state_t* gs, const size_t targ, const bool upper_triangle, uint32_t* neighbours)
+{
+    size_t n_reported = 0;
+    for (size_t i = 0; i < gs->degree[targ]; i++)
+    {
+        const uint32_t vertex = gs->neighbours[targ][i];
+        if (upper_triangle && vertex <= targ)
+        {
+            continue;
+        }
+        if (NULL != neighbours)
+        {
+            neighbours[n_reported] = vertex;
+        }
+        n_reported++;
+    }
+
+    if (NULL != neighbours)
+    {
+        qsort(neighbours, n_reported, sizeof(uint32_t), __inline_graph_state_cmp);
+    }
+    return n_reported;
+}
+
+
+/*
+ * graph_state_to_tableau
+ * Writes the stabilisers of the graph state to a tableau
+ * :: gs : const graph_state_t* :: The graph state
+ * :: tab : tableau_t* :: Freshly created tableau with at least as many qubits
+ * Used for printing and for comparing against the tableau engine
+ */
+void graph_state_to_tableau(const graph_state_t* gs, tableau_t* tab)
+{
+    assert(tab->n_qubits >= gs->n_qubits);
+
+    for (size_t i = 0; i < gs->n_qubits; i++)
+    {
+        SINGLE_QUBIT_OPERATIONS[_H_ & INSTRUCTION_OPERATOR_MASK](tab, i);
+    }
+
+    // Each edge is applied once from its lower vertex
+    for (size_t i = 0; i < gs->n_qubits; i++)
+    {
+        for (uint32_t j = 0; j < gs->degree[i]; j++)
+        {
+            if (gs->neighbours[i][j] > i)
+            {
+                TWO_QUBIT_OPERATIONS[_CZ_ & INSTRUCTION_OPERATOR_MASK](tab, i, gs->neighbours[i][j]);
+            }
+        }
+    }
+
+    for (size_t i = 0; i < gs->n_qubits; i++)
+    {
+        SINGLE_QUBIT_OPERATIONS[gs->vops[i] & INSTRUCTION_OPERATOR_MASK](tab, i);
+    }
+}
@@ -17,7 +17,8 @@ void __inline_local_clifford_gate(
     wid->queue->table[target] = LOCAL_CLIFFORD_LEFT(inst->opcode, wid->queue->table[target]);
 
     // Pauli Correction Tracking
-    PAULI_TRACKER_LOCAL(inst->opcode)(wid->pauli_tracker, target);
+    WIDGET_STATS_TIME(wid, pauli_tracker_ns,
+        PAULI_TRACKER_LOCAL(inst->opcode)(wid->pauli_tracker, target));
     return;
 } 
 
@@ -29,11 +30,79 @@ void __inline_local_clifford_gate(
  */
 void apply_local_cliffords(widget_t* wid)
 {
+    assert(NULL == wid->csr); // Finalised widgets hold no tableau or graph, see widget_finalise
+    WIDGET_STATS_START(start);
+    if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        for (size_t i = 0; i < wid->n_qubits; i++)
+        {
+            graph_state_local_clifford(wid->graph, wid->queue->table[i], i);
+            wid->queue->table[i] = _I_;
+        }
+        WIDGET_STATS_STOP(wid, queue_flush_ns, start);
+        return;
+    }
+
     for (size_t i = 0; i < wid->n_qubits; i++)
     {
         SINGLE_QUBIT_OPERATIONS[wid->queue->table[i] & INSTRUCTION_OPERATOR_MASK](wid->tableau, i);
         wid->queue->table[i] = _I_; 
     }
+    WIDGET_STATS_STOP(wid, queue_flush_ns, start);
+}
+
+/*
+ * __inline_widget_auto_engine
+ * Counts a two qubit gate and converts automatic widgets to the tableau once the graph is dense
+ * :: wid : widget_t* :: The widget
+ * Called before the gate touches the engine, density is the edge toggle rate over the last window
+ */
+static inline
+void __inline_widget_auto_engine(widget_t* wid)
+{
+    wid->engine_stats.n_gates++;
+    if (WIDGET_ENGINE_AUTO != wid->engine_stats.requested_engine
+        || WIDGET_ENGINE_GRAPH != wid->engine
+        || 0 != wid->engine_stats.n_gates % WIDGET_AUTO_WINDOW)
+    {
+        return;
+    }
+
+    const size_t n_toggles = wid->graph->n_toggles - wid->auto_window_toggles;
+    wid->auto_window_toggles = wid->graph->n_toggles;
+
+    // Tableau gates scale with the qubits in use, graph gates with the edges toggled
+    if ((double)(n_toggles * WIDGET_AUTO_TOGGLE_QUBITS) >= wid->auto_threshold * WIDGET_AUTO_WINDOW * wid->n_qubits)
+    {
+        widget_convert_to_tableau(wid);
+    }
+}
+
+/*
+ * __inline_widget_fused_non_local_clifford
+ * Applies flushed local Cliffords and a two qubit gate on the widget's engine
+ * :: wid : widget_t* :: The widget
+ * :: opcode : const instruction_t :: Two qubit opcode
+ * :: ctrl_clifford : const instruction_t :: Local Clifford opcode on the control
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ_clifford : const instruction_t :: Local Clifford opcode on the target
+ * :: targ : const size_t :: The target qubit
+ */
+static inline
+void __inline_widget_fused_non_local_clifford(
+    widget_t* wid,
+    const instruction_t opcode,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ)
+{
+    if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        graph_state_non_local_clifford(wid->graph, opcode, ctrl_clifford, ctrl, targ_clifford, targ);
+        return;
+    }
+    __inline_tableau_fused_non_local_clifford(wid->tableau, opcode, ctrl_clifford, ctrl, targ_clifford, targ);
 }
 
 /*
@@ -49,21 +118,23 @@ void __inline_non_local_clifford_gate(
     widget_t* wid,
     struct two_qubit_instruction* inst)
 {
+    __inline_widget_auto_engine(wid);
+
     // First pass dump the tables and implement the instruction
     size_t ctrl = wid->q_map[inst->ctrl]; 
     size_t targ = wid->q_map[inst->targ]; 
 
-    // Execute the queued cliffords 
-    // TODO : Merge these operations with CX/CZ gates to cut runtime to one third 
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[ctrl] & INSTRUCTION_OPERATOR_MASK](wid->tableau, ctrl);
-    wid->queue->table[ctrl] = _I_;
+    // Queued cliffords that commute through the gate stay in the queue
+    instruction_t ctrl_flush;
+    instruction_t targ_flush;
+    __inline_clifford_queue_non_local_clifford(wid->queue, inst->opcode, ctrl, targ, &ctrl_flush, &targ_flush);
 
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[targ] & INSTRUCTION_OPERATOR_MASK](wid->tableau, targ);
-    wid->queue->table[targ] = _I_;
-    TWO_QUBIT_OPERATIONS[inst->opcode & INSTRUCTION_OPERATOR_MASK](wid->tableau, ctrl, targ);
+    // Execute the remaining queued cliffords in the same pass as the gate
+    __inline_widget_fused_non_local_clifford(wid, inst->opcode, ctrl_flush, ctrl, targ_flush, targ);
 
     // Pauli Correction Tracking
-    PAULI_TRACKER_NON_LOCAL(inst->opcode)(wid->pauli_tracker, ctrl, targ);
+    WIDGET_STATS_TIME(wid, pauli_tracker_ns,
+        PAULI_TRACKER_NON_LOCAL(inst->opcode)(wid->pauli_tracker, ctrl, targ));
 
     return;
 } 
@@ -74,33 +145,37 @@ void __inline_non_local_clifford_gate(
  * :: wid : widget_t* :: The widget in question 
  * :: inst : rz_instruction* :: The rz instruction indicating an angle 
  * Teleports an RZ operation, allocating a new qubit in the process
- * Compilation fails if the number of qubits exceeds some maximum 
+ * The widget grows when it runs out of qubits
  */
 static inline
 void __inline_rz_gate(
     widget_t* wid,
     struct rz_instruction* inst) 
 {
-    
-    // This could be handled with a better return
-    assert(wid->n_qubits < wid->max_qubits);
+    widget_reserve(wid, wid->n_qubits + 1);
+
+    __inline_widget_auto_engine(wid);
 
     const size_t ctrl = WMAP_LOOKUP(wid, inst->arg);
     const size_t targ = wid->n_qubits; 
+    const size_t n_active = targ + 1;
+
+    // Extend the live region of the tableau to cover the new qubit
+    if (WIDGET_ENGINE_TABLEAU == wid->engine)
+    {
+        tableau_set_active_qubits(wid->tableau, n_active);
+    }
 
     wid->queue->non_cliffords[ctrl] = inst->tag;
     wid->q_map[inst->arg] = wid->n_qubits;
 
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[ctrl] & INSTRUCTION_OPERATOR_MASK](wid->tableau, ctrl);
-    wid->queue->table[ctrl] = _I_;
-
-    SINGLE_QUBIT_OPERATIONS[wid->queue->table[targ] & INSTRUCTION_OPERATOR_MASK](wid->tableau, targ);
-    wid->queue->table[targ] = _I_;
-
-    tableau_CNOT(wid->tableau, ctrl, targ);
+    instruction_t ctrl_flush;
+    instruction_t targ_flush;
+    __inline_clifford_queue_non_local_clifford(wid->queue, _CNOT_, ctrl, targ, &ctrl_flush, &targ_flush);
+    __inline_widget_fused_non_local_clifford(wid, _CNOT_, ctrl_flush, ctrl, targ_flush, targ);
 
     // Propagate tracked Pauli corrections 
-    pauli_track_z(wid->pauli_tracker, ctrl, targ);
+    WIDGET_STATS_TIME(wid, pauli_tracker_ns, pauli_track_z(wid->pauli_tracker, ctrl, targ));
 
     // Number of qubits increases by one
     wid->n_qubits += 1;  
@@ -108,6 +183,24 @@ void __inline_rz_gate(
     return;
 }
 
+/*
+ * swap_gate
+ * Implements a swap gate by exchanging the physical qubits behind two logical qubits
+ * :: wid : widget_t* :: The widget in question
+ * :: inst : two_qubit_instruction* :: The swap instruction
+ * The queue, tableau or graph and Pauli tracker are indexed by physical qubit and are left untouched
+ */
+static inline
+void __inline_swap_gate(
+    widget_t* wid,
+    struct two_qubit_instruction* inst)
+{
+    const size_t ctrl = WMAP_LOOKUP(wid, inst->ctrl);
+    wid->q_map[inst->ctrl] = WMAP_LOOKUP(wid, inst->targ);
+    wid->q_map[inst->targ] = ctrl;
+    return;
+}
+
 void (*conditional_instruction_switch[N_INSTRUCTION_TYPES])(widget_t*, size_t, size_t) = {
         conditional_I, // 0x00
         conditional_x, // 0x01
@@ -149,7 +242,7 @@ void (*instruction_switch[N_INSTRUCTION_TYPES])(widget_t*, void*) = {
         (void (*)(widget_t*, void*))NULL, // 0x00
         (void (*)(widget_t*, void*))__inline_local_clifford_gate, // 0x01
         (void (*)(widget_t*, void*))__inline_non_local_clifford_gate, // 0x02
-        (void (*)(widget_t*, void*))NULL, // 0x03
+        (void (*)(widget_t*, void*))__inline_swap_gate, // 0x03
         (void (*)(widget_t*, void*))__inline_rz_gate, // 0x04
         (void (*)(widget_t*, void*))NULL, // 0x05
         (void (*)(widget_t*, void*))__inline_conditional_instruction, // 0x06
@@ -169,13 +262,43 @@ void parse_instruction_block(
     instruction_stream_u* instructions,
     const size_t n_instructions)
 {
+    assert(NULL == wid->csr); // Finalised widgets hold no tableau or graph, see widget_finalise
+    WIDGET_STATS_START(start);
     #pragma GCC unroll 8
     for (size_t i = 0; i < n_instructions; i++)
     {
+        WIDGET_STATS_COUNT(wid, n_gates[INSTRUCTION_TYPE((instructions + i)->instruction)], 1);
         instruction_switch[
             INSTRUCTION_TYPE((instructions + i)->instruction) 
             ](wid, instructions + i);
     }
+    WIDGET_STATS_STOP(wid, ingestion_ns, start);
+    return;
+}
+
+/*
+ * widget_permute_qubits
+ * Permutes the logical qubits of the widget
+ * :: wid : widget_t* :: Current widget
+ * :: perm : const uint32_t* :: Permutation over the initial qubits, logical qubit i moves to perm[i]
+ * Acts on the qubit map only, the same as a sequence of swap gates
+ */
+void widget_permute_qubits(widget_t* wid, const uint32_t* perm)
+{
+    const size_t n_qubits = wid->n_initial_qubits;
+    qubit_map_t* q_map = (qubit_map_t*)malloc(n_qubits * sizeof(qubit_map_t));
+    memcpy(q_map, wid->q_map, n_qubits * sizeof(qubit_map_t));
+
+    // Every slot must be written exactly once
+    memset(wid->q_map, 0xff, n_qubits * sizeof(qubit_map_t));
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        assert(perm[i] < n_qubits);
+        assert(SIZE_MAX == wid->q_map[perm[i]]);
+        wid->q_map[perm[i]] = q_map[i];
+    }
+
+    free(q_map);
     return;
 }
 
@@ -190,27 +313,39 @@ void parse_instruction_block(
  */
 void teleport_input(widget_t* wid, size_t n_input_qubits)
 {
-    // Check that we have sufficient memory for this operation
-    assert(wid->max_qubits >= wid->n_initial_qubits + n_input_qubits);
+    widget_reserve(wid, wid->n_initial_qubits + n_input_qubits);
 
     // Double the number of initial qubits 
     wid->n_qubits += n_input_qubits;
+    if (WIDGET_ENGINE_TABLEAU == wid->engine)
+    {
+        tableau_set_active_qubits(wid->tableau, wid->n_qubits);
+    }
     
     // This could be replaced with a different tableau preparation step
     for (size_t i = 0; i < n_input_qubits; i++)
     {
-        tableau_H(wid->tableau, i);
-        tableau_H(wid->tableau, i + wid->n_initial_qubits);
+        if (WIDGET_ENGINE_GRAPH == wid->engine)
+        {
+            graph_state_local_clifford(wid->graph, _H_, i);
+            graph_state_local_clifford(wid->graph, _H_, i + wid->n_initial_qubits);
+            graph_state_CZ(wid->graph, i, wid->n_initial_qubits + i);
+        }
+        else
+        {
+            tableau_H(wid->tableau, i);
+            tableau_H(wid->tableau, i + wid->n_initial_qubits);
 
-        // Construct a Bell state
-        tableau_CZ(wid->tableau, i, wid->n_initial_qubits + i);
+            // Construct a Bell state
+            tableau_CZ(wid->tableau, i, wid->n_initial_qubits + i);
+        }
 
         // Fix up the map, we should now be indexing off the target qubit  
         wid->q_map[i] += wid->n_initial_qubits;      
         // TODO: Stop proxying the input qubits like this 
         // pauli_track_z(wid->pauli_tracker, i, wid->n_initial_qubits + i);
     
-        pauli_track_x(wid->pauli_tracker, i, wid->n_initial_qubits + i);
+        WIDGET_STATS_TIME(wid, pauli_tracker_ns, pauli_track_x(wid->pauli_tracker, i, wid->n_initial_qubits + i));
     }
 
     return;
@@ -0,0 +1,260 @@
+#include "input_stream_par.h"
+
+
+/*
+ * __inline_log_local_clifford
+ * Flushes the queued local Clifford on a qubit into the log
+ * :: wid : widget_t* :: The widget
+ * :: log : struct tableau_op_log_t* :: The tableau operation log
+ * :: targ : const size_t :: Physical qubit to flush
+ */
+static inline
+void __inline_log_local_clifford(
+    widget_t* wid,
+    struct tableau_op_log_t* log,
+    const size_t targ)
+{
+    // Identities are not replayed
+    if (_I_ != wid->queue->table[targ])
+    {
+        log->ops[log->n_ops].single.opcode = wid->queue->table[targ];
+        log->ops[log->n_ops].single.arg = targ;
+        log->n_ops++;
+    }
+    wid->queue->table[targ] = _I_;
+}
+
+
+/*
+ * __inline_log_non_local_clifford
+ * Appends a two qubit Clifford to the log, flushing queued local Cliffords that do not commute through it
+ * :: wid : widget_t* :: The widget
+ * :: log : struct tableau_op_log_t* :: The tableau operation log
+ * :: opcode : const instruction_t :: Two qubit opcode
+ * :: ctrl : const size_t :: Physical control qubit
+ * :: targ : const size_t :: Physical target qubit
+ */
+static inline
+void __inline_log_non_local_clifford(
+    widget_t* wid,
+    struct tableau_op_log_t* log,
+    const instruction_t opcode,
+    const size_t ctrl,
+    const size_t targ)
+{
+    instruction_t ctrl_flush;
+    instruction_t targ_flush;
+    __inline_clifford_queue_non_local_clifford(wid->queue, opcode, ctrl, targ, &ctrl_flush, &targ_flush);
+
+    log->ops[log->n_ops].fused.opcode = opcode;
+    log->ops[log->n_ops].fused.ctrl_clifford = ctrl_flush;
+    log->ops[log->n_ops].fused.targ_clifford = targ_flush;
+    log->ops[log->n_ops].fused.ctrl = ctrl;
+    log->ops[log->n_ops].fused.targ = targ;
+    log->n_ops++;
+}
+
+
+/*
+ * __inline_log_non_local_clifford_gate
+ * Bookkeeping half of a non-local Clifford gate
+ * :: wid : widget_t* :: The widget
+ * :: log : struct tableau_op_log_t* :: The tableau operation log
+ * :: inst : struct two_qubit_instruction* :: The two qubit operation
+ * Mirrors __inline_non_local_clifford_gate, with the tableau updates deferred to the log
+ */
+static inline
+void __inline_log_non_local_clifford_gate(
+    widget_t* wid,
+    struct tableau_op_log_t* log,
+    struct two_qubit_instruction* inst)
+{
+    const size_t ctrl = wid->q_map[inst->ctrl];
+    const size_t targ = wid->q_map[inst->targ];
+    wid->engine_stats.n_gates++;
+
+    __inline_log_non_local_clifford(wid, log, inst->opcode, ctrl, targ);
+
+    // Pauli Correction Tracking
+    WIDGET_STATS_TIME(wid, pauli_tracker_ns,
+        PAULI_TRACKER_NON_LOCAL(inst->opcode)(wid->pauli_tracker, ctrl, targ));
+}
+
+
+/*
+ * __inline_log_rz_gate
+ * Bookkeeping half of an rz gate
+ * :: wid : widget_t* :: The widget
+ * :: log : struct tableau_op_log_t* :: The tableau operation log
+ * :: inst : struct rz_instruction* :: The rz instruction
+ * Mirrors __inline_rz_gate, with the tableau updates deferred to the log
+ */
+static inline
+void __inline_log_rz_gate(
+    widget_t* wid,
+    struct tableau_op_log_t* log,
+    struct rz_instruction* inst)
+{
+    assert(wid->n_qubits < wid->max_qubits);
+
+    const size_t ctrl = WMAP_LOOKUP(wid, inst->arg);
+    const size_t targ = wid->n_qubits;
+    wid->engine_stats.n_gates++;
+
+    wid->queue->non_cliffords[ctrl] = inst->tag;
+    wid->q_map[inst->arg] = wid->n_qubits;
+
+    __inline_log_non_local_clifford(wid, log, _CNOT_, ctrl, targ);
+
+    // Propagate tracked Pauli corrections
+    WIDGET_STATS_TIME(wid, pauli_tracker_ns, pauli_track_z(wid->pauli_tracker, ctrl, targ));
+
+    wid->n_qubits += 1;
+}
+
+
+/*
+ * __inline_replay_stripe
+ * Replays a tableau operation log over one stripe of the tableau
+ * :: args : void* :: struct distributed_tableau_op* with the log as its args
+ */
+static inline
+void __inline_replay_stripe(void* args)
+{
+    struct distributed_tableau_op* op = (struct distributed_tableau_op*)args;
+    struct tableau_op_log_t* log = (struct tableau_op_log_t*)op->args;
+    tableau_t view = tableau_stripe_view(op->tab, op->start, op->stop);
+
+    for (size_t i = 0; i < log->n_ops; i++)
+    {
+        tableau_op_u* entry = log->ops + i;
+        if (LOCAL_CLIFFORD_MASK & entry->opcode)
+        {
+            SINGLE_QUBIT_OPERATIONS[entry->single.opcode & INSTRUCTION_OPERATOR_MASK](&view, entry->single.arg);
+        }
+        else
+        {
+            __inline_tableau_fused_non_local_clifford(
+                &view, entry->fused.opcode, entry->fused.ctrl_clifford, entry->fused.ctrl, entry->fused.targ_clifford, entry->fused.targ);
+        }
+    }
+}
+
+
+/*
+ * __inline_replay_log
+ * Replays a log over the live region of the tableau using the threadpool
+ * :: wid : widget_t* :: The widget
+ * :: log : struct tableau_op_log_t* :: The tableau operation log
+ */
+static inline
+void __inline_replay_log(widget_t* wid, struct tableau_op_log_t* log)
+{
+    if (0 == log->n_ops)
+    {
+        return;
+    }
+
+    // Gates act trivially on rows that have not yet been allocated,
+    // so every stripe can replay the block against its final width
+    if (wid->tableau->active_len < TABLEAU_ACTIVE_LEN_BYTES(wid->n_qubits))
+    {
+        tableau_set_active_qubits(wid->tableau, wid->n_qubits);
+    }
+    threadpool_distribute_tableau_operation_args(wid->tableau, __inline_replay_stripe, NULL_TARG, NULL_TARG, log);
+}
+
+
+/*
+ * parse_instruction_block_par
+ * Parses a block of instructions over the threadpool
+ * :: wid : widget_t* :: Current widget
+ * :: instructions : instruction_stream_u* :: Array of instructions
+ * :: n_instructions : const size_t :: Number of instructions in the stream
+ * The clifford queue, qubit map and Pauli tracker are updated once on the calling thread
+ * The resulting tableau operations are then replayed by each worker over its own byte stripe
+ * Falls back to parse_instruction_block if the pool is not running, the tableau is small or the widget uses the graph engine
+ */
+void parse_instruction_block_par(
+    widget_t* wid,
+    instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    assert(NULL == wid->csr); // Finalised widgets hold no tableau or graph, see widget_finalise
+    WIDGET_STATS_START(start);
+    size_t n_rz = 0;
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        n_rz += (INSTRUCTION_TYPE(RZ_MASK) == INSTRUCTION_TYPE((instructions + i)->instruction));
+    }
+
+    // Grow once up front, logged operations hold no pointers into the tableau but the replay needs the final width
+    widget_reserve(wid, wid->n_qubits + n_rz);
+
+    const size_t final_len = TABLEAU_ACTIVE_LEN_BYTES(wid->n_qubits + n_rz);
+    if (WIDGET_ENGINE_GRAPH == wid->engine || 1 == threadpool_n_workers() || final_len < INPUT_STREAM_PAR_MIN_BYTES)
+    {
+        // The serial parser times itself
+        WIDGET_STATS_STOP(wid, ingestion_ns, start);
+        parse_instruction_block(wid, instructions, n_instructions);
+        return;
+    }
+
+    // Each instruction emits at most one tableau operation
+    struct tableau_op_log_t log;
+    log.n_ops = 0;
+    log.ops = (tableau_op_u*)malloc(n_instructions * sizeof(tableau_op_u));
+
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        instruction_stream_u* inst = instructions + i;
+        WIDGET_STATS_COUNT(wid, n_gates[INSTRUCTION_TYPE(inst->instruction)], 1);
+        switch (INSTRUCTION_TYPE(inst->instruction))
+        {
+            case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+                __inline_log_non_local_clifford_gate(wid, &log, &inst->multi);
+                break;
+            case INSTRUCTION_TYPE(RZ_MASK):
+                __inline_log_rz_gate(wid, &log, &inst->rz);
+                break;
+            default:
+                // Local Cliffords and conditional operations do not touch the tableau
+                instruction_switch[INSTRUCTION_TYPE(inst->instruction)](wid, inst);
+        }
+    }
+
+    __inline_replay_log(wid, &log);
+    free(log.ops);
+    WIDGET_STATS_STOP(wid, ingestion_ns, start);
+}
+
+
+/*
+ * apply_local_cliffords_par
+ * Empties the local clifford table and applies the local cliffords over the threadpool
+ * :: wid : widget_t* :: The widget
+ * Acts in place over the tableau and the clifford table
+ */
+void apply_local_cliffords_par(widget_t* wid)
+{
+    assert(NULL == wid->csr); // Finalised widgets hold no tableau or graph, see widget_finalise
+    if (WIDGET_ENGINE_GRAPH == wid->engine || 1 == threadpool_n_workers() || wid->tableau->active_len < INPUT_STREAM_PAR_MIN_BYTES)
+    {
+        apply_local_cliffords(wid);
+        return;
+    }
+
+    WIDGET_STATS_START(start);
+    struct tableau_op_log_t log;
+    log.n_ops = 0;
+    log.ops = (tableau_op_u*)malloc(wid->n_qubits * sizeof(tableau_op_u));
+
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        __inline_log_local_clifford(wid, &log, i);
+    }
+
+    __inline_replay_log(wid, &log);
+    free(log.ops);
+    WIDGET_STATS_STOP(wid, queue_flush_ns, start);
+}
@@ -0,0 +1,681 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "instruction_file.h"
+
+/*
+ * __inline_instruction_file_is_rz
+ * Whether an opcode is an rz gate
+ */
+static inline
+bool __inline_instruction_file_is_rz(const instruction_t opcode)
+{
+    return INSTRUCTION_TYPE(RZ_MASK) == INSTRUCTION_TYPE(opcode);
+}
+
+/*
+ * __inline_instruction_file_valid_opcode
+ * Whether an opcode names an instruction the parsers implement
+ */
+static inline
+bool __inline_instruction_file_valid_opcode(const instruction_t opcode)
+{
+    const instruction_t op = opcode & INSTRUCTION_OP_MASK;
+    switch (INSTRUCTION_TYPE(opcode))
+    {
+        case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            return op < N_LOCAL_CLIFFORDS;
+        case INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK):
+            return op < N_NON_LOCAL_CLIFFORDS;
+        case INSTRUCTION_TYPE(QUBIT_MAP_MASK):
+            return _SWAP_ == opcode;
+        case INSTRUCTION_TYPE(RZ_MASK):
+            return _RZ_ == opcode;
+        case INSTRUCTION_TYPE(MEASUREMENT_CONDITIONED_MASK):
+            return opcode <= _MCZ_;
+        default:
+            return false;
+    }
+}
+
+/*
+ * __inline_instruction_file_get_operand
+ * Reads one uint32 operand
+ * :: src : const uint8_t** :: Cursor
+ * :: end : const uint8_t* :: End of the block
+ * :: dst : uint32_t* :: Operand
+ * Returns false if the varint is truncated or out of range
+ */
+static inline
+bool __inline_instruction_file_get_operand(const uint8_t** src, const uint8_t* end, uint32_t* dst)
+{
+    uint64_t val;
+    if (!__inline_binary_read_varint(src, end, &val) || val > UINT32_MAX)
+    {
+        return false;
+    }
+    *dst = (uint32_t)val;
+    return true;
+}
+
+/*
+ * __inline_instruction_file_encode
+ * Packs one instruction as its opcode then its operands as varints
+ * :: dst : uint8_t* :: Destination, at least INSTRUCTION_FILE_ENCODED_MAX bytes
+ * :: inst : const instruction_stream_u* :: Instruction
+ * Returns the number of bytes written
+ */
+static inline
+size_t __inline_instruction_file_encode(uint8_t* dst, const instruction_stream_u* inst)
+{
+    size_t len = 0;
+    dst[len++] = inst->instruction;
+    switch (INSTRUCTION_TYPE(inst->instruction))
+    {
+        case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            len += __inline_binary_put_varint(dst + len, inst->single.arg);
+            break;
+        case INSTRUCTION_TYPE(RZ_MASK):
+            len += __inline_binary_put_varint(dst + len, inst->rz.arg);
+            len += __inline_binary_put_varint(dst + len, inst->rz.tag);
+            break;
+        default:
+            len += __inline_binary_put_varint(dst + len, inst->multi.ctrl);
+            len += __inline_binary_put_varint(dst + len, inst->multi.targ);
+            break;
+    }
+    return len;
+}
+
+/*
+ * __inline_instruction_file_decode
+ * Inverse of __inline_instruction_file_encode, advances the cursor
+ * :: dst : instruction_stream_u* :: Decoded instruction
+ * :: src : const uint8_t** :: Cursor
+ * :: end : const uint8_t* :: End of the block
+ * Returns false if the opcode is unknown or an operand is truncated or out of range
+ */
+static inline
+bool __inline_instruction_file_decode(instruction_stream_u* dst, const uint8_t** src, const uint8_t* end)
+{
+    if (*src == end)
+    {
+        return false;
+    }
+    const instruction_t opcode = *((*src)++);
+    if (!__inline_instruction_file_valid_opcode(opcode))
+    {
+        return false;
+    }
+
+    memset(dst, 0, sizeof(instruction_stream_u));
+    switch (INSTRUCTION_TYPE(opcode))
+    {
+        case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            dst->single.opcode = opcode;
+            return __inline_instruction_file_get_operand(src, end, &dst->single.arg);
+        case INSTRUCTION_TYPE(RZ_MASK):
+            dst->rz.opcode = opcode;
+            return __inline_instruction_file_get_operand(src, end, &dst->rz.arg)
+                && __inline_instruction_file_get_operand(src, end, &dst->rz.tag);
+        default:
+            dst->multi.opcode = opcode;
+            return __inline_instruction_file_get_operand(src, end, &dst->multi.ctrl)
+                && __inline_instruction_file_get_operand(src, end, &dst->multi.targ);
+    }
+}
+
+/*
+ * __inline_instruction_file_in_width
+ * Whether every qubit operand of a decoded block is below a width
+ * :: instructions : const instruction_stream_u* :: Decoded instructions
+ * :: n_instructions : const size_t :: Number of instructions
+ * :: width : const size_t :: Number of logical qubits
+ */
+static inline
+bool __inline_instruction_file_in_width(
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const size_t width)
+{
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        const instruction_stream_u* inst = instructions + i;
+        switch (INSTRUCTION_TYPE(inst->instruction))
+        {
+            case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+                if (inst->single.arg >= width)
+                {
+                    return false;
+                }
+                break;
+            case INSTRUCTION_TYPE(RZ_MASK):
+                if (inst->rz.arg >= width)
+                {
+                    return false;
+                }
+                break;
+            default:
+                if (inst->multi.ctrl >= width || inst->multi.targ >= width)
+                {
+                    return false;
+                }
+                break;
+        }
+    }
+    return true;
+}
+
+/*
+ * __inline_instruction_file_flush
+ * Writes the current block and adds it to the index
+ */
+static inline
+void __inline_instruction_file_flush(instruction_file_writer_t* writer)
+{
+    if (0 == writer->current.n_instructions)
+    {
+        return;
+    }
+
+    writer->failed = writer->failed || !__inline_binary_write_all(writer->fd, writer->buffer, writer->buffer_len);
+    if (writer->n_blocks == writer->capacity)
+    {
+        writer->capacity *= 2;
+        writer->blocks = (instruction_file_block_t*)realloc(writer->blocks, writer->capacity * sizeof(instruction_file_block_t));
+        assert(NULL != writer->blocks);
+    }
+    writer->current.offset = writer->n_bytes;
+    writer->current.len = writer->buffer_len;
+    writer->blocks[writer->n_blocks++] = writer->current;
+
+    writer->n_bytes += writer->buffer_len;
+    writer->buffer_len = 0;
+    writer->current.n_instructions = 0;
+    writer->current.n_rz = 0;
+}
+
+/*
+ * instruction_file_writer_open
+ * Starts an instruction file on a file descriptor and writes its header
+ * :: fd : const int :: Open, writable file descriptor, not closed by the writer
+ * :: block_size : const size_t :: Instructions per block, 0 for INSTRUCTION_FILE_DEFAULT_BLOCK
+ * Returns NULL if the header cannot be written
+ */
+instruction_file_writer_t* instruction_file_writer_open(const int fd, const size_t block_size)
+{
+    instruction_file_writer_t* writer = (instruction_file_writer_t*)calloc(1, sizeof(instruction_file_writer_t));
+    assert(NULL != writer);
+    writer->fd = fd;
+    writer->block_size = (0 == block_size) ? INSTRUCTION_FILE_DEFAULT_BLOCK : block_size;
+    writer->buffer = (uint8_t*)malloc(writer->block_size * INSTRUCTION_FILE_ENCODED_MAX);
+    assert(NULL != writer->buffer);
+    writer->capacity = 16;
+    writer->blocks = (instruction_file_block_t*)malloc(writer->capacity * sizeof(instruction_file_block_t));
+    assert(NULL != writer->blocks);
+
+    uint8_t header[INSTRUCTION_FILE_HEADER_LEN];
+    const uint32_t version = INSTRUCTION_FILE_VERSION;
+    memcpy(header, INSTRUCTION_FILE_MAGIC, INSTRUCTION_FILE_MAGIC_LEN);
+    memcpy(header + INSTRUCTION_FILE_MAGIC_LEN, &version, sizeof(uint32_t));
+    if (!__inline_binary_write_all(fd, header, INSTRUCTION_FILE_HEADER_LEN))
+    {
+        free(writer->buffer);
+        free(writer->blocks);
+        free(writer);
+        return NULL;
+    }
+    writer->n_bytes = INSTRUCTION_FILE_HEADER_LEN;
+    return writer;
+}
+
+/*
+ * instruction_file_write
+ * Appends instructions to the file
+ * :: writer : instruction_file_writer_t* :: Writer
+ * :: instructions : const instruction_stream_u* :: Instructions
+ * :: n_instructions : const size_t :: Number of instructions
+ */
+void instruction_file_write(
+    instruction_file_writer_t* writer,
+    const instruction_stream_u* instructions,
+    const size_t n_instructions)
+{
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        writer->buffer_len += __inline_instruction_file_encode(writer->buffer + writer->buffer_len, instructions + i);
+        writer->current.n_rz += __inline_instruction_file_is_rz(instructions[i].instruction);
+        writer->current.n_instructions++;
+        if (writer->current.n_instructions == writer->block_size)
+        {
+            __inline_instruction_file_flush(writer);
+        }
+    }
+}
+
+/*
+ * instruction_file_writer_close
+ * Writes the last block, the index and the trailer then frees the writer
+ * :: writer : instruction_file_writer_t* :: Writer
+ * Returns the size of the file in bytes, 0 if any write failed, the file descriptor stays open
+ */
+size_t instruction_file_writer_close(instruction_file_writer_t* writer)
+{
+    __inline_instruction_file_flush(writer);
+
+    const uint64_t index_offset = writer->n_bytes;
+    for (size_t i = 0; i < writer->n_blocks; i++)
+    {
+        const uint64_t entry[4] = {
+            writer->blocks[i].offset,
+            writer->blocks[i].len,
+            writer->blocks[i].n_instructions,
+            writer->blocks[i].n_rz};
+        writer->failed = writer->failed || !__inline_binary_write_all(writer->fd, (const uint8_t*)entry, INSTRUCTION_FILE_INDEX_ENTRY_LEN);
+    }
+    writer->n_bytes += writer->n_blocks * INSTRUCTION_FILE_INDEX_ENTRY_LEN;
+
+    uint8_t trailer[INSTRUCTION_FILE_TRAILER_LEN];
+    const uint64_t n_blocks = writer->n_blocks;
+    memcpy(trailer, &n_blocks, sizeof(uint64_t));
+    memcpy(trailer + sizeof(uint64_t), &index_offset, sizeof(uint64_t));
+    memcpy(trailer + 2 * sizeof(uint64_t), INSTRUCTION_FILE_MAGIC, INSTRUCTION_FILE_MAGIC_LEN);
+    writer->failed = writer->failed || !__inline_binary_write_all(writer->fd, trailer, INSTRUCTION_FILE_TRAILER_LEN);
+    writer->n_bytes += INSTRUCTION_FILE_TRAILER_LEN;
+
+    const size_t n_bytes = writer->failed ? 0 : writer->n_bytes;
+    free(writer->buffer);
+    free(writer->blocks);
+    free(writer);
+    return n_bytes;
+}
+
+/*
+ * instruction_file_reader_open
+ * Maps an instruction file read only and reads its index
+ * :: path : const char* :: Path to the file
+ * Returns NULL if the file cannot be mapped, is not of this version or was not closed
+ */
+instruction_file_reader_t* instruction_file_reader_open(const char* path)
+{
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    struct stat st;
+    if (0 != fstat(fd, &st) || (size_t)st.st_size < INSTRUCTION_FILE_HEADER_LEN + INSTRUCTION_FILE_TRAILER_LEN)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    const size_t len = st.st_size;
+    const uint8_t* map = (const uint8_t*)mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map)
+    {
+        return NULL;
+    }
+
+    uint32_t version;
+    uint64_t n_blocks;
+    uint64_t index_offset;
+    const uint8_t* trailer = map + len - INSTRUCTION_FILE_TRAILER_LEN;
+    memcpy(&version, map + INSTRUCTION_FILE_MAGIC_LEN, sizeof(uint32_t));
+    memcpy(&n_blocks, trailer, sizeof(uint64_t));
+    memcpy(&index_offset, trailer + sizeof(uint64_t), sizeof(uint64_t));
+
+    const size_t index_end = len - INSTRUCTION_FILE_TRAILER_LEN;
+    bool valid = (0 == memcmp(map, INSTRUCTION_FILE_MAGIC, INSTRUCTION_FILE_MAGIC_LEN))
+        && (0 == memcmp(trailer + 2 * sizeof(uint64_t), INSTRUCTION_FILE_MAGIC, INSTRUCTION_FILE_MAGIC_LEN))
+        && (INSTRUCTION_FILE_VERSION == version)
+        && (index_offset >= INSTRUCTION_FILE_HEADER_LEN)
+        && (index_offset <= index_end)
+        && (n_blocks == (index_end - index_offset) / INSTRUCTION_FILE_INDEX_ENTRY_LEN)
+        && (0 == (index_end - index_offset) % INSTRUCTION_FILE_INDEX_ENTRY_LEN);
+    if (!valid)
+    {
+        munmap((void*)map, len);
+        return NULL;
+    }
+
+    instruction_file_block_t* blocks = (instruction_file_block_t*)malloc((n_blocks + 1) * sizeof(instruction_file_block_t));
+    assert(NULL != blocks);
+    size_t n_instructions = 0;
+    size_t n_rz = 0;
+    size_t max_block = 0;
+    size_t pos = INSTRUCTION_FILE_HEADER_LEN;
+    for (size_t i = 0; valid && i < n_blocks; i++)
+    {
+        uint64_t entry[4];
+        memcpy(entry, map + index_offset + i * INSTRUCTION_FILE_INDEX_ENTRY_LEN, INSTRUCTION_FILE_INDEX_ENTRY_LEN);
+        blocks[i].offset = entry[0];
+        blocks[i].len = entry[1];
+        blocks[i].n_instructions = entry[2];
+        blocks[i].n_rz = entry[3];
+
+        // Blocks are contiguous and each instruction takes between two and INSTRUCTION_FILE_ENCODED_MAX bytes
+        valid = (blocks[i].offset == pos)
+            && (blocks[i].len <= index_offset - pos)
+            && (blocks[i].n_instructions > 0)
+            && (blocks[i].len >= 2 * blocks[i].n_instructions)
+            && (blocks[i].len <= INSTRUCTION_FILE_ENCODED_MAX * blocks[i].n_instructions)
+            && (blocks[i].n_rz <= blocks[i].n_instructions);
+        pos += blocks[i].len;
+        n_instructions += blocks[i].n_instructions;
+        n_rz += blocks[i].n_rz;
+        max_block = (blocks[i].n_instructions > max_block) ? blocks[i].n_instructions : max_block;
+    }
+    if (!valid || pos != index_offset)
+    {
+        munmap((void*)map, len);
+        free(blocks);
+        return NULL;
+    }
+
+    // Blocks are read front to back and dropped once decoded
+    madvise((void*)map, len, MADV_SEQUENTIAL);
+
+    instruction_file_reader_t* reader = (instruction_file_reader_t*)malloc(sizeof(instruction_file_reader_t));
+    assert(NULL != reader);
+    reader->map = map;
+    reader->len = len;
+    reader->n_blocks = n_blocks;
+    reader->n_instructions = n_instructions;
+    reader->n_rz = n_rz;
+    reader->max_block = max_block;
+    reader->blocks = blocks;
+    return reader;
+}
+
+/*
+ * instruction_file_reader_close
+ * Unmaps the file
+ * :: reader : instruction_file_reader_t* :: Reader
+ */
+void instruction_file_reader_close(instruction_file_reader_t* reader)
+{
+    munmap((void*)reader->map, reader->len);
+    free(reader->blocks);
+    free(reader);
+}
+
+/*
+ * instruction_file_n_instructions
+ * Number of instructions in the file
+ * :: reader : const instruction_file_reader_t* :: Reader
+ */
+size_t instruction_file_n_instructions(const instruction_file_reader_t* reader)
+{
+    return reader->n_instructions;
+}
+
+/*
+ * instruction_file_read_block
+ * Decodes one block
+ * :: reader : const instruction_file_reader_t* :: Reader
+ * :: idx : const size_t :: Block index
+ * :: dst : instruction_stream_u* :: At least the block's instruction count, max_block always suffices
+ * Returns the number of instructions decoded, 0 if the block is corrupt as blocks are never empty
+ */
+size_t instruction_file_read_block(const instruction_file_reader_t* reader, const size_t idx, instruction_stream_u* dst)
+{
+    assert(idx < reader->n_blocks);
+    const instruction_file_block_t* block = reader->blocks + idx;
+    const uint8_t* src = reader->map + block->offset;
+    const uint8_t* end = src + block->len;
+    size_t n_rz = 0;
+    for (size_t i = 0; i < block->n_instructions; i++)
+    {
+        if (!__inline_instruction_file_decode(dst + i, &src, end))
+        {
+            return 0;
+        }
+        n_rz += __inline_instruction_file_is_rz(dst[i].instruction);
+    }
+    if (src != end || n_rz != block->n_rz)
+    {
+        return 0;
+    }
+
+    // Drop the pages that only this block touches, the mapping refaults them if the block is read again
+    const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t start = (block->offset + page - 1) & ~(page - 1);
+    const size_t stop = (block->offset + block->len) & ~(page - 1);
+    if (stop > start)
+    {
+        madvise((void*)(reader->map + start), stop - start, MADV_DONTNEED);
+    }
+    return block->n_instructions;
+}
+
+/*
+ * instruction_file_read
+ * Decodes the whole file
+ * :: reader : const instruction_file_reader_t* :: Reader
+ * :: dst : instruction_stream_u* :: instruction_file_n_instructions entries
+ * Returns false if a block is corrupt, blocks before it are decoded
+ */
+bool instruction_file_read(const instruction_file_reader_t* reader, instruction_stream_u* dst)
+{
+    for (size_t i = 0; i < reader->n_blocks; i++)
+    {
+        const size_t n_instructions = instruction_file_read_block(reader, i, dst);
+        if (0 == n_instructions)
+        {
+            return false;
+        }
+        dst += n_instructions;
+    }
+    return true;
+}
+
+/*
+ * instruction_file_parse
+ * Parses every instruction of the file into a widget, one block at a time
+ * :: reader : const instruction_file_reader_t* :: Reader
+ * :: wid : widget_t* :: Widget
+ * :: parse : parser :: parse_instruction_block or parse_instruction_block_par
+ * Returns false if a block is corrupt or addresses a qubit past the widget's initial qubits
+ * Blocks before it have been parsed
+ */
+bool instruction_file_parse(
+    const instruction_file_reader_t* reader,
+    widget_t* wid,
+    void (*parse)(widget_t*, instruction_stream_u*, const size_t))
+{
+    instruction_stream_u* buffer = (instruction_stream_u*)malloc((reader->max_block + 1) * sizeof(instruction_stream_u));
+    assert(NULL != buffer);
+    bool valid = true;
+    for (size_t i = 0; valid && i < reader->n_blocks; i++)
+    {
+        const size_t n_instructions = instruction_file_read_block(reader, i, buffer);
+        valid = (n_instructions > 0) && __inline_instruction_file_in_width(buffer, n_instructions, wid->n_initial_qubits);
+        if (valid)
+        {
+            parse(wid, buffer, n_instructions);
+        }
+    }
+    free(buffer);
+    return valid;
+}
+
+/*
+ * instruction_file_sequence_create
+ * Constructor for a widget sequence over a file
+ * :: reader : const instruction_file_reader_t* :: Reader, not copied
+ * :: qubit_width : const size_t :: Initial qubits of each widget
+ * :: max_qubits : const size_t :: Qubits per widget, the rz budget is what remains after the inputs are teleported
+ * :: teleport_input : const bool :: Whether each widget teleports its inputs
+ */
+instruction_file_sequence_t* instruction_file_sequence_create(
+    const instruction_file_reader_t* reader,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const bool teleport_input)
+{
+    // Teleported inputs take a second register of qubit_width
+    const size_t reserved = (1 + teleport_input) * qubit_width;
+    assert(max_qubits > reserved);
+
+    instruction_file_sequence_t* seq = (instruction_file_sequence_t*)malloc(sizeof(instruction_file_sequence_t));
+    assert(NULL != seq);
+    seq->reader = reader;
+    seq->buffer = (instruction_stream_u*)malloc((reader->max_block + 1) * sizeof(instruction_stream_u));
+    assert(NULL != seq->buffer);
+    seq->n_decoded = 0;
+    seq->position = 0;
+    seq->next_block = 0;
+    seq->qubit_width = qubit_width;
+    seq->max_qubits = max_qubits;
+    seq->rz_budget = max_qubits - reserved;
+    seq->teleport_input = teleport_input;
+    seq->n_widgets = 0;
+    seq->failed = false;
+    return seq;
+}
+
+/*
+ * instruction_file_sequence_destroy
+ * Destructor for a widget sequence over a file
+ * :: seq : instruction_file_sequence_t* :: Sequence to free, the reader is left alone
+ */
+void instruction_file_sequence_destroy(instruction_file_sequence_t* seq)
+{
+    free(seq->buffer);
+    free(seq);
+}
+
+/*
+ * instruction_file_sequence_done
+ * Whether every widget of the sequence has been filled, or the sequence failed
+ * :: seq : const instruction_file_sequence_t* :: Sequence
+ */
+bool instruction_file_sequence_done(const instruction_file_sequence_t* seq)
+{
+    // An empty file still produces one widget, as widget_sequence_t does for an empty stream
+    return seq->failed
+        || (seq->position >= seq->n_decoded
+            && seq->next_block == seq->reader->n_blocks
+            && seq->n_widgets > 0);
+}
+
+/*
+ * instruction_file_sequence_failed
+ * Whether the sequence stopped at a corrupt block or at an instruction outside qubit_width
+ * :: seq : const instruction_file_sequence_t* :: Sequence
+ */
+bool instruction_file_sequence_failed(const instruction_file_sequence_t* seq)
+{
+    return seq->failed;
+}
+
+/*
+ * instruction_file_sequence_fill
+ * Parses the next widget of the file without decomposing it
+ * :: seq : instruction_file_sequence_t* :: Sequence, must not be done
+ * :: wid : widget_t* :: Widget to reset and reuse, NULL to allocate a new one
+ * :: parse : parser :: parse_instruction_block or parse_instruction_block_par
+ * Returns the filled widget, or NULL if the sequence failed
+ * On failure a widget passed in stays with the caller and one allocated here is freed
+ */
+widget_t* instruction_file_sequence_fill(
+    instruction_file_sequence_t* seq,
+    widget_t* wid,
+    void (*parse)(widget_t*, instruction_stream_u*, const size_t))
+{
+    assert(!instruction_file_sequence_done(seq));
+
+    const bool allocated = (NULL == wid);
+    if (allocated)
+    {
+        wid = widget_create(seq->qubit_width, seq->max_qubits);
+    }
+    else
+    {
+        widget_reset(wid, seq->qubit_width);
+    }
+    if (seq->teleport_input)
+    {
+        teleport_input(wid, seq->qubit_width);
+    }
+
+    // A widget may span blocks, it closes at the rz that would exceed its budget
+    size_t remaining = seq->rz_budget;
+    while (true)
+    {
+        if (seq->position == seq->n_decoded)
+        {
+            if (seq->next_block == seq->reader->n_blocks)
+            {
+                break;
+            }
+            seq->n_decoded = instruction_file_read_block(seq->reader, seq->next_block, seq->buffer);
+            seq->next_block++;
+            seq->position = 0;
+            // Whole blocks are checked before any of their instructions reach the parser
+            if (0 == seq->n_decoded || !__inline_instruction_file_in_width(seq->buffer, seq->n_decoded, seq->qubit_width))
+            {
+                seq->failed = true;
+                seq->n_decoded = 0;
+                if (allocated)
+                {
+                    widget_destroy(wid);
+                }
+                return NULL;
+            }
+        }
+
+        size_t stop = seq->position;
+        while (stop < seq->n_decoded)
+        {
+            if (__inline_instruction_file_is_rz(seq->buffer[stop].instruction))
+            {
+                if (0 == remaining)
+                {
+                    break;
+                }
+                remaining--;
+            }
+            stop++;
+        }
+
+        if (stop > seq->position)
+        {
+            parse(wid, seq->buffer + seq->position, stop - seq->position);
+        }
+        seq->position = stop;
+        if (stop < seq->n_decoded)
+        {
+            break;
+        }
+    }
+
+    seq->n_widgets++;
+    return wid;
+}
+
+/*
+ * instruction_file_sequence_next
+ * Builds and decomposes the next widget of the file
+ * :: seq : instruction_file_sequence_t* :: Sequence
+ * :: wid : widget_t* :: Widget from an earlier call to reset and reuse, NULL to allocate a new one
+ * Returns the decomposed widget, owned by the caller, or NULL once the file is consumed or the sequence failed
+ */
+widget_t* instruction_file_sequence_next(instruction_file_sequence_t* seq, widget_t* wid)
+{
+    if (instruction_file_sequence_done(seq))
+    {
+        return NULL;
+    }
+
+    wid = instruction_file_sequence_fill(seq, wid, parse_instruction_block_par);
+    if (NULL != wid)
+    {
+        widget_decompose(wid);
+    }
+    return wid;
+}
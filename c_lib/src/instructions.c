@@ -47,6 +47,50 @@ void clifford_queue_destroy(clifford_queue_t* que)
 }
 
 
+/*
+ * clifford_queue_reset
+ * Returns every qubit of an instruction queue to the identity
+ * :: que : clifford_queue_t* :: Instruction queue
+ * Decomposition writes to qubits that were never allocated, so the whole queue is cleared
+ */
+void clifford_queue_reset(clifford_queue_t* que)
+{
+    memset(que->table, _I_, que->n_qubits);
+    memset(que->non_cliffords, 0, que->n_qubits * sizeof(non_clifford_tag_t));
+}
+
+/*
+ * clifford_queue_grow
+ * Extends an instruction queue
+ * :: que : clifford_queue_t* :: Instruction queue
+ * :: n_qubits : const size_t :: New number of qubits supported by the queue
+ * New qubits start with an identity and no terminating non-clifford
+ */
+void clifford_queue_grow(clifford_queue_t* que, const size_t n_qubits)
+{
+    assert(n_qubits >= que->n_qubits);
+
+    // realloc does not keep the alignment
+    void* instructions = NULL;
+    int err_code = posix_memalign(&instructions, CACHE_SIZE, n_qubits);
+    assert(0 == err_code);
+    memcpy(instructions, que->table, que->n_qubits);
+    memset((uint8_t*)instructions + que->n_qubits, _I_, n_qubits - que->n_qubits);
+
+    non_clifford_tag_t* non_cliffords = NULL;
+    err_code = posix_memalign((void**)&non_cliffords, CACHE_SIZE, n_qubits * sizeof(non_clifford_tag_t));
+    assert(0 == err_code);
+    memcpy(non_cliffords, que->non_cliffords, que->n_qubits * sizeof(non_clifford_tag_t));
+    memset(non_cliffords + que->n_qubits, 0, (n_qubits - que->n_qubits) * sizeof(non_clifford_tag_t));
+
+    free(que->table);
+    free(que->non_cliffords);
+    que->table = (instruction_t*)instructions;
+    que->non_cliffords = non_cliffords;
+    que->n_qubits = n_qubits;
+}
+
+
 /*
  * clifford_queue_local_clifford_right 
  * Applies clifford operator from the right of the expression  
@@ -25,6 +25,29 @@ void pauli_tracker_destroy(void* tracker)
     lib_pauli_tracker_destroy(tracker);
 }
 
+/*
+ * pauli_tracker_clear
+ * Empties the tracker for reuse
+ * :: tracker : void* :: Opaque pointer to rust tracker object
+ * :: n_qubits : size_t :: Number of qubits in the cleared tracker
+ */
+void pauli_tracker_clear(void* tracker, size_t n_qubits)
+{
+    lib_pauli_tracker_clear(tracker, n_qubits);
+}
+
+/*
+ * pauli_tracker_grow
+ * Adds qubits to the tracker
+ * :: tracker : void* :: Opaque pointer to rust tracker object
+ * :: n_qubits : size_t :: Current number of qubits in the tracker
+ * :: new_qubits : size_t :: Number of qubits after growing
+ */
+void pauli_tracker_grow(void* tracker, size_t n_qubits, size_t new_qubits)
+{
+    lib_pauli_tracker_new_qubits(tracker, n_qubits, new_qubits);
+}
+
 /*
  * pauli_track_x
  * :: tracker : void* :: Opaque pointer to rust tracker object
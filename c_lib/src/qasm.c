@@ -0,0 +1,806 @@
+#include <ctype.h>
+#include <errno.h>
+#include <float.h>
+#include <math.h>
+
+#include "qasm.h"
+
+#define QASM_STATEMENT_INITIAL_CAP (256)
+
+/*
+ * qasm_gate_t
+ * Entry of the gate table
+ */
+struct qasm_gate_t
+{
+    const char* name;
+    instruction_t opcode;
+    size_t n_operands;
+    bool parameterised; // Takes an angle
+    double angle; // Fixed angle of rz gates that are not parameterised
+};
+typedef struct qasm_gate_t qasm_gate_t;
+
+static const qasm_gate_t QASM_GATES[] = {
+    {"id", _I_, 1, false, 0},
+    {"x", _X_, 1, false, 0},
+    {"y", _Y_, 1, false, 0},
+    {"z", _Z_, 1, false, 0},
+    {"h", _H_, 1, false, 0},
+    {"s", _S_, 1, false, 0},
+    {"sdg", _R_, 1, false, 0},
+    {"t", _RZ_, 1, false, M_PI / 4},
+    {"tdg", _RZ_, 1, false, -M_PI / 4},
+    {"rz", _RZ_, 1, true, 0},
+    {"cx", _CNOT_, 2, false, 0},
+    {"CX", _CNOT_, 2, false, 0},
+    {"cz", _CZ_, 2, false, 0},
+    {"swap", _SWAP_, 2, false, 0},
+};
+#define QASM_N_GATES (sizeof(QASM_GATES) / sizeof(qasm_gate_t))
+
+/*
+ * __inline_qasm_fail
+ * Records a parse error, the first error is kept
+ */
+static inline
+void __inline_qasm_fail(qasm_parser_t* parser, const char* error)
+{
+    if (NULL == parser->error)
+    {
+        parser->error = error;
+    }
+    parser->n_pending = 0;
+}
+
+/*
+ * __inline_qasm_skip_space
+ * Advances a cursor past whitespace
+ */
+static inline
+const char* __inline_qasm_skip_space(const char* c)
+{
+    while (isspace((unsigned char)*c))
+    {
+        c++;
+    }
+    return c;
+}
+
+/*
+ * __inline_qasm_identifier
+ * Length of the identifier at the cursor, 0 if there is none
+ */
+static inline
+size_t __inline_qasm_identifier(const char* c)
+{
+    if (!(isalpha((unsigned char)*c) || '_' == *c))
+    {
+        return 0;
+    }
+    size_t len = 1;
+    while (isalnum((unsigned char)c[len]) || '_' == c[len])
+    {
+        len++;
+    }
+    return len;
+}
+
+/*
+ * __inline_qasm_keyword
+ * Whether the identifier at the cursor is the given keyword
+ */
+static inline
+bool __inline_qasm_keyword(const char* c, const size_t len, const char* keyword)
+{
+    return strlen(keyword) == len && 0 == strncmp(c, keyword, len);
+}
+
+/*
+ * __inline_qasm_push
+ * Appends a character to the current statement
+ */
+static inline
+void __inline_qasm_push(qasm_parser_t* parser, const char c)
+{
+    if (parser->statement_len + 1 >= parser->statement_cap)
+    {
+        parser->statement_cap *= 2;
+        parser->statement = (char*)realloc(parser->statement, parser->statement_cap);
+        assert(NULL != parser->statement);
+    }
+    parser->statement[parser->statement_len++] = c;
+}
+
+/*
+ * __inline_qasm_next_statement
+ * Reads up to the next semicolon, dropping comments
+ * :: parser : qasm_parser_t* :: Parser
+ * Returns false once the stream is consumed
+ */
+static inline
+bool __inline_qasm_next_statement(qasm_parser_t* parser)
+{
+    parser->statement_len = 0;
+    bool started = false;
+    int c;
+    while (EOF != (c = getc(parser->stream)))
+    {
+        if ('\n' == c)
+        {
+            parser->next_line++;
+        }
+        if ('/' == c)
+        {
+            const int next = getc(parser->stream);
+            if ('/' == next)
+            {
+                while (EOF != (c = getc(parser->stream)) && '\n' != c);
+                if ('\n' == c)
+                {
+                    parser->next_line++;
+                }
+                c = ' ';
+            }
+            else if (EOF != next)
+            {
+                ungetc(next, parser->stream);
+            }
+        }
+        if (';' == c)
+        {
+            parser->statement[parser->statement_len] = '\0';
+            return true;
+        }
+        if (!started && !isspace(c))
+        {
+            started = true;
+            parser->line = parser->next_line;
+        }
+        if (started)
+        {
+            __inline_qasm_push(parser, (char)c);
+        }
+    }
+    if (started)
+    {
+        __inline_qasm_fail(parser, "statement is missing a semicolon");
+    }
+    return false;
+}
+
+static double __inline_qasm_expression(qasm_parser_t* parser, const char** c);
+
+/*
+ * __inline_qasm_primary
+ * Number, pi or a parenthesised expression
+ */
+static inline
+double __inline_qasm_primary(qasm_parser_t* parser, const char** c)
+{
+    *c = __inline_qasm_skip_space(*c);
+    if ('(' == **c)
+    {
+        (*c)++;
+        const double value = __inline_qasm_expression(parser, c);
+        *c = __inline_qasm_skip_space(*c);
+        if (')' != **c)
+        {
+            __inline_qasm_fail(parser, "unbalanced parentheses in angle");
+            return 0;
+        }
+        (*c)++;
+        return value;
+    }
+    const size_t len = __inline_qasm_identifier(*c);
+    if (len > 0)
+    {
+        if (!__inline_qasm_keyword(*c, len, "pi"))
+        {
+            __inline_qasm_fail(parser, "unsupported symbol in angle");
+            return 0;
+        }
+        *c += len;
+        return M_PI;
+    }
+    char* end;
+    const double value = strtod(*c, &end);
+    if (end == *c)
+    {
+        __inline_qasm_fail(parser, "expected a number in angle");
+        return 0;
+    }
+    *c = end;
+    return value;
+}
+
+/*
+ * __inline_qasm_unary
+ * Signed primary
+ */
+static inline
+double __inline_qasm_unary(qasm_parser_t* parser, const char** c)
+{
+    *c = __inline_qasm_skip_space(*c);
+    if ('-' == **c)
+    {
+        (*c)++;
+        return -__inline_qasm_unary(parser, c);
+    }
+    if ('+' == **c)
+    {
+        (*c)++;
+        return __inline_qasm_unary(parser, c);
+    }
+    return __inline_qasm_primary(parser, c);
+}
+
+/*
+ * __inline_qasm_term
+ * Products and quotients, left associative
+ */
+static inline
+double __inline_qasm_term(qasm_parser_t* parser, const char** c)
+{
+    double value = __inline_qasm_unary(parser, c);
+    while (NULL == parser->error)
+    {
+        *c = __inline_qasm_skip_space(*c);
+        if ('*' == **c)
+        {
+            (*c)++;
+            value *= __inline_qasm_unary(parser, c);
+        }
+        else if ('/' == **c)
+        {
+            (*c)++;
+            value /= __inline_qasm_unary(parser, c);
+        }
+        else
+        {
+            break;
+        }
+    }
+    return value;
+}
+
+/*
+ * __inline_qasm_expression
+ * Sums and differences, left associative
+ */
+static double __inline_qasm_expression(qasm_parser_t* parser, const char** c)
+{
+    double value = __inline_qasm_term(parser, c);
+    while (NULL == parser->error)
+    {
+        *c = __inline_qasm_skip_space(*c);
+        if ('+' == **c)
+        {
+            (*c)++;
+            value += __inline_qasm_term(parser, c);
+        }
+        else if ('-' == **c)
+        {
+            (*c)++;
+            value -= __inline_qasm_term(parser, c);
+        }
+        else
+        {
+            break;
+        }
+    }
+    return value;
+}
+
+/*
+ * __inline_qasm_finite
+ * Whether an angle is neither infinite nor NaN
+ * Tests the exponent bits, as -ffast-math lets isfinite fold to true
+ */
+static inline
+bool __inline_qasm_finite(const double angle)
+{
+    uint64_t bits;
+    memcpy(&bits, &angle, sizeof(bits));
+    return 0x7ff != ((bits >> 52) & 0x7ff);
+}
+
+/*
+ * __inline_qasm_register
+ * Looks up a register by name
+ * Returns NULL if it was not declared
+ */
+static inline
+qasm_register_t* __inline_qasm_register(qasm_parser_t* parser, const char* name, const size_t len)
+{
+    for (size_t i = 0; i < parser->n_qregs; i++)
+    {
+        if (__inline_qasm_keyword(name, len, parser->qregs[i].name))
+        {
+            return parser->qregs + i;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * __inline_qasm_index
+ * Parses a bracketed index, advancing the cursor
+ * Returns false if there is none or it does not fit in a size_t
+ */
+static inline
+bool __inline_qasm_index(const char** c, size_t* idx)
+{
+    const char* cursor = __inline_qasm_skip_space(*c);
+    if ('[' != *cursor)
+    {
+        return false;
+    }
+    cursor = __inline_qasm_skip_space(cursor + 1);
+    if (!isdigit((unsigned char)*cursor))
+    {
+        return false;
+    }
+    char* end;
+    errno = 0;
+    const unsigned long long parsed = strtoull(cursor, &end, 10);
+    if (0 != errno || parsed > SIZE_MAX)
+    {
+        return false;
+    }
+    *idx = parsed;
+    cursor = __inline_qasm_skip_space(end);
+    if (']' != *cursor)
+    {
+        return false;
+    }
+    *c = cursor + 1;
+    return true;
+}
+
+/*
+ * __inline_qasm_operand
+ * Parses a qubit or a whole register, advancing the cursor
+ */
+static inline
+void __inline_qasm_operand(qasm_parser_t* parser, const char** c, qasm_operand_t* operand)
+{
+    *c = __inline_qasm_skip_space(*c);
+    const size_t len = __inline_qasm_identifier(*c);
+    qasm_register_t* reg = (len > 0) ? __inline_qasm_register(parser, *c, len) : NULL;
+    if (NULL == reg)
+    {
+        __inline_qasm_fail(parser, "undeclared quantum register");
+        return;
+    }
+    *c += len;
+
+    size_t idx = 0;
+    const char* cursor = __inline_qasm_skip_space(*c);
+    if ('[' != *cursor)
+    {
+        operand->offset = reg->offset;
+        operand->len = reg->len;
+        operand->broadcast = true;
+        return;
+    }
+    if (!__inline_qasm_index(c, &idx))
+    {
+        __inline_qasm_fail(parser, "malformed qubit index");
+        return;
+    }
+    if (idx >= reg->len)
+    {
+        __inline_qasm_fail(parser, "qubit index out of range");
+        return;
+    }
+    operand->offset = reg->offset + idx;
+    operand->len = 1;
+    operand->broadcast = false;
+}
+
+/*
+ * __inline_qasm_operands
+ * Parses a comma separated operand list and sets up the pending statement
+ */
+static inline
+void __inline_qasm_operands(qasm_parser_t* parser, const char* c, const size_t n_operands)
+{
+    parser->n_operands = n_operands;
+    parser->n_pending = 1;
+    parser->emitted = 0;
+    bool broadcast = false;
+    size_t broadcast_len = 0;
+    for (size_t i = 0; i < n_operands; i++)
+    {
+        if (i > 0)
+        {
+            c = __inline_qasm_skip_space(c);
+            if (',' != *c)
+            {
+                __inline_qasm_fail(parser, "wrong number of operands");
+                return;
+            }
+            c++;
+        }
+        __inline_qasm_operand(parser, &c, parser->operands + i);
+        if (NULL != parser->error)
+        {
+            return;
+        }
+        if (parser->operands[i].broadcast)
+        {
+            if (broadcast && broadcast_len != parser->operands[i].len)
+            {
+                __inline_qasm_fail(parser, "registers differ in size");
+                return;
+            }
+            broadcast = true;
+            broadcast_len = parser->operands[i].len;
+        }
+    }
+    // A broadcast over an empty register emits nothing
+    if (broadcast)
+    {
+        parser->n_pending = broadcast_len;
+    }
+    // The remainder of a measure is its classical target, which is not tracked
+    c = __inline_qasm_skip_space(c);
+    if ('\0' != *c && !(_MEAS_ == parser->opcode && 0 == strncmp(c, "->", 2)))
+    {
+        __inline_qasm_fail(parser, "wrong number of operands");
+    }
+}
+
+/*
+ * __inline_qasm_qreg
+ * Declares a quantum register
+ */
+static inline
+void __inline_qasm_qreg(qasm_parser_t* parser, const char* c)
+{
+    c = __inline_qasm_skip_space(c);
+    const size_t len = __inline_qasm_identifier(c);
+    size_t size = 0;
+    const char* name = c;
+    c += len;
+    if (0 == len || !__inline_qasm_index(&c, &size) || '\0' != *__inline_qasm_skip_space(c))
+    {
+        __inline_qasm_fail(parser, "malformed register declaration");
+        return;
+    }
+    if (NULL != __inline_qasm_register(parser, name, len))
+    {
+        __inline_qasm_fail(parser, "register declared twice");
+        return;
+    }
+    if (size > UINT32_MAX - parser->n_qubits)
+    {
+        __inline_qasm_fail(parser, "too many qubits");
+        return;
+    }
+
+    parser->qregs = (qasm_register_t*)realloc(parser->qregs, (parser->n_qregs + 1) * sizeof(qasm_register_t));
+    assert(NULL != parser->qregs);
+    qasm_register_t* reg = parser->qregs + parser->n_qregs;
+    reg->name = strndup(name, len);
+    assert(NULL != reg->name);
+    reg->offset = parser->n_qubits;
+    reg->len = size;
+    parser->n_qregs++;
+    parser->n_qubits += size;
+}
+
+/*
+ * __inline_qasm_statement
+ * Interprets the current statement, gates are left pending
+ */
+static inline
+void __inline_qasm_statement(qasm_parser_t* parser)
+{
+    const char* c = parser->statement;
+    const size_t len = __inline_qasm_identifier(c);
+    if (0 == len)
+    {
+        __inline_qasm_fail(parser, "expected a statement");
+        return;
+    }
+
+    // Declarations and directives that emit nothing
+    if (__inline_qasm_keyword(c, len, "OPENQASM")
+        || __inline_qasm_keyword(c, len, "include")
+        || __inline_qasm_keyword(c, len, "creg")
+        || __inline_qasm_keyword(c, len, "barrier"))
+    {
+        return;
+    }
+    if (__inline_qasm_keyword(c, len, "qreg"))
+    {
+        __inline_qasm_qreg(parser, c + len);
+        return;
+    }
+    if (__inline_qasm_keyword(c, len, "measure"))
+    {
+        parser->opcode = _MEAS_;
+        parser->tag = 0;
+        __inline_qasm_operands(parser, c + len, 1);
+        return;
+    }
+
+    const qasm_gate_t* gate = NULL;
+    for (size_t i = 0; i < QASM_N_GATES; i++)
+    {
+        if (__inline_qasm_keyword(c, len, QASM_GATES[i].name))
+        {
+            gate = QASM_GATES + i;
+            break;
+        }
+    }
+    if (NULL == gate)
+    {
+        __inline_qasm_fail(parser, "unsupported statement or gate");
+        return;
+    }
+    c += len;
+
+    double angle = gate->angle;
+    c = __inline_qasm_skip_space(c);
+    if (gate->parameterised)
+    {
+        if ('(' != *c)
+        {
+            __inline_qasm_fail(parser, "expected an angle");
+            return;
+        }
+        angle = __inline_qasm_primary(parser, &c);
+        if (NULL != parser->error)
+        {
+            return;
+        }
+        // Division by zero and overflow, including past the float the tag holds
+        if (!__inline_qasm_finite(angle) || fabs(angle) > FLT_MAX)
+        {
+            __inline_qasm_fail(parser, "angle is not finite");
+            return;
+        }
+    }
+    parser->opcode = gate->opcode;
+    parser->tag = qasm_angle_to_tag(angle);
+    __inline_qasm_operands(parser, c, gate->n_operands);
+}
+
+/*
+ * __inline_qasm_emit
+ * Writes one instruction of the pending statement
+ * Returns false if the instruction is invalid
+ */
+static inline
+bool __inline_qasm_emit(qasm_parser_t* parser, instruction_stream_u* dst)
+{
+    const size_t i = parser->emitted;
+    uint32_t qubits[QASM_MAX_OPERANDS] = {0};
+    for (size_t j = 0; j < parser->n_operands; j++)
+    {
+        qubits[j] = parser->operands[j].offset + (parser->operands[j].broadcast ? i : 0);
+    }
+
+    memset(dst, 0, sizeof(instruction_stream_u));
+    switch (INSTRUCTION_TYPE(parser->opcode))
+    {
+        case INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK):
+            dst->single.opcode = parser->opcode;
+            dst->single.arg = qubits[0];
+            break;
+        case INSTRUCTION_TYPE(RZ_MASK):
+            dst->rz.opcode = parser->opcode;
+            dst->rz.arg = qubits[0];
+            dst->rz.tag = parser->tag;
+            break;
+        case INSTRUCTION_TYPE(MEASUREMENT_CONDITIONED_MASK):
+            // Bare measurement, the target is unused
+            dst->cond.opcode = parser->opcode;
+            dst->cond.ctrl = qubits[0];
+            break;
+        default:
+            if (qubits[0] == qubits[1])
+            {
+                __inline_qasm_fail(parser, "two qubit gate on a single qubit");
+                return false;
+            }
+            dst->multi.opcode = parser->opcode;
+            dst->multi.ctrl = qubits[0];
+            dst->multi.targ = qubits[1];
+            break;
+    }
+    parser->emitted++;
+    return true;
+}
+
+/*
+ * qasm_parser_create
+ * Constructor for a parser over an open stream
+ * :: stream : FILE* :: Readable stream, not closed by the parser
+ */
+qasm_parser_t* qasm_parser_create(FILE* stream)
+{
+    qasm_parser_t* parser = (qasm_parser_t*)calloc(1, sizeof(qasm_parser_t));
+    assert(NULL != parser);
+    parser->stream = stream;
+    parser->owned = false;
+    parser->statement_cap = QASM_STATEMENT_INITIAL_CAP;
+    parser->statement = (char*)malloc(parser->statement_cap);
+    assert(NULL != parser->statement);
+    parser->line = 1;
+    parser->next_line = 1;
+    return parser;
+}
+
+/*
+ * qasm_parser_open
+ * Constructor for a parser over a file
+ * :: path : const char* :: Path to the file
+ * Returns NULL if the file cannot be opened
+ */
+qasm_parser_t* qasm_parser_open(const char* path)
+{
+    FILE* stream = fopen(path, "r");
+    if (NULL == stream)
+    {
+        return NULL;
+    }
+    qasm_parser_t* parser = qasm_parser_create(stream);
+    parser->owned = true;
+    return parser;
+}
+
+/*
+ * qasm_parser_destroy
+ * Destructor for a parser
+ * :: parser : qasm_parser_t* :: Parser to free, closes the stream if it was opened by the parser
+ */
+void qasm_parser_destroy(qasm_parser_t* parser)
+{
+    if (parser->owned)
+    {
+        fclose(parser->stream);
+    }
+    for (size_t i = 0; i < parser->n_qregs; i++)
+    {
+        free(parser->qregs[i].name);
+    }
+    free(parser->qregs);
+    free(parser->statement);
+    free(parser);
+}
+
+/*
+ * qasm_angle_to_tag
+ * Interns an angle as a tag
+ * :: angle : const double :: Angle in radians
+ * Returns the bits of the angle as a float, or 0 for angles within QASM_ANGLE_EPS of 0
+ * The angle must be finite and fit in a float, the parser rejects any other
+ */
+non_clifford_tag_t qasm_angle_to_tag(const double angle)
+{
+    if (fabs(angle) < QASM_ANGLE_EPS)
+    {
+        return 0;
+    }
+    const float truncated = (float)angle;
+    non_clifford_tag_t tag;
+    memcpy(&tag, &truncated, sizeof(tag));
+    return tag;
+}
+
+/*
+ * qasm_parser_read
+ * Parses the next instructions from the stream
+ * :: parser : qasm_parser_t* :: Parser
+ * :: dst : instruction_stream_u* :: Destination
+ * :: max_instructions : const size_t :: Capacity of the destination
+ * Returns the number of instructions written, 0 once the stream is consumed or parsing fails
+ */
+size_t qasm_parser_read(qasm_parser_t* parser, instruction_stream_u* dst, const size_t max_instructions)
+{
+    size_t n = 0;
+    while (n < max_instructions && NULL == parser->error)
+    {
+        if (parser->emitted < parser->n_pending)
+        {
+            if (__inline_qasm_emit(parser, dst + n))
+            {
+                n++;
+            }
+            continue;
+        }
+        if (!__inline_qasm_next_statement(parser))
+        {
+            break;
+        }
+        parser->n_pending = 0;
+        parser->emitted = 0;
+        __inline_qasm_statement(parser);
+    }
+
+    if (NULL != parser->error)
+    {
+        return 0;
+    }
+    parser->n_instructions += n;
+    return n;
+}
+
+/*
+ * qasm_parser_error
+ * Describes why parsing failed
+ * :: parser : const qasm_parser_t* :: Parser
+ * Returns NULL if it has not, see qasm_parser_line for where
+ */
+const char* qasm_parser_error(const qasm_parser_t* parser)
+{
+    return parser->error;
+}
+
+/*
+ * qasm_parser_line
+ * Line of the statement being parsed, which is the failing statement after an error
+ * :: parser : const qasm_parser_t* :: Parser
+ */
+size_t qasm_parser_line(const qasm_parser_t* parser)
+{
+    return parser->line;
+}
+
+/*
+ * qasm_parse
+ * Parses the whole stream into a widget in blocks
+ * :: parser : qasm_parser_t* :: Parser
+ * :: wid : widget_t* :: Widget with at least as many initial qubits as the circuit declares
+ * :: parse : parser :: parse_instruction_block or parse_instruction_block_par
+ * Returns the number of instructions parsed, check qasm_parser_error
+ */
+size_t qasm_parse(
+    qasm_parser_t* parser,
+    widget_t* wid,
+    void (*parse)(widget_t*, instruction_stream_u*, const size_t))
+{
+    instruction_stream_u* buffer = (instruction_stream_u*)malloc((QASM_DEFAULT_BLOCK + 1) * sizeof(instruction_stream_u));
+    assert(NULL != buffer);
+    size_t n_parsed = 0;
+    size_t n_instructions;
+    while (0 < (n_instructions = qasm_parser_read(parser, buffer, QASM_DEFAULT_BLOCK)))
+    {
+        // Registers may be declared part way through, so the width is checked per block
+        if (parser->n_qubits > wid->n_initial_qubits)
+        {
+            __inline_qasm_fail(parser, "circuit is wider than the widget");
+            break;
+        }
+        parse(wid, buffer, n_instructions);
+        n_parsed += n_instructions;
+    }
+    free(buffer);
+    return n_parsed;
+}
+
+/*
+ * qasm_write_instruction_file
+ * Converts the whole stream to an instruction file, which instruction_file_sequence_t splits into widgets
+ * :: parser : qasm_parser_t* :: Parser
+ * :: writer : instruction_file_writer_t* :: Open writer, left open
+ * Returns the number of instructions written, check qasm_parser_error
+ */
+size_t qasm_write_instruction_file(qasm_parser_t* parser, instruction_file_writer_t* writer)
+{
+    instruction_stream_u* buffer = (instruction_stream_u*)malloc(QASM_DEFAULT_BLOCK * sizeof(instruction_stream_u));
+    assert(NULL != buffer);
+    size_t n_written = 0;
+    size_t n_instructions;
+    while (0 < (n_instructions = qasm_parser_read(parser, buffer, QASM_DEFAULT_BLOCK)))
+    {
+        instruction_file_write(writer, buffer, n_instructions);
+        n_written += n_instructions;
+    }
+    free(buffer);
+    return n_written;
+}
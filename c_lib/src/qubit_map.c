@@ -1,3 +1,5 @@
+#include <assert.h>
+
 #include "qubit_map.h"
 
 /*
@@ -18,6 +20,20 @@ qubit_map_t* qubit_map_create(const size_t initial_qubits, const size_t max_qubi
 }
 
 
+/*
+ * qubit_map_grow
+ * Extends a qubit map
+ * :: q_map : qubit_map_t* :: The qubit map
+ * :: max_qubits : const size_t :: New maximum number of qubits in the map
+ * Returns the map, which may have moved
+ */
+qubit_map_t* qubit_map_grow(qubit_map_t* q_map, const size_t max_qubits)
+{
+    q_map = (qubit_map_t*)realloc(q_map, max_qubits * sizeof(size_t));
+    assert(NULL != q_map);
+    return q_map;
+}
+
 /*
  * qubit_map_destroy
  * Destructor for the qubit map
@@ -0,0 +1,48 @@
+#include "tableau_kernels.h"
+
+/*
+ * scalar_rowsum_cnf
+ * CNF rowsum on 64 bit words
+ * :: n_bytes : size_t :: Length of the chunk
+ * :: ctrl_x :: void* :: Control X vec
+ * :: ctrl_z :: void* :: Control Z vec
+ * :: targ_x :: void* :: Target X vec
+ * :: targ_z :: void* :: Target Z vec
+ * Returns the phase term
+ * Accumulates the same bit sliced counters as the vector kernels
+ */
+int8_t scalar_rowsum_cnf(
+    const size_t n_bytes,
+    void* restrict ctrl_x,
+    void* restrict ctrl_z,
+    void* restrict targ_x,
+    void* restrict targ_z)
+{
+    uint64_t pos = 0;
+    uint64_t neg = 0;
+    uint64_t acc = 0;
+
+    for (size_t i = 0; i < n_bytes / CHUNK_SIZE; i++)
+    {
+        const uint64_t c_x = ((uint64_t*)ctrl_x)[i];
+        const uint64_t c_z = ((uint64_t*)ctrl_z)[i];
+        const uint64_t t_x = ((uint64_t*)targ_x)[i];
+        const uint64_t t_z = ((uint64_t*)targ_z)[i];
+
+        const uint64_t plus = (~(t_z | c_x) & (c_z & t_x)) | ((c_x & t_z) & (c_z ^ t_x));
+        const uint64_t minus = (~(t_x | c_z) & (c_x & t_z)) | ((c_z & t_x) & (c_x ^ t_z));
+
+        ((uint64_t*)targ_x)[i] = c_x ^ t_x;
+        ((uint64_t*)targ_z)[i] = c_z ^ t_z;
+
+        acc ^= (pos & plus) ^ (neg & minus);
+        pos ^= plus;
+        neg ^= minus;
+    }
+
+    uint64_t total = __builtin_popcountll(pos);
+    total -= __builtin_popcountll(neg);
+    total += __builtin_popcountll(acc) << 1;
+
+    return ((total + 2) % 4) - 2;
+}
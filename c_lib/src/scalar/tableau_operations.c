@@ -0,0 +1,208 @@
+#include "tableau_kernels.h"
+
+/*
+ * __inline_scalar_ternlog
+ * Evaluates a three input truth table over 64 bit words
+ * :: x : const uint64_t :: Word matching TL_X
+ * :: z : const uint64_t :: Word matching TL_Z
+ * :: r : const uint64_t :: Word matching TL_R
+ * :: imm : const uint8_t :: Truth table
+ * The table is a constant at every call site, so the minterm loop folds away
+ */
+static inline
+uint64_t __inline_scalar_ternlog(const uint64_t x, const uint64_t z, const uint64_t r, const uint8_t imm)
+{
+    uint64_t res = 0;
+    #pragma GCC unroll 8
+    for (uint8_t b = 0; b < 8; b++)
+    {
+        if ((imm >> b) & 1)
+        {
+            res |= ((b & 4) ? x : ~x) & ((b & 2) ? z : ~z) & ((b & 1) ? r : ~r);
+        }
+    }
+    return res;
+}
+
+
+/*
+ * scalar_tableau_<clifford>
+ * Single qubit clifford operations on 64 bit words
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: targ : const size_t :: The target qubit
+ * Generated from LOCAL_CLIFFORD_TRUTH_TABLES, outputs that are unchanged are not stored
+ */
+#define SCALAR_LOCAL_CLIFFORD(gate, f_x, f_z, f_r) \
+void scalar_tableau_##gate(tableau_t* restrict tab, const size_t targ) \
+{ \
+    uint64_t* restrict slice_x = (uint64_t*)(tab->slices_x[targ]); \
+    uint64_t* restrict slice_z = (uint64_t*)(tab->slices_z[targ]); \
+    uint64_t* restrict slice_r = (uint64_t*)(tab->phases); \
+    for (size_t i = tab->active_start / CHUNK_SIZE; i < tab->active_len / CHUNK_SIZE; i++) \
+    { \
+        const uint64_t x = slice_x[i]; \
+        const uint64_t z = slice_z[i]; \
+        const uint64_t r = slice_r[i]; \
+        if (TL_X != TL_IMM(f_x)) { slice_x[i] = __inline_scalar_ternlog(x, z, r, TL_IMM(f_x)); } \
+        if (TL_Z != TL_IMM(f_z)) { slice_z[i] = __inline_scalar_ternlog(x, z, r, TL_IMM(f_z)); } \
+        if (TL_R != TL_IMM(f_r)) { slice_r[i] = __inline_scalar_ternlog(x, z, r, TL_IMM(f_r)); } \
+    } \
+}
+
+LOCAL_CLIFFORD_TRUTH_TABLES(SCALAR_LOCAL_CLIFFORD)
+
+
+void scalar_tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+{
+    /*
+     * CNOT a, b: (
+     *     r ^= x_a & z_b & (1 ^ x_b ^ z_a);
+     *     x_b ^= x_a;
+     *     z_a ^= z_b)
+     */
+    uint64_t* restrict ctrl_slice_x = (uint64_t*)(tab->slices_x[ctrl]);
+    uint64_t* restrict ctrl_slice_z = (uint64_t*)(tab->slices_z[ctrl]);
+    uint64_t* restrict targ_slice_x = (uint64_t*)(tab->slices_x[targ]);
+    uint64_t* restrict targ_slice_z = (uint64_t*)(tab->slices_z[targ]);
+    uint64_t* restrict slice_r = (uint64_t*)(tab->phases);
+
+    for (size_t i = tab->active_start / CHUNK_SIZE; i < tab->active_len / CHUNK_SIZE; i++)
+    {
+        const uint64_t ctrl_x = ctrl_slice_x[i];
+        const uint64_t ctrl_z = ctrl_slice_z[i];
+        const uint64_t targ_x = targ_slice_x[i];
+        const uint64_t targ_z = targ_slice_z[i];
+
+        targ_slice_x[i] = ctrl_x ^ targ_x;
+        ctrl_slice_z[i] = ctrl_z ^ targ_z;
+        slice_r[i] ^= ctrl_x & targ_z & ~(targ_x ^ ctrl_z);
+    }
+}
+
+
+void scalar_tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+{
+    /*
+     * CZ a, b: (
+     *     r ^= x_a & x_b & (z_a ^ z_b);
+     *     z_b ^= x_a;
+     *     z_a ^= x_b)
+     */
+    uint64_t* restrict ctrl_slice_x = (uint64_t*)(tab->slices_x[ctrl]);
+    uint64_t* restrict ctrl_slice_z = (uint64_t*)(tab->slices_z[ctrl]);
+    uint64_t* restrict targ_slice_x = (uint64_t*)(tab->slices_x[targ]);
+    uint64_t* restrict targ_slice_z = (uint64_t*)(tab->slices_z[targ]);
+    uint64_t* restrict slice_r = (uint64_t*)(tab->phases);
+
+    for (size_t i = tab->active_start / CHUNK_SIZE; i < tab->active_len / CHUNK_SIZE; i++)
+    {
+        const uint64_t ctrl_x = ctrl_slice_x[i];
+        const uint64_t ctrl_z = ctrl_slice_z[i];
+        const uint64_t targ_x = targ_slice_x[i];
+        const uint64_t targ_z = targ_slice_z[i];
+
+        targ_slice_z[i] = ctrl_x ^ targ_z;
+        ctrl_slice_z[i] = ctrl_z ^ targ_x;
+        slice_r[i] ^= ctrl_x & targ_x & (ctrl_z ^ targ_z);
+    }
+}
+
+
+/*
+ * __inline_scalar_local_clifford
+ * Applies a local Clifford in symplectic form to one word of a qubit
+ * :: m : struct local_clifford_masks_t const* :: The Clifford
+ * :: x : uint64_t* :: X word, updated in place
+ * :: z : uint64_t* :: Z word, updated in place
+ * :: r : uint64_t* :: Phase word, updated in place
+ */
+static inline
+void __inline_scalar_local_clifford(struct local_clifford_masks_t const* m, uint64_t* x, uint64_t* z, uint64_t* r)
+{
+    const uint64_t x_0 = *x;
+    const uint64_t z_0 = *z;
+    *r ^= (x_0 & m->rx) ^ (z_0 & m->rz) ^ (x_0 & z_0 & m->ry);
+    *x = (x_0 & m->xx) ^ (z_0 & m->xz);
+    *z = (x_0 & m->zx) ^ (z_0 & m->zz);
+}
+
+
+/*
+ * scalar_tableau_fused_<clifford>
+ * Queued local Cliffords on both qubits followed by a two qubit gate, in one pass
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: ctrl_clifford : const instruction_t :: Local Clifford on the control
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ_clifford : const instruction_t :: Local Clifford on the target
+ * :: targ : const size_t :: The target qubit
+ */
+void scalar_tableau_fused_CNOT(
+    tableau_t* restrict tab,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ)
+{
+    struct local_clifford_masks_t const* ctrl_m = LOCAL_CLIFFORD_MASKS + (ctrl_clifford & INSTRUCTION_OPERATOR_MASK);
+    struct local_clifford_masks_t const* targ_m = LOCAL_CLIFFORD_MASKS + (targ_clifford & INSTRUCTION_OPERATOR_MASK);
+
+    uint64_t* restrict ctrl_slice_x = (uint64_t*)(tab->slices_x[ctrl]);
+    uint64_t* restrict ctrl_slice_z = (uint64_t*)(tab->slices_z[ctrl]);
+    uint64_t* restrict targ_slice_x = (uint64_t*)(tab->slices_x[targ]);
+    uint64_t* restrict targ_slice_z = (uint64_t*)(tab->slices_z[targ]);
+    uint64_t* restrict slice_r = (uint64_t*)(tab->phases);
+
+    for (size_t i = tab->active_start / CHUNK_SIZE; i < tab->active_len / CHUNK_SIZE; i++)
+    {
+        uint64_t ctrl_x = ctrl_slice_x[i];
+        uint64_t ctrl_z = ctrl_slice_z[i];
+        uint64_t targ_x = targ_slice_x[i];
+        uint64_t targ_z = targ_slice_z[i];
+        uint64_t r = slice_r[i];
+
+        __inline_scalar_local_clifford(ctrl_m, &ctrl_x, &ctrl_z, &r);
+        __inline_scalar_local_clifford(targ_m, &targ_x, &targ_z, &r);
+
+        ctrl_slice_x[i] = ctrl_x;
+        targ_slice_z[i] = targ_z;
+        targ_slice_x[i] = ctrl_x ^ targ_x;
+        ctrl_slice_z[i] = ctrl_z ^ targ_z;
+        slice_r[i] = r ^ (ctrl_x & targ_z & ~(targ_x ^ ctrl_z));
+    }
+}
+
+
+void scalar_tableau_fused_CZ(
+    tableau_t* restrict tab,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ)
+{
+    struct local_clifford_masks_t const* ctrl_m = LOCAL_CLIFFORD_MASKS + (ctrl_clifford & INSTRUCTION_OPERATOR_MASK);
+    struct local_clifford_masks_t const* targ_m = LOCAL_CLIFFORD_MASKS + (targ_clifford & INSTRUCTION_OPERATOR_MASK);
+
+    uint64_t* restrict ctrl_slice_x = (uint64_t*)(tab->slices_x[ctrl]);
+    uint64_t* restrict ctrl_slice_z = (uint64_t*)(tab->slices_z[ctrl]);
+    uint64_t* restrict targ_slice_x = (uint64_t*)(tab->slices_x[targ]);
+    uint64_t* restrict targ_slice_z = (uint64_t*)(tab->slices_z[targ]);
+    uint64_t* restrict slice_r = (uint64_t*)(tab->phases);
+
+    for (size_t i = tab->active_start / CHUNK_SIZE; i < tab->active_len / CHUNK_SIZE; i++)
+    {
+        uint64_t ctrl_x = ctrl_slice_x[i];
+        uint64_t ctrl_z = ctrl_slice_z[i];
+        uint64_t targ_x = targ_slice_x[i];
+        uint64_t targ_z = targ_slice_z[i];
+        uint64_t r = slice_r[i];
+
+        __inline_scalar_local_clifford(ctrl_m, &ctrl_x, &ctrl_z, &r);
+        __inline_scalar_local_clifford(targ_m, &targ_x, &targ_z, &r);
+
+        ctrl_slice_x[i] = ctrl_x;
+        targ_slice_x[i] = targ_x;
+        targ_slice_z[i] = ctrl_x ^ targ_z;
+        ctrl_slice_z[i] = ctrl_z ^ targ_x;
+        slice_r[i] = r ^ (ctrl_x & targ_x & (ctrl_z ^ targ_z));
+    }
+}
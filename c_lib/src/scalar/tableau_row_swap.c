@@ -0,0 +1,21 @@
+#include "tableau_kernels.h"
+
+void scalar_row_swap(
+    const size_t n_bytes,
+    void* restrict ctrl_x,
+    void* restrict ctrl_z,
+    void* restrict targ_x,
+    void* restrict targ_z
+)
+{
+    for (size_t i = 0; i < n_bytes / CHUNK_SIZE; i++)
+    {
+        const uint64_t c_x = ((uint64_t*)ctrl_x)[i];
+        const uint64_t c_z = ((uint64_t*)ctrl_z)[i];
+
+        ((uint64_t*)ctrl_x)[i] = ((uint64_t*)targ_x)[i];
+        ((uint64_t*)ctrl_z)[i] = ((uint64_t*)targ_z)[i];
+        ((uint64_t*)targ_x)[i] = c_x;
+        ((uint64_t*)targ_z)[i] = c_z;
+    }
+}
@@ -0,0 +1,71 @@
+#include "tableau_kernels.h"
+
+/*
+ * __inline_scalar_transpose_block
+ * Transposes a 64x64 bit block held in registers
+ * :: block : uint64_t[64] :: Block to transpose
+ * Swaps off diagonal sub blocks of halving widths
+ */
+static inline
+void __inline_scalar_transpose_block(uint64_t block[64])
+{
+    uint64_t mask = 0x00000000ffffffffull;
+    for (size_t width = 32; width != 0; width >>= 1, mask ^= (mask << width))
+    {
+        for (size_t k = 0; k < 64; k = (k + width + 1) & ~width)
+        {
+            const uint64_t t = ((block[k] >> width) ^ block[k + width]) & mask;
+            block[k] ^= t << width;
+            block[k + width] ^= t;
+        }
+    }
+}
+
+
+/*
+ * scalar_transpose_64x64
+ * Transposes two 64x64 blocks and exchanges them
+ * :: block_a : uint64_t*[64] :: Rows of the first block, receives the transpose of the second
+ * :: block_b : uint64_t*[64] :: Rows of the second block, receives the transpose of the first
+ */
+void scalar_transpose_64x64(uint64_t* restrict block_a[64], uint64_t* restrict block_b[64])
+{
+    uint64_t a[64];
+    uint64_t b[64];
+    for (size_t i = 0; i < 64; i++)
+    {
+        a[i] = *block_a[i];
+        b[i] = *block_b[i];
+    }
+
+    __inline_scalar_transpose_block(a);
+    __inline_scalar_transpose_block(b);
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        *block_a[i] = b[i];
+        *block_b[i] = a[i];
+    }
+}
+
+
+/*
+ * scalar_transpose_64x64_inplace
+ * Transposes a 64x64 block on the diagonal
+ * :: block_a : uint64_t*[64] :: Rows of the block
+ */
+void scalar_transpose_64x64_inplace(uint64_t* block_a[64])
+{
+    uint64_t a[64];
+    for (size_t i = 0; i < 64; i++)
+    {
+        a[i] = *block_a[i];
+    }
+
+    __inline_scalar_transpose_block(a);
+
+    for (size_t i = 0; i < 64; i++)
+    {
+        *block_a[i] = a[i];
+    }
+}
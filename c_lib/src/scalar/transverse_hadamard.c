@@ -0,0 +1,40 @@
+#include "tableau_kernels.h"
+
+/*
+ * scalar_tableau_transverse_hadamard
+ * Applies a hadamard when transposed
+ * :: tab : tableau_t*  :: Tableau object
+ * :: targ : const size_t :: Index to target
+ * Walks one row at a time over the chunk holding the target column
+ */
+void scalar_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ)
+{
+    const size_t row_bytes = tab->slice_len;
+    const size_t offset = targ / 64 * 8;
+    const size_t shift = targ % 64;
+    const uint64_t mask = 1ull << shift;
+
+    void* slices_x = (void*)(tab->slices_x[0]) + offset;
+    void* slices_z = (void*)(tab->slices_z[0]) + offset;
+    uint64_t* bit_phase = (uint64_t*)(tab->phases);
+
+    for (size_t i = 0; i < tab->n_qubits; i += 64)
+    {
+        uint64_t phase = 0;
+        for (size_t j = 0; j < 64; j++)
+        {
+            uint64_t* row_x = (uint64_t*)(slices_x + (i + j) * row_bytes);
+            uint64_t* row_z = (uint64_t*)(slices_z + (i + j) * row_bytes);
+
+            const uint64_t x = *row_x;
+            const uint64_t z = *row_z;
+
+            phase |= ((x & z) >> shift & 1ull) << j;
+
+            const uint64_t swap = (x ^ z) & mask;
+            *row_x = x ^ swap;
+            *row_z = z ^ swap;
+        }
+        bit_phase[i / 64] ^= phase;
+    }
+}
@@ -1,4 +1,5 @@
 #include "simd_rowsum.h"
+#include "tableau_kernels.h"
 
 #define MASK_0 (0x0101010101010101ull) 
 #define MASK_1 (0x0202020202020202ull) 
@@ -421,7 +422,7 @@ int8_t simd_rowsum_cnf_popcnt(
     return (((pos - neg) % 4 + 2) % 4) - 2;
 }
 
-int8_t simd_rowsum_cnf(
+int8_t avx2_rowsum_cnf(
     const size_t n_bytes,
     void *restrict ctrl_x,
     void *restrict ctrl_z,
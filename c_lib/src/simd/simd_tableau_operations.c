@@ -1,9 +1,8 @@
 #define INSTRUCTIONS_TABLE
-#define TABLEAU_OPERATIONS_SRC 
 
 #include "tableau_operations.h"
 
-void tableau_H(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_H(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * x -> z
@@ -14,7 +13,7 @@ void tableau_H(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += sizeof(__m256i))
+    for (size_t i = tab->active_start; i < tab->active_len; i += sizeof(__m256i))
     {
         __m256i x = _mm256_load_si256(slice_x + i);   
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -27,7 +26,7 @@ void tableau_H(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_S(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_S(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * x -> x  
@@ -38,7 +37,7 @@ void tableau_S(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -53,7 +52,7 @@ void tableau_S(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_Z(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_Z(tableau_t* restrict tab, const size_t targ)
 {
 /*
  * Doubled S gate
@@ -67,7 +66,7 @@ void tableau_Z(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -81,7 +80,7 @@ void tableau_Z(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_R(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_R(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * Triple S gate
@@ -102,7 +101,7 @@ void tableau_R(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -119,12 +118,12 @@ void tableau_R(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_I(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_I(tableau_t* restrict tab, const size_t targ)
 {
     return;
 }
 
-void tableau_X(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_X(tableau_t* restrict tab, const size_t targ)
 {
 /*
  * HZH Gate
@@ -148,7 +147,7 @@ void tableau_X(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i z = _mm256_load_si256(slice_z + i);
         __m256i r = _mm256_load_si256(slice_r + i);
@@ -157,7 +156,7 @@ void tableau_X(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_Y(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_Y(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * Y = XZ
@@ -175,7 +174,7 @@ void tableau_Y(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -189,7 +188,7 @@ void tableau_Y(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HX(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_HX(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * X : (r ^= z)
@@ -206,7 +205,7 @@ void tableau_HX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -222,7 +221,7 @@ void tableau_HX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_SX(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_SX(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * X : (r ^= z)
@@ -238,7 +237,7 @@ void tableau_SX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -256,7 +255,7 @@ void tableau_SX(tableau_t* restrict tab, const size_t targ)
 
 
 
-void tableau_RX(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_RX(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * X : (r ^= z)
@@ -273,7 +272,7 @@ void tableau_RX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -289,7 +288,7 @@ void tableau_RX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HZ(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_HZ(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * Z : (r ^= x)
@@ -307,7 +306,7 @@ void tableau_HZ(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -325,7 +324,7 @@ void tableau_HZ(tableau_t* restrict tab, const size_t targ)
 
 
 
-void tableau_HY(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_HY(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * Y : r ^= x ^ z
@@ -343,7 +342,7 @@ void tableau_HY(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -360,7 +359,7 @@ void tableau_HY(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_SH(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_SH(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * H : (r ^= x.z; x <-> z) 
@@ -380,7 +379,7 @@ void tableau_SH(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);   
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -394,7 +393,7 @@ void tableau_SH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_RH(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_RH(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -415,7 +414,7 @@ void tableau_RH(tableau_t* restrict tab, const size_t targ)
      *
      */
     // DONE
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);   
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -428,7 +427,7 @@ void tableau_RH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_HS(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_HS(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -451,7 +450,7 @@ void tableau_HS(tableau_t* restrict tab, const size_t targ)
      * x_2 = z_1 = z ^ x  
      *
      */
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);   
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -463,7 +462,7 @@ void tableau_HS(tableau_t* restrict tab, const size_t targ)
     }  
 }
 
-void tableau_HR(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_HR(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
@@ -486,7 +485,7 @@ void tableau_HR(tableau_t* restrict tab, const size_t targ)
      *
      */
     // DONE
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);   
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -496,7 +495,7 @@ void tableau_HR(tableau_t* restrict tab, const size_t targ)
     }  
 }
 
-void tableau_HSX(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_HSX(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * X : (r ^= z)
@@ -522,7 +521,7 @@ void tableau_HSX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -538,7 +537,7 @@ void tableau_HSX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HRX(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_HRX(tableau_t* restrict tab, const size_t targ)
 {
     /*
      * X : (r ^= z)
@@ -563,7 +562,7 @@ void tableau_HRX(tableau_t* restrict tab, const size_t targ)
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -575,13 +574,13 @@ void tableau_HRX(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_SHY(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_SHY(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -593,13 +592,13 @@ void tableau_SHY(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_RHY(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_RHY(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -611,14 +610,14 @@ void tableau_RHY(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HSH(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_HSH(tableau_t* restrict tab, const size_t targ)
 {
 
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -634,13 +633,13 @@ void tableau_HSH(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_HRH(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_HRH(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -657,13 +656,13 @@ void tableau_HRH(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_RHS(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_RHS(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -680,13 +679,13 @@ void tableau_RHS(tableau_t* restrict tab, const size_t targ)
 }
 
 
-void tableau_SHR(tableau_t* restrict tab, const size_t targ)
+void avx2_tableau_SHR(tableau_t* restrict tab, const size_t targ)
 {
     void* restrict slice_x = (void*)(tab->slices_x[targ]); 
     void* restrict slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i x = _mm256_load_si256(slice_x + i);
         __m256i z = _mm256_load_si256(slice_z + i);
@@ -702,7 +701,7 @@ void tableau_SHR(tableau_t* restrict tab, const size_t targ)
     }
 }
 
-void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+void avx2_tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
 {
     /*
      * CNOT a, b: ( 
@@ -718,7 +717,7 @@ void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i ctrl_x = _mm256_load_si256(ctrl_slice_x + i);
         __m256i ctrl_z = _mm256_load_si256(ctrl_slice_z + i);
@@ -739,7 +738,7 @@ void tableau_CNOT(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     }
 }
 
-void tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
+void avx2_tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
 {
     /* CZ = H_b CNOT H_b 
      * H : (r ^= x.z; x <-> z) 
@@ -783,7 +782,7 @@ void tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
     void* restrict targ_slice_z = (void*)(tab->slices_z[targ]); 
     void* restrict slice_r = (void*)(tab->phases); 
 
-    for (size_t i = 0; i < tab->slice_len; i += TABLEAU_SIMD_STRIDE)
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
     {
         __m256i ctrl_x = _mm256_load_si256(ctrl_slice_x + i);
         __m256i ctrl_z = _mm256_load_si256(ctrl_slice_z + i);
@@ -806,3 +805,142 @@ void tableau_CZ(tableau_t* restrict tab, const size_t ctrl, const size_t targ)
         );
     }
 }
+
+
+/*
+ * Broadcast form of struct local_clifford_masks_t
+ */
+struct avx2_local_clifford_t
+{
+    __m256i xx, xz, zx, zz, rx, rz, ry;
+};
+
+static inline
+struct avx2_local_clifford_t __inline_avx2_local_clifford_load(const instruction_t clifford)
+{
+    struct local_clifford_masks_t const* m = LOCAL_CLIFFORD_MASKS + (clifford & INSTRUCTION_OPERATOR_MASK);
+    struct avx2_local_clifford_t v = {
+        _mm256_set1_epi64x(m->xx), _mm256_set1_epi64x(m->xz),
+        _mm256_set1_epi64x(m->zx), _mm256_set1_epi64x(m->zz),
+        _mm256_set1_epi64x(m->rx), _mm256_set1_epi64x(m->rz), _mm256_set1_epi64x(m->ry)
+    };
+    return v;
+}
+
+/*
+ * __inline_avx2_local_clifford
+ * Applies a local Clifford in symplectic form to one vector of a qubit
+ * :: c : struct avx2_local_clifford_t const* :: The Clifford
+ * :: x : __m256i* :: X vector, updated in place
+ * :: z : __m256i* :: Z vector, updated in place
+ * :: r : __m256i* :: Phase vector, updated in place
+ */
+static inline
+void __inline_avx2_local_clifford(struct avx2_local_clifford_t const* c, __m256i* x, __m256i* z, __m256i* r)
+{
+    const __m256i x_0 = *x;
+    const __m256i z_0 = *z;
+    *r = _mm256_xor_si256(*r,
+        _mm256_xor_si256(
+            _mm256_and_si256(x_0, c->rx),
+            _mm256_xor_si256(
+                _mm256_and_si256(z_0, c->rz),
+                _mm256_and_si256(_mm256_and_si256(x_0, z_0), c->ry))));
+    *x = _mm256_xor_si256(_mm256_and_si256(x_0, c->xx), _mm256_and_si256(z_0, c->xz));
+    *z = _mm256_xor_si256(_mm256_and_si256(x_0, c->zx), _mm256_and_si256(z_0, c->zz));
+}
+
+
+/*
+ * avx2_tableau_fused_<clifford>
+ * Queued local Cliffords on both qubits followed by a two qubit gate, in one pass
+ * :: tab : tableau_t* :: The tableau to operate on
+ * :: ctrl_clifford : const instruction_t :: Local Clifford on the control
+ * :: ctrl : const size_t :: The control qubit
+ * :: targ_clifford : const instruction_t :: Local Clifford on the target
+ * :: targ : const size_t :: The target qubit
+ */
+void avx2_tableau_fused_CNOT(
+    tableau_t* restrict tab,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ)
+{
+    const struct avx2_local_clifford_t ctrl_c = __inline_avx2_local_clifford_load(ctrl_clifford);
+    const struct avx2_local_clifford_t targ_c = __inline_avx2_local_clifford_load(targ_clifford);
+
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]);
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]);
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]);
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]);
+    void* restrict slice_r = (void*)(tab->phases);
+
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m256i ctrl_x = _mm256_load_si256(ctrl_slice_x + i);
+        __m256i ctrl_z = _mm256_load_si256(ctrl_slice_z + i);
+        __m256i targ_x = _mm256_load_si256(targ_slice_x + i);
+        __m256i targ_z = _mm256_load_si256(targ_slice_z + i);
+        __m256i r = _mm256_load_si256(slice_r + i);
+
+        __inline_avx2_local_clifford(&ctrl_c, &ctrl_x, &ctrl_z, &r);
+        __inline_avx2_local_clifford(&targ_c, &targ_x, &targ_z, &r);
+
+        _mm256_store_si256(ctrl_slice_x + i, ctrl_x);
+        _mm256_store_si256(targ_slice_z + i, targ_z);
+        _mm256_store_si256(targ_slice_x + i, _mm256_xor_si256(ctrl_x, targ_x));
+        _mm256_store_si256(ctrl_slice_z + i, _mm256_xor_si256(ctrl_z, targ_z));
+        _mm256_store_si256(slice_r + i,
+            _mm256_xor_si256(r,
+                _mm256_andnot_si256(
+                    _mm256_xor_si256(targ_x, ctrl_z),
+                    _mm256_and_si256(ctrl_x, targ_z)
+                )
+            )
+        );
+    }
+}
+
+
+void avx2_tableau_fused_CZ(
+    tableau_t* restrict tab,
+    const instruction_t ctrl_clifford,
+    const size_t ctrl,
+    const instruction_t targ_clifford,
+    const size_t targ)
+{
+    const struct avx2_local_clifford_t ctrl_c = __inline_avx2_local_clifford_load(ctrl_clifford);
+    const struct avx2_local_clifford_t targ_c = __inline_avx2_local_clifford_load(targ_clifford);
+
+    void* restrict ctrl_slice_x = (void*)(tab->slices_x[ctrl]);
+    void* restrict ctrl_slice_z = (void*)(tab->slices_z[ctrl]);
+    void* restrict targ_slice_x = (void*)(tab->slices_x[targ]);
+    void* restrict targ_slice_z = (void*)(tab->slices_z[targ]);
+    void* restrict slice_r = (void*)(tab->phases);
+
+    for (size_t i = tab->active_start; i < tab->active_len; i += TABLEAU_SIMD_STRIDE)
+    {
+        __m256i ctrl_x = _mm256_load_si256(ctrl_slice_x + i);
+        __m256i ctrl_z = _mm256_load_si256(ctrl_slice_z + i);
+        __m256i targ_x = _mm256_load_si256(targ_slice_x + i);
+        __m256i targ_z = _mm256_load_si256(targ_slice_z + i);
+        __m256i r = _mm256_load_si256(slice_r + i);
+
+        __inline_avx2_local_clifford(&ctrl_c, &ctrl_x, &ctrl_z, &r);
+        __inline_avx2_local_clifford(&targ_c, &targ_x, &targ_z, &r);
+
+        _mm256_store_si256(ctrl_slice_x + i, ctrl_x);
+        _mm256_store_si256(targ_slice_x + i, targ_x);
+        _mm256_store_si256(targ_slice_z + i, _mm256_xor_si256(ctrl_x, targ_z));
+        _mm256_store_si256(ctrl_slice_z + i, _mm256_xor_si256(ctrl_z, targ_x));
+        _mm256_store_si256(slice_r + i,
+            _mm256_xor_si256(r,
+                _mm256_and_si256(
+                    _mm256_and_si256(ctrl_x, targ_x),
+                    _mm256_xor_si256(ctrl_z, targ_z)
+                )
+            )
+        );
+    }
+}
@@ -1,6 +1,7 @@
 #include "rowswap.h"
+#include "tableau_kernels.h"
 
-void simd_row_swap(
+void avx2_row_swap(
     const size_t n_bytes,
     void* restrict ctrl_x, 
     void* restrict ctrl_z, 
@@ -1,59 +1,63 @@
 #include "transverse_hadamard.h"
 
 /*
- * simd_tableau_transverse_hadamard
+ * avx2_tableau_transverse_hadamard
  * Applies a hadamard when transposed 
  * :: tab : tableau_t*  :: Tableau object
  * :: c_que :  clifford_queue_t* :: Clifford queue 
  * :: i : const size_t :: Index to target 
  *
+ * Walks 64 row tiles of the chunk holding the target column, four rows at a time
+ * The X and Z bits are swapped with masked xors and the phase contributions
+ * are shifted into the sign bit and collected with a movemask
  */
-void simd_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ)
+void avx2_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ)
 { 
-    const size_t stride = 64;
-    uint8_t bit_x[64] = {0};
-    uint8_t bit_z[64] = {0};
-    uint64_t* bit_phase;
-  
     // Number of bytes between transverseally adjacent bytes  
     const size_t row_bytes = tab->slice_len;
     const size_t offset = targ / 64 * 8; // Aligned offset load  
 
-    // TODO Vectorise this
-    // Use the strided load to do this faster
-    // Unfortunately scatter operations are avx512 :(
+    void* slices_x = (void*)(tab->slices_x[0]) + offset;
+    void* slices_z = (void*)(tab->slices_z[0]) + offset;
+    uint64_t* bit_phase = (uint64_t*)(tab->phases); 
 
-    // Gathers 8 values
-    //__m256i gathered = _mm256_i32gather_epi64(
-    //    base_address
-    //    __m128i vindex,
-    //    1
-    //); 
+    const __m256i mask = _mm256_set1_epi64x(1ull << (targ % 64));
+    const __m128i sign_shift = _mm_cvtsi64_si128(63 - (targ % 64));
+    const __m256i row_stride = _mm256_set_epi64x(3 * row_bytes, 2 * row_bytes, row_bytes, 0);
 
-    // TODO SIMD this by chunks
-    // Otherwise we're trying to pipeline this
-    for (size_t i = 0; i < tab->n_qubits; i += stride)
+    // Slices are padded to a multiple of 64, so every tile is in bounds
+    for (size_t i = 0; i < tab->n_qubits; i += 64)
     {
-        bit_phase = (uint64_t*)(tab->phases) + i / stride; 
-        #pragma GCC unroll 64 
-        for (size_t j = 0; j < stride; j++)
-        {
-            bit_z[j] = __inline_slice_get_bit(tab->slices_z[i + j], targ); 
-            bit_x[j] = __inline_slice_get_bit(tab->slices_x[i + j], targ); 
-        }
+        uint64_t phase = 0;
 
-        #pragma GCC unroll 64 
-        for (size_t j = 0; j < stride; j++)
+        // Loading whole tiles before storing them evicts the rows from L1,
+        // so each group of rows is written back as soon as it is updated
+        #pragma GCC unroll 4 
+        for (size_t j = 0; j < 64; j += 4)
         {
-            *bit_phase ^= ((uint64_t)bit_z[j] & (uint64_t)bit_x[j]) << j;
-        }
-       
-        #pragma GCC unroll 64 
-        for (size_t j = 0; j < stride; j++)
-        {
-            __inline_slice_set_bit(tab->slices_z[i + j], targ, bit_x[j]); 
-            __inline_slice_set_bit(tab->slices_x[i + j], targ, bit_z[j]); 
+            void* row_x = slices_x + (i + j) * row_bytes;
+            void* row_z = slices_z + (i + j) * row_bytes;
+
+            __m256i x = _mm256_i64gather_epi64((long long const*)row_x, row_stride, 1);
+            __m256i z = _mm256_i64gather_epi64((long long const*)row_z, row_stride, 1);
+
+            // Y terms pick up a phase
+            __m256i y = _mm256_sll_epi64(_mm256_and_si256(x, z), sign_shift);
+            phase |= (uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(y)) << j;
+
+            // Bits that differ between X and Z are flipped in both
+            uint64_t swap[4];
+            _mm256_storeu_si256((__m256i*)swap, _mm256_and_si256(_mm256_xor_si256(x, z), mask));
+
+            #pragma GCC unroll 4 
+            for (size_t k = 0; k < 4; k++)
+            {
+                *(uint64_t*)(row_x + k * row_bytes) ^= swap[k];
+                *(uint64_t*)(row_z + k * row_bytes) ^= swap[k];
+            }
         }
+
+        bit_phase[i / 64] ^= phase;
     }
     return;
 }
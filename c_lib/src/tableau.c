@@ -1,4 +1,7 @@
+#include <sys/mman.h>
+
 #include "tableau.h"
+#include "threadpool.h"
 
 /*
  * slice_set_bit
@@ -48,6 +51,73 @@ size_t tableau_get_slice_len(tableau_t* tab) {
     return tab->slice_len;
 }
 
+/*
+ * __inline_tableau_map
+ * Reserves an anonymous mapping for the tableau bitmap
+ * :: n_bytes : size_t* :: Size of the mapping, rounded up to a huge page for explicit huge pages
+ * :: alloc_policy : uint8_t* :: Requested policy, updated to the policy that was honoured
+ * Pages are zero filled by the kernel when they are first touched
+ */
+static inline
+void* __inline_tableau_map(size_t* n_bytes, uint8_t* alloc_policy)
+{
+    void* map = MAP_FAILED;
+    if (TABLEAU_ALLOC_HUGETLB == *alloc_policy)
+    {
+        #ifdef MAP_HUGETLB
+        const size_t huge_bytes = (*n_bytes + TABLEAU_HUGE_PAGE_SIZE - 1) & ~(TABLEAU_HUGE_PAGE_SIZE - 1);
+        map = mmap(NULL, huge_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (MAP_FAILED != map)
+        {
+            *n_bytes = huge_bytes;
+            return map;
+        }
+        #endif
+        // No huge pages reserved, let the kernel promote pages instead
+        DPRINT(DEBUG_1, "\tExplicit huge pages unavailable, using transparent huge pages\n");
+        *alloc_policy = TABLEAU_ALLOC_HUGE;
+    }
+
+    map = mmap(NULL, *n_bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    assert(MAP_FAILED != map);
+
+    if (TABLEAU_ALLOC_HUGE == *alloc_policy)
+    {
+        // Advisory only, a kernel without transparent huge pages leaves the mapping as is
+        #ifdef MADV_HUGEPAGE
+        madvise(map, *n_bytes, MADV_HUGEPAGE);
+        #else
+        *alloc_policy = TABLEAU_ALLOC_MMAP;
+        #endif
+    }
+    return map;
+}
+
+/*
+ * tableau_first_touch
+ * Zeros a stripe of every slice and sets the Z diagonal bits that fall within it
+ * :: args : void* :: struct distributed_tableau_op* covering the stripe
+ * Run by the worker that owns the stripe so that the pages are placed on its node
+ */
+static void tableau_first_touch(void* args)
+{
+    struct distributed_tableau_op* op = (struct distributed_tableau_op*)args;
+    tableau_t* tab = op->tab;
+    const size_t n_ptrs = *(size_t*)op->args;
+
+    for (size_t i = 0; i < n_ptrs; i++)
+    {
+        memset((uint8_t*)tab->slices_x[i] + op->start, 0x00, op->stop - op->start);
+        memset((uint8_t*)tab->slices_z[i] + op->start, 0x00, op->stop - op->start);
+    }
+
+    const size_t stop = (op->stop * 8 < n_ptrs) ? op->stop * 8 : n_ptrs;
+    for (size_t i = op->start * 8; i < stop; i++)
+    {
+        __inline_slice_set_bit(tab->slices_z[i], i, 1);
+    }
+}
+
 /*
  * tableau_create 
  * Constructor class for tableau  
@@ -56,6 +126,20 @@ size_t tableau_get_slice_len(tableau_t* tab) {
  */
 tableau_t* tableau_create(const size_t n_qubits)
 {
+    return tableau_create_alloc(n_qubits, TABLEAU_ALLOC_DEFAULT);
+}
+
+/*
+ * tableau_create_alloc
+ * Constructor for tableau with a choice of allocation policy for the bitmap
+ * :: n_qubits : const size_t :: Number of qubits
+ * :: alloc_policy : const uint8_t :: One of the TABLEAU_ALLOC_* policies
+ * Mapped policies skip the memset, untouched pages read as zero
+ * First touch distributes the zeroing over the threadpool so each page lands on the node of the worker that owns its stripe
+ */
+tableau_t* tableau_create_alloc(const size_t n_qubits, const uint8_t alloc_policy)
+{
+    assert(alloc_policy < TABLEAU_N_ALLOC_POLICIES);
     DPRINT(DEBUG_1, "Allocating %zu qubit tableau\n", n_qubits);
 
     // The extra chunk is a 64 byte region that we can use for cache line alignment 
@@ -65,16 +149,25 @@ tableau_t* tableau_create(const size_t n_qubits)
     const size_t tableau_half_bytes = slice_len_bytes * n_ptrs;
     const size_t tableau_bytes = tableau_half_bytes * 2; 
 
-    // Construct memaligned bitmap
     void* tableau_bitmap = NULL;
+    uint8_t policy = alloc_policy;
+    size_t alloc_bytes = tableau_bytes;
+    int err_code = 0;
+    if (TABLEAU_ALLOC_ALIGNED == policy)
+    {
+        // Construct memaligned bitmap
+        err_code = posix_memalign(&tableau_bitmap, CACHE_SIZE, tableau_bytes); 
+        assert(0 == err_code);
 
-    int err_code = posix_memalign(&tableau_bitmap, CACHE_SIZE, tableau_bytes); 
-    assert(0 == err_code);
-
-    // Set map to all zeros
-    // TODO: fast memset
-    memset(tableau_bitmap, 0x00, tableau_bytes);
-    DPRINT(DEBUG_2, "\tAllocated %ld bytes for tableau\n", tableau_bytes);
+        // Set map to all zeros
+        memset(tableau_bitmap, 0x00, tableau_bytes);
+    }
+    else
+    {
+        // Page aligned, which covers cache line alignment
+        tableau_bitmap = __inline_tableau_map(&alloc_bytes, &policy);
+    }
+    DPRINT(DEBUG_2, "\tAllocated %ld bytes for tableau\n", alloc_bytes);
     DPRINT(DEBUG_2, "\tSlices contain %zu bytes\n", slice_len_bytes);
     
     // Slice tracking pointers 
@@ -90,11 +183,15 @@ tableau_t* tableau_create(const size_t n_qubits)
     tableau_t* tab = malloc(sizeof(tableau_t)); 
     tab->n_qubits = n_qubits;
     tab->slice_len = slice_len_bytes;
+    tab->active_start = 0;
+    tab->active_len = slice_len_bytes;
     tab->chunks = tableau_bitmap; 
     tab->slices_x = slice_ptrs_x;
     tab->slices_z = slice_ptrs_z;
     tab->orientation = COL_MAJOR;
     tab->phases = phases;
+    tab->alloc_policy = policy;
+    tab->alloc_bytes = alloc_bytes;
 
     // Construct start of X and Z segments 
     void* x_start = tableau_bitmap; 
@@ -103,16 +200,22 @@ tableau_t* tableau_create(const size_t n_qubits)
     // TODO: eliminate this and just use pointer arithmetic
     for (size_t i = 0; i < n_ptrs; i++)
     {   
-        uint8_t* ptr_z = z_start + (i * slice_len_bytes);
-        uint8_t* ptr_x = x_start + (i * slice_len_bytes);
+        tab->slices_z[i] = (tableau_slice_p)((uint8_t*)z_start + (i * slice_len_bytes)); 
+        tab->slices_x[i] = (tableau_slice_p)((uint8_t*)x_start + (i * slice_len_bytes)); 
+    }
 
-        tab->slices_z[i] = (tableau_slice_p)ptr_z; 
-        // One write per cache line entry, should be collision free 
-        slice_set_bit(tab->slices_z[i], i, 1); 
-        tab->slices_x[i] = (tableau_slice_p)ptr_x; 
+    if (TABLEAU_ALLOC_FIRST_TOUCH == policy)
+    {
+        size_t n_rows = n_ptrs;
+        threadpool_distribute_tableau_operation_args(tab, tableau_first_touch, 0, NULL_TARG, &n_rows);
+        return tab;
+    }
 
-        // TODO: Remove
-        assert(tab->slices_x[i][0] == 0ull);
+    // One write per cache line entry, should be collision free 
+    // The X half is left untouched so mapped pages are only faulted in once a gate reaches them
+    for (size_t i = 0; i < n_ptrs; i++)
+    {   
+        slice_set_bit(tab->slices_z[i], i, 1); 
     }
     return tab;
 }
@@ -129,8 +232,89 @@ void tableau_set_n_qubits(tableau_t* tab, const size_t n_qubits)
 {
     tab->n_qubits = n_qubits; 
     tab->slice_len = SLICE_LEN_BYTES(n_qubits, CACHE_SIZE); 
+    if (tab->active_len > tab->slice_len)
+    {
+        tab->active_len = tab->slice_len;
+    }
+}
+
+/*
+ * tableau_set_active_qubits
+ * Sets the high water mark of live rows in the tableau
+ * :: tab : tableau_t* :: The tableau
+ * :: n_active : const size_t :: Number of live rows
+ * Gate kernels only act on the first active_len bytes of each slice
+ * Rows past the high water mark must still be in their initial identity state
+ */
+void tableau_set_active_qubits(tableau_t* tab, const size_t n_active)
+{
+    const size_t active_len = TABLEAU_ACTIVE_LEN_BYTES(n_active);
+    tab->active_len = (active_len < tab->slice_len) ? active_len : tab->slice_len; 
+}
+
+
+/*
+ * tableau_reset
+ * Returns a tableau to the all zero state without reallocating
+ * :: tab : tableau_t* :: Tableau to reset
+ * :: n_dirty : const size_t :: Number of qubits that gates or a decomposition have acted on
+ * Columns below n_dirty are cleared over the live region, past it only the diagonal word can have changed
+ * Leaves the live region covering n_dirty qubits
+ */
+void tableau_reset(tableau_t* tab, const size_t n_dirty)
+{
+    assert(0 == tab->active_start);
+    const size_t n_ptrs = tab->n_qubits + !!(tab->n_qubits % CACHE_SIZE) * (CACHE_SIZE - (tab->n_qubits % CACHE_SIZE));
+    const size_t n_cleared = (n_dirty < n_ptrs) ? n_dirty : n_ptrs;
+
+    for (size_t i = 0; i < n_cleared; i++)
+    {
+        memset(tab->slices_x[i], 0x00, tab->active_len);
+        memset(tab->slices_z[i], 0x00, tab->active_len);
+        __inline_slice_set_bit(tab->slices_z[i], i, 1);
+    }
+
+    // Idle qubits are only ever moved between X and Z on their own diagonal
+    for (size_t i = n_cleared; i < n_ptrs; i++)
+    {
+        __inline_slice_set_bit(tab->slices_x[i], i, 0);
+        __inline_slice_set_bit(tab->slices_z[i], i, 1);
+    }
+    memset(tab->phases, 0x00, tab->active_len);
+
+    tab->orientation = COL_MAJOR;
+    tableau_set_active_qubits(tab, n_cleared);
 }
 
+/*
+ * tableau_grow
+ * Moves a column major tableau into a larger allocation
+ * :: tab : tableau_t* :: Tableau to grow, freed by this call
+ * :: n_qubits : const size_t :: New number of qubits
+ * :: alloc_policy : const uint8_t :: TABLEAU_ALLOC_* policy for the new bitmap
+ * Only the live region of each slice is copied, rows and columns past it are still in the identity state
+ * Returns the new tableau with the same live region
+ */
+tableau_t* tableau_grow(tableau_t* tab, const size_t n_qubits, const uint8_t alloc_policy)
+{
+    assert(COL_MAJOR == tab->orientation);
+    assert(0 == tab->active_start);
+    assert(n_qubits >= tab->n_qubits);
+
+    tableau_t* grown = tableau_create_alloc(n_qubits, alloc_policy);
+    grown->active_len = tab->active_len;
+
+    // Slices are re-strided, so each live region is copied on its own
+    for (size_t i = 0; i < tab->n_qubits; i++)
+    {
+        memcpy(grown->slices_x[i], tab->slices_x[i], tab->active_len);
+        memcpy(grown->slices_z[i], tab->slices_z[i], tab->active_len);
+    }
+    memcpy(grown->phases, tab->phases, tab->active_len);
+
+    tableau_destroy(tab);
+    return grown;
+}
 
 /*
  * tableau_destroy 
@@ -144,7 +328,14 @@ void tableau_destroy(tableau_t* tab)
 
     free(tab->slices_x);
     free(tab->slices_z);
-    free(tab->chunks);
+    if (TABLEAU_ALLOC_ALIGNED == tab->alloc_policy)
+    {
+        free(tab->chunks);
+    }
+    else
+    {
+        munmap(tab->chunks, tab->alloc_bytes);
+    }
     free(tab->phases);
     free(tab);
     return;
@@ -590,41 +781,3 @@ void tableau_rowsum(tableau_t* tab, const size_t ctrl, const size_t targ)
     slice_set_bit(tab->phases, targ, phase);
 }
 
-
-/*
- * Calculates the rowsum starting from an offset 
- * :: tab : tableau_t* :: Tableau object
- * :: ctrl : const size_t :: Control qubit
- * :: targ : const size_t :: Target qubit
- * :: offset : const size_t :: Offset qubit index 
- */
-static inline
-void __inline_tableau_rowsum_offset(tableau_t* tab, const size_t ctrl, const size_t targ, const size_t offset)
-{
-    const size_t offset_bytes = (offset / 256) * 8; 
-
-    tableau_slice* slice_ctrl_x = (tableau_slice*)((void*)(tab->slices_x[ctrl]) + offset_bytes); 
-    tableau_slice* slice_ctrl_z = (tableau_slice*)((void*)(tab->slices_z[ctrl]) + offset_bytes); 
-    tableau_slice* slice_targ_x = (tableau_slice*)((void*)(tab->slices_x[targ]) + offset_bytes); 
-    tableau_slice* slice_targ_z = (tableau_slice*)((void*)(tab->slices_z[targ]) + offset_bytes); 
-
-    int8_t phase = simd_rowsum_cnf(
-        tab->slice_len - offset_bytes,
-        slice_ctrl_x,
-        slice_ctrl_z,
-        slice_targ_x,
-        slice_targ_z);
-
-    // Inlining will remove this as a blocking load
-    int8_t c_phase = slice_get_bit(tab->phases, ctrl) << 1;
-    int8_t t_phase = slice_get_bit(tab->phases, targ) << 1;
-
-    // https://arxiv.org/pdf/quant-ph/0406196 Page 4
-    phase = ((c_phase + t_phase + phase) % 4) >> 1;
-
-    slice_set_bit(tab->phases, targ, phase);
-}
-void tableau_rowsum_offset(tableau_t* tab, const size_t ctrl, const size_t targ, const size_t offset)
-{
-    __inline_tableau_rowsum_offset(tab, ctrl, targ, offset);
-}
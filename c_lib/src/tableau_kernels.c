@@ -0,0 +1,268 @@
+#define TABLEAU_KERNELS_SRC
+#define TABLEAU_OPERATIONS_SRC
+
+#include <stdio.h>
+
+#include "tableau_operations.h"
+#include "tableau_kernels.h"
+#include "simd_transpose.h"
+#include "simd_rowsum.h"
+#include "rowswap.h"
+#include "transverse_hadamard.h"
+
+#define KERNEL_ENTRY_SCALAR(gate, ...) scalar_tableau_##gate,
+#define KERNEL_ENTRY_AVX2(gate, ...) avx2_tableau_##gate,
+#define KERNEL_ENTRY_AVX512(gate, ...) avx512_tableau_##gate,
+#define KERNEL_ENTRY_NEON(gate, ...) neon_tableau_##gate,
+
+static const struct tableau_kernels_t TABLEAU_KERNELS_SCALAR_SET = {
+    .backend = TABLEAU_KERNELS_SCALAR,
+    .name = "scalar",
+    .single_qubit = {LOCAL_CLIFFORD_TRUTH_TABLES(KERNEL_ENTRY_SCALAR)},
+    .two_qubit = {scalar_tableau_CNOT, scalar_tableau_CZ},
+    .fused_two_qubit = {scalar_tableau_fused_CNOT, scalar_tableau_fused_CZ},
+    .rowsum_cnf = scalar_rowsum_cnf,
+    .row_swap = scalar_row_swap,
+    .transpose_64x64 = scalar_transpose_64x64,
+    .transpose_64x64_inplace = scalar_transpose_64x64_inplace,
+    .transverse_hadamard = scalar_tableau_transverse_hadamard
+};
+
+#if defined(__x86_64__)
+static const struct tableau_kernels_t TABLEAU_KERNELS_AVX2_SET = {
+    .backend = TABLEAU_KERNELS_AVX2,
+    .name = "avx2",
+    .single_qubit = {LOCAL_CLIFFORD_TRUTH_TABLES(KERNEL_ENTRY_AVX2)},
+    .two_qubit = {avx2_tableau_CNOT, avx2_tableau_CZ},
+    .fused_two_qubit = {avx2_tableau_fused_CNOT, avx2_tableau_fused_CZ},
+    .rowsum_cnf = avx2_rowsum_cnf,
+    .row_swap = avx2_row_swap,
+    .transpose_64x64 = avx2_transpose_64x64,
+    .transpose_64x64_inplace = avx2_transpose_64x64_inplace,
+    .transverse_hadamard = avx2_tableau_transverse_hadamard
+};
+
+// The transposes and the transverse hadamard are bound by the gathers, so the AVX2 versions are kept
+static const struct tableau_kernels_t TABLEAU_KERNELS_AVX512_SET = {
+    .backend = TABLEAU_KERNELS_AVX512,
+    .name = "avx512",
+    .single_qubit = {LOCAL_CLIFFORD_TRUTH_TABLES(KERNEL_ENTRY_AVX512)},
+    .two_qubit = {avx512_tableau_CNOT, avx512_tableau_CZ},
+    .fused_two_qubit = {avx512_tableau_fused_CNOT, avx512_tableau_fused_CZ},
+    .rowsum_cnf = avx512_rowsum_cnf,
+    .row_swap = avx512_row_swap,
+    .transpose_64x64 = avx2_transpose_64x64,
+    .transpose_64x64_inplace = avx2_transpose_64x64_inplace,
+    .transverse_hadamard = avx2_tableau_transverse_hadamard
+};
+#elif defined(__arm__) || defined(__aarch64__)
+static const struct tableau_kernels_t TABLEAU_KERNELS_NEON_SET = {
+    .backend = TABLEAU_KERNELS_NEON,
+    .name = "neon",
+    .single_qubit = {LOCAL_CLIFFORD_TRUTH_TABLES(KERNEL_ENTRY_NEON)},
+    .two_qubit = {neon_tableau_CNOT, neon_tableau_CZ},
+    .fused_two_qubit = {neon_tableau_fused_CNOT, neon_tableau_fused_CZ},
+    .rowsum_cnf = neon_rowsum_cnf,
+    .row_swap = neon_row_swap,
+    .transpose_64x64 = neon_transpose_64x64,
+    .transpose_64x64_inplace = neon_transpose_64x64_inplace,
+    .transverse_hadamard = neon_tableau_transverse_hadamard
+};
+#endif
+
+static const char* TABLEAU_KERNELS_NAMES[TABLEAU_KERNELS_N_BACKENDS] = {"scalar", "avx2", "avx512", "neon"};
+
+static uint8_t TABLEAU_KERNELS_INITIALISED = 0;
+
+
+/*
+ * __inline_tableau_kernels_set
+ * Gets the kernel set for a backend
+ * :: backend : const uint8_t :: One of the TABLEAU_KERNELS_* backends
+ * Returns NULL if the backend was not compiled for this architecture
+ */
+static inline
+struct tableau_kernels_t const* __inline_tableau_kernels_set(const uint8_t backend)
+{
+    switch (backend)
+    {
+        case TABLEAU_KERNELS_SCALAR:
+            return &TABLEAU_KERNELS_SCALAR_SET;
+        #if defined(__x86_64__)
+        case TABLEAU_KERNELS_AVX2:
+            return &TABLEAU_KERNELS_AVX2_SET;
+        case TABLEAU_KERNELS_AVX512:
+            return &TABLEAU_KERNELS_AVX512_SET;
+        #elif defined(__arm__) || defined(__aarch64__)
+        case TABLEAU_KERNELS_NEON:
+            return &TABLEAU_KERNELS_NEON_SET;
+        #endif
+        default:
+            return NULL;
+    }
+}
+
+
+uint8_t tableau_kernels_backend_supported(const uint8_t backend)
+{
+    if (NULL == __inline_tableau_kernels_set(backend))
+    {
+        return 0;
+    }
+
+    #if defined(__x86_64__)
+    __builtin_cpu_init();
+    const uint8_t avx2 = __builtin_cpu_supports("avx2")
+        && __builtin_cpu_supports("bmi2")
+        && __builtin_cpu_supports("popcnt");
+    switch (backend)
+    {
+        case TABLEAU_KERNELS_AVX2:
+            return avx2;
+        case TABLEAU_KERNELS_AVX512:
+            return avx2
+                && __builtin_cpu_supports("avx512f")
+                && __builtin_cpu_supports("avx512bw")
+                && __builtin_cpu_supports("avx512dq")
+                && __builtin_cpu_supports("avx512vl");
+    }
+    #endif
+
+    // Scalar kernels run anywhere and NEON is part of the base ARM targets
+    return 1;
+}
+
+
+const char* tableau_kernels_backend_name(const uint8_t backend)
+{
+    assert(backend < TABLEAU_KERNELS_N_BACKENDS);
+    return TABLEAU_KERNELS_NAMES[backend];
+}
+
+
+uint8_t tableau_kernels_set_backend(const uint8_t backend)
+{
+    if (!tableau_kernels_backend_supported(backend))
+    {
+        return 0;
+    }
+
+    TABLEAU_KERNELS_g = *__inline_tableau_kernels_set(backend);
+    memcpy(SINGLE_QUBIT_OPERATIONS, TABLEAU_KERNELS_g.single_qubit, sizeof(TABLEAU_KERNELS_g.single_qubit));
+    memcpy(TWO_QUBIT_OPERATIONS, TABLEAU_KERNELS_g.two_qubit, sizeof(TABLEAU_KERNELS_g.two_qubit));
+    memcpy(FUSED_TWO_QUBIT_OPERATIONS, TABLEAU_KERNELS_g.fused_two_qubit, sizeof(TABLEAU_KERNELS_g.fused_two_qubit));
+    TABLEAU_KERNELS_INITIALISED = 1;
+    return 1;
+}
+
+
+uint8_t tableau_kernels_backend(void)
+{
+    tableau_kernels_init();
+    return TABLEAU_KERNELS_g.backend;
+}
+
+
+void __attribute__((constructor)) tableau_kernels_init(void)
+{
+    if (TABLEAU_KERNELS_INITIALISED)
+    {
+        return;
+    }
+
+    const char* env = getenv(TABLEAU_KERNELS_ENV_BACKEND);
+    if (NULL != env)
+    {
+        for (uint8_t backend = 0; backend < TABLEAU_KERNELS_N_BACKENDS; backend++)
+        {
+            if (0 == strcmp(env, TABLEAU_KERNELS_NAMES[backend]) && tableau_kernels_set_backend(backend))
+            {
+                return;
+            }
+        }
+        fprintf(stderr, "%s=%s is not supported on this host, detecting the kernel set instead\n", TABLEAU_KERNELS_ENV_BACKEND, env);
+    }
+
+    // Widest first
+    static const uint8_t preference[] = {
+        TABLEAU_KERNELS_AVX512,
+        TABLEAU_KERNELS_AVX2,
+        TABLEAU_KERNELS_NEON,
+        TABLEAU_KERNELS_SCALAR
+    };
+    for (size_t i = 0; i < sizeof(preference); i++)
+    {
+        if (tableau_kernels_set_backend(preference[i]))
+        {
+            return;
+        }
+    }
+}
+
+
+/*
+ * Dispatched kernels
+ * Public entry points forward to the active kernel set
+ */
+#define DISPATCH_LOCAL_CLIFFORD(gate, ...) \
+void tableau_##gate(tableau_t* tab, const size_t targ) \
+{ \
+    SINGLE_QUBIT_OPERATIONS[_##gate##_ & INSTRUCTION_OPERATOR_MASK](tab, targ); \
+}
+
+LOCAL_CLIFFORD_TRUTH_TABLES(DISPATCH_LOCAL_CLIFFORD)
+
+void tableau_CNOT(tableau_t* tab, const size_t ctrl, const size_t targ)
+{
+    TWO_QUBIT_OPERATIONS[_CNOT_ & INSTRUCTION_OPERATOR_MASK](tab, ctrl, targ);
+}
+
+void tableau_CZ(tableau_t* tab, const size_t ctrl, const size_t targ)
+{
+    TWO_QUBIT_OPERATIONS[_CZ_ & INSTRUCTION_OPERATOR_MASK](tab, ctrl, targ);
+}
+
+void tableau_fused_CNOT(tableau_t* tab, const instruction_t ctrl_clifford, const size_t ctrl, const instruction_t targ_clifford, const size_t targ)
+{
+    FUSED_TWO_QUBIT_OPERATIONS[_CNOT_ & INSTRUCTION_OPERATOR_MASK](tab, ctrl_clifford, ctrl, targ_clifford, targ);
+}
+
+void tableau_fused_CZ(tableau_t* tab, const instruction_t ctrl_clifford, const size_t ctrl, const instruction_t targ_clifford, const size_t targ)
+{
+    FUSED_TWO_QUBIT_OPERATIONS[_CZ_ & INSTRUCTION_OPERATOR_MASK](tab, ctrl_clifford, ctrl, targ_clifford, targ);
+}
+
+int8_t simd_rowsum_cnf(
+    const size_t n_bytes,
+    void* restrict ctrl_x,
+    void* restrict ctrl_z,
+    void* restrict targ_x,
+    void* restrict targ_z)
+{
+    return TABLEAU_KERNELS_g.rowsum_cnf(n_bytes, ctrl_x, ctrl_z, targ_x, targ_z);
+}
+
+void simd_row_swap(
+    const size_t n_bytes,
+    void* restrict ctrl_x,
+    void* restrict ctrl_z,
+    void* restrict targ_x,
+    void* restrict targ_z)
+{
+    TABLEAU_KERNELS_g.row_swap(n_bytes, ctrl_x, ctrl_z, targ_x, targ_z);
+}
+
+void simd_transpose_64x64(uint64_t* restrict src[64], uint64_t* restrict targ[64])
+{
+    TABLEAU_KERNELS_g.transpose_64x64(src, targ);
+}
+
+void simd_transpose_64x64_inplace(uint64_t* src[64])
+{
+    TABLEAU_KERNELS_g.transpose_64x64_inplace(src);
+}
+
+void simd_tableau_transverse_hadamard(tableau_t const* tab, const size_t targ)
+{
+    TABLEAU_KERNELS_g.transverse_hadamard(tab, targ);
+}
@@ -0,0 +1,480 @@
+#define _GNU_SOURCE // pthread_setaffinity_np
+#define THREADPOOL_SRC
+#include "threadpool.h"
+
+#include <sched.h>
+
+#if defined(__x86_64__)
+    #define THREADPOOL_RELAX() __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+    #define THREADPOOL_RELAX() __asm__ volatile("yield")
+#else
+    #define THREADPOOL_RELAX() sched_yield()
+#endif
+
+static __thread size_t THREADPOOL_WORKER_ID = SIZE_MAX; // SIZE_MAX for threads outside the pool
+static struct threadpool_arg THREADPOOL_ARGS[THREADPOOL_MAX_WORKERS];
+
+
+static inline
+void __inline_deque_lock(struct threadpool_deque_t* deque)
+{
+    while (__atomic_exchange_n(&deque->lock, 1, __ATOMIC_ACQUIRE))
+    {
+        while (__atomic_load_n(&deque->lock, __ATOMIC_RELAXED))
+        {
+            THREADPOOL_RELAX();
+        }
+    }
+}
+
+
+static inline
+void __inline_deque_unlock(struct threadpool_deque_t* deque)
+{
+    __atomic_store_n(&deque->lock, 0, __ATOMIC_RELEASE);
+}
+
+
+/*
+ * __inline_deque_push
+ * Pushes a job onto the bottom of a deque
+ * :: deque : struct threadpool_deque_t* :: Target deque
+ * :: job : struct threadpool_job :: Job to push
+ * Returns false if the deque is full
+ */
+static inline
+bool __inline_deque_push(struct threadpool_deque_t* deque, struct threadpool_job job)
+{
+    __inline_deque_lock(deque);
+    if (deque->bottom - deque->top == THREADPOOL_DEQUE_SIZE)
+    {
+        __inline_deque_unlock(deque);
+        return false;
+    }
+    deque->jobs[deque->bottom & THREADPOOL_DEQUE_MASK] = job;
+    // Indices are read without the lock by the empty check in __inline_deque_take
+    __atomic_store_n(&deque->bottom, deque->bottom + 1, __ATOMIC_RELAXED);
+
+    // Counted before the job becomes visible to thieves so a barrier cannot miss it
+    if (NULL != job.batch)
+    {
+        __atomic_add_fetch(&job.batch->n_pending, 1, __ATOMIC_SEQ_CST);
+    }
+    __atomic_add_fetch(&THREADPOOL_g.n_pending, 1, __ATOMIC_SEQ_CST);
+    __atomic_add_fetch(&THREADPOOL_g.n_queued, 1, __ATOMIC_SEQ_CST);
+    __inline_deque_unlock(deque);
+    return true;
+}
+
+
+/*
+ * __inline_deque_take
+ * Removes a job from a deque
+ * :: deque : struct threadpool_deque_t* :: Deque to take from
+ * :: job : struct threadpool_job* :: Written with the job on success
+ * :: steal : const bool :: Take from the top rather than the bottom
+ * Returns false if the deque is empty
+ */
+static inline
+bool __inline_deque_take(struct threadpool_deque_t* deque, struct threadpool_job* job, const bool steal)
+{
+    if (__atomic_load_n(&deque->bottom, __ATOMIC_RELAXED) == __atomic_load_n(&deque->top, __ATOMIC_RELAXED))
+    {
+        return false;
+    }
+
+    __inline_deque_lock(deque);
+    if (deque->bottom == deque->top)
+    {
+        __inline_deque_unlock(deque);
+        return false;
+    }
+    if (steal)
+    {
+        *job = deque->jobs[deque->top & THREADPOOL_DEQUE_MASK];
+        __atomic_store_n(&deque->top, deque->top + 1, __ATOMIC_RELAXED);
+    }
+    else
+    {
+        __atomic_store_n(&deque->bottom, deque->bottom - 1, __ATOMIC_RELAXED);
+        *job = deque->jobs[deque->bottom & THREADPOOL_DEQUE_MASK];
+    }
+    __atomic_sub_fetch(&THREADPOOL_g.n_queued, 1, __ATOMIC_SEQ_CST);
+    __inline_deque_unlock(deque);
+    return true;
+}
+
+
+/*
+ * __inline_threadpool_get_job
+ * Pops from the local deque, then attempts to steal from the others
+ * :: worker_id : const size_t :: Calling worker, SIZE_MAX for external threads
+ * :: job : struct threadpool_job* :: Written with the job on success
+ */
+static inline
+bool __inline_threadpool_get_job(const size_t worker_id, struct threadpool_job* job)
+{
+    if (0 == __atomic_load_n(&THREADPOOL_g.n_queued, __ATOMIC_SEQ_CST))
+    {
+        return false;
+    }
+
+    const size_t n_workers = THREADPOOL_g.n_workers;
+    size_t start = 0;
+    if (worker_id != SIZE_MAX)
+    {
+        if (__inline_deque_take(THREADPOOL_g.deques + worker_id, job, false))
+        {
+            return true;
+        }
+        start = worker_id + 1;
+    }
+
+    for (size_t i = 0; i < n_workers; i++)
+    {
+        const size_t victim = (start + i) % n_workers;
+        if (victim != worker_id && __inline_deque_take(THREADPOOL_g.deques + victim, job, true))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+static inline
+void __inline_threadpool_run_job(struct threadpool_job* job)
+{
+    // The batch belongs to a waiting caller and may go out of scope once its count drops
+    threadpool_batch_t* batch = job->batch;
+    job->fn(job->args);
+    if (NULL != batch)
+    {
+        __atomic_sub_fetch(&batch->n_pending, 1, __ATOMIC_SEQ_CST);
+    }
+    __atomic_sub_fetch(&THREADPOOL_g.n_pending, 1, __ATOMIC_SEQ_CST);
+}
+
+
+/*
+ * threadpool_worker
+ * Threadpool worker function
+ * :: args : void* :: struct threadpool_arg* owned by the worker
+ * Pops jobs from its own deque and steals from the other workers when empty
+ * Idle workers spin briefly before sleeping on the wake condition
+ * Returns NULL
+ */
+void* threadpool_worker(void* args)
+{
+    const size_t worker_id = ((struct threadpool_arg*)args)->thread_id;
+    THREADPOOL_WORKER_ID = worker_id;
+
+    struct threadpool_job job;
+    size_t spins = 0;
+    while (__atomic_load_n(&THREADPOOL_g.alive, __ATOMIC_ACQUIRE))
+    {
+        if (__inline_threadpool_get_job(worker_id, &job))
+        {
+            __inline_threadpool_run_job(&job);
+            spins = 0;
+            continue;
+        }
+
+        if (spins++ < THREADPOOL_SPIN_ITERS)
+        {
+            THREADPOOL_RELAX();
+            continue;
+        }
+
+        // Submitters bump n_queued before reading n_sleeping, so no wakeup is lost
+        pthread_mutex_lock(&THREADPOOL_g.sleep_lock);
+        __atomic_add_fetch(&THREADPOOL_g.n_sleeping, 1, __ATOMIC_SEQ_CST);
+        while (__atomic_load_n(&THREADPOOL_g.alive, __ATOMIC_ACQUIRE)
+            && 0 == __atomic_load_n(&THREADPOOL_g.n_queued, __ATOMIC_SEQ_CST))
+        {
+            pthread_cond_wait(&THREADPOOL_g.wake, &THREADPOOL_g.sleep_lock);
+        }
+        __atomic_sub_fetch(&THREADPOOL_g.n_sleeping, 1, __ATOMIC_SEQ_CST);
+        pthread_mutex_unlock(&THREADPOOL_g.sleep_lock);
+        spins = 0;
+    }
+    return NULL;
+}
+
+
+/*
+ * threadpool_add_task
+ * Adds a job to the threadpool
+ * :: fn : void (*)(void*) :: Job function
+ * :: args : void* :: Arguments to the job, owned by the caller
+ * Jobs submitted from a worker land on that worker's deque
+ * If the target deque is full the job is run inline
+ */
+void threadpool_add_task(void (*fn)(void*), void* args)
+{
+    threadpool_batch_add_task(NULL, fn, args);
+}
+
+
+/*
+ * threadpool_batch_add_task
+ * Adds a job to the threadpool as part of a batch
+ * :: batch : threadpool_batch_t* :: Batch to count the job against, must outlive the job
+ * :: fn : void (*)(void*) :: Job function
+ * :: args : void* :: Arguments to the job, owned by the caller
+ * Otherwise as threadpool_add_task
+ */
+void threadpool_batch_add_task(threadpool_batch_t* batch, void (*fn)(void*), void* args)
+{
+    if (!THREADPOOL_INITIALISED)
+    {
+        fn(args);
+        return;
+    }
+
+    size_t target = THREADPOOL_WORKER_ID;
+    if (target == SIZE_MAX)
+    {
+        target = __atomic_fetch_add(&THREADPOOL_g.next_deque, 1, __ATOMIC_RELAXED) % THREADPOOL_g.n_workers;
+    }
+
+    struct threadpool_job job = {.fn = fn, .args = args, .batch = batch};
+    if (!__inline_deque_push(THREADPOOL_g.deques + target, job))
+    {
+        fn(args);
+        return;
+    }
+
+    if (__atomic_load_n(&THREADPOOL_g.n_sleeping, __ATOMIC_SEQ_CST))
+    {
+        pthread_mutex_lock(&THREADPOOL_g.sleep_lock);
+        pthread_cond_signal(&THREADPOOL_g.wake);
+        pthread_mutex_unlock(&THREADPOOL_g.sleep_lock);
+    }
+}
+
+
+/*
+ * threadpool_distribute_tableau_operation
+ * Distributes a tableau operation over the workers
+ * :: tab : tableau_t* :: Tableau to operate over
+ * :: fn : void (*)(void*) :: Function to distribute, receives a struct distributed_tableau_op*
+ * :: ctrl : const size_t :: First qubit
+ * :: targ : const size_t :: Second qubit, set to NULL_TARG to null
+ * Splits the live region of the tableau into one stripe per worker
+ * Returns once all stripes have completed
+ */
+void threadpool_distribute_tableau_operation(
+    tableau_t* tab,
+    void (*fn)(void*),
+    const size_t ctrl,
+    const size_t targ)
+{
+    threadpool_distribute_tableau_operation_args(tab, fn, ctrl, targ, NULL);
+}
+
+
+/*
+ * threadpool_distribute_tableau_operation_args
+ * As threadpool_distribute_tableau_operation, with extra arguments shared by every stripe
+ * :: args : void* :: Passed through as the args member of each struct distributed_tableau_op
+ */
+void threadpool_distribute_tableau_operation_args(
+    tableau_t* tab,
+    void (*fn)(void*),
+    const size_t ctrl,
+    const size_t targ,
+    void* args)
+{
+    // Stripes are cache line aligned so that workers never share a line
+    const size_t n_lines = (tab->active_len - tab->active_start) / CACHE_SIZE;
+    size_t n_stripes = threadpool_n_workers();
+    n_stripes = (n_stripes < n_lines) ? n_stripes : n_lines;
+    n_stripes = (n_stripes > 0) ? n_stripes : 1;
+
+    struct distributed_tableau_op ops[THREADPOOL_MAX_WORKERS];
+    for (size_t i = 0; i < n_stripes; i++)
+    {
+        ops[i].tab = tab;
+        ops[i].ctrl = ctrl;
+        ops[i].targ = targ;
+        ops[i].start = tab->active_start + ((n_lines * i) / n_stripes) * CACHE_SIZE;
+        ops[i].stop = tab->active_start + ((n_lines * (i + 1)) / n_stripes) * CACHE_SIZE;
+        ops[i].args = args;
+    }
+    ops[n_stripes - 1].stop = tab->active_len;
+
+    threadpool_batch_t batch = THREADPOOL_BATCH_INIT;
+    for (size_t i = 1; i < n_stripes; i++)
+    {
+        threadpool_batch_add_task(&batch, fn, ops + i);
+    }
+    fn(ops);
+    threadpool_batch_wait(&batch);
+}
+
+
+/*
+ * __inline_threadpool_wait
+ * Runs queued jobs until a pending counter drops to zero
+ * :: n_pending : size_t* :: Counter to wait on
+ */
+static inline
+void __inline_threadpool_wait(size_t* n_pending)
+{
+    struct threadpool_job job;
+    while (__atomic_load_n(n_pending, __ATOMIC_SEQ_CST))
+    {
+        if (__inline_threadpool_get_job(THREADPOOL_WORKER_ID, &job))
+        {
+            __inline_threadpool_run_job(&job);
+        }
+        else
+        {
+            THREADPOOL_RELAX();
+        }
+    }
+}
+
+
+/*
+ * threadpool_batch_wait
+ * Blocks until every job in the batch has completed
+ * :: batch : threadpool_batch_t* :: Batch to wait on
+ * The calling thread runs queued jobs while it waits
+ * Safe to call from inside a pool job
+ */
+void threadpool_batch_wait(threadpool_batch_t* batch)
+{
+    if (!THREADPOOL_INITIALISED)
+    {
+        return;
+    }
+    __inline_threadpool_wait(&batch->n_pending);
+}
+
+
+/*
+ * threadpool_barrier
+ * Blocks until every submitted job has completed, including jobs in other threads' batches
+ * The calling thread runs queued jobs while it waits
+ * Only for draining the pool, code that waits on its own jobs should use a batch
+ */
+void threadpool_barrier()
+{
+    if (!THREADPOOL_INITIALISED)
+    {
+        return;
+    }
+    __inline_threadpool_wait(&THREADPOOL_g.n_pending);
+}
+
+
+/*
+ * threadpool_join
+ * Waits for outstanding jobs, stops the workers and joins their threads
+ */
+void threadpool_join()
+{
+    threadpool_barrier();
+
+    pthread_mutex_lock(&THREADPOOL_g.sleep_lock);
+    __atomic_store_n(&THREADPOOL_g.alive, false, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&THREADPOOL_g.wake);
+    pthread_mutex_unlock(&THREADPOOL_g.sleep_lock);
+
+    for (size_t i = 0; i < THREADPOOL_g.active_workers; i++)
+    {
+        pthread_join(THREADPOOL_g.workers[i], NULL);
+    }
+    THREADPOOL_g.active_workers = 0;
+}
+
+
+/*
+ * threadpool_destroy
+ * Joins the workers and releases the pool
+ * The pool may be initialised again afterwards
+ */
+void threadpool_destroy()
+{
+    if (!THREADPOOL_INITIALISED)
+    {
+        return;
+    }
+    threadpool_join();
+    free(THREADPOOL_g.deques);
+    pthread_mutex_destroy(&THREADPOOL_g.sleep_lock);
+    pthread_cond_destroy(&THREADPOOL_g.wake);
+    THREADPOOL_INITIALISED = false;
+}
+
+
+/*
+ * threadpool_init
+ * Starts the pool
+ * :: n_workers : const size_t :: Number of worker threads, 0 reads CABALISER_N_THREADS and falls back to the number of online CPUs
+ * :: flags : const uint32_t :: THREADPOOL_PIN_WORKERS to pin workers to CPUs
+ * Calling init on a running pool restarts it with the new configuration
+ */
+void threadpool_init(const size_t n_workers, const uint32_t flags)
+{
+    threadpool_destroy();
+
+    const long n_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t n = n_workers;
+    if (0 == n)
+    {
+        const char* env = getenv(THREADPOOL_ENV_N_WORKERS);
+        n = (NULL != env) ? strtoull(env, NULL, 10) : 0;
+    }
+    if (0 == n)
+    {
+        n = (n_cpus > 0) ? n_cpus : 1;
+    }
+    n = (n < THREADPOOL_MAX_WORKERS) ? n : THREADPOOL_MAX_WORKERS;
+
+    THREADPOOL_g.n_workers = n;
+    THREADPOOL_g.flags = flags;
+    THREADPOOL_g.n_queued = 0;
+    THREADPOOL_g.n_pending = 0;
+    THREADPOOL_g.n_sleeping = 0;
+    THREADPOOL_g.next_deque = 0;
+    THREADPOOL_g.alive = true;
+    THREADPOOL_g.deques = aligned_alloc(CACHE_SIZE, n * sizeof(struct threadpool_deque_t));
+    assert(NULL != THREADPOOL_g.deques);
+    memset(THREADPOOL_g.deques, 0, n * sizeof(struct threadpool_deque_t));
+
+    pthread_mutex_init(&THREADPOOL_g.sleep_lock, NULL);
+    pthread_cond_init(&THREADPOOL_g.wake, NULL);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        THREADPOOL_ARGS[i].thread_id = i;
+        const int err = pthread_create(THREADPOOL_g.workers + i, NULL, threadpool_worker, THREADPOOL_ARGS + i);
+        assert(0 == err);
+
+        #ifdef __linux__
+        if (flags & THREADPOOL_PIN_WORKERS)
+        {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(i % ((n_cpus > 0) ? n_cpus : 1), &cpus);
+            pthread_setaffinity_np(THREADPOOL_g.workers[i], sizeof(cpu_set_t), &cpus);
+        }
+        #endif
+    }
+    THREADPOOL_g.active_workers = n;
+    THREADPOOL_INITIALISED = true;
+}
+
+
+/*
+ * threadpool_n_workers
+ * Number of workers in the pool, 1 if the pool is not running
+ */
+size_t threadpool_n_workers()
+{
+    return THREADPOOL_INITIALISED ? THREADPOOL_g.n_workers : 1;
+}
@@ -1,4 +1,19 @@
 #include "widget.h"
+#include "threadpool.h"
+
+/*
+ * __inline_widget_free_csr
+ * Frees the compact graph left by widget_finalise
+ * :: wid : widget_t* :: Finalised widget
+ */
+static inline
+void __inline_widget_free_csr(widget_t* wid)
+{
+    free(wid->csr->offsets);
+    free(wid->csr->neighbours);
+    free(wid->csr);
+    wid->csr = NULL;
+}
 
 /*
  * widget_create
@@ -8,6 +23,37 @@
  */
 widget_t* widget_create(const size_t initial_qubits, const size_t max_qubits)
 {
+    return widget_create_engine(initial_qubits, max_qubits, WIDGET_ENGINE_TABLEAU);
+}
+
+/*
+ * widget_create_engine
+ * Constructor for widget object with a choice of simulation engine
+ * :: initial_qubits : const size_t :: Initial number of qubits that are allocated
+ * :: max_qubits : const size_t :: Maximum number of qubits that may be allocated
+ * :: engine : const uint8_t :: WIDGET_ENGINE_TABLEAU, WIDGET_ENGINE_GRAPH or WIDGET_ENGINE_AUTO
+ */
+widget_t* widget_create_engine(const size_t initial_qubits, const size_t max_qubits, const uint8_t engine)
+{
+    return widget_create_alloc(initial_qubits, max_qubits, engine, TABLEAU_ALLOC_DEFAULT);
+}
+
+/*
+ * widget_create_alloc
+ * Constructor for widget object with a choice of engine and tableau allocation policy
+ * :: initial_qubits : const size_t :: Initial number of qubits that are allocated
+ * :: max_qubits : const size_t :: Maximum number of qubits that may be allocated
+ * :: engine : const uint8_t :: WIDGET_ENGINE_TABLEAU, WIDGET_ENGINE_GRAPH or WIDGET_ENGINE_AUTO
+ * :: alloc_policy : const uint8_t :: TABLEAU_ALLOC_* policy
+ */
+widget_t* widget_create_alloc(const size_t initial_qubits, const size_t max_qubits, const uint8_t engine, const uint8_t alloc_policy)
+{
+    assert(alloc_policy < TABLEAU_N_ALLOC_POLICIES);
+    assert(WIDGET_ENGINE_TABLEAU == engine || WIDGET_ENGINE_GRAPH == engine || WIDGET_ENGINE_AUTO == engine);
+
+    // Library constructors do not run for every embedding, so the kernel set is checked here too
+    tableau_kernels_init();
+
     // Max qubits must be a multiple of 64:
     const size_t aligned_max_qubits = max_qubits + (
             !!(max_qubits % 64)) * (64 - (max_qubits % 64)); 
@@ -16,13 +62,216 @@ widget_t* widget_create(const size_t initial_qubits, const size_t max_qubits)
     wid->n_initial_qubits = initial_qubits;
     wid->n_qubits = initial_qubits;
     wid->max_qubits = max_qubits; 
-    wid->tableau = tableau_create(aligned_max_qubits);
+    // Automatic widgets start sparse
+    wid->engine = (WIDGET_ENGINE_AUTO == engine) ? WIDGET_ENGINE_GRAPH : engine;
+    memset(&wid->engine_stats, 0, sizeof(struct widget_engine_stats_t));
+    wid->engine_stats.requested_engine = engine;
+    wid->engine_stats.engine = wid->engine;
+    memset(&wid->stats, 0, sizeof(struct widget_stats_t));
+    wid->stats.enabled = WIDGET_STATS_ENABLED;
+    wid->auto_threshold = WIDGET_AUTO_DEFAULT_THRESHOLD;
+    wid->auto_window_toggles = 0;
+    wid->alloc_policy = alloc_policy;
+
+    wid->tableau = NULL;
+    wid->graph = NULL;
+    wid->csr = NULL;
+    if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        wid->graph = graph_state_create(aligned_max_qubits);
+    }
+    else
+    {
+        wid->tableau = tableau_create_alloc(aligned_max_qubits, alloc_policy);
+        // Gates only sweep rows that are in use
+        tableau_set_active_qubits(wid->tableau, initial_qubits);
+    }
     wid->queue = clifford_queue_create(aligned_max_qubits);
     wid->q_map = qubit_map_create(initial_qubits, max_qubits); 
     wid->pauli_tracker = pauli_tracker_create(max_qubits);
     return wid;
 }
 
+/*
+ * widget_reset
+ * Returns a widget to the state widget_create would give it, reusing its allocations
+ * :: wid : widget_t* :: Widget to reset, decomposed or not
+ * :: initial_qubits : const size_t :: Initial number of qubits for the next use
+ */
+void widget_reset(widget_t* wid, const size_t initial_qubits)
+{
+    // Finalised widgets get fresh simulation state at their current capacity
+    if (NULL != wid->csr)
+    {
+        __inline_widget_free_csr(wid);
+        const size_t aligned_max_qubits = wid->max_qubits + (
+                !!(wid->max_qubits % 64)) * (64 - (wid->max_qubits % 64));
+        wid->engine = (WIDGET_ENGINE_TABLEAU == wid->engine_stats.requested_engine) ? WIDGET_ENGINE_TABLEAU : WIDGET_ENGINE_GRAPH;
+        if (WIDGET_ENGINE_GRAPH == wid->engine)
+        {
+            wid->graph = graph_state_create(aligned_max_qubits);
+        }
+        else
+        {
+            wid->tableau = tableau_create_alloc(aligned_max_qubits, wid->alloc_policy);
+        }
+        wid->n_qubits = 0;
+    }
+
+    widget_reserve(wid, initial_qubits);
+
+    // Every qubit the widget has used, the rest are untouched apart from the tableau diagonal
+    const size_t n_dirty = wid->n_qubits;
+    const size_t aligned_max_qubits = wid->max_qubits + (
+            !!(wid->max_qubits % 64)) * (64 - (wid->max_qubits % 64));
+
+    if (WIDGET_ENGINE_AUTO == wid->engine_stats.requested_engine && WIDGET_ENGINE_TABLEAU == wid->engine)
+    {
+        tableau_destroy(wid->tableau);
+        wid->tableau = NULL;
+        wid->graph = graph_state_create(aligned_max_qubits);
+        wid->engine = WIDGET_ENGINE_GRAPH;
+    }
+    else if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        graph_state_reset(wid->graph, n_dirty);
+    }
+    else
+    {
+        tableau_reset(wid->tableau, n_dirty);
+        tableau_set_active_qubits(wid->tableau, initial_qubits);
+    }
+
+    clifford_queue_reset(wid->queue);
+    for (size_t i = 0; i < initial_qubits; i++)
+    {
+        wid->q_map[i] = i;
+    }
+    pauli_tracker_clear(wid->pauli_tracker, wid->max_qubits);
+
+    wid->n_initial_qubits = initial_qubits;
+    wid->n_qubits = initial_qubits;
+
+    const uint8_t requested_engine = wid->engine_stats.requested_engine;
+    memset(&wid->engine_stats, 0, sizeof(struct widget_engine_stats_t));
+    wid->engine_stats.requested_engine = requested_engine;
+    wid->engine_stats.engine = wid->engine;
+    wid->auto_window_toggles = 0;
+
+    memset(&wid->stats, 0, sizeof(struct widget_stats_t));
+    wid->stats.enabled = WIDGET_STATS_ENABLED;
+}
+
+/*
+ * widget_reserve
+ * Ensures the widget has room for a number of qubits
+ * :: wid : widget_t* :: Widget to grow
+ * :: n_qubits : const size_t :: Number of qubits the widget must be able to hold
+ * Capacity grows geometrically, moving the tableau or graph, clifford queue, qubit map and Pauli tracker together
+ */
+void widget_reserve(widget_t* wid, const size_t n_qubits)
+{
+    if (n_qubits <= wid->max_qubits)
+    {
+        return;
+    }
+
+    size_t capacity = (wid->max_qubits * WIDGET_GROWTH_NUMERATOR) / WIDGET_GROWTH_DENOMINATOR;
+    capacity = (capacity > n_qubits) ? capacity : n_qubits;
+    capacity += !!(capacity % 64) * (64 - (capacity % 64));
+    DPRINT(DEBUG_1, "Growing widget from %zu to %zu qubits\n", wid->max_qubits, capacity);
+
+    if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        graph_state_grow(wid->graph, capacity);
+    }
+    else
+    {
+        wid->tableau = tableau_grow(wid->tableau, capacity, wid->alloc_policy);
+    }
+    clifford_queue_grow(wid->queue, capacity);
+    wid->q_map = qubit_map_grow(wid->q_map, capacity);
+    pauli_tracker_grow(wid->pauli_tracker, wid->max_qubits, capacity);
+    wid->max_qubits = capacity;
+}
+
+/*
+ * widget_convert_to_tableau
+ * Moves a graph engine widget onto a dense tableau
+ * :: wid : widget_t* :: Widget on the graph engine
+ * Writes the graph state to a new tableau and frees the graph, the clifford queue is untouched
+ */
+void widget_convert_to_tableau(widget_t* wid)
+{
+    assert(WIDGET_ENGINE_GRAPH == wid->engine);
+
+    // Written over every row, so qubits past the live region keep their zero state
+    wid->tableau = tableau_create_alloc(wid->graph->n_qubits, wid->alloc_policy);
+    graph_state_to_tableau(wid->graph, wid->tableau);
+    tableau_set_active_qubits(wid->tableau, wid->n_qubits);
+
+    wid->engine_stats = widget_get_engine_stats(wid);
+    wid->engine_stats.converted = 1;
+    wid->engine_stats.conversion_gate = wid->engine_stats.n_gates;
+    wid->engine_stats.conversion_qubits = wid->n_qubits;
+    wid->engine_stats.engine = WIDGET_ENGINE_TABLEAU;
+
+    graph_state_destroy(wid->graph);
+    wid->graph = NULL;
+    wid->engine = WIDGET_ENGINE_TABLEAU;
+}
+
+/*
+ * widget_set_auto_threshold
+ * Sets how dense the graph may get before an automatic widget converts
+ * :: wid : widget_t* :: The widget
+ * :: threshold : const double :: Ratio of the graph engine's cost per gate to the tableau's
+ */
+void widget_set_auto_threshold(widget_t* wid, const double threshold)
+{
+    wid->auto_threshold = threshold;
+}
+
+/*
+ * widget_get_engine_stats
+ * Reports the engine in use and the graph density
+ * :: wid : const widget_t* :: The widget
+ */
+struct widget_engine_stats_t widget_get_engine_stats(const widget_t* wid)
+{
+    struct widget_engine_stats_t stats = wid->engine_stats;
+    if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        stats.n_edges = wid->graph->n_edges;
+        stats.max_degree = wid->graph->max_degree;
+        stats.n_toggles = wid->graph->n_toggles;
+    }
+    return stats;
+}
+
+/*
+ * widget_get_stats
+ * Reports the phase timings and counters of the widget
+ * :: wid : const widget_t* :: The widget
+ */
+struct widget_stats_t widget_get_stats(const widget_t* wid)
+{
+    return wid->stats;
+}
+
+/*
+ * widget_partial_order_graph
+ * Builds the partial order graph of the measurements from the Pauli tracker
+ * :: wid : widget_t* :: The widget
+ */
+void* widget_partial_order_graph(widget_t* wid)
+{
+    void* graph;
+    WIDGET_STATS_TIME(wid, partial_order_ns,
+        graph = lib_pauli_tracker_partial_order_graph((MappedPauliTracker*)wid->pauli_tracker));
+    return graph;
+}
+
 uint8_t widget_get_clifford_from_table(widget_t* wid, size_t i) {
     return wid->queue->table[i];
 }
@@ -34,7 +283,18 @@ uint8_t widget_get_clifford_from_table(widget_t* wid, size_t i) {
  */
 void widget_destroy(widget_t* wid)
 {
-    tableau_destroy(wid->tableau);
+    if (NULL != wid->csr)
+    {
+        __inline_widget_free_csr(wid);
+    }
+    else if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        graph_state_destroy(wid->graph);
+    }
+    else
+    {
+        tableau_destroy(wid->tableau);
+    }
     clifford_queue_destroy(wid->queue);
     qubit_map_destroy(wid->q_map);
     pauli_tracker_destroy(wid->pauli_tracker);
@@ -61,6 +321,55 @@ size_t widget_get_max_qubits(const widget_t* wid)
     return wid->max_qubits;
 }
 
+/*
+ * __inline_widget_csr_adjacencies
+ * Copies one row of a finalised widget's graph into an adjacency object
+ * :: csr : const struct adjacency_csr_t* :: Compact graph
+ * :: targ : const size_t :: The row
+ */
+static inline
+struct adjacency_obj __inline_widget_csr_adjacencies(const struct adjacency_csr_t* csr, const size_t targ)
+{
+    struct adjacency_obj adj = {
+        .targ = targ,
+        .n_adjacent = csr->offsets[targ + 1] - csr->offsets[targ],
+        .adjacencies = NULL
+    };
+    if (adj.n_adjacent > 0)
+    {
+        adj.adjacencies = (uint32_t*)malloc(adj.n_adjacent * sizeof(uint32_t));
+        assert(NULL != adj.adjacencies);
+        memcpy(adj.adjacencies, csr->neighbours + csr->offsets[targ], adj.n_adjacent * sizeof(uint32_t));
+    }
+    return adj;
+}
+
+/*
+ * __inline_widget_csr_row
+ * Reads one row of a finalised widget's graph
+ * :: csr : const struct adjacency_csr_t* :: Compact graph
+ * :: targ : const size_t :: The row
+ * :: upper_triangle : const bool :: Skip columns at or below the row
+ * :: neighbours : uint32_t* :: Destination, NULL to only count
+ * Returns the number of neighbours in the row
+ */
+static inline
+size_t __inline_widget_csr_row(const struct adjacency_csr_t* csr, const size_t targ, const bool upper_triangle, uint32_t* neighbours)
+{
+    size_t start = csr->offsets[targ];
+    const size_t stop = csr->offsets[targ + 1];
+    // Rows are sorted, so the upper triangle is a suffix
+    while (upper_triangle && start < stop && csr->neighbours[start] <= targ)
+    {
+        start++;
+    }
+    if (NULL != neighbours)
+    {
+        memcpy(neighbours, csr->neighbours + start, (stop - start) * sizeof(uint32_t));
+    }
+    return stop - start;
+}
+
 /*
  * widget_get_adjacencies
  * For a qubit in the tableau, list all adjacent qubits 
@@ -70,6 +379,15 @@ size_t widget_get_max_qubits(const widget_t* wid)
  */
 struct adjacency_obj widget_get_adjacencies(const widget_t* wid, const size_t target_qubit)
 {
+    if (NULL != wid->csr)
+    {
+        return __inline_widget_csr_adjacencies(wid->csr, target_qubit);
+    }
+    if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        return graph_state_get_adjacencies(wid->graph, target_qubit);
+    }
+
     struct adjacency_obj adj; 
     adj.adjacencies = malloc(wid->n_qubits * sizeof(uint32_t));
     adj.targ = target_qubit;
@@ -88,7 +406,7 @@ struct adjacency_obj widget_get_adjacencies(const widget_t* wid, const size_t ta
             {
                 uint32_t edge =  __CHUNK_CTZ(obj);
                 obj ^= (1ull << edge);  
-                edge += i * sizeof(CHUNK_OBJ);
+                edge += i * CHUNK_SIZE_BITS;
     
                 // Test that fetch occurs prior to addition
                 // TODO wrap in macro for multi-arch support 
@@ -112,6 +430,149 @@ struct adjacency_obj widget_get_adjacencies(const widget_t* wid, const size_t ta
 }
 
 
+/*
+ * __inline_widget_tableau_row
+ * Reads one row of the graph from the Z block of a decomposed tableau
+ * :: wid : const widget_t* :: The widget
+ * :: targ : const size_t :: The row
+ * :: upper_triangle : const bool :: Skip columns at or below the row
+ * :: neighbours : uint32_t* :: Destination, NULL to only count
+ * Returns the number of neighbours in the row
+ */
+static inline
+size_t __inline_widget_tableau_row(const widget_t* wid, const size_t targ, const bool upper_triangle, uint32_t* neighbours)
+{
+    const CHUNK_OBJ* slice = (const CHUNK_OBJ*)wid->tableau->slices_z[targ];
+    const size_t first = upper_triangle ? targ + 1 : 0;
+    const size_t n_words = (wid->n_qubits + CHUNK_SIZE_BITS - 1) / CHUNK_SIZE_BITS;
+
+    size_t n_adjacent = 0;
+    for (size_t i = first / CHUNK_SIZE_BITS; i < n_words; i++)
+    {
+        CHUNK_OBJ obj = slice[i];
+        if (i == first / CHUNK_SIZE_BITS)
+        {
+            obj &= ~0ull << (first % CHUNK_SIZE_BITS);
+        }
+        if (i == n_words - 1 && 0 != wid->n_qubits % CHUNK_SIZE_BITS)
+        {
+            obj &= ~(~0ull << (wid->n_qubits % CHUNK_SIZE_BITS));
+        }
+
+        if (NULL == neighbours)
+        {
+            n_adjacent += __builtin_popcountll(obj);
+            continue;
+        }
+        while (obj > 0)
+        {
+            neighbours[n_adjacent++] = (uint32_t)(i * CHUNK_SIZE_BITS + __CHUNK_CTZ(obj));
+            obj &= obj - 1;
+        }
+    }
+    return n_adjacent;
+}
+
+/*
+ * widget_csr_block
+ * Rows [start, stop) of a graph export
+ * Counting writes the length of row i to offsets[i + 1], filling writes from offsets[i]
+ */
+struct widget_csr_block
+{
+    const widget_t* wid;
+    size_t start;
+    size_t stop;
+    size_t* offsets;
+    uint32_t* neighbours;
+    bool upper_triangle;
+};
+
+/*
+ * widget_csr_rows
+ * Threadpool job over a block of rows
+ * :: args : void* :: struct widget_csr_block*
+ */
+static void widget_csr_rows(void* args)
+{
+    struct widget_csr_block* block = (struct widget_csr_block*)args;
+    const widget_t* wid = block->wid;
+    for (size_t i = block->start; i < block->stop; i++)
+    {
+        uint32_t* row = (NULL == block->neighbours) ? NULL : block->neighbours + block->offsets[i];
+        size_t n_adjacent;
+        if (NULL != wid->csr)
+        {
+            n_adjacent = __inline_widget_csr_row(wid->csr, i, block->upper_triangle, row);
+        }
+        else if (WIDGET_ENGINE_GRAPH == wid->engine)
+        {
+            n_adjacent = graph_state_get_neighbours(wid->graph, i, block->upper_triangle, row);
+        }
+        else
+        {
+            n_adjacent = __inline_widget_tableau_row(wid, i, block->upper_triangle, row);
+        }
+        if (NULL == row)
+        {
+            block->offsets[i + 1] = n_adjacent;
+        }
+    }
+}
+
+/*
+ * widget_get_graph_csr
+ * Exports the whole graph in compressed sparse row form
+ * :: wid : const widget_t* :: Decomposed widget
+ * :: offsets : size_t* :: Caller provided, n_qubits + 1 entries, row i spans [offsets[i], offsets[i + 1])
+ * :: neighbours : uint32_t* :: Caller provided, offsets[n_qubits] entries, NULL to only fill the offsets
+ * :: upper_triangle : const bool :: Only report each edge from its lower vertex
+ * Returns the number of neighbour entries
+ */
+size_t widget_get_graph_csr(const widget_t* wid, size_t* offsets, uint32_t* neighbours, const bool upper_triangle)
+{
+    const size_t n_blocks = (wid->n_qubits + WIDGET_CSR_ROWS_PER_TASK - 1) / WIDGET_CSR_ROWS_PER_TASK;
+    // One spare block, so a widget without qubits does not allocate zero bytes
+    struct widget_csr_block* blocks = (struct widget_csr_block*)malloc((n_blocks + 1) * sizeof(struct widget_csr_block));
+    assert(NULL != blocks);
+
+    for (size_t i = 0; i < n_blocks; i++)
+    {
+        blocks[i].wid = wid;
+        blocks[i].start = i * WIDGET_CSR_ROWS_PER_TASK;
+        blocks[i].stop = (i + 1) * WIDGET_CSR_ROWS_PER_TASK;
+        blocks[i].stop = (blocks[i].stop < wid->n_qubits) ? blocks[i].stop : wid->n_qubits;
+        blocks[i].offsets = offsets;
+        blocks[i].neighbours = neighbours;
+        blocks[i].upper_triangle = upper_triangle;
+    }
+
+    // Waits on its own batch only, the pool may be busy decomposing the next widget
+    threadpool_batch_t batch = THREADPOOL_BATCH_INIT;
+    for (size_t i = 1; i < n_blocks; i++)
+    {
+        threadpool_batch_add_task(&batch, widget_csr_rows, blocks + i);
+    }
+    if (n_blocks > 0)
+    {
+        widget_csr_rows(blocks);
+    }
+    threadpool_batch_wait(&batch);
+    free(blocks);
+
+    // Row lengths become offsets, the fill pass reuses them
+    if (NULL == neighbours)
+    {
+        offsets[0] = 0;
+        for (size_t i = 0; i < wid->n_qubits; i++)
+        {
+            offsets[i + 1] += offsets[i];
+        }
+    }
+    return offsets[wid->n_qubits];
+}
+
+
 /*
  * widget_get_io_map
  * Indicates the mapping of input to output qubits
@@ -134,6 +595,17 @@ size_t* widget_get_io_map(const widget_t* wid)
  */
 void widget_decompose(widget_t* wid)
 {
+    assert(NULL == wid->csr); // Finalised widgets hold no tableau or graph, see widget_finalise
+    if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        // Already a graph state, the vertex operators act before anything still queued
+        for (size_t i = 0; i < wid->n_qubits; i++)
+        {
+            wid->queue->table[i] = LOCAL_CLIFFORD_LEFT(wid->queue->table[i], wid->graph->vops[i]);
+            wid->graph->vops[i] = _I_;
+        }
+        return;
+    }
     simd_widget_decompose(wid);
 }
 
@@ -208,3 +680,40 @@ void __widget_decompose(widget_t* wid)
 
     return;
 }
+
+
+/*
+ * widget_finalise
+ * Keeps only the compact result of a decomposed widget
+ * :: wid : widget_t* :: Decomposed widget
+ * Copies the graph into a CSR structure and frees the tableau or graph state
+ */
+void widget_finalise(widget_t* wid)
+{
+    if (NULL != wid->csr)
+    {
+        return;
+    }
+
+    struct adjacency_csr_t* csr = (struct adjacency_csr_t*)malloc(sizeof(struct adjacency_csr_t));
+    assert(NULL != csr);
+    csr->n_vertices = wid->n_qubits;
+    csr->offsets = (size_t*)malloc((wid->n_qubits + 1) * sizeof(size_t));
+    assert(NULL != csr->offsets);
+    const size_t n_entries = widget_get_graph_csr(wid, csr->offsets, NULL, false);
+    csr->neighbours = (uint32_t*)malloc((n_entries + 1) * sizeof(uint32_t));
+    assert(NULL != csr->neighbours);
+    widget_get_graph_csr(wid, csr->offsets, csr->neighbours, false);
+
+    if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        graph_state_destroy(wid->graph);
+        wid->graph = NULL;
+    }
+    else
+    {
+        tableau_destroy(wid->tableau);
+        wid->tableau = NULL;
+    }
+    wid->csr = csr;
+}
@@ -0,0 +1,912 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "widget_binary.h"
+
+#define WIDGET_BINARY_N_COUNTS (8)
+#define WIDGET_BINARY_RECORD_HEADER_MAX (sizeof(uint64_t) + (WIDGET_BINARY_N_COUNTS + WIDGET_BINARY_N_SECTIONS) * WIDGET_BINARY_VARINT_MAX)
+
+/*
+ * __inline_binary_packed_len
+ * Bytes needed to pack n_entries of n_bits each
+ */
+static inline
+size_t __inline_binary_packed_len(const size_t n_entries, const size_t n_bits)
+{
+    return (n_entries * n_bits + 7) / 8;
+}
+
+/*
+ * __inline_binary_pack
+ * Packs small values least significant bit first
+ * :: dst : uint8_t* :: Destination, __inline_binary_packed_len bytes
+ * :: src : const uint8_t* :: Values, each below 1 << n_bits
+ * :: n_entries : const size_t :: Number of values
+ * :: n_bits : const size_t :: Bits per value
+ * Returns the number of bytes written
+ */
+static inline
+size_t __inline_binary_pack(uint8_t* dst, const uint8_t* src, const size_t n_entries, const size_t n_bits)
+{
+    const size_t len = __inline_binary_packed_len(n_entries, n_bits);
+    memset(dst, 0, len);
+    for (size_t i = 0; i < n_entries; i++)
+    {
+        const size_t bit = i * n_bits;
+        const uint16_t val = (uint16_t)(src[i] & ((1u << n_bits) - 1)) << (bit % 8);
+        dst[bit / 8] |= (uint8_t)val;
+        if ((bit % 8) + n_bits > 8)
+        {
+            dst[bit / 8 + 1] |= (uint8_t)(val >> 8);
+        }
+    }
+    return len;
+}
+
+/*
+ * __inline_binary_unpack
+ * Inverse of __inline_binary_pack
+ */
+static inline
+void __inline_binary_unpack(uint8_t* dst, const uint8_t* src, const size_t n_entries, const size_t n_bits)
+{
+    for (size_t i = 0; i < n_entries; i++)
+    {
+        const size_t bit = i * n_bits;
+        uint16_t val = src[bit / 8];
+        if ((bit % 8) + n_bits > 8)
+        {
+            val |= (uint16_t)src[bit / 8 + 1] << 8;
+        }
+        dst[i] = (uint8_t)((val >> (bit % 8)) & ((1u << n_bits) - 1));
+    }
+}
+
+/*
+ * __inline_binary_reserve
+ * Grows the writer buffer to hold at least len bytes
+ */
+static inline
+void __inline_binary_reserve(widget_binary_writer_t* writer, const size_t len)
+{
+    if (len <= writer->capacity)
+    {
+        return;
+    }
+    size_t capacity = 2 * writer->capacity;
+    capacity = (capacity > len) ? capacity : len;
+    writer->buffer = (uint8_t*)realloc(writer->buffer, capacity);
+    assert(NULL != writer->buffer);
+    writer->capacity = capacity;
+}
+
+/*
+ * widget_binary_writer_open
+ * Starts a container on a file descriptor and writes its header
+ * :: fd : const int :: Open, writable file descriptor, not closed by the writer
+ * Returns NULL if the header cannot be written
+ */
+widget_binary_writer_t* widget_binary_writer_open(const int fd)
+{
+    widget_binary_writer_t* writer = (widget_binary_writer_t*)calloc(1, sizeof(widget_binary_writer_t));
+    assert(NULL != writer);
+    writer->fd = fd;
+
+    uint8_t header[WIDGET_BINARY_HEADER_LEN];
+    const uint32_t version = WIDGET_BINARY_VERSION;
+    memcpy(header, WIDGET_BINARY_MAGIC, WIDGET_BINARY_MAGIC_LEN);
+    memcpy(header + WIDGET_BINARY_MAGIC_LEN, &version, sizeof(uint32_t));
+    if (!__inline_binary_write_all(fd, header, WIDGET_BINARY_HEADER_LEN))
+    {
+        free(writer);
+        return NULL;
+    }
+    writer->n_bytes = WIDGET_BINARY_HEADER_LEN;
+    return writer;
+}
+
+/*
+ * widget_binary_write
+ * Appends one decomposed widget to the container
+ * :: writer : widget_binary_writer_t* :: Writer
+ * :: wid : const widget_t* :: Decomposed widget
+ * :: schedule : const widget_binary_schedule_t* :: Schedule and corrections, NULL writes empty sections
+ * Returns the number of bytes written, 0 if the file descriptor failed part way through the record
+ */
+size_t widget_binary_write(widget_binary_writer_t* writer, const widget_t* wid, const widget_binary_schedule_t* schedule)
+{
+    const widget_binary_schedule_t empty = {0};
+    schedule = (NULL == schedule) ? &empty : schedule;
+    const size_t n_qubits = wid->n_qubits;
+
+    size_t* offsets = (size_t*)malloc((n_qubits + 1) * sizeof(size_t));
+    const size_t n_edges = widget_get_graph_csr(wid, offsets, NULL, true);
+    uint32_t* neighbours = (uint32_t*)malloc((n_edges + 1) * sizeof(uint32_t));
+    widget_get_graph_csr(wid, offsets, neighbours, true);
+
+    // Sections are encoded past the largest possible header, which is then written just in front of them
+    size_t section_len[WIDGET_BINARY_N_SECTIONS];
+    size_t pos = WIDGET_BINARY_RECORD_HEADER_MAX;
+    size_t start = pos;
+
+    __inline_binary_reserve(writer, pos + (n_qubits + n_edges) * WIDGET_BINARY_VARINT_MAX);
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        pos += __inline_binary_put_varint(writer->buffer + pos, offsets[i + 1] - offsets[i]);
+        size_t prev = i;
+        for (size_t j = offsets[i]; j < offsets[i + 1]; j++)
+        {
+            pos += __inline_binary_put_varint(writer->buffer + pos, neighbours[j] - prev - 1);
+            prev = neighbours[j];
+        }
+    }
+    section_len[WIDGET_BINARY_GRAPH] = pos - start;
+    free(offsets);
+    free(neighbours);
+
+    start = pos;
+    __inline_binary_reserve(writer, pos + __inline_binary_packed_len(n_qubits, WIDGET_BINARY_CLIFFORD_BITS));
+    pos += __inline_binary_pack(writer->buffer + pos, wid->queue->table, n_qubits, WIDGET_BINARY_CLIFFORD_BITS);
+    section_len[WIDGET_BINARY_CLIFFORDS] = pos - start;
+
+    start = pos;
+    __inline_binary_reserve(writer, pos + n_qubits * WIDGET_BINARY_VARINT_MAX);
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        pos += __inline_binary_put_varint(writer->buffer + pos, wid->queue->non_cliffords[i]);
+    }
+    section_len[WIDGET_BINARY_TAGS] = pos - start;
+
+    start = pos;
+    __inline_binary_reserve(writer, pos + wid->n_initial_qubits * WIDGET_BINARY_VARINT_MAX);
+    for (size_t i = 0; i < wid->n_initial_qubits; i++)
+    {
+        pos += __inline_binary_put_varint(writer->buffer + pos, wid->q_map[i]);
+    }
+    section_len[WIDGET_BINARY_IO_MAP] = pos - start;
+
+    start = pos;
+    __inline_binary_reserve(writer, pos + (schedule->n_layers + 2 * schedule->n_nodes + schedule->n_deps) * WIDGET_BINARY_VARINT_MAX);
+    for (size_t i = 0; i < schedule->n_layers; i++)
+    {
+        pos += __inline_binary_put_varint(writer->buffer + pos, schedule->layer_offsets[i + 1] - schedule->layer_offsets[i]);
+        for (size_t j = schedule->layer_offsets[i]; j < schedule->layer_offsets[i + 1]; j++)
+        {
+            pos += __inline_binary_put_varint(writer->buffer + pos, schedule->nodes[j]);
+            pos += __inline_binary_put_varint(writer->buffer + pos, schedule->dep_offsets[j + 1] - schedule->dep_offsets[j]);
+            for (size_t k = schedule->dep_offsets[j]; k < schedule->dep_offsets[j + 1]; k++)
+            {
+                pos += __inline_binary_put_varint(writer->buffer + pos, schedule->deps[k]);
+            }
+        }
+    }
+    section_len[WIDGET_BINARY_SCHEDULE] = pos - start;
+
+    start = pos;
+    const size_t correction_len = __inline_binary_packed_len(schedule->correction_width, WIDGET_BINARY_PAULI_BITS);
+    __inline_binary_reserve(writer, pos + schedule->n_corrections * (WIDGET_BINARY_VARINT_MAX + correction_len));
+    for (size_t i = 0; i < schedule->n_corrections; i++)
+    {
+        pos += __inline_binary_put_varint(writer->buffer + pos, schedule->correction_qubits[i]);
+        pos += __inline_binary_pack(
+            writer->buffer + pos,
+            schedule->paulis + i * schedule->correction_width,
+            schedule->correction_width,
+            WIDGET_BINARY_PAULI_BITS);
+    }
+    section_len[WIDGET_BINARY_CORRECTIONS] = pos - start;
+
+    // Counts and section lengths, then the record length in front
+    uint8_t header[WIDGET_BINARY_RECORD_HEADER_MAX];
+    size_t header_len = sizeof(uint64_t);
+    const size_t counts[WIDGET_BINARY_N_COUNTS] = {
+        n_qubits, wid->n_initial_qubits, n_edges,
+        schedule->n_layers, schedule->n_nodes, schedule->n_deps,
+        schedule->n_corrections, schedule->correction_width
+    };
+    for (size_t i = 0; i < WIDGET_BINARY_N_COUNTS; i++)
+    {
+        header_len += __inline_binary_put_varint(header + header_len, counts[i]);
+    }
+    for (size_t i = 0; i < WIDGET_BINARY_N_SECTIONS; i++)
+    {
+        header_len += __inline_binary_put_varint(header + header_len, section_len[i]);
+    }
+    const uint64_t body_len = header_len - sizeof(uint64_t) + pos - WIDGET_BINARY_RECORD_HEADER_MAX;
+    memcpy(header, &body_len, sizeof(uint64_t));
+
+    uint8_t* record = writer->buffer + WIDGET_BINARY_RECORD_HEADER_MAX - header_len;
+    memcpy(record, header, header_len);
+
+    const size_t record_len = sizeof(uint64_t) + body_len;
+    if (!__inline_binary_write_all(writer->fd, record, record_len))
+    {
+        return 0;
+    }
+    writer->n_widgets++;
+    writer->n_bytes += record_len;
+    return record_len;
+}
+
+/*
+ * widget_binary_writer_close
+ * Frees the writer, the file descriptor stays open
+ * :: writer : widget_binary_writer_t* :: Writer
+ */
+void widget_binary_writer_close(widget_binary_writer_t* writer)
+{
+    free(writer->buffer);
+    free(writer);
+}
+
+/*
+ * __inline_binary_grow
+ * Doubles an array until it holds at least n entries
+ * :: arr : void** :: Array, reallocated in place
+ * :: capacity : size_t* :: Entries allocated
+ * :: n : const size_t :: Entries required
+ * :: size : const size_t :: Bytes per entry
+ */
+static inline
+void __inline_binary_grow(void** arr, size_t* capacity, const size_t n, const size_t size)
+{
+    if (n <= *capacity)
+    {
+        return;
+    }
+    while (*capacity < n)
+    {
+        *capacity = (*capacity > 0) ? 2 * *capacity : 64;
+    }
+    *arr = realloc(*arr, *capacity * size);
+    assert(NULL != *arr);
+}
+
+/*
+ * widget_binary_schedule_create
+ * Runs the Pauli tracker scheduler over a decomposed widget
+ * :: wid : widget_t* :: Decomposed widget, the graph build is added to its stats
+ * Nodes are limited to the widget's qubits, as Widget.get_schedule does
+ * Corrections are truncated to the widget's qubits, as Widget.get_pauli_corrections does
+ * Free the result with widget_binary_schedule_destroy
+ */
+widget_binary_schedule_t* widget_binary_schedule_create(widget_t* wid)
+{
+    // Dense Pauli codes of the tracker are I, Z, X, Y
+    static const uint8_t dense_to_binary[4] = {0, 3, 1, 2};
+
+    MappedPauliTracker* tracker = (MappedPauliTracker*)wid->pauli_tracker;
+    const size_t n_qubits = wid->n_qubits;
+    widget_binary_schedule_t* schedule = (widget_binary_schedule_t*)calloc(1, sizeof(widget_binary_schedule_t));
+    assert(NULL != schedule);
+
+    void* graph = widget_partial_order_graph(wid);
+    schedule->n_layers = lib_pauli_n_layers(graph);
+    schedule->layer_offsets = (size_t*)malloc((schedule->n_layers + 1) * sizeof(size_t));
+    assert(NULL != schedule->layer_offsets);
+
+    size_t n_candidates = 0;
+    for (size_t i = 0; i < schedule->n_layers; i++)
+    {
+        n_candidates += lib_pauli_n_dependents(lib_pauli_graph_to_layer(graph, i));
+    }
+    schedule->nodes = (uint32_t*)malloc((n_candidates + 1) * sizeof(uint32_t));
+    schedule->dep_offsets = (size_t*)malloc((n_candidates + 1) * sizeof(size_t));
+    assert(NULL != schedule->nodes);
+    assert(NULL != schedule->dep_offsets);
+
+    size_t deps_capacity = 0;
+    schedule->layer_offsets[0] = 0;
+    schedule->dep_offsets[0] = 0;
+    for (size_t i = 0; i < schedule->n_layers; i++)
+    {
+        void* layer = lib_pauli_graph_to_layer(graph, i);
+        const size_t n_layer = lib_pauli_n_dependents(layer);
+        for (size_t j = 0; j < n_layer; j++)
+        {
+            const size_t qubit = lib_pauli_dependent_qubit_idx(layer, j);
+            if (qubit >= n_qubits)
+            {
+                continue;
+            }
+            PauliConstVec* deps = lib_pauli_layer_to_dependent_node(layer, j);
+            const size_t* dep_qubits = (const size_t*)deps->ptr;
+            __inline_binary_grow((void**)&schedule->deps, &deps_capacity, schedule->n_deps + deps->len, sizeof(uint32_t));
+            for (size_t k = 0; k < deps->len; k++)
+            {
+                schedule->deps[schedule->n_deps++] = (uint32_t)dep_qubits[k];
+            }
+            lib_pauli_tracker_const_vec_destroy(deps);
+
+            schedule->nodes[schedule->n_nodes++] = (uint32_t)qubit;
+            schedule->dep_offsets[schedule->n_nodes] = schedule->n_deps;
+        }
+        schedule->layer_offsets[i + 1] = schedule->n_nodes;
+    }
+    lib_pauli_tracker_graph_destroy(graph);
+
+    void* corrections = lib_pauli_tracker_create_pauli_corrections(tracker);
+    void* inv_mapper = lib_pauli_tracker_get_inv_mapper(tracker, n_qubits);
+    PauliConstVec* inv_view = lib_pauli_mapper_to_const_vec(inv_mapper);
+    const size_t* inv_map = (const size_t*)inv_view->ptr;
+
+    schedule->n_corrections = lib_pauli_tracker_get_correction_table_len(corrections);
+    schedule->correction_qubits = (uint32_t*)malloc((schedule->n_corrections + 1) * sizeof(uint32_t));
+    assert(NULL != schedule->correction_qubits);
+    for (size_t i = 0; i < schedule->n_corrections; i++)
+    {
+        PauliConstVec* paulis = lib_pauli_tracker_get_pauli_corrections(corrections, i);
+        const size_t width = (paulis->len < n_qubits) ? paulis->len : n_qubits;
+        schedule->correction_width = (width > schedule->correction_width) ? width : schedule->correction_width;
+        lib_pauli_tracker_destroy_corrections(paulis);
+        schedule->correction_qubits[i] = (i < inv_view->len) ? (uint32_t)inv_map[i] : UINT32_MAX;
+    }
+
+    // Shorter corrections are padded with identities
+    schedule->paulis = (uint8_t*)calloc(schedule->n_corrections * schedule->correction_width + 1, sizeof(uint8_t));
+    assert(NULL != schedule->paulis);
+    for (size_t i = 0; i < schedule->n_corrections; i++)
+    {
+        PauliConstVec* paulis = lib_pauli_tracker_get_pauli_corrections(corrections, i);
+        const uint8_t* dense = (const uint8_t*)paulis->ptr;
+        const size_t width = (paulis->len < n_qubits) ? paulis->len : n_qubits;
+        uint8_t* dst = schedule->paulis + i * schedule->correction_width;
+        for (size_t k = 0; k < width; k++)
+        {
+            dst[k] = dense_to_binary[dense[k] & 3];
+        }
+        lib_pauli_tracker_destroy_corrections(paulis);
+    }
+
+    lib_pauli_tracker_destroy_inv_map(inv_mapper, inv_view);
+    lib_pauli_tracker_corrections_destroy(corrections);
+    return schedule;
+}
+
+/*
+ * widget_binary_schedule_destroy
+ * Frees a schedule from widget_binary_schedule_create
+ * :: schedule : widget_binary_schedule_t* :: Schedule
+ */
+void widget_binary_schedule_destroy(widget_binary_schedule_t* schedule)
+{
+    free(schedule->layer_offsets);
+    free(schedule->nodes);
+    free(schedule->dep_offsets);
+    free(schedule->deps);
+    free(schedule->correction_qubits);
+    free(schedule->paulis);
+    free(schedule);
+}
+
+/*
+ * __inline_binary_next
+ * Reads a varint from a record that was validated when the reader opened
+ * :: ptr : const uint8_t** :: Cursor
+ * :: end : const uint8_t* :: End of the section
+ */
+static inline
+uint64_t __inline_binary_next(const uint8_t** ptr, const uint8_t* end)
+{
+    uint64_t val = 0;
+    const bool read = __inline_binary_read_varint(ptr, end, &val);
+    assert(read);
+    return val;
+}
+
+/*
+ * __inline_binary_record_header
+ * Reads the counts and section lengths at the start of a record body
+ * :: ptr : const uint8_t** :: Cursor, advanced past the header
+ * :: end : const uint8_t* :: End of the record
+ * :: info : widget_binary_info_t* :: Counts, written to
+ * :: section_len : size_t* :: WIDGET_BINARY_N_SECTIONS entries, written to
+ * Returns false if the header runs past the record or the sections do not fill the rest of it exactly
+ */
+static inline
+bool __inline_binary_record_header(
+    const uint8_t** ptr,
+    const uint8_t* end,
+    widget_binary_info_t* info,
+    size_t* section_len)
+{
+    uint64_t counts[WIDGET_BINARY_N_COUNTS];
+    for (size_t i = 0; i < WIDGET_BINARY_N_COUNTS; i++)
+    {
+        if (!__inline_binary_read_varint(ptr, end, counts + i))
+        {
+            return false;
+        }
+    }
+    info->n_qubits = counts[0];
+    info->n_initial_qubits = counts[1];
+    info->n_edges = counts[2];
+    info->n_layers = counts[3];
+    info->n_nodes = counts[4];
+    info->n_deps = counts[5];
+    info->n_corrections = counts[6];
+    info->correction_width = counts[7];
+
+    for (size_t i = 0; i < WIDGET_BINARY_N_SECTIONS; i++)
+    {
+        uint64_t len;
+        if (!__inline_binary_read_varint(ptr, end, &len))
+        {
+            return false;
+        }
+        section_len[i] = len;
+    }
+
+    // Checked one at a time so a huge length cannot wrap the sum
+    size_t total = 0;
+    for (size_t i = 0; i < WIDGET_BINARY_N_SECTIONS; i++)
+    {
+        if (section_len[i] > (size_t)(end - *ptr) - total)
+        {
+            return false;
+        }
+        total += section_len[i];
+    }
+    return total == (size_t)(end - *ptr);
+}
+
+/*
+ * __inline_binary_valid_record
+ * Walks every section of a record with bounded reads
+ * :: body : const uint8_t* :: Start of the record body
+ * :: body_len : const size_t :: Length of the body
+ * Returns false unless each section decodes to exactly its length and agrees with the counts,
+ * after which the decoders below can trust the record
+ */
+static inline
+bool __inline_binary_valid_record(const uint8_t* body, const size_t body_len)
+{
+    const uint8_t* ptr = body;
+    const uint8_t* end = body + body_len;
+    widget_binary_info_t info;
+    size_t section_len[WIDGET_BINARY_N_SECTIONS];
+    if (!__inline_binary_record_header(&ptr, end, &info, section_len))
+    {
+        return false;
+    }
+    uint64_t val;
+
+    // Upper triangle rows, each neighbour above its row and below n_qubits
+    const uint8_t* section_end = ptr + section_len[WIDGET_BINARY_GRAPH];
+    size_t n_edges = 0;
+    for (size_t i = 0; i < info.n_qubits; i++)
+    {
+        if (!__inline_binary_read_varint(&ptr, section_end, &val) || val >= info.n_qubits - i)
+        {
+            return false;
+        }
+        const size_t n_row = val;
+        size_t prev = i;
+        for (size_t j = 0; j < n_row; j++)
+        {
+            if (!__inline_binary_read_varint(&ptr, section_end, &val) || val >= info.n_qubits - prev - 1)
+            {
+                return false;
+            }
+            prev += val + 1;
+        }
+        n_edges += n_row;
+    }
+    if (ptr != section_end || n_edges != info.n_edges)
+    {
+        return false;
+    }
+
+    // n_qubits is bounded by the graph section, so the packed length cannot wrap
+    if (section_len[WIDGET_BINARY_CLIFFORDS] != __inline_binary_packed_len(info.n_qubits, WIDGET_BINARY_CLIFFORD_BITS))
+    {
+        return false;
+    }
+    ptr += section_len[WIDGET_BINARY_CLIFFORDS];
+
+    section_end = ptr + section_len[WIDGET_BINARY_TAGS];
+    for (size_t i = 0; i < info.n_qubits; i++)
+    {
+        if (!__inline_binary_read_varint(&ptr, section_end, &val))
+        {
+            return false;
+        }
+    }
+    if (ptr != section_end)
+    {
+        return false;
+    }
+
+    section_end = ptr + section_len[WIDGET_BINARY_IO_MAP];
+    for (size_t i = 0; i < info.n_initial_qubits; i++)
+    {
+        if (!__inline_binary_read_varint(&ptr, section_end, &val))
+        {
+            return false;
+        }
+    }
+    if (ptr != section_end)
+    {
+        return false;
+    }
+
+    section_end = ptr + section_len[WIDGET_BINARY_SCHEDULE];
+    size_t n_nodes = 0;
+    size_t n_deps = 0;
+    for (size_t i = 0; i < info.n_layers; i++)
+    {
+        if (!__inline_binary_read_varint(&ptr, section_end, &val))
+        {
+            return false;
+        }
+        const size_t n_layer = val;
+        for (size_t j = 0; j < n_layer; j++)
+        {
+            uint64_t n_node_deps;
+            if (!__inline_binary_read_varint(&ptr, section_end, &val)
+                || !__inline_binary_read_varint(&ptr, section_end, &n_node_deps))
+            {
+                return false;
+            }
+            for (size_t k = 0; k < n_node_deps; k++)
+            {
+                if (!__inline_binary_read_varint(&ptr, section_end, &val))
+                {
+                    return false;
+                }
+            }
+            n_deps += n_node_deps;
+        }
+        n_nodes += n_layer;
+    }
+    if (ptr != section_end || n_nodes != info.n_nodes || n_deps != info.n_deps)
+    {
+        return false;
+    }
+
+    // Every Pauli takes a quarter of a byte, so a wider correction cannot fit, the width is free without corrections
+    section_end = ptr + section_len[WIDGET_BINARY_CORRECTIONS];
+    if (0 == info.n_corrections)
+    {
+        return ptr == section_end;
+    }
+    if (info.correction_width > 4 * section_len[WIDGET_BINARY_CORRECTIONS])
+    {
+        return false;
+    }
+    const size_t correction_len = __inline_binary_packed_len(info.correction_width, WIDGET_BINARY_PAULI_BITS);
+    for (size_t i = 0; i < info.n_corrections; i++)
+    {
+        if (!__inline_binary_read_varint(&ptr, section_end, &val) || correction_len > (size_t)(section_end - ptr))
+        {
+            return false;
+        }
+        ptr += correction_len;
+    }
+    return ptr == section_end;
+}
+
+/*
+ * widget_binary_reader_open
+ * Maps a container read only and indexes its records
+ * :: path : const char* :: Path to the container
+ * Returns NULL if the file cannot be mapped, is not a container of this version, or holds a malformed record or trailing bytes
+ */
+widget_binary_reader_t* widget_binary_reader_open(const char* path)
+{
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return NULL;
+    }
+    struct stat st;
+    if (0 != fstat(fd, &st) || (size_t)st.st_size < WIDGET_BINARY_HEADER_LEN)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    const size_t len = st.st_size;
+    const uint8_t* map = (const uint8_t*)mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map)
+    {
+        return NULL;
+    }
+
+    uint32_t version;
+    memcpy(&version, map + WIDGET_BINARY_MAGIC_LEN, sizeof(uint32_t));
+    if (0 != memcmp(map, WIDGET_BINARY_MAGIC, WIDGET_BINARY_MAGIC_LEN) || WIDGET_BINARY_VERSION != version)
+    {
+        munmap((void*)map, len);
+        return NULL;
+    }
+
+    // Walk the record lengths, a truncated or malformed record or any bytes past the last record reject the container
+    size_t n_widgets = 0;
+    size_t capacity = 16;
+    size_t* records = (size_t*)malloc(capacity * sizeof(size_t));
+    assert(NULL != records);
+    size_t pos = WIDGET_BINARY_HEADER_LEN;
+    while (pos < len)
+    {
+        uint64_t body_len;
+        if (len - pos < sizeof(uint64_t))
+        {
+            munmap((void*)map, len);
+            free(records);
+            return NULL;
+        }
+        memcpy(&body_len, map + pos, sizeof(uint64_t));
+        pos += sizeof(uint64_t);
+        if (body_len > len - pos || !__inline_binary_valid_record(map + pos, body_len))
+        {
+            munmap((void*)map, len);
+            free(records);
+            return NULL;
+        }
+        if (n_widgets == capacity)
+        {
+            capacity *= 2;
+            records = (size_t*)realloc(records, capacity * sizeof(size_t));
+            assert(NULL != records);
+        }
+        records[n_widgets++] = pos;
+        pos += body_len;
+    }
+
+    widget_binary_reader_t* reader = (widget_binary_reader_t*)malloc(sizeof(widget_binary_reader_t));
+    assert(NULL != reader);
+    reader->map = map;
+    reader->len = len;
+    reader->n_widgets = n_widgets;
+    reader->records = records;
+    return reader;
+}
+
+/*
+ * widget_binary_reader_close
+ * Unmaps the container
+ * :: reader : widget_binary_reader_t* :: Reader
+ */
+void widget_binary_reader_close(widget_binary_reader_t* reader)
+{
+    munmap((void*)reader->map, reader->len);
+    free(reader->records);
+    free(reader);
+}
+
+/*
+ * widget_binary_n_widgets
+ * Number of records in the container
+ * :: reader : const widget_binary_reader_t* :: Reader
+ */
+size_t widget_binary_n_widgets(const widget_binary_reader_t* reader)
+{
+    return reader->n_widgets;
+}
+
+/*
+ * __inline_binary_record
+ * Decodes the header of a record
+ * :: reader : const widget_binary_reader_t* :: Reader
+ * :: idx : const size_t :: Record index
+ * :: info : widget_binary_info_t* :: Counts, written to
+ * :: sections : const uint8_t** :: WIDGET_BINARY_N_SECTIONS + 1 entries, start of each section then the end of the record
+ */
+static inline
+void __inline_binary_record(
+    const widget_binary_reader_t* reader,
+    const size_t idx,
+    widget_binary_info_t* info,
+    const uint8_t** sections)
+{
+    assert(idx < reader->n_widgets);
+    const uint8_t* ptr = reader->map + reader->records[idx];
+    uint64_t body_len;
+    memcpy(&body_len, ptr - sizeof(uint64_t), sizeof(uint64_t));
+    const uint8_t* end = ptr + body_len;
+
+    size_t section_len[WIDGET_BINARY_N_SECTIONS];
+    const bool valid = __inline_binary_record_header(&ptr, end, info, section_len);
+    assert(valid);
+    for (size_t i = 0; i < WIDGET_BINARY_N_SECTIONS; i++)
+    {
+        sections[i] = ptr;
+        ptr += section_len[i];
+    }
+    sections[WIDGET_BINARY_N_SECTIONS] = end;
+}
+
+/*
+ * widget_binary_read_info
+ * Reads the counts of a record
+ * :: reader : const widget_binary_reader_t* :: Reader
+ * :: idx : const size_t :: Record index
+ * :: info : widget_binary_info_t* :: Written to
+ */
+void widget_binary_read_info(const widget_binary_reader_t* reader, const size_t idx, widget_binary_info_t* info)
+{
+    const uint8_t* sections[WIDGET_BINARY_N_SECTIONS + 1];
+    __inline_binary_record(reader, idx, info, sections);
+}
+
+/*
+ * widget_binary_read_graph
+ * Decodes the graph of a record in compressed sparse row form
+ * :: reader : const widget_binary_reader_t* :: Reader
+ * :: idx : const size_t :: Record index
+ * :: offsets : size_t* :: n_qubits + 1 entries
+ * :: neighbours : uint32_t* :: n_edges entries for the upper triangle, otherwise 2 * n_edges
+ * :: upper_triangle : const bool :: Only report each edge from its lower vertex
+ */
+void widget_binary_read_graph(
+    const widget_binary_reader_t* reader,
+    const size_t idx,
+    size_t* offsets,
+    uint32_t* neighbours,
+    const bool upper_triangle)
+{
+    widget_binary_info_t info;
+    const uint8_t* sections[WIDGET_BINARY_N_SECTIONS + 1];
+    __inline_binary_record(reader, idx, &info, sections);
+
+    const uint8_t* ptr = sections[WIDGET_BINARY_GRAPH];
+    const uint8_t* end = sections[WIDGET_BINARY_GRAPH + 1];
+    if (upper_triangle)
+    {
+        offsets[0] = 0;
+        for (size_t i = 0; i < info.n_qubits; i++)
+        {
+            const size_t n_row = __inline_binary_next(&ptr, end);
+            offsets[i + 1] = offsets[i] + n_row;
+            size_t prev = i;
+            for (size_t j = offsets[i]; j < offsets[i + 1]; j++)
+            {
+                prev += __inline_binary_next(&ptr, end) + 1;
+                neighbours[j] = (uint32_t)prev;
+            }
+        }
+        return;
+    }
+
+    // Each row is its edges from lower vertices followed by its stored upper row
+    size_t* n_lower = (size_t*)calloc(info.n_qubits + 1, sizeof(size_t));
+    size_t* n_upper = (size_t*)malloc((info.n_qubits + 1) * sizeof(size_t));
+    for (size_t i = 0; i < info.n_qubits; i++)
+    {
+        n_upper[i] = __inline_binary_next(&ptr, end);
+        size_t prev = i;
+        for (size_t j = 0; j < n_upper[i]; j++)
+        {
+            prev += __inline_binary_next(&ptr, end) + 1;
+            n_lower[prev]++;
+        }
+    }
+    offsets[0] = 0;
+    for (size_t i = 0; i < info.n_qubits; i++)
+    {
+        offsets[i + 1] = offsets[i] + n_lower[i] + n_upper[i];
+        n_lower[i] = offsets[i];
+    }
+
+    ptr = sections[WIDGET_BINARY_GRAPH];
+    for (size_t i = 0; i < info.n_qubits; i++)
+    {
+        const size_t n_row = __inline_binary_next(&ptr, end);
+        uint32_t* row = neighbours + offsets[i + 1] - n_row;
+        size_t prev = i;
+        for (size_t j = 0; j < n_row; j++)
+        {
+            prev += __inline_binary_next(&ptr, end) + 1;
+            row[j] = (uint32_t)prev;
+            // Rows are visited in ascending order, so lower neighbours arrive sorted
+            neighbours[n_lower[prev]++] = (uint32_t)i;
+        }
+    }
+    free(n_lower);
+    free(n_upper);
+}
+
+/*
+ * widget_binary_read_qubits
+ * Decodes the per qubit sections of a record
+ * :: reader : const widget_binary_reader_t* :: Reader
+ * :: idx : const size_t :: Record index
+ * :: local_cliffords : instruction_t* :: n_qubits entries, NULL to skip
+ * :: measurement_tags : non_clifford_tag_t* :: n_qubits entries, NULL to skip
+ * :: io_map : size_t* :: n_initial_qubits entries, NULL to skip
+ */
+void widget_binary_read_qubits(
+    const widget_binary_reader_t* reader,
+    const size_t idx,
+    instruction_t* local_cliffords,
+    non_clifford_tag_t* measurement_tags,
+    size_t* io_map)
+{
+    widget_binary_info_t info;
+    const uint8_t* sections[WIDGET_BINARY_N_SECTIONS + 1];
+    __inline_binary_record(reader, idx, &info, sections);
+
+    if (NULL != local_cliffords)
+    {
+        __inline_binary_unpack(local_cliffords, sections[WIDGET_BINARY_CLIFFORDS], info.n_qubits, WIDGET_BINARY_CLIFFORD_BITS);
+        for (size_t i = 0; i < info.n_qubits; i++)
+        {
+            local_cliffords[i] |= LOCAL_CLIFFORD_MASK;
+        }
+    }
+
+    if (NULL != measurement_tags)
+    {
+        const uint8_t* ptr = sections[WIDGET_BINARY_TAGS];
+        const uint8_t* end = sections[WIDGET_BINARY_TAGS + 1];
+        for (size_t i = 0; i < info.n_qubits; i++)
+        {
+            measurement_tags[i] = (non_clifford_tag_t)__inline_binary_next(&ptr, end);
+        }
+    }
+
+    if (NULL != io_map)
+    {
+        const uint8_t* ptr = sections[WIDGET_BINARY_IO_MAP];
+        const uint8_t* end = sections[WIDGET_BINARY_IO_MAP + 1];
+        for (size_t i = 0; i < info.n_initial_qubits; i++)
+        {
+            io_map[i] = __inline_binary_next(&ptr, end);
+        }
+    }
+}
+
+/*
+ * widget_binary_read_schedule
+ * Decodes the schedule and corrections of a record
+ * :: reader : const widget_binary_reader_t* :: Reader
+ * :: idx : const size_t :: Record index
+ * :: schedule : widget_binary_schedule_t* :: Arrays sized from widget_binary_read_info, the counts are written
+ */
+void widget_binary_read_schedule(const widget_binary_reader_t* reader, const size_t idx, widget_binary_schedule_t* schedule)
+{
+    widget_binary_info_t info;
+    const uint8_t* sections[WIDGET_BINARY_N_SECTIONS + 1];
+    __inline_binary_record(reader, idx, &info, sections);
+
+    schedule->n_layers = info.n_layers;
+    schedule->n_nodes = info.n_nodes;
+    schedule->n_deps = info.n_deps;
+    schedule->n_corrections = info.n_corrections;
+    schedule->correction_width = info.correction_width;
+
+    const uint8_t* ptr = sections[WIDGET_BINARY_SCHEDULE];
+    const uint8_t* end = sections[WIDGET_BINARY_SCHEDULE + 1];
+    size_t node = 0;
+    schedule->layer_offsets[0] = 0;
+    schedule->dep_offsets[0] = 0;
+    for (size_t i = 0; i < info.n_layers; i++)
+    {
+        const size_t n_layer = __inline_binary_next(&ptr, end);
+        schedule->layer_offsets[i + 1] = schedule->layer_offsets[i] + n_layer;
+        for (; node < schedule->layer_offsets[i + 1]; node++)
+        {
+            schedule->nodes[node] = (uint32_t)__inline_binary_next(&ptr, end);
+            const size_t n_deps = __inline_binary_next(&ptr, end);
+            schedule->dep_offsets[node + 1] = schedule->dep_offsets[node] + n_deps;
+            for (size_t k = schedule->dep_offsets[node]; k < schedule->dep_offsets[node + 1]; k++)
+            {
+                schedule->deps[k] = (uint32_t)__inline_binary_next(&ptr, end);
+            }
+        }
+    }
+
+    ptr = sections[WIDGET_BINARY_CORRECTIONS];
+    end = sections[WIDGET_BINARY_CORRECTIONS + 1];
+    const size_t correction_len = __inline_binary_packed_len(info.correction_width, WIDGET_BINARY_PAULI_BITS);
+    for (size_t i = 0; i < info.n_corrections; i++)
+    {
+        schedule->correction_qubits[i] = (uint32_t)__inline_binary_next(&ptr, end);
+        __inline_binary_unpack(schedule->paulis + i * info.correction_width, ptr, info.correction_width, WIDGET_BINARY_PAULI_BITS);
+        ptr += correction_len;
+    }
+}
@@ -0,0 +1,218 @@
+#include "widget_pipeline.h"
+
+/*
+ * __inline_pipeline_push
+ * __inline_pipeline_pop
+ * Queue operations, the caller holds the pipeline lock
+ */
+static inline
+void __inline_pipeline_push(struct widget_pipeline_queue_t* que, widget_t* wid)
+{
+    assert(que->count < WIDGET_PIPELINE_MAX_DEPTH);
+    que->slots[(que->head + que->count) % WIDGET_PIPELINE_MAX_DEPTH] = wid;
+    que->count++;
+}
+
+static inline
+widget_t* __inline_pipeline_pop(struct widget_pipeline_queue_t* que)
+{
+    assert(que->count > 0);
+    widget_t* wid = que->slots[que->head];
+    que->head = (que->head + 1) % WIDGET_PIPELINE_MAX_DEPTH;
+    que->count--;
+    return wid;
+}
+
+/*
+ * widget_pipeline_ingest
+ * Ingestion stage
+ * :: args : void* :: widget_pipeline_t*
+ * Fills free widgets in sequence order, allocating until the pipeline reaches its depth
+ */
+static void* widget_pipeline_ingest(void* args)
+{
+    widget_pipeline_t* pipe = (widget_pipeline_t*)args;
+
+    while (!widget_sequence_done(pipe->seq))
+    {
+        widget_t* wid = NULL;
+        pthread_mutex_lock(&pipe->lock);
+        while (pipe->alive && 0 == pipe->free.count && pipe->n_widgets == pipe->depth)
+        {
+            pthread_cond_wait(&pipe->changed, &pipe->lock);
+        }
+        if (!pipe->alive)
+        {
+            pthread_mutex_unlock(&pipe->lock);
+            break;
+        }
+        if (pipe->free.count > 0)
+        {
+            wid = __inline_pipeline_pop(&pipe->free);
+        }
+        else
+        {
+            // Claim the slot now, the widget is allocated outside the lock
+            pipe->n_widgets++;
+        }
+        const size_t slot = pipe->n_widgets - 1;
+        pthread_mutex_unlock(&pipe->lock);
+
+        const bool allocated = (NULL == wid);
+        wid = widget_sequence_fill(pipe->seq, wid, parse_instruction_block_par);
+
+        pthread_mutex_lock(&pipe->lock);
+        if (allocated)
+        {
+            pipe->widgets[slot] = wid;
+        }
+        __inline_pipeline_push(&pipe->filled, wid);
+        pthread_cond_broadcast(&pipe->changed);
+        pthread_mutex_unlock(&pipe->lock);
+    }
+
+    pthread_mutex_lock(&pipe->lock);
+    pipe->filling = false;
+    pthread_cond_broadcast(&pipe->changed);
+    pthread_mutex_unlock(&pipe->lock);
+    return NULL;
+}
+
+/*
+ * widget_pipeline_decompose
+ * Decomposition stage
+ * :: args : void* :: widget_pipeline_t*
+ * Decomposes filled widgets in the order they were filled
+ */
+static void* widget_pipeline_decompose(void* args)
+{
+    widget_pipeline_t* pipe = (widget_pipeline_t*)args;
+
+    while (true)
+    {
+        pthread_mutex_lock(&pipe->lock);
+        while (pipe->alive && 0 == pipe->filled.count && pipe->filling)
+        {
+            pthread_cond_wait(&pipe->changed, &pipe->lock);
+        }
+        if (!pipe->alive || 0 == pipe->filled.count)
+        {
+            pthread_mutex_unlock(&pipe->lock);
+            break;
+        }
+        widget_t* wid = __inline_pipeline_pop(&pipe->filled);
+        pthread_mutex_unlock(&pipe->lock);
+
+        widget_decompose(wid);
+
+        pthread_mutex_lock(&pipe->lock);
+        __inline_pipeline_push(&pipe->decomposed, wid);
+        pthread_cond_broadcast(&pipe->changed);
+        pthread_mutex_unlock(&pipe->lock);
+    }
+
+    pthread_mutex_lock(&pipe->lock);
+    pipe->decomposing = false;
+    pthread_cond_broadcast(&pipe->changed);
+    pthread_mutex_unlock(&pipe->lock);
+    return NULL;
+}
+
+/*
+ * widget_pipeline_create
+ * Starts a pipelined widget sequence
+ * :: instructions : instruction_stream_u* :: Instruction stream, not copied, must outlive the pipeline
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: qubit_width : const size_t :: Initial qubits of each widget
+ * :: max_qubits : const size_t :: Qubits per widget, as for widget_sequence_create
+ * :: teleport_input : const bool :: Whether each widget teleports its inputs
+ * :: depth : const size_t :: Widgets in flight, 0 selects WIDGET_PIPELINE_DEFAULT_DEPTH
+ */
+widget_pipeline_t* widget_pipeline_create(
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const bool teleport_input,
+    const size_t depth)
+{
+    assert(depth <= WIDGET_PIPELINE_MAX_DEPTH);
+
+    widget_pipeline_t* pipe = (widget_pipeline_t*)calloc(1, sizeof(widget_pipeline_t));
+    assert(NULL != pipe);
+
+    pipe->seq = widget_sequence_create(instructions, n_instructions, qubit_width, max_qubits, teleport_input);
+    pipe->depth = (0 == depth) ? WIDGET_PIPELINE_DEFAULT_DEPTH : depth;
+    pipe->filling = true;
+    pipe->decomposing = true;
+    pipe->alive = true;
+    pthread_mutex_init(&pipe->lock, NULL);
+    pthread_cond_init(&pipe->changed, NULL);
+
+    int err_code = pthread_create(&pipe->ingest_thread, NULL, widget_pipeline_ingest, pipe);
+    assert(0 == err_code);
+    err_code = pthread_create(&pipe->decompose_thread, NULL, widget_pipeline_decompose, pipe);
+    assert(0 == err_code);
+    return pipe;
+}
+
+/*
+ * widget_pipeline_next
+ * Waits for the next decomposed widget
+ * :: pipe : widget_pipeline_t* :: Pipeline
+ * Returns the widget, still owned by the pipeline, or NULL once the sequence is exhausted
+ */
+widget_t* widget_pipeline_next(widget_pipeline_t* pipe)
+{
+    widget_t* wid = NULL;
+    pthread_mutex_lock(&pipe->lock);
+    while (0 == pipe->decomposed.count && pipe->decomposing)
+    {
+        pthread_cond_wait(&pipe->changed, &pipe->lock);
+    }
+    if (pipe->decomposed.count > 0)
+    {
+        wid = __inline_pipeline_pop(&pipe->decomposed);
+    }
+    pthread_mutex_unlock(&pipe->lock);
+    return wid;
+}
+
+/*
+ * widget_pipeline_release
+ * Hands a widget back to the pipeline for reuse
+ * :: pipe : widget_pipeline_t* :: Pipeline
+ * :: wid : widget_t* :: Widget from widget_pipeline_next
+ */
+void widget_pipeline_release(widget_pipeline_t* pipe, widget_t* wid)
+{
+    pthread_mutex_lock(&pipe->lock);
+    __inline_pipeline_push(&pipe->free, wid);
+    pthread_cond_broadcast(&pipe->changed);
+    pthread_mutex_unlock(&pipe->lock);
+}
+
+/*
+ * widget_pipeline_destroy
+ * Stops both stages, joins their threads and frees every widget
+ * :: pipe : widget_pipeline_t* :: Pipeline, may be destroyed before it is exhausted
+ */
+void widget_pipeline_destroy(widget_pipeline_t* pipe)
+{
+    pthread_mutex_lock(&pipe->lock);
+    pipe->alive = false;
+    pthread_cond_broadcast(&pipe->changed);
+    pthread_mutex_unlock(&pipe->lock);
+
+    pthread_join(pipe->ingest_thread, NULL);
+    pthread_join(pipe->decompose_thread, NULL);
+
+    for (size_t i = 0; i < pipe->n_widgets; i++)
+    {
+        widget_destroy(pipe->widgets[i]);
+    }
+    widget_sequence_destroy(pipe->seq);
+    pthread_mutex_destroy(&pipe->lock);
+    pthread_cond_destroy(&pipe->changed);
+    free(pipe);
+}
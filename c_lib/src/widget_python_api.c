@@ -76,6 +76,54 @@ void widget_get_pauli_tracker_api(
     *tracker = wid->pauli_tracker; 
 }
 
+/*
+ * __inline_widget_print
+ * Prints the widget's tableau, the graph engine writes its state to a temporary tableau first
+ * :: wid : const widget_t* :: The widget
+ * :: print_fn : void (*)(const tableau_t*) :: Tableau printer
+ */
+static inline
+void __inline_widget_print(
+    const widget_t* wid,
+    void (*print_fn)(const tableau_t*))
+{
+    tableau_t* tab = wid->tableau;
+    if (NULL != wid->csr)
+    {
+        // Finalised widgets print the stabilisers of their graph state
+        tab = tableau_create(wid->n_qubits);
+        for (size_t i = 0; i < wid->n_qubits; i++)
+        {
+            tableau_H(tab, i);
+        }
+        for (size_t i = 0; i < wid->n_qubits; i++)
+        {
+            for (size_t j = wid->csr->offsets[i]; j < wid->csr->offsets[i + 1]; j++)
+            {
+                if (wid->csr->neighbours[j] > i)
+                {
+                    tableau_CZ(tab, i, wid->csr->neighbours[j]);
+                }
+            }
+        }
+    }
+    else if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        tab = tableau_create(wid->graph->n_qubits);
+        graph_state_to_tableau(wid->graph, tab);
+    }
+
+    size_t tmp = tab->n_qubits;
+    tab->n_qubits = wid->n_qubits;
+    print_fn(tab); 
+    tab->n_qubits = tmp;
+
+    if (tab != wid->tableau)
+    {
+        tableau_destroy(tab);
+    }
+}
+
 /*
  * widget_print_tableau
  * Prints the tableau
@@ -83,10 +131,7 @@ void widget_get_pauli_tracker_api(
 void widget_print_tableau_api(
     const widget_t* wid)
 {
-    size_t tmp = wid->tableau->n_qubits;
-    wid->tableau->n_qubits = wid->n_qubits;
-    tableau_print(wid->tableau); 
-    wid->tableau->n_qubits = tmp;
+    __inline_widget_print(wid, tableau_print);
 }
 
 /*
@@ -96,8 +141,31 @@ void widget_print_tableau_api(
 void widget_print_tableau_phases_api(
     const widget_t* wid)
 {
-    size_t tmp = wid->tableau->n_qubits;
-    wid->tableau->n_qubits = wid->n_qubits;
-    tableau_print_phases(wid->tableau); 
-    wid->tableau->n_qubits = tmp;
+    __inline_widget_print(wid, tableau_print_phases);
+}
+
+/*
+ * widget_get_engine_stats_api
+ * Writes the engine statistics of the widget
+ * :: wid : const widget_t* :: The widget
+ * :: stats : struct widget_engine_stats_t* :: Object to write to
+ */
+void widget_get_engine_stats_api(
+    const widget_t* wid,
+    struct widget_engine_stats_t* stats)
+{
+    *stats = widget_get_engine_stats(wid);
+}
+
+/*
+ * widget_get_stats_api
+ * Writes the phase timings and counters of the widget
+ * :: wid : const widget_t* :: The widget
+ * :: stats : struct widget_stats_t* :: Object to write to
+ */
+void widget_get_stats_api(
+    const widget_t* wid,
+    struct widget_stats_t* stats)
+{
+    *stats = widget_get_stats(wid);
 }
@@ -0,0 +1,139 @@
+#include "widget_sequence.h"
+
+/*
+ * widget_sequence_create
+ * Constructor for a widget sequence
+ * :: instructions : instruction_stream_u* :: Instruction stream, not copied
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: qubit_width : const size_t :: Initial qubits of each widget
+ * :: max_qubits : const size_t :: Qubits per widget, the rz budget is what remains after the inputs are teleported
+ * :: teleport_input : const bool :: Whether each widget teleports its inputs
+ */
+widget_sequence_t* widget_sequence_create(
+    instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const size_t qubit_width,
+    const size_t max_qubits,
+    const bool teleport_input)
+{
+    // Teleported inputs take a second register of qubit_width
+    const size_t reserved = (1 + teleport_input) * qubit_width;
+    assert(max_qubits > reserved);
+
+    widget_sequence_t* seq = (widget_sequence_t*)malloc(sizeof(widget_sequence_t));
+    seq->instructions = instructions;
+    seq->n_instructions = n_instructions;
+    seq->position = 0;
+    seq->qubit_width = qubit_width;
+    seq->max_qubits = max_qubits;
+    seq->rz_budget = max_qubits - reserved;
+    seq->teleport_input = teleport_input;
+    seq->n_widgets = 0;
+    return seq;
+}
+
+/*
+ * widget_sequence_destroy
+ * Destructor for a widget sequence
+ * :: seq : widget_sequence_t* :: Sequence to free, the instruction stream is left alone
+ */
+void widget_sequence_destroy(widget_sequence_t* seq)
+{
+    free(seq);
+}
+
+/*
+ * widget_sequence_split
+ * Finds the end of the next widget
+ * :: instructions : const instruction_stream_u* :: Instruction stream
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: start : const size_t :: First instruction of the widget
+ * :: rz_budget : const size_t :: Rz gates allowed in the widget
+ * Returns one past the last instruction of the widget
+ */
+size_t widget_sequence_split(
+    const instruction_stream_u* instructions,
+    const size_t n_instructions,
+    const size_t start,
+    const size_t rz_budget)
+{
+    size_t n_rz = 0;
+    for (size_t i = start; i < n_instructions; i++)
+    {
+        if (INSTRUCTION_TYPE(RZ_MASK) == INSTRUCTION_TYPE(instructions[i].instruction))
+        {
+            if (n_rz == rz_budget)
+            {
+                return i;
+            }
+            n_rz++;
+        }
+    }
+    return n_instructions;
+}
+
+/*
+ * widget_sequence_done
+ * Whether every widget of the sequence has been filled
+ * :: seq : const widget_sequence_t* :: Sequence
+ */
+bool widget_sequence_done(const widget_sequence_t* seq)
+{
+    // An empty stream still produces one widget, as it would for a single call on a widget
+    return seq->position >= seq->n_instructions && seq->n_widgets > 0;
+}
+
+/*
+ * widget_sequence_fill
+ * Parses the next chunk of the sequence into a widget without decomposing it
+ * :: seq : widget_sequence_t* :: Sequence, must not be done
+ * :: wid : widget_t* :: Widget to reset and reuse, NULL to allocate a new one
+ * :: parse : parser :: parse_instruction_block or parse_instruction_block_par
+ * Returns the filled widget
+ */
+widget_t* widget_sequence_fill(
+    widget_sequence_t* seq,
+    widget_t* wid,
+    void (*parse)(widget_t*, instruction_stream_u*, const size_t))
+{
+    assert(!widget_sequence_done(seq));
+    const size_t stop = widget_sequence_split(seq->instructions, seq->n_instructions, seq->position, seq->rz_budget);
+
+    if (NULL == wid)
+    {
+        wid = widget_create(seq->qubit_width, seq->max_qubits);
+    }
+    else
+    {
+        widget_reset(wid, seq->qubit_width);
+    }
+    if (seq->teleport_input)
+    {
+        teleport_input(wid, seq->qubit_width);
+    }
+    parse(wid, seq->instructions + seq->position, stop - seq->position);
+
+    seq->position = stop;
+    seq->n_widgets++;
+    return wid;
+}
+
+/*
+ * widget_sequence_next
+ * Builds and decomposes the next widget of the sequence
+ * :: seq : widget_sequence_t* :: Sequence
+ * :: wid : widget_t* :: Widget from an earlier call to reset and reuse, NULL to allocate a new one
+ * Returns the decomposed widget, owned by the caller, or NULL once the stream is consumed
+ * A reused widget is left alone once the stream is consumed, the caller still owns it
+ */
+widget_t* widget_sequence_next(widget_sequence_t* seq, widget_t* wid)
+{
+    if (widget_sequence_done(seq))
+    {
+        return NULL;
+    }
+
+    wid = widget_sequence_fill(seq, wid, parse_instruction_block_par);
+    widget_decompose(wid);
+    return wid;
+}
@@ -0,0 +1,540 @@
+#include <assert.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "graph_state.h"
+#include "tableau_operations.h"
+#include "input_stream.h"
+#include "instructions.h"
+
+#define N_TEST_ITERATIONS (32)
+#define MAX_TEST_QUBITS (64) // Stabiliser rows are packed into a single word
+
+/*
+ * Stabiliser generators in row form, one word per Pauli string
+ * Two tableaux describe the same state when their reduced row echelon forms match
+ */
+struct stabiliser_rows_t
+{
+    size_t n_qubits;
+    uint64_t x[MAX_TEST_QUBITS];
+    uint64_t z[MAX_TEST_QUBITS];
+    uint8_t r[MAX_TEST_QUBITS];
+};
+
+void rows_from_tableau(struct stabiliser_rows_t* rows, const tableau_t* tab, const size_t n_qubits)
+{
+    rows->n_qubits = n_qubits;
+    for (size_t j = 0; j < n_qubits; j++)
+    {
+        rows->x[j] = 0;
+        rows->z[j] = 0;
+        rows->r[j] = __inline_slice_get_bit(tab->phases, j);
+        for (size_t q = 0; q < n_qubits; q++)
+        {
+            rows->x[j] |= (uint64_t)__inline_slice_get_bit(tab->slices_x[q], j) << q;
+            rows->z[j] |= (uint64_t)__inline_slice_get_bit(tab->slices_z[q], j) << q;
+        }
+    }
+}
+
+/*
+ * Phase exponent of i picked up when multiplying single qubit Paulis
+ */
+int pauli_phase(const int x1, const int z1, const int x2, const int z2)
+{
+    if (!x1 && !z1)
+    {
+        return 0;
+    }
+    if (x1 && z1)
+    {
+        return z2 - x2;
+    }
+    if (x1)
+    {
+        return z2 * (2 * x2 - 1);
+    }
+    return x2 * (1 - 2 * z2);
+}
+
+/*
+ * Multiplies row src into row dst
+ */
+void rows_rowsum(struct stabiliser_rows_t* rows, const size_t dst, const size_t src)
+{
+    int phase = 2 * rows->r[dst] + 2 * rows->r[src];
+    for (size_t q = 0; q < rows->n_qubits; q++)
+    {
+        phase += pauli_phase(
+            (rows->x[src] >> q) & 1, (rows->z[src] >> q) & 1,
+            (rows->x[dst] >> q) & 1, (rows->z[dst] >> q) & 1);
+    }
+    rows->r[dst] = (2 == (((phase % 4) + 4) % 4));
+    rows->x[dst] ^= rows->x[src];
+    rows->z[dst] ^= rows->z[src];
+}
+
+void rows_canonicalise(struct stabiliser_rows_t* rows)
+{
+    size_t pivot = 0;
+    for (size_t col = 0; col < 2 * rows->n_qubits; col++)
+    {
+        uint64_t* block = (col < rows->n_qubits) ? rows->x : rows->z;
+        const uint64_t mask = 1ull << (col % rows->n_qubits);
+
+        size_t row = pivot;
+        while (row < rows->n_qubits && !(block[row] & mask))
+        {
+            row++;
+        }
+        if (row == rows->n_qubits)
+        {
+            continue;
+        }
+
+        const uint64_t x = rows->x[row];
+        const uint64_t z = rows->z[row];
+        const uint8_t r = rows->r[row];
+        rows->x[row] = rows->x[pivot];
+        rows->z[row] = rows->z[pivot];
+        rows->r[row] = rows->r[pivot];
+        rows->x[pivot] = x;
+        rows->z[pivot] = z;
+        rows->r[pivot] = r;
+
+        for (size_t k = 0; k < rows->n_qubits; k++)
+        {
+            if (k != pivot && (block[k] & mask))
+            {
+                rows_rowsum(rows, k, pivot);
+            }
+        }
+        pivot++;
+    }
+}
+
+void assert_same_state(const tableau_t* a, const tableau_t* b, const size_t n_qubits, const bool check_phases)
+{
+    struct stabiliser_rows_t rows_a;
+    struct stabiliser_rows_t rows_b;
+    rows_from_tableau(&rows_a, a, n_qubits);
+    rows_from_tableau(&rows_b, b, n_qubits);
+    rows_canonicalise(&rows_a);
+    rows_canonicalise(&rows_b);
+
+    for (size_t j = 0; j < n_qubits; j++)
+    {
+        assert(rows_a.x[j] == rows_b.x[j]);
+        assert(rows_a.z[j] == rows_b.z[j]);
+        assert(!check_phases || rows_a.r[j] == rows_b.r[j]);
+    }
+}
+
+
+/*
+ * Tableau of the widget's state including anything still in the clifford queue
+ */
+tableau_t* widget_state(widget_t* wid)
+{
+    tableau_t* tab = tableau_create(MAX_TEST_QUBITS);
+    if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        graph_state_to_tableau(wid->graph, tab);
+    }
+    else
+    {
+        for (size_t i = 0; i < wid->tableau->n_qubits; i++)
+        {
+            memcpy(tab->slices_x[i], wid->tableau->slices_x[i], tab->slice_len);
+            memcpy(tab->slices_z[i], wid->tableau->slices_z[i], tab->slice_len);
+        }
+        memcpy(tab->phases, wid->tableau->phases, tab->slice_len);
+    }
+
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        SINGLE_QUBIT_OPERATIONS[wid->queue->table[i] & INSTRUCTION_OPERATOR_MASK](tab, i);
+    }
+    return tab;
+}
+
+/*
+ * Tableau of a decomposed widget, built from its adjacencies and local Cliffords
+ */
+tableau_t* widget_decomposed_state(widget_t* wid)
+{
+    tableau_t* tab = tableau_create(MAX_TEST_QUBITS);
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        tableau_H(tab, i);
+    }
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        struct adjacency_obj adj = widget_get_adjacencies(wid, i);
+        for (size_t j = 0; j < adj.n_adjacent; j++)
+        {
+            assert(adj.adjacencies[j] != i);
+            if (adj.adjacencies[j] > i)
+            {
+                tableau_CZ(tab, i, adj.adjacencies[j]);
+            }
+        }
+        free(adj.adjacencies);
+    }
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        SINGLE_QUBIT_OPERATIONS[wid->queue->table[i] & INSTRUCTION_OPERATOR_MASK](tab, i);
+    }
+    return tab;
+}
+
+
+/*
+ * Random gates on a graph state match the tableau kernels
+ */
+void test_gates(const size_t n_qubits, const size_t n_gates)
+{
+    graph_state_t* gs = graph_state_create(n_qubits);
+    tableau_t* ref = tableau_create(n_qubits);
+
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        size_t targ;
+        while ((targ = rand() % n_qubits) == ctrl){};
+
+        switch (rand() % 3)
+        {
+            case 0:
+            {
+                const instruction_t opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORDS);
+                SINGLE_QUBIT_OPERATIONS[opcode & INSTRUCTION_OPERATOR_MASK](ref, ctrl);
+                graph_state_local_clifford(gs, opcode, ctrl);
+                break;
+            }
+            case 1:
+                tableau_CZ(ref, ctrl, targ);
+                graph_state_CZ(gs, ctrl, targ);
+                break;
+            default:
+                tableau_CNOT(ref, ctrl, targ);
+                graph_state_CNOT(gs, ctrl, targ);
+        }
+    }
+
+    tableau_t* tab = tableau_create(n_qubits);
+    graph_state_to_tableau(gs, tab);
+    assert_same_state(ref, tab, n_qubits, true);
+
+    tableau_destroy(ref);
+    tableau_destroy(tab);
+    graph_state_destroy(gs);
+}
+
+/*
+ * Tableau of a graph state on four qubits, the pair under test then a neighbour for each
+ * Qubits 2 and 3 hang off the control and target, and only when asked
+ */
+tableau_t* cz_pair_state(
+    const uint8_t edge,
+    const instruction_t ctrl_vop,
+    const instruction_t targ_vop,
+    const bool ctrl_neighbour,
+    const bool targ_neighbour)
+{
+    tableau_t* tab = tableau_create(4);
+    for (size_t i = 0; i < 4; i++)
+    {
+        tableau_H(tab, i);
+    }
+    if (edge)
+    {
+        tableau_CZ(tab, 0, 1);
+    }
+    if (ctrl_neighbour)
+    {
+        tableau_CZ(tab, 0, 2);
+    }
+    if (targ_neighbour)
+    {
+        tableau_CZ(tab, 1, 3);
+    }
+    SINGLE_QUBIT_OPERATIONS[ctrl_vop & INSTRUCTION_OPERATOR_MASK](tab, 0);
+    SINGLE_QUBIT_OPERATIONS[targ_vop & INSTRUCTION_OPERATOR_MASK](tab, 1);
+    return tab;
+}
+
+/*
+ * Every entry of GRAPH_STATE_CZ_TABLE against a CZ through the tableau kernels
+ * Diagonal vertex operators are also checked with a neighbour outside the pair
+ */
+void test_cz_table()
+{
+    for (uint8_t edge = 0; edge < 2; edge++)
+    {
+        for (instruction_t ctrl = 0; ctrl < N_LOCAL_CLIFFORDS; ctrl++)
+        {
+            for (instruction_t targ = 0; targ < N_LOCAL_CLIFFORDS; targ++)
+            {
+                const struct graph_state_cz_t* entry = GRAPH_STATE_CZ_TABLE
+                    + edge * N_LOCAL_CLIFFORDS * N_LOCAL_CLIFFORDS
+                    + ctrl * N_LOCAL_CLIFFORDS
+                    + targ;
+                assert(entry->edge < 2);
+                assert((entry->ctrl & INSTRUCTION_OPERATOR_MASK) < N_LOCAL_CLIFFORDS);
+                assert((entry->targ & INSTRUCTION_OPERATOR_MASK) < N_LOCAL_CLIFFORDS);
+
+                const bool ctrl_diagonal = GRAPH_STATE_DIAGONAL(LOCAL_CLIFFORD_MASK | ctrl);
+                const bool targ_diagonal = GRAPH_STATE_DIAGONAL(LOCAL_CLIFFORD_MASK | targ);
+                for (uint8_t neighbours = 0; neighbours < 4; neighbours++)
+                {
+                    const bool ctrl_neighbour = neighbours & 1;
+                    const bool targ_neighbour = neighbours & 2;
+                    if ((ctrl_neighbour && !ctrl_diagonal) || (targ_neighbour && !targ_diagonal))
+                    {
+                        continue;
+                    }
+
+                    tableau_t* ref = cz_pair_state(edge, LOCAL_CLIFFORD_MASK | ctrl, LOCAL_CLIFFORD_MASK | targ, ctrl_neighbour, targ_neighbour);
+                    tableau_CZ(ref, 0, 1);
+                    tableau_t* tab = cz_pair_state(entry->edge, entry->ctrl, entry->targ, ctrl_neighbour, targ_neighbour);
+                    assert_same_state(ref, tab, 4, true);
+                    tableau_destroy(ref);
+                    tableau_destroy(tab);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * Empty graph states allocate and grow like any other
+ */
+void test_empty()
+{
+    graph_state_t* gs = graph_state_create(0);
+    assert(0 == gs->n_qubits);
+    graph_state_grow(gs, 0);
+    graph_state_grow(gs, 3);
+    graph_state_local_clifford(gs, _H_, 0);
+    graph_state_local_clifford(gs, _H_, 2);
+    graph_state_CZ(gs, 0, 2);
+    assert(1 == gs->n_edges);
+    graph_state_destroy(gs);
+}
+
+/*
+ * Local complementation changes the graph but not the state
+ */
+void test_local_complementation(const size_t n_qubits)
+{
+    graph_state_t* gs = graph_state_create(n_qubits);
+    for (size_t i = 0; i < 4 * n_qubits; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        size_t targ;
+        while ((targ = rand() % n_qubits) == ctrl){};
+        graph_state_local_clifford(gs, LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORDS), ctrl);
+        graph_state_CZ(gs, ctrl, targ);
+    }
+
+    tableau_t* ref = tableau_create(n_qubits);
+    graph_state_to_tableau(gs, ref);
+
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        graph_state_local_complementation(gs, rand() % n_qubits);
+
+        tableau_t* tab = tableau_create(n_qubits);
+        graph_state_to_tableau(gs, tab);
+        assert_same_state(ref, tab, n_qubits, true);
+        tableau_destroy(tab);
+    }
+
+    // Adjacencies are symmetric and sorted
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        struct adjacency_obj adj = graph_state_get_adjacencies(gs, i);
+        assert(adj.n_adjacent == gs->degree[i]);
+        for (size_t j = 0; j < adj.n_adjacent; j++)
+        {
+            assert(0 == j || adj.adjacencies[j - 1] < adj.adjacencies[j]);
+            struct adjacency_obj other = graph_state_get_adjacencies(gs, adj.adjacencies[j]);
+            size_t found = 0;
+            for (size_t k = 0; k < other.n_adjacent; k++)
+            {
+                found += (other.adjacencies[k] == i);
+            }
+            assert(1 == found);
+            free(other.adjacencies);
+        }
+        free(adj.adjacencies);
+    }
+
+    tableau_destroy(ref);
+    graph_state_destroy(gs);
+}
+
+
+/*
+ * Random stream of local, non-local, swap and rz instructions
+ */
+instruction_stream_u* random_stream(const size_t n_qubits, const size_t max_qubits, const size_t n_instructions)
+{
+    instruction_stream_u* inst = malloc(sizeof(instruction_stream_u) * n_instructions);
+    size_t n_rz = 0;
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        switch (rand() % 4)
+        {
+            case 0:
+                inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].single.arg = rand() % n_qubits;
+                break;
+            case 1:
+                inst[i].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].multi.ctrl = rand() % n_qubits;
+                while ((inst[i].multi.targ = rand() % n_qubits) == inst[i].multi.ctrl){};
+                break;
+            case 2:
+                inst[i].multi.opcode = _SWAP_;
+                inst[i].multi.ctrl = rand() % n_qubits;
+                while ((inst[i].multi.targ = rand() % n_qubits) == inst[i].multi.ctrl){};
+                break;
+            default:
+                if (n_qubits + n_rz < max_qubits)
+                {
+                    inst[i].rz.opcode = _RZ_;
+                    inst[i].rz.arg = rand() % n_qubits;
+                    inst[i].rz.tag = rand();
+                    n_rz++;
+                    break;
+                }
+                inst[i].single.opcode = _H_;
+                inst[i].single.arg = rand() % n_qubits;
+        }
+    }
+    return inst;
+}
+
+/*
+ * Both engines track the same state, map and measurement tags, before and after decomposition
+ */
+void test_engines(const size_t n_qubits, const size_t max_qubits, const size_t n_instructions)
+{
+    widget_t* ref = widget_create_engine(n_qubits, max_qubits, WIDGET_ENGINE_TABLEAU);
+    widget_t* wid = widget_create_engine(n_qubits, max_qubits, WIDGET_ENGINE_GRAPH);
+    assert(NULL == wid->tableau);
+    teleport_input(ref, n_qubits / 2);
+    teleport_input(wid, n_qubits / 2);
+
+    instruction_stream_u* inst = random_stream(n_qubits, max_qubits - n_qubits / 2, n_instructions);
+    parse_instruction_block(ref, inst, n_instructions);
+    parse_instruction_block(wid, inst, n_instructions);
+    free(inst);
+
+    assert(wid->n_qubits == ref->n_qubits);
+    assert(0 == memcmp(wid->q_map, ref->q_map, wid->n_initial_qubits * sizeof(size_t)));
+    assert(0 == memcmp(wid->queue->non_cliffords, ref->queue->non_cliffords, wid->n_qubits * sizeof(non_clifford_tag_t)));
+
+    tableau_t* ref_state = widget_state(ref);
+    tableau_t* state = widget_state(wid);
+    assert_same_state(ref_state, state, wid->n_qubits, true);
+
+    widget_decompose(ref);
+    widget_decompose(wid);
+
+    // The graph engine keeps the exact state through decomposition
+    tableau_t* decomposed = widget_decomposed_state(wid);
+    assert_same_state(state, decomposed, wid->n_qubits, true);
+    tableau_destroy(decomposed);
+
+    // Tableau elimination does not track every stabiliser sign, so only agree up to Paulis
+    decomposed = widget_decomposed_state(ref);
+    assert_same_state(state, decomposed, wid->n_qubits, false);
+    tableau_destroy(decomposed);
+
+    tableau_destroy(ref_state);
+    tableau_destroy(state);
+
+    widget_destroy(ref);
+    widget_destroy(wid);
+}
+
+
+/*
+ * Automatic widgets convert once the window after the threshold is crossed and track the same state throughout
+ */
+void test_auto_engine(const size_t n_qubits, const size_t n_instructions, const double threshold)
+{
+    widget_t* ref = widget_create_engine(n_qubits, MAX_TEST_QUBITS, WIDGET_ENGINE_TABLEAU);
+    widget_t* wid = widget_create_engine(n_qubits, MAX_TEST_QUBITS, WIDGET_ENGINE_AUTO);
+    widget_set_auto_threshold(wid, threshold);
+    assert(WIDGET_ENGINE_GRAPH == wid->engine);
+
+    instruction_stream_u* inst = random_stream(n_qubits, MAX_TEST_QUBITS, n_instructions);
+    size_t n_gates = 0;
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        const instruction_t type = INSTRUCTION_TYPE(inst[i].single.opcode);
+        n_gates += (INSTRUCTION_TYPE(NON_LOCAL_CLIFFORD_MASK) == type) || (INSTRUCTION_TYPE(RZ_MASK) == type);
+    }
+    parse_instruction_block(ref, inst, n_instructions);
+    parse_instruction_block(wid, inst, n_instructions);
+    free(inst);
+
+    struct widget_engine_stats_t stats = widget_get_engine_stats(wid);
+    assert(WIDGET_ENGINE_AUTO == stats.requested_engine);
+    assert(wid->engine == stats.engine);
+    assert(n_gates == stats.n_gates);
+    assert(n_gates == widget_get_engine_stats(ref).n_gates);
+
+    if (0 == threshold)
+    {
+        // Always converts at the end of the first window
+        assert(n_gates < WIDGET_AUTO_WINDOW || stats.converted);
+    }
+    if (stats.converted)
+    {
+        assert(WIDGET_ENGINE_TABLEAU == wid->engine);
+        assert(NULL == wid->graph);
+        assert(0 == stats.conversion_gate % WIDGET_AUTO_WINDOW);
+        assert(stats.conversion_qubits <= wid->n_qubits);
+    }
+    else
+    {
+        assert(WIDGET_ENGINE_GRAPH == wid->engine);
+        assert(wid->graph->n_edges == stats.n_edges);
+    }
+
+    tableau_t* ref_state = widget_state(ref);
+    tableau_t* state = widget_state(wid);
+    assert_same_state(ref_state, state, wid->n_qubits, true);
+    tableau_destroy(ref_state);
+    tableau_destroy(state);
+
+    widget_destroy(ref);
+    widget_destroy(wid);
+}
+
+int main()
+{
+    srand(0);
+    test_empty();
+    test_cz_table();
+    for (size_t i = 0; i < N_TEST_ITERATIONS; i++)
+    {
+        test_gates(2 + rand() % (MAX_TEST_QUBITS - 1), 256);
+        test_local_complementation(2 + rand() % (MAX_TEST_QUBITS - 1));
+
+        const size_t n_qubits = 2 + rand() % 30;
+        test_engines(n_qubits, MAX_TEST_QUBITS, 4 * n_qubits);
+
+        test_auto_engine(n_qubits, 16 * n_qubits, 0);
+        test_auto_engine(n_qubits, 16 * n_qubits, WIDGET_AUTO_DEFAULT_THRESHOLD);
+        test_auto_engine(n_qubits, 16 * n_qubits, 1e9);
+    }
+    return 0;
+}
@@ -167,6 +167,9 @@ void test_cnot_stream(const size_t n_qubits)
 
         parse_instruction_block(wid, inst, 3);
 
+        // Paulis commute through the gate and stay queued
+        apply_local_cliffords(wid);
+
         tableau_X(tab, i);
         tableau_X(tab, i + 1);
         tableau_CNOT(tab, i, i + 1);
@@ -204,6 +207,9 @@ void test_cz_stream(const size_t n_qubits)
 
         parse_instruction_block(wid, inst, 3);
 
+        // Paulis commute through the gate and stay queued
+        apply_local_cliffords(wid);
+
         tableau_X(tab, i);
         tableau_X(tab, i + 1);
         tableau_CZ(tab, i, i + 1);
@@ -216,6 +222,219 @@ void test_cz_stream(const size_t n_qubits)
     return;
 }
 
+/*
+ * Widgets only sweep rows below the live qubit count
+ * Compares against a widget with the live region forced to the full tableau
+ */
+void test_active_width(const size_t n_qubits, const size_t max_qubits)
+{
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* ref = widget_create(n_qubits, max_qubits);
+    tableau_set_active_qubits(ref->tableau, ref->tableau->n_qubits);
+
+    const size_t n_instructions = 4 * n_qubits;
+    instruction_stream_u* inst = malloc(sizeof(instruction_stream_u) * n_instructions);
+
+    size_t n_rz = 0;
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        switch (rand() % 3)
+        {
+            case 0:
+                inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].single.arg = rand() % n_qubits;
+                break;
+            case 1:
+                inst[i].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].multi.ctrl = rand() % n_qubits;
+                while ((inst[i].multi.targ = rand() % n_qubits) == inst[i].multi.ctrl){};
+                break;
+            default:
+                if (n_qubits + n_rz < max_qubits)
+                {
+                    inst[i].rz.opcode = _RZ_;
+                    inst[i].rz.arg = rand() % n_qubits;
+                    inst[i].rz.tag = rand();
+                    n_rz++;
+                }
+                else
+                {
+                    inst[i].single.opcode = _H_;
+                    inst[i].single.arg = rand() % n_qubits;
+                }
+        }
+    }
+
+    parse_instruction_block(wid, inst, n_instructions);
+    parse_instruction_block(ref, inst, n_instructions);
+    apply_local_cliffords(wid);
+    apply_local_cliffords(ref);
+
+    assert(wid->tableau->active_len <= wid->tableau->slice_len);
+    assert(wid->tableau->active_len * 8 >= wid->n_qubits);
+
+    for (size_t i = 0; i < wid->tableau->n_qubits; i++)
+    {
+        assert(0 == memcmp(wid->tableau->slices_x[i], ref->tableau->slices_x[i], wid->tableau->slice_len));
+        assert(0 == memcmp(wid->tableau->slices_z[i], ref->tableau->slices_z[i], wid->tableau->slice_len));
+    }
+    assert(0 == memcmp(wid->tableau->phases, ref->tableau->phases, wid->tableau->slice_len));
+
+    free(inst);
+    widget_destroy(wid);
+    widget_destroy(ref);
+    return;
+}
+
+
+/*
+ * Queued Cliffords commuted through two qubit gates match applying every gate directly
+ * Local gates are drawn mostly from the Paulis and phase gates, which commute through
+ */
+void test_commuted_stream(const size_t n_qubits, const size_t n_instructions)
+{
+    widget_t* wid = widget_create(n_qubits, n_qubits);
+    tableau_destroy(wid->tableau);
+    wid->tableau = tableau_random_create(n_qubits);
+    tableau_t* tab = tableau_copy(wid->tableau);
+
+    const instruction_t commuting[] = {_X_, _Y_, _Z_, _S_, _R_};
+
+    size_t n_commuted = 0;
+    instruction_stream_u inst;
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        if (rand() % 2)
+        {
+            inst.single.opcode = (rand() % 4) ?
+                commuting[rand() % 5] :
+                LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst.single.arg = rand() % n_qubits;
+            SINGLE_QUBIT_OPERATIONS[inst.single.opcode & INSTRUCTION_OPERATOR_MASK](tab, inst.single.arg);
+        }
+        else
+        {
+            inst.multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+            inst.multi.ctrl = rand() % n_qubits;
+            while ((inst.multi.targ = rand() % n_qubits) == inst.multi.ctrl){};
+            TWO_QUBIT_OPERATIONS[inst.multi.opcode & INSTRUCTION_OPERATOR_MASK](tab, inst.multi.ctrl, inst.multi.targ);
+        }
+        parse_instruction_block(wid, &inst, 1);
+
+        n_commuted += (_I_ != wid->queue->table[rand() % n_qubits]);
+    }
+
+    // Something must have stayed queued across a two qubit gate
+    assert(n_commuted > 0);
+
+    apply_local_cliffords(wid);
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        assert(0 == memcmp(wid->tableau->slices_x[i], tab->slices_x[i], tab->slice_len));
+        assert(0 == memcmp(wid->tableau->slices_z[i], tab->slices_z[i], tab->slice_len));
+    }
+    assert(0 == memcmp(wid->tableau->phases, tab->phases, tab->slice_len));
+
+    tableau_destroy(tab);
+    widget_destroy(wid);
+    return;
+}
+
+
+/*
+ * Swaps relabel qubits, matching the same swaps lowered to three CNOTs
+ * Logical qubit i sits on physical q_map[i] in each widget
+ */
+void test_swap_stream(const size_t n_qubits, const size_t n_instructions)
+{
+    widget_t* wid = widget_create(n_qubits, n_qubits);
+    widget_t* ref = widget_create(n_qubits, n_qubits);
+    tableau_destroy(wid->tableau);
+    tableau_destroy(ref->tableau);
+    wid->tableau = tableau_random_create(n_qubits);
+    ref->tableau = tableau_copy(wid->tableau);
+
+    instruction_stream_u inst[3];
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        switch (rand() % 3)
+        {
+            case 0:
+                inst[0].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[0].single.arg = rand() % n_qubits;
+                parse_instruction_block(wid, inst, 1);
+                parse_instruction_block(ref, inst, 1);
+                break;
+            case 1:
+                inst[0].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[0].multi.ctrl = rand() % n_qubits;
+                while ((inst[0].multi.targ = rand() % n_qubits) == inst[0].multi.ctrl){};
+                parse_instruction_block(wid, inst, 1);
+                parse_instruction_block(ref, inst, 1);
+                break;
+            default:
+            {
+                const uint32_t ctrl = rand() % n_qubits;
+                uint32_t targ;
+                while ((targ = rand() % n_qubits) == ctrl){};
+
+                inst[0].multi.opcode = _SWAP_;
+                inst[0].multi.ctrl = ctrl;
+                inst[0].multi.targ = targ;
+                parse_instruction_block(wid, inst, 1);
+
+                for (size_t j = 0; j < 3; j++)
+                {
+                    inst[j].multi.opcode = _CNOT_;
+                    inst[j].multi.ctrl = (j & 1) ? targ : ctrl;
+                    inst[j].multi.targ = (j & 1) ? ctrl : targ;
+                }
+                parse_instruction_block(ref, inst, 3);
+            }
+        }
+    }
+
+    // Physical qubits are never reassigned by a swap
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        assert(ref->q_map[i] == i);
+    }
+
+    apply_local_cliffords(wid);
+    apply_local_cliffords(ref);
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        assert(0 == memcmp(wid->tableau->slices_x[wid->q_map[i]], ref->tableau->slices_x[i], ref->tableau->slice_len));
+        assert(0 == memcmp(wid->tableau->slices_z[wid->q_map[i]], ref->tableau->slices_z[i], ref->tableau->slice_len));
+    }
+    assert(0 == memcmp(wid->tableau->phases, ref->tableau->phases, ref->tableau->slice_len));
+
+    // Bulk permutations only move entries of the map
+    uint32_t* perm = malloc(n_qubits * sizeof(uint32_t));
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        perm[i] = i;
+    }
+    for (size_t i = n_qubits - 1; i > 0; i--)
+    {
+        const size_t j = rand() % (i + 1);
+        const uint32_t tmp = perm[i];
+        perm[i] = perm[j];
+        perm[j] = tmp;
+    }
+
+    widget_permute_qubits(ref, perm);
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        assert(ref->q_map[perm[i]] == i);
+    }
+
+    free(perm);
+    widget_destroy(wid);
+    widget_destroy(ref);
+    return;
+}
+
 
 int main()
 {
@@ -230,5 +449,20 @@ int main()
         test_cz_stream(n_qubits);
     }
 
+    for (size_t n_qubits = 8; n_qubits < 512; n_qubits += 40) 
+    {
+        test_active_width(n_qubits, 4 * n_qubits);
+    }
+
+    for (size_t n_qubits = 2; n_qubits < 256; n_qubits += 23)
+    {
+        test_commuted_stream(n_qubits, 64 * n_qubits);
+    }
+
+    for (size_t n_qubits = 2; n_qubits < 256; n_qubits += 23)
+    {
+        test_swap_stream(n_qubits, 16 * n_qubits);
+    }
+
     return 0;
 }
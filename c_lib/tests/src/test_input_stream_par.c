@@ -0,0 +1,110 @@
+#include <assert.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "tableau_operations.h"
+#include "input_stream.h"
+#include "input_stream_par.h"
+#include "instructions.h"
+
+#include "test_tableau.h"
+
+/*
+ * Random stream of local, non-local, swap and rz instructions
+ */
+instruction_stream_u* random_stream(const size_t n_qubits, const size_t max_qubits, const size_t n_instructions)
+{
+    instruction_stream_u* inst = malloc(sizeof(instruction_stream_u) * n_instructions);
+    size_t n_rz = 0;
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        switch (rand() % 5)
+        {
+            case 0:
+                inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].single.arg = rand() % n_qubits;
+                break;
+            case 1:
+                inst[i].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].multi.ctrl = rand() % n_qubits;
+                while ((inst[i].multi.targ = rand() % n_qubits) == inst[i].multi.ctrl){};
+                break;
+            case 3:
+                inst[i].multi.opcode = _SWAP_;
+                inst[i].multi.ctrl = rand() % n_qubits;
+                while ((inst[i].multi.targ = rand() % n_qubits) == inst[i].multi.ctrl){};
+                break;
+            case 2:
+                if (n_qubits + n_rz < max_qubits)
+                {
+                    inst[i].rz.opcode = _RZ_;
+                    inst[i].rz.arg = rand() % n_qubits;
+                    inst[i].rz.tag = rand();
+                    n_rz++;
+                    break;
+                }
+            default:
+                inst[i].single.opcode = _H_;
+                inst[i].single.arg = rand() % n_qubits;
+        }
+    }
+    return inst;
+}
+
+void assert_widgets_equal(widget_t* wid, widget_t* ref)
+{
+    assert(wid->n_qubits == ref->n_qubits);
+    assert(0 == memcmp(wid->q_map, ref->q_map, wid->n_initial_qubits * sizeof(size_t)));
+    assert(0 == memcmp(wid->queue->table, ref->queue->table, wid->n_qubits * sizeof(instruction_t)));
+    assert(0 == memcmp(wid->queue->non_cliffords, ref->queue->non_cliffords, wid->n_qubits * sizeof(non_clifford_tag_t)));
+
+    for (size_t i = 0; i < wid->tableau->n_qubits; i++)
+    {
+        assert(0 == memcmp(wid->tableau->slices_x[i], ref->tableau->slices_x[i], wid->tableau->slice_len));
+        assert(0 == memcmp(wid->tableau->slices_z[i], ref->tableau->slices_z[i], wid->tableau->slice_len));
+    }
+    assert(0 == memcmp(wid->tableau->phases, ref->tableau->phases, wid->tableau->slice_len));
+}
+
+void test_par_stream(const size_t n_workers, const size_t n_qubits, const size_t max_qubits)
+{
+    threadpool_init(n_workers, 0);
+
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    widget_t* ref = widget_create(n_qubits, max_qubits);
+    teleport_input(wid, n_qubits / 2);
+    teleport_input(ref, n_qubits / 2);
+
+    const size_t n_instructions = 2 * n_qubits;
+
+    // Several blocks so that queued cliffords carry over between blocks
+    for (size_t block = 0; block < 4; block++)
+    {
+        instruction_stream_u* inst = random_stream(n_qubits, max_qubits - ref->n_qubits + n_qubits, n_instructions);
+        parse_instruction_block_par(wid, inst, n_instructions);
+        parse_instruction_block(ref, inst, n_instructions);
+        assert_widgets_equal(wid, ref);
+        free(inst);
+    }
+
+    apply_local_cliffords_par(wid);
+    apply_local_cliffords(ref);
+    assert_widgets_equal(wid, ref);
+
+    widget_destroy(wid);
+    widget_destroy(ref);
+    threadpool_destroy();
+}
+
+int main()
+{
+    for (size_t n_workers = 1; n_workers <= 6; n_workers++)
+    {
+        for (size_t n_qubits = 64; n_qubits <= 1600; n_qubits += 384)
+        {
+            test_par_stream(n_workers, n_qubits, 8 * n_qubits);
+        }
+    }
+    return 0;
+}
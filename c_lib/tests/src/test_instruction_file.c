@@ -0,0 +1,440 @@
+#include <assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "instruction_file.h"
+#include "widget_sequence.h"
+
+#define N_TEST_ITERATIONS (8)
+
+/*
+ * random_stream
+ * Random stream of every instruction type, with operands across the varint widths
+ * :: n_qubits : const size_t :: Width of the register
+ * :: n_instructions : const size_t :: Length of the stream
+ */
+instruction_stream_u* random_stream(const size_t n_qubits, const size_t n_instructions)
+{
+    instruction_stream_u* inst = (instruction_stream_u*)calloc(n_instructions + 1, sizeof(instruction_stream_u));
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        switch (rand() % 5)
+        {
+            case 0:
+                inst[i].single.opcode = (rand() % 2) ? _H_ : _S_;
+                inst[i].single.arg = rand() % n_qubits;
+                break;
+            case 1:
+                inst[i].multi.opcode = (rand() % 2) ? _CNOT_ : _CZ_;
+                inst[i].multi.ctrl = rand() % n_qubits;
+                inst[i].multi.targ = (inst[i].multi.ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+                break;
+            case 2:
+                inst[i].multi.opcode = _SWAP_;
+                inst[i].multi.ctrl = rand() % n_qubits;
+                inst[i].multi.targ = (inst[i].multi.ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+                break;
+            default:
+                inst[i].rz.opcode = _RZ_;
+                inst[i].rz.arg = rand() % n_qubits;
+                inst[i].rz.tag = (rand() % 2) ? rand() % 128 : UINT32_MAX - rand() % 128;
+        }
+    }
+    return inst;
+}
+
+/*
+ * instruction_eq
+ * Compares the opcode and operands of two instructions, ignoring padding
+ */
+bool instruction_eq(const instruction_stream_u* a, const instruction_stream_u* b)
+{
+    if (a->instruction != b->instruction)
+    {
+        return false;
+    }
+    if (INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK) == INSTRUCTION_TYPE(a->instruction))
+    {
+        return a->single.arg == b->single.arg;
+    }
+    return a->multi.ctrl == b->multi.ctrl && a->multi.targ == b->multi.targ;
+}
+
+/*
+ * write_stream
+ * Writes a stream to a new temporary file in uneven chunks
+ * :: path : char* :: mkstemp template, replaced by the path
+ * :: inst : const instruction_stream_u* :: Stream
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: block_size : const size_t :: Instructions per block
+ */
+void write_stream(char* path, const instruction_stream_u* inst, const size_t n_instructions, const size_t block_size)
+{
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    instruction_file_writer_t* writer = instruction_file_writer_open(fd, block_size);
+    size_t pos = 0;
+    while (pos < n_instructions)
+    {
+        size_t chunk = 1 + rand() % (2 * block_size);
+        chunk = (pos + chunk > n_instructions) ? n_instructions - pos : chunk;
+        instruction_file_write(writer, inst + pos, chunk);
+        pos += chunk;
+    }
+    const size_t n_bytes = instruction_file_writer_close(writer);
+    close(fd);
+
+    struct stat st;
+    assert(0 == stat(path, &st));
+    assert(n_bytes == (size_t)st.st_size);
+}
+
+/*
+ * test_instruction_file_round_trip
+ * Every block and the whole file decode back to the stream that was written
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: block_size : const size_t :: Instructions per block
+ */
+void test_instruction_file_round_trip(const size_t n_instructions, const size_t block_size)
+{
+    const size_t n_qubits = 2 + rand() % 100000;
+    instruction_stream_u* inst = random_stream(n_qubits, n_instructions);
+    char path[] = "/tmp/test_instruction_file_XXXXXX";
+    write_stream(path, inst, n_instructions, block_size);
+
+    instruction_file_reader_t* reader = instruction_file_reader_open(path);
+    assert(NULL != reader);
+    assert(n_instructions == instruction_file_n_instructions(reader));
+    assert(reader->n_blocks == (n_instructions + block_size - 1) / block_size);
+    assert(reader->max_block <= block_size);
+
+    // Much smaller than the unpacked stream
+    assert(reader->len < n_instructions * sizeof(instruction_stream_u) || n_instructions < 16);
+
+    instruction_stream_u* decoded = (instruction_stream_u*)malloc((n_instructions + 1) * sizeof(instruction_stream_u));
+    size_t pos = 0;
+    size_t n_rz = 0;
+    for (size_t i = 0; i < reader->n_blocks; i++)
+    {
+        const size_t n_block = instruction_file_read_block(reader, i, decoded);
+        for (size_t j = 0; j < n_block; j++)
+        {
+            assert(instruction_eq(inst + pos + j, decoded + j));
+            n_rz += (INSTRUCTION_TYPE(RZ_MASK) == INSTRUCTION_TYPE(decoded[j].instruction));
+        }
+        assert(n_rz <= reader->n_rz);
+        pos += n_block;
+    }
+    assert(n_instructions == pos);
+    assert(n_rz == reader->n_rz);
+
+    // Blocks can be read again after their pages were dropped
+    assert(instruction_file_read(reader, decoded));
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        assert(instruction_eq(inst + i, decoded + i));
+    }
+
+    instruction_file_reader_close(reader);
+    unlink(path);
+    free(decoded);
+    free(inst);
+}
+
+/*
+ * assert_widget_eq
+ * Two widgets built from the same instructions agree
+ */
+void assert_widget_eq(const widget_t* a, const widget_t* b, const size_t n_qubits)
+{
+    assert(a->n_qubits == b->n_qubits);
+    assert(0 == memcmp(a->q_map, b->q_map, n_qubits * sizeof(size_t)));
+    assert(0 == memcmp(a->queue->table, b->queue->table, a->n_qubits));
+    assert(0 == memcmp(a->queue->non_cliffords, b->queue->non_cliffords, a->n_qubits * sizeof(non_clifford_tag_t)));
+}
+
+/*
+ * test_instruction_file_parse
+ * Parsing a file block by block matches parsing the stream in one go
+ * :: n_qubits : const size_t :: Width of the register
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: block_size : const size_t :: Instructions per block
+ */
+void test_instruction_file_parse(const size_t n_qubits, const size_t n_instructions, const size_t block_size)
+{
+    instruction_stream_u* inst = random_stream(n_qubits, n_instructions);
+    char path[] = "/tmp/test_instruction_file_XXXXXX";
+    write_stream(path, inst, n_instructions, block_size);
+    instruction_file_reader_t* reader = instruction_file_reader_open(path);
+    assert(NULL != reader);
+
+    widget_t* streamed = widget_create(n_qubits, n_qubits);
+    widget_t* direct = widget_create(n_qubits, n_qubits);
+    teleport_input(streamed, n_qubits);
+    teleport_input(direct, n_qubits);
+    assert(instruction_file_parse(reader, streamed, parse_instruction_block));
+    parse_instruction_block(direct, inst, n_instructions);
+    widget_decompose(streamed);
+    widget_decompose(direct);
+    assert_widget_eq(streamed, direct, n_qubits);
+
+    widget_destroy(streamed);
+    widget_destroy(direct);
+    instruction_file_reader_close(reader);
+    unlink(path);
+    free(inst);
+}
+
+/*
+ * test_instruction_file_sequence
+ * Widgets split from a file match those split from the stream, including widgets that span blocks
+ * :: n_qubits : const size_t :: Width of the register
+ * :: max_qubits : const size_t :: Capacity of each widget
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: block_size : const size_t :: Instructions per block
+ */
+void test_instruction_file_sequence(const size_t n_qubits, const size_t max_qubits, const size_t n_instructions, const size_t block_size)
+{
+    instruction_stream_u* inst = random_stream(n_qubits, n_instructions);
+    char path[] = "/tmp/test_instruction_file_XXXXXX";
+    write_stream(path, inst, n_instructions, block_size);
+    instruction_file_reader_t* reader = instruction_file_reader_open(path);
+    assert(NULL != reader);
+
+    widget_sequence_t* seq = widget_sequence_create(inst, n_instructions, n_qubits, max_qubits, true);
+    instruction_file_sequence_t* file_seq = instruction_file_sequence_create(reader, n_qubits, max_qubits, true);
+
+    widget_t* wid = NULL;
+    widget_t* file_wid = NULL;
+    while (NULL != (wid = widget_sequence_next(seq, wid)))
+    {
+        file_wid = instruction_file_sequence_next(file_seq, file_wid);
+        assert(NULL != file_wid);
+        assert_widget_eq(wid, file_wid, n_qubits);
+    }
+    assert(NULL == instruction_file_sequence_next(file_seq, file_wid));
+    assert(seq->n_widgets == file_seq->n_widgets);
+
+    widget_destroy(file_wid);
+    instruction_file_sequence_destroy(file_seq);
+    widget_sequence_destroy(seq);
+    instruction_file_reader_close(reader);
+    unlink(path);
+    free(inst);
+}
+
+/*
+ * test_instruction_file_header
+ * Empty files are valid, foreign and unclosed files are not
+ */
+void test_instruction_file_header()
+{
+    char path[] = "/tmp/test_instruction_file_XXXXXX";
+    int fd = mkstemp(path);
+    assert(fd >= 0);
+    instruction_file_writer_close(instruction_file_writer_open(fd, 0));
+    close(fd);
+
+    instruction_file_reader_t* reader = instruction_file_reader_open(path);
+    assert(NULL != reader);
+    assert(0 == instruction_file_n_instructions(reader));
+    instruction_file_sequence_t* seq = instruction_file_sequence_create(reader, 2, 8, true);
+    widget_t* wid = instruction_file_sequence_next(seq, NULL);
+    assert(NULL != wid);
+    assert(4 == wid->n_qubits);
+    assert(NULL == instruction_file_sequence_next(seq, wid));
+    widget_destroy(wid);
+    instruction_file_sequence_destroy(seq);
+    instruction_file_reader_close(reader);
+    unlink(path);
+
+    // Written blocks without the index
+    instruction_stream_u* inst = random_stream(4, 100);
+    char unclosed[] = "/tmp/test_instruction_file_XXXXXX";
+    write_stream(unclosed, inst, 100, 16);
+    struct stat st;
+    assert(0 == stat(unclosed, &st));
+    assert(0 == truncate(unclosed, st.st_size - INSTRUCTION_FILE_TRAILER_LEN));
+    assert(NULL == instruction_file_reader_open(unclosed));
+
+    fd = open(unclosed, O_WRONLY);
+    assert(fd >= 0);
+    assert(4 == write(fd, "JSON", 4));
+    close(fd);
+    assert(NULL == instruction_file_reader_open(unclosed));
+    unlink(unclosed);
+    free(inst);
+
+    assert(NULL == instruction_file_reader_open("/tmp/test_instruction_file_missing"));
+}
+
+/*
+ * write_raw_block
+ * Writes a file holding one block of raw bytes, with a well formed index and trailer
+ * :: path : char* :: mkstemp template, replaced by the path
+ * :: bytes : const uint8_t* :: Encoded block
+ * :: len : const size_t :: Bytes in the block
+ * :: n_instructions : const size_t :: Instruction count recorded in the index
+ * :: n_rz : const size_t :: Rz count recorded in the index
+ */
+void write_raw_block(char* path, const uint8_t* bytes, const size_t len, const size_t n_instructions, const size_t n_rz)
+{
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    const uint32_t version = INSTRUCTION_FILE_VERSION;
+    assert(INSTRUCTION_FILE_MAGIC_LEN == write(fd, INSTRUCTION_FILE_MAGIC, INSTRUCTION_FILE_MAGIC_LEN));
+    assert(sizeof(uint32_t) == write(fd, &version, sizeof(uint32_t)));
+    assert((ssize_t)len == write(fd, bytes, len));
+    const uint64_t index_offset = INSTRUCTION_FILE_HEADER_LEN + len;
+    const uint64_t entry[4] = {INSTRUCTION_FILE_HEADER_LEN, len, n_instructions, n_rz};
+    const uint64_t n_blocks = 1;
+    assert(INSTRUCTION_FILE_INDEX_ENTRY_LEN == write(fd, entry, INSTRUCTION_FILE_INDEX_ENTRY_LEN));
+    assert(sizeof(uint64_t) == write(fd, &n_blocks, sizeof(uint64_t)));
+    assert(sizeof(uint64_t) == write(fd, &index_offset, sizeof(uint64_t)));
+    assert(INSTRUCTION_FILE_MAGIC_LEN == write(fd, INSTRUCTION_FILE_MAGIC, INSTRUCTION_FILE_MAGIC_LEN));
+    close(fd);
+}
+
+/*
+ * read_raw_block
+ * Whether a single raw block decodes, and the instructions it decodes to
+ */
+bool read_raw_block(const uint8_t* bytes, const size_t len, const size_t n_instructions, const size_t n_rz, instruction_stream_u* dst)
+{
+    char path[] = "/tmp/test_instruction_file_XXXXXX";
+    write_raw_block(path, bytes, len, n_instructions, n_rz);
+    instruction_file_reader_t* reader = instruction_file_reader_open(path);
+    assert(NULL != reader);
+    const size_t n_decoded = instruction_file_read_block(reader, 0, dst);
+    assert(0 == n_decoded || n_instructions == n_decoded);
+    assert((0 != n_decoded) == instruction_file_read(reader, dst));
+    instruction_file_reader_close(reader);
+    unlink(path);
+    return 0 != n_decoded;
+}
+
+/*
+ * test_instruction_file_corrupt
+ * Blocks that pass the index checks but do not decode are rejected without reading past the block
+ */
+void test_instruction_file_corrupt()
+{
+    instruction_stream_u dst[2];
+
+    const uint8_t valid[] = {_H_, 0x03};
+    assert(read_raw_block(valid, sizeof(valid), 1, 0, dst));
+    assert(_H_ == dst[0].single.opcode && 3 == dst[0].single.arg);
+
+    const uint8_t unknown_opcode[] = {0x3f, 0x01};
+    assert(!read_raw_block(unknown_opcode, sizeof(unknown_opcode), 1, 0, dst));
+    const uint8_t unknown_type[] = {0x00, 0x01};
+    assert(!read_raw_block(unknown_type, sizeof(unknown_type), 1, 0, dst));
+    const uint8_t unknown_conditional[] = {_MCZ_ + 1, 0x01, 0x00};
+    assert(!read_raw_block(unknown_conditional, sizeof(unknown_conditional), 1, 0, dst));
+
+    // Continuation bit set on the last byte of the block
+    const uint8_t truncated[] = {_H_, 0x80};
+    assert(!read_raw_block(truncated, sizeof(truncated), 1, 0, dst));
+    const uint8_t missing_operand[] = {_CNOT_, 0x01, _H_, 0x00};
+    assert(!read_raw_block(missing_operand, sizeof(missing_operand), 2, 0, dst));
+
+    // Ten byte varint with more than 64 bits
+    const uint8_t overlong[] = {_H_, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x02};
+    assert(!read_raw_block(overlong, sizeof(overlong), 1, 0, dst));
+
+    // Tag of 2**36 - 1 does not fit the instruction
+    const uint8_t wide_tag[] = {_RZ_, 0x00, 0xff, 0xff, 0xff, 0xff, 0x7f};
+    assert(!read_raw_block(wide_tag, sizeof(wide_tag), 1, 1, dst));
+
+    const uint8_t trailing[] = {_H_, 0x00, 0x00};
+    assert(!read_raw_block(trailing, sizeof(trailing), 1, 0, dst));
+    const uint8_t miscounted_rz[] = {_RZ_, 0x00, 0x00};
+    assert(!read_raw_block(miscounted_rz, sizeof(miscounted_rz), 1, 0, dst));
+}
+
+/*
+ * test_instruction_file_width
+ * Files that decode but address qubits past the widget width are rejected before parsing
+ */
+void test_instruction_file_width()
+{
+    // CNOT(0, 50000000)
+    const uint8_t far_targ[] = {_CNOT_, 0x00, 0x80, 0xe1, 0xeb, 0x17};
+    char path[] = "/tmp/test_instruction_file_XXXXXX";
+    write_raw_block(path, far_targ, sizeof(far_targ), 1, 0);
+    instruction_file_reader_t* reader = instruction_file_reader_open(path);
+    assert(NULL != reader);
+    instruction_stream_u dst[1];
+    assert(instruction_file_read(reader, dst));
+    assert(50000000 == dst[0].multi.targ);
+
+    widget_t* wid = widget_create(4, 64);
+    assert(!instruction_file_parse(reader, wid, parse_instruction_block));
+    assert(_I_ == wid->queue->table[0]);
+
+    instruction_file_sequence_t* seq = instruction_file_sequence_create(reader, 4, 64, true);
+    assert(!instruction_file_sequence_failed(seq));
+    assert(NULL == instruction_file_sequence_fill(seq, NULL, parse_instruction_block));
+    assert(instruction_file_sequence_failed(seq));
+    assert(instruction_file_sequence_done(seq));
+    assert(NULL == instruction_file_sequence_next(seq, wid));
+    instruction_file_sequence_destroy(seq);
+
+    // A reused widget is left with the caller
+    seq = instruction_file_sequence_create(reader, 4, 64, true);
+    assert(NULL == instruction_file_sequence_next(seq, wid));
+    assert(instruction_file_sequence_failed(seq));
+    widget_destroy(wid);
+    instruction_file_sequence_destroy(seq);
+
+    instruction_file_reader_close(reader);
+    unlink(path);
+}
+
+/*
+ * test_instruction_file_write_failure
+ * Writes to a descriptor that refuses them are reported when the writer closes
+ */
+void test_instruction_file_write_failure()
+{
+    char path[] = "/tmp/test_instruction_file_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    const int read_only = open(path, O_RDONLY);
+    assert(read_only >= 0);
+    assert(NULL == instruction_file_writer_open(read_only, 0));
+
+    instruction_file_writer_t* writer = instruction_file_writer_open(fd, 16);
+    assert(NULL != writer);
+    assert(fd == dup2(read_only, fd));
+    instruction_stream_u* inst = random_stream(8, 100);
+    instruction_file_write(writer, inst, 100);
+    assert(writer->failed);
+    assert(0 == instruction_file_writer_close(writer));
+    free(inst);
+
+    close(read_only);
+    close(fd);
+    unlink(path);
+}
+
+int main()
+{
+    test_instruction_file_header();
+    test_instruction_file_corrupt();
+    test_instruction_file_width();
+    test_instruction_file_write_failure();
+    for (size_t i = 0; i < N_TEST_ITERATIONS; i++)
+    {
+        test_instruction_file_round_trip(rand() % 5000, 1 + rand() % 700);
+        test_instruction_file_parse(2 + rand() % 64, rand() % 2000, 1 + rand() % 300);
+        test_instruction_file_sequence(2 + rand() % 16, 64 + rand() % 64, rand() % 3000, 1 + rand() % 200);
+    }
+    test_instruction_file_round_trip(100000, INSTRUCTION_FILE_DEFAULT_BLOCK);
+    return 0;
+}
@@ -0,0 +1,336 @@
+#include <assert.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "qasm.h"
+
+#define N_TEST_ITERATIONS (8)
+
+/*
+ * parser_from_string
+ * Parser over an in memory circuit
+ */
+qasm_parser_t* parser_from_string(const char* text)
+{
+    FILE* stream = fmemopen((void*)text, strlen(text), "r");
+    assert(NULL != stream);
+    qasm_parser_t* parser = qasm_parser_create(stream);
+    parser->owned = true;
+    return parser;
+}
+
+/*
+ * parse_string
+ * Parses a whole circuit
+ * :: text : const char* :: Circuit
+ * :: dst : instruction_stream_u* :: Destination
+ * :: max_instructions : const size_t :: Capacity of the destination
+ * :: chunk : const size_t :: Instructions per read
+ * Returns the number of instructions, or SIZE_MAX if parsing failed
+ */
+size_t parse_string(const char* text, instruction_stream_u* dst, const size_t max_instructions, const size_t chunk)
+{
+    qasm_parser_t* parser = parser_from_string(text);
+    size_t n = 0;
+    size_t n_read;
+    while (0 < (n_read = qasm_parser_read(parser, dst + n, (n + chunk > max_instructions) ? max_instructions - n : chunk)))
+    {
+        n += n_read;
+    }
+    if (NULL != qasm_parser_error(parser))
+    {
+        n = SIZE_MAX;
+    }
+    else
+    {
+        assert(n == parser->n_instructions);
+    }
+    qasm_parser_destroy(parser);
+    return n;
+}
+
+/*
+ * test_qasm_angle_to_tag
+ * Tags are the bits of the angle as a float
+ */
+void test_qasm_angle_to_tag()
+{
+    assert(0 == qasm_angle_to_tag(0));
+    assert(0 == qasm_angle_to_tag(1e-13));
+    const float quarter = M_PI / 4;
+    uint32_t bits;
+    memcpy(&bits, &quarter, sizeof(bits));
+    assert(bits == qasm_angle_to_tag(M_PI / 4));
+    assert((bits | (1u << 31)) == qasm_angle_to_tag(-M_PI / 4));
+}
+
+/*
+ * test_qasm_gates
+ * Every supported gate and its operands
+ */
+void test_qasm_gates()
+{
+    const char* text =
+        "OPENQASM 2.0;\n"
+        "include \"qelib1.inc\";\n"
+        "// Two registers share one index space\n"
+        "qreg a[2];\n"
+        "qreg b[3];\n"
+        "creg c[5];\n"
+        "h a[0]; s a[1]; sdg b[0]; x b[1]; y b[2]; z a[0]; id a[1];\n"
+        "cx a[0], b[2];\n"
+        "cz b[0],a[1]; // trailing comment\n"
+        "swap a[0], a[1];\n"
+        "barrier a, b;\n"
+        "rz(-3*pi/4) b[1];\n"
+        "rz(0) b[1];\n"
+        "t a[0]; tdg a[1];\n"
+        "rz( (pi + pi) / 8 ) b[2];\n"
+        "measure b[1] -> c[3];\n";
+
+    instruction_stream_u inst[32];
+    const size_t n = parse_string(text, inst, 32, 32);
+    assert(16 == n);
+
+    const instruction_t opcodes[] = {_H_, _S_, _R_, _X_, _Y_, _Z_, _I_, _CNOT_, _CZ_, _SWAP_, _RZ_, _RZ_, _RZ_, _RZ_, _RZ_, _MEAS_};
+    for (size_t i = 0; i < 16; i++)
+    {
+        assert(opcodes[i] == inst[i].instruction);
+    }
+    assert(0 == inst[0].single.arg);
+    assert(1 == inst[1].single.arg);
+    assert(2 == inst[2].single.arg);
+    assert(4 == inst[4].single.arg);
+    assert(0 == inst[7].multi.ctrl && 4 == inst[7].multi.targ);
+    assert(2 == inst[8].multi.ctrl && 1 == inst[8].multi.targ);
+    assert(3 == inst[10].rz.arg);
+    assert(qasm_angle_to_tag(-3 * M_PI / 4) == inst[10].rz.tag);
+    assert(0 == inst[11].rz.tag);
+    assert(qasm_angle_to_tag(M_PI / 4) == inst[12].rz.tag);
+    assert(qasm_angle_to_tag(-M_PI / 4) == inst[13].rz.tag);
+    assert(qasm_angle_to_tag(M_PI / 4) == inst[14].rz.tag);
+    assert(3 == inst[15].cond.ctrl);
+}
+
+/*
+ * test_qasm_broadcast
+ * Gates on whole registers apply to each qubit, or pairwise for two registers
+ */
+void test_qasm_broadcast()
+{
+    const char* text =
+        "qreg q[4]; qreg r[4];\n"
+        "h q;\n"
+        "cx q, r;\n"
+        "cz q[1], r;\n"
+        "measure r -> c;\n";
+
+    instruction_stream_u inst[32];
+    // Broadcasts split across reads
+    for (size_t chunk = 1; chunk < 20; chunk++)
+    {
+        assert(16 == parse_string(text, inst, 32, chunk));
+        for (size_t i = 0; i < 4; i++)
+        {
+            assert(_H_ == inst[i].instruction && i == inst[i].single.arg);
+            assert(_CNOT_ == inst[4 + i].instruction && i == inst[4 + i].multi.ctrl && 4 + i == inst[4 + i].multi.targ);
+            assert(_CZ_ == inst[8 + i].instruction && 1 == inst[8 + i].multi.ctrl && 4 + i == inst[8 + i].multi.targ);
+            assert(_MEAS_ == inst[12 + i].instruction && 4 + i == inst[12 + i].cond.ctrl);
+        }
+    }
+}
+
+/*
+ * test_qasm_empty_register
+ * Broadcasts over an empty register emit nothing rather than acting on the next register
+ */
+void test_qasm_empty_register()
+{
+    instruction_stream_u inst[8];
+    assert(0 == parse_string("qreg a[0]; qreg b[2]; h a; x a;", inst, 8, 8));
+    assert(0 == parse_string("qreg a[0]; qreg b[0]; cx a, b; measure a -> c;", inst, 8, 1));
+    assert(1 == parse_string("qreg a[0]; qreg b[2]; h a; x b[1];", inst, 8, 8));
+    assert(_X_ == inst[0].instruction && 1 == inst[0].single.arg);
+}
+
+/*
+ * test_qasm_errors
+ * Malformed circuits fail with an error rather than emitting instructions
+ */
+void test_qasm_errors()
+{
+    const char* invalid[] = {
+        "qreg q[2]; ccx q[0], q[1], q[0];",
+        "qreg q[2]; h q[2];",
+        "qreg q[2]; h p[0];",
+        "qreg q[2]; cx q[0];",
+        "qreg q[2]; cx q[0], q[0];",
+        "qreg q[2]; qreg r[3]; cx q, r;",
+        "qreg q[2]; rz(theta) q[0];",
+        "qreg q[2]; rz(pi/2 q[0];",
+        "qreg q[2]; h q[0]",
+        "qreg q[2]; qreg q[2];",
+        "qreg q[2]; gate g a { h a; }",
+        "qreg a[1]; qreg b[18446744073709551615]; h b;",
+        "qreg a[1]; qreg b[99999999999999999999999]; h b;",
+        "qreg a[4294967295]; qreg b[1];",
+        "qreg q[2]; rz(pi/0) q[0];",
+        "qreg q[2]; rz(-1/0) q[0];",
+        "qreg q[2]; rz(0/0) q[0];",
+        "qreg q[2]; rz(1e300*1e300) q[0];",
+        "qreg q[2]; rz(1e39) q[0];",
+        "qreg q[0]; qreg r[2]; cx q, r;",
+    };
+    instruction_stream_u inst[8];
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(char*); i++)
+    {
+        assert(SIZE_MAX == parse_string(invalid[i], inst, 8, 8));
+    }
+
+    qasm_parser_t* parser = parser_from_string("qreg q[2];\nh q[0];\n\nx q[5];\n");
+    assert(0 == qasm_parser_read(parser, inst, 8));
+    assert(NULL != qasm_parser_error(parser));
+    assert(4 == qasm_parser_line(parser));
+    qasm_parser_destroy(parser);
+}
+
+/*
+ * random_circuit
+ * Writes a random circuit as text
+ * Returns the text, freed by the caller
+ */
+char* random_circuit(const size_t n_qubits, const size_t n_gates)
+{
+    char* text = (char*)malloc(64 * (n_gates + 1));
+    size_t len = sprintf(text, "OPENQASM 2.0;\nqreg q[%zu];\n", n_qubits);
+    const char* single[] = {"h", "s", "sdg", "x", "y", "z", "t", "tdg"};
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        const size_t targ = (ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+        switch (rand() % 4)
+        {
+            case 0:
+                len += sprintf(text + len, "%s q[%zu];\n", single[rand() % 8], ctrl);
+                break;
+            case 1:
+                len += sprintf(text + len, "%s q[%zu],q[%zu];\n", (rand() % 2) ? "cx" : "cz", ctrl, targ);
+                break;
+            case 2:
+                len += sprintf(text + len, "rz(%d*pi/%d) q[%zu];\n", rand() % 7 - 3, 1 + rand() % 8, ctrl);
+                break;
+            default:
+                len += sprintf(text + len, "swap q[%zu], q[%zu];\n", ctrl, targ);
+        }
+    }
+    return text;
+}
+
+/*
+ * test_qasm_parse
+ * Parsing into a widget in blocks matches parsing the instructions in one go
+ * :: n_qubits : const size_t :: Width of the circuit
+ * :: n_gates : const size_t :: Length of the circuit
+ */
+void test_qasm_parse(const size_t n_qubits, const size_t n_gates)
+{
+    char* text = random_circuit(n_qubits, n_gates);
+    instruction_stream_u* inst = (instruction_stream_u*)malloc((n_gates + 1) * sizeof(instruction_stream_u));
+    assert(n_gates == parse_string(text, inst, n_gates, n_gates));
+
+    widget_t* streamed = widget_create(n_qubits, 4 * n_qubits + n_gates);
+    widget_t* direct = widget_create(n_qubits, 4 * n_qubits + n_gates);
+    teleport_input(streamed, n_qubits);
+    teleport_input(direct, n_qubits);
+
+    qasm_parser_t* parser = parser_from_string(text);
+    assert(n_gates == qasm_parse(parser, streamed, parse_instruction_block));
+    assert(NULL == qasm_parser_error(parser));
+    assert(n_qubits == parser->n_qubits);
+    qasm_parser_destroy(parser);
+    parse_instruction_block(direct, inst, n_gates);
+
+    widget_decompose(streamed);
+    widget_decompose(direct);
+    assert(streamed->n_qubits == direct->n_qubits);
+    assert(0 == memcmp(streamed->q_map, direct->q_map, n_qubits * sizeof(size_t)));
+    assert(0 == memcmp(streamed->queue->table, direct->queue->table, direct->n_qubits));
+    assert(0 == memcmp(streamed->queue->non_cliffords, direct->queue->non_cliffords, direct->n_qubits * sizeof(non_clifford_tag_t)));
+
+    // Too narrow a widget is an error
+    widget_t* narrow = widget_create(n_qubits - 1, 4 * n_qubits + n_gates);
+    parser = parser_from_string(text);
+    assert(0 == qasm_parse(parser, narrow, parse_instruction_block));
+    assert(NULL != qasm_parser_error(parser));
+    qasm_parser_destroy(parser);
+
+    widget_destroy(narrow);
+    widget_destroy(streamed);
+    widget_destroy(direct);
+    free(inst);
+    free(text);
+}
+
+/*
+ * test_qasm_instruction_file
+ * Circuits convert to instruction files that read back as the parsed instructions
+ * :: n_qubits : const size_t :: Width of the circuit
+ * :: n_gates : const size_t :: Length of the circuit
+ */
+void test_qasm_instruction_file(const size_t n_qubits, const size_t n_gates)
+{
+    char* text = random_circuit(n_qubits, n_gates);
+    instruction_stream_u* inst = (instruction_stream_u*)malloc((n_gates + 1) * sizeof(instruction_stream_u));
+    assert(n_gates == parse_string(text, inst, n_gates, n_gates));
+
+    char path[] = "/tmp/test_qasm_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    instruction_file_writer_t* writer = instruction_file_writer_open(fd, 1 + rand() % 100);
+    qasm_parser_t* parser = parser_from_string(text);
+    assert(n_gates == qasm_write_instruction_file(parser, writer));
+    qasm_parser_destroy(parser);
+    instruction_file_writer_close(writer);
+    close(fd);
+
+    instruction_file_reader_t* reader = instruction_file_reader_open(path);
+    assert(NULL != reader);
+    assert(n_gates == instruction_file_n_instructions(reader));
+    instruction_stream_u* decoded = (instruction_stream_u*)malloc((n_gates + 1) * sizeof(instruction_stream_u));
+    assert(instruction_file_read(reader, decoded));
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        assert(inst[i].instruction == decoded[i].instruction);
+        assert(inst[i].multi.ctrl == decoded[i].multi.ctrl);
+        if (INSTRUCTION_TYPE(LOCAL_CLIFFORD_MASK) != INSTRUCTION_TYPE(inst[i].instruction))
+        {
+            assert(inst[i].multi.targ == decoded[i].multi.targ);
+        }
+    }
+
+    instruction_file_reader_close(reader);
+    unlink(path);
+    free(decoded);
+    free(inst);
+    free(text);
+}
+
+int main()
+{
+    test_qasm_angle_to_tag();
+    test_qasm_gates();
+    test_qasm_broadcast();
+    test_qasm_empty_register();
+    test_qasm_errors();
+    for (size_t i = 0; i < N_TEST_ITERATIONS; i++)
+    {
+        test_qasm_parse(2 + rand() % 32, rand() % 2000);
+        test_qasm_instruction_file(2 + rand() % 32, rand() % 2000);
+    }
+    return 0;
+}
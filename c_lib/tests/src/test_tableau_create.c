@@ -1,4 +1,5 @@
 #include "tableau.h"
+#include "threadpool.h"
 #include <assert.h>
 
 void test_tableau_mem(const size_t n_qubits)
@@ -37,6 +38,39 @@ void test_tableau_create(const size_t n_qubits)
     tableau_destroy(tab);
 }
 
+void test_tableau_create_alloc(const size_t n_qubits, const uint8_t alloc_policy)
+{
+    tableau_t* tab = tableau_create_alloc(n_qubits, alloc_policy);
+    assert(NULL != tab);
+
+    // Explicit huge pages may fall back, but never to the unmapped path
+    if (TABLEAU_ALLOC_HUGETLB == alloc_policy)
+    {
+        assert(TABLEAU_ALLOC_HUGETLB == tab->alloc_policy
+            || TABLEAU_ALLOC_HUGE == tab->alloc_policy
+            || TABLEAU_ALLOC_MMAP == tab->alloc_policy);
+    }
+    else if (TABLEAU_ALLOC_HUGE != alloc_policy)
+    {
+        assert(alloc_policy == tab->alloc_policy);
+    }
+    assert(tab->alloc_bytes >= 2 * tab->slice_len * n_qubits);
+
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        for (size_t j = 0; j < tab->slice_len / sizeof(CHUNK_OBJ); j++)
+        {
+            assert(0 == tab->slices_x[i][j]);
+            CHUNK_OBJ expected = (j == i / CHUNK_SIZE_BITS) ? (1ull << (i % CHUNK_SIZE_BITS)) : 0;
+            assert(expected == tab->slices_z[i][j]);
+        }
+    }
+
+    // The whole allocation must be writable
+    memset(tab->chunks, 0xff, 2 * tab->slice_len * n_qubits);
+    tableau_destroy(tab);
+}
+
 
 int main()
 {
@@ -60,5 +94,21 @@ int main()
         test_tableau_create(n_qubits);
     }
 
+    for (uint8_t policy = 0; policy < TABLEAU_N_ALLOC_POLICIES; policy++)
+    {
+        test_tableau_create_alloc(1, policy);
+        test_tableau_create_alloc(CACHE_SIZE_BITS * 3 + 17, policy);
+        test_tableau_create_alloc(4096, policy);
+    }
+
+    // First touch stripes over the workers
+    threadpool_init(4, 0);
+    for (size_t n_qubits = 1; n_qubits < CACHE_SIZE_BITS * 8; n_qubits += 61)
+    {
+        test_tableau_create_alloc(n_qubits, TABLEAU_ALLOC_FIRST_TOUCH);
+    }
+    test_tableau_create_alloc(4096, TABLEAU_ALLOC_FIRST_TOUCH);
+    threadpool_destroy();
+
     return 0;    
 }
@@ -0,0 +1,102 @@
+#include <assert.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "tableau_operations.h"
+#include "simd_gaussian_elimination.h"
+#include "threadpool.h"
+
+#include "input_stream.h"
+#include "instructions.h"
+
+/*
+ * Random stream of local, non-local and rz instructions
+ */
+instruction_stream_u* create_instruction_stream(const size_t n_qubits, const size_t n_rz, const size_t n_gates)
+{
+    instruction_stream_u* inst = malloc(n_gates * sizeof(instruction_stream_u));
+    size_t rz = 0;
+    for (size_t i = 0; i < n_gates; i++)
+    {
+        switch (rand() % 3)
+        {
+            case 0:
+                inst[i].single.opcode = LOCAL_CLIFFORD_MASK | (rand() % N_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].single.arg = rand() % n_qubits;
+                break;
+            case 1:
+                if (rz < n_rz)
+                {
+                    inst[i].rz.opcode = _RZ_;
+                    inst[i].rz.arg = rand() % n_qubits;
+                    inst[i].rz.tag = rand();
+                    rz++;
+                    break;
+                }
+            default:
+                inst[i].multi.opcode = NON_LOCAL_CLIFFORD_MASK | (rand() % N_NON_LOCAL_CLIFFORD_INSTRUCTIONS);
+                inst[i].multi.ctrl = rand() % n_qubits;
+                while ((inst[i].multi.targ = rand() % n_qubits) == inst[i].multi.ctrl){};
+        }
+    }
+    return inst;
+}
+
+/*
+ * Decomposes the same widget serially and over the threadpool
+ * The decomposed X block is the identity, so both results must agree exactly
+ */
+void test_decomp_par(const size_t n_workers, const size_t n_qubits, const size_t max_qubits)
+{
+    const size_t n_gates = 4 * n_qubits;
+    instruction_stream_u* inst = create_instruction_stream(n_qubits, max_qubits - n_qubits, n_gates);
+
+    widget_t* ref = widget_create(n_qubits, max_qubits);
+    widget_t* wid = widget_create(n_qubits, max_qubits);
+    parse_instruction_block(ref, inst, n_gates);
+    parse_instruction_block(wid, inst, n_gates);
+    apply_local_cliffords(ref);
+    apply_local_cliffords(wid);
+
+    simd_widget_decompose(ref);
+
+    // Adjacency matrix of the graph state is symmetric
+    for (size_t i = 0; i < ref->tableau->n_qubits; i++)
+    {
+        for (size_t j = 0; j < i; j++)
+        {
+            assert(__inline_slice_get_bit(ref->tableau->slices_z[i], j) == __inline_slice_get_bit(ref->tableau->slices_z[j], i));
+        }
+    }
+
+    threadpool_init(n_workers, 0);
+    simd_widget_decompose(wid);
+    threadpool_destroy();
+
+    for (size_t i = 0; i < wid->tableau->n_qubits; i++)
+    {
+        assert(1 == __inline_slice_get_bit(wid->tableau->slices_x[i], i));
+        assert(0 == memcmp(wid->tableau->slices_x[i], ref->tableau->slices_x[i], wid->tableau->slice_len));
+        assert(0 == memcmp(wid->tableau->slices_z[i], ref->tableau->slices_z[i], wid->tableau->slice_len));
+    }
+    assert(0 == memcmp(wid->tableau->phases, ref->tableau->phases, wid->tableau->slice_len));
+    assert(0 == memcmp(wid->queue->table, ref->queue->table, wid->tableau->n_qubits * sizeof(instruction_t)));
+
+    free(inst);
+    widget_destroy(ref);
+    widget_destroy(wid);
+}
+
+int main()
+{
+    for (size_t n_workers = 2; n_workers <= 5; n_workers++)
+    {
+        for (size_t n_qubits = 128; n_qubits <= 768; n_qubits += 320)
+        {
+            test_decomp_par(n_workers, n_qubits, n_qubits);
+            test_decomp_par(n_workers, n_qubits, 2 * n_qubits + 64);
+        }
+    }
+    return 0;
+}
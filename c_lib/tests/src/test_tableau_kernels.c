@@ -0,0 +1,275 @@
+#include <assert.h>
+
+#include "tableau.h"
+#include "tableau_operations.h"
+#include "tableau_kernels.h"
+#include "simd_gaussian_elimination.h"
+#include "rowswap.h"
+
+/*
+ * Random tableau with every slice and the phases filled
+ */
+tableau_t* create_random_tableau(const size_t n_qubits)
+{
+    tableau_t* tab = tableau_create(n_qubits);
+    for (size_t i = 0; i < n_qubits; i++)
+    {
+        for (size_t j = 0; j < tab->slice_len; j++)
+        {
+            ((uint8_t*)tab->slices_x[i])[j] = rand();
+            ((uint8_t*)tab->slices_z[i])[j] = rand();
+        }
+    }
+    for (size_t j = 0; j < tab->slice_len; j++)
+    {
+        ((uint8_t*)tab->phases)[j] = rand();
+    }
+    return tab;
+}
+
+/*
+ * Copies the contents of one tableau into another of the same size
+ */
+void copy_tableau(tableau_t* dst, tableau_t const* src)
+{
+    for (size_t i = 0; i < src->n_qubits; i++)
+    {
+        memcpy(dst->slices_x[i], src->slices_x[i], src->slice_len);
+        memcpy(dst->slices_z[i], src->slices_z[i], src->slice_len);
+    }
+    memcpy(dst->phases, src->phases, src->slice_len);
+    dst->active_start = src->active_start;
+    dst->active_len = src->active_len;
+}
+
+void assert_tableau_eq(tableau_t const* a, tableau_t const* b)
+{
+    for (size_t i = 0; i < a->n_qubits; i++)
+    {
+        assert(0 == memcmp(a->slices_x[i], b->slices_x[i], a->slice_len));
+        assert(0 == memcmp(a->slices_z[i], b->slices_z[i], a->slice_len));
+    }
+    assert(0 == memcmp(a->phases, b->phases, a->slice_len));
+}
+
+
+/*
+ * Every gate on the backend matches the scalar kernels, over the full and partial active regions
+ */
+void test_gates(const uint8_t backend, const size_t n_qubits, const size_t n_active)
+{
+    tableau_t* ref = create_random_tableau(n_qubits);
+    tableau_t* tab = tableau_create(n_qubits);
+    tableau_set_active_qubits(ref, n_active);
+
+    for (size_t gate = 0; gate < N_LOCAL_CLIFFORDS; gate++)
+    {
+        const size_t targ = rand() % n_qubits;
+        copy_tableau(tab, ref);
+
+        assert(tableau_kernels_set_backend(TABLEAU_KERNELS_SCALAR));
+        SINGLE_QUBIT_OPERATIONS[gate](ref, targ);
+
+        assert(tableau_kernels_set_backend(backend));
+        SINGLE_QUBIT_OPERATIONS[gate](tab, targ);
+
+        assert_tableau_eq(ref, tab);
+    }
+
+    for (size_t gate = 0; gate < N_NON_LOCAL_CLIFFORDS; gate++)
+    {
+        const size_t ctrl = rand() % n_qubits;
+        size_t targ;
+        while ((targ = rand() % n_qubits) == ctrl){};
+        copy_tableau(tab, ref);
+
+        assert(tableau_kernels_set_backend(TABLEAU_KERNELS_SCALAR));
+        TWO_QUBIT_OPERATIONS[gate](ref, ctrl, targ);
+
+        assert(tableau_kernels_set_backend(backend));
+        TWO_QUBIT_OPERATIONS[gate](tab, ctrl, targ);
+
+        assert_tableau_eq(ref, tab);
+    }
+
+    tableau_destroy(ref);
+    tableau_destroy(tab);
+}
+
+
+/*
+ * Fused kernels match flushing both local Cliffords with the scalar kernels before the gate
+ */
+void test_fused(const uint8_t backend, const size_t n_qubits, const size_t n_active)
+{
+    tableau_t* init = create_random_tableau(n_qubits);
+    tableau_t* ref = tableau_create(n_qubits);
+    tableau_t* tab = tableau_create(n_qubits);
+    tableau_set_active_qubits(init, n_active);
+
+    for (size_t gate = 0; gate < N_NON_LOCAL_CLIFFORDS; gate++)
+    {
+        for (size_t ctrl_clifford = 0; ctrl_clifford < N_LOCAL_CLIFFORDS; ctrl_clifford++)
+        {
+            for (size_t targ_clifford = 0; targ_clifford < N_LOCAL_CLIFFORDS; targ_clifford++)
+            {
+                const size_t ctrl = rand() % n_qubits;
+                size_t targ;
+                while ((targ = rand() % n_qubits) == ctrl){};
+                copy_tableau(ref, init);
+                copy_tableau(tab, init);
+
+                assert(tableau_kernels_set_backend(TABLEAU_KERNELS_SCALAR));
+                SINGLE_QUBIT_OPERATIONS[ctrl_clifford](ref, ctrl);
+                SINGLE_QUBIT_OPERATIONS[targ_clifford](ref, targ);
+                TWO_QUBIT_OPERATIONS[gate](ref, ctrl, targ);
+
+                assert(tableau_kernels_set_backend(backend));
+                FUSED_TWO_QUBIT_OPERATIONS[gate](tab, LOCAL_CLIFFORD_MASK | ctrl_clifford, ctrl, LOCAL_CLIFFORD_MASK | targ_clifford, targ);
+
+                assert_tableau_eq(ref, tab);
+            }
+        }
+    }
+
+    tableau_destroy(init);
+    tableau_destroy(ref);
+    tableau_destroy(tab);
+}
+
+
+/*
+ * Rowsums and row swaps match the scalar kernels, including the phase
+ */
+void test_rows(const uint8_t backend, const size_t n_bytes)
+{
+    uint8_t* rows[2][4];
+    for (size_t i = 0; i < 4; i++)
+    {
+        rows[0][i] = malloc(n_bytes);
+        rows[1][i] = malloc(n_bytes);
+        for (size_t j = 0; j < n_bytes; j++)
+        {
+            rows[0][i][j] = rows[1][i][j] = rand();
+        }
+    }
+
+    assert(tableau_kernels_set_backend(TABLEAU_KERNELS_SCALAR));
+    const int8_t ref_phase = simd_rowsum_cnf(n_bytes, rows[0][0], rows[0][1], rows[0][2], rows[0][3]);
+    simd_row_swap(n_bytes, rows[0][0], rows[0][1], rows[0][2], rows[0][3]);
+
+    assert(tableau_kernels_set_backend(backend));
+    const int8_t phase = simd_rowsum_cnf(n_bytes, rows[1][0], rows[1][1], rows[1][2], rows[1][3]);
+    simd_row_swap(n_bytes, rows[1][0], rows[1][1], rows[1][2], rows[1][3]);
+
+    assert(ref_phase == phase);
+    for (size_t i = 0; i < 4; i++)
+    {
+        assert(0 == memcmp(rows[0][i], rows[1][i], n_bytes));
+        free(rows[0][i]);
+        free(rows[1][i]);
+    }
+}
+
+
+/*
+ * Both transposes and the transverse hadamard match the scalar kernels
+ */
+void test_transposed(const uint8_t backend, const size_t n_qubits)
+{
+    tableau_t* ref = create_random_tableau(n_qubits);
+    tableau_t* tab = tableau_create(n_qubits);
+    copy_tableau(tab, ref);
+    const size_t targ = rand() % n_qubits;
+
+    assert(tableau_kernels_set_backend(TABLEAU_KERNELS_SCALAR));
+    simd_transpose_64x64(ref->slices_x, ref->slices_x + 64);
+    simd_transpose_64x64_inplace(ref->slices_z);
+    simd_tableau_transverse_hadamard(ref, targ);
+
+    assert(tableau_kernels_set_backend(backend));
+    simd_transpose_64x64(tab->slices_x, tab->slices_x + 64);
+    simd_transpose_64x64_inplace(tab->slices_z);
+    simd_tableau_transverse_hadamard(tab, targ);
+
+    assert_tableau_eq(ref, tab);
+
+    tableau_destroy(ref);
+    tableau_destroy(tab);
+}
+
+
+/*
+ * The scalar transpose swaps bit (i, j) of one block with bit (j, i) of the other
+ */
+void test_scalar_transpose(void)
+{
+    uint64_t a[64];
+    uint64_t b[64];
+    uint64_t* ptr_a[64];
+    uint64_t* ptr_b[64];
+    for (size_t i = 0; i < 64; i++)
+    {
+        a[i] = ((uint64_t)rand() << 32) ^ rand();
+        b[i] = ((uint64_t)rand() << 32) ^ rand();
+        ptr_a[i] = a + i;
+        ptr_b[i] = b + i;
+    }
+
+    uint64_t init_a[64];
+    uint64_t init_b[64];
+    memcpy(init_a, a, sizeof(a));
+    memcpy(init_b, b, sizeof(b));
+
+    scalar_transpose_64x64(ptr_a, ptr_b);
+    for (size_t i = 0; i < 64; i++)
+    {
+        for (size_t j = 0; j < 64; j++)
+        {
+            assert(((a[i] >> j) & 1) == ((init_b[j] >> i) & 1));
+            assert(((b[i] >> j) & 1) == ((init_a[j] >> i) & 1));
+        }
+    }
+}
+
+
+int main()
+{
+    srand(0);
+    tableau_kernels_init();
+    const uint8_t host_backend = tableau_kernels_backend();
+    assert(tableau_kernels_backend_supported(host_backend));
+    assert(tableau_kernels_backend_supported(TABLEAU_KERNELS_SCALAR));
+    assert(!tableau_kernels_set_backend(TABLEAU_KERNELS_N_BACKENDS));
+
+    test_scalar_transpose();
+
+    for (uint8_t backend = 0; backend < TABLEAU_KERNELS_N_BACKENDS; backend++)
+    {
+        if (!tableau_kernels_backend_supported(backend))
+        {
+            continue;
+        }
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            test_gates(backend, 1088, 1088);
+            test_gates(backend, 1088, 1 + rand() % 1088);
+        }
+
+        test_fused(backend, 256, 256);
+        test_fused(backend, 576, 1 + rand() % 576);
+
+        // Rows are always whole cache lines
+        for (size_t n_bytes = CACHE_SIZE; n_bytes <= 8 * CACHE_SIZE; n_bytes += CACHE_SIZE)
+        {
+            test_rows(backend, n_bytes);
+        }
+
+        test_transposed(backend, 128);
+        test_transposed(backend, 1088);
+    }
+
+    assert(tableau_kernels_set_backend(host_backend));
+    return 0;
+}
@@ -0,0 +1,220 @@
+#include <assert.h>
+#include <pthread.h>
+#include <sched.h>
+
+#include "threadpool.h"
+#include "tableau_operations.h"
+
+#include "test_tableau.h"
+
+#define N_TASKS (1 << 14)
+
+void count_task(void* args)
+{
+    __atomic_add_fetch((size_t*)args, 1, __ATOMIC_RELAXED);
+}
+
+/*
+ * Spawns further tasks from inside the pool
+ * These land on the local deque and are stolen by idle workers
+ */
+void spawn_task(void* args)
+{
+    for (size_t i = 0; i < 16; i++)
+    {
+        threadpool_add_task(count_task, args);
+    }
+}
+
+/*
+ * Waits on its own batch from inside the pool
+ */
+void nested_batch_task(void* args)
+{
+    size_t counter = 0;
+    threadpool_batch_t batch = THREADPOOL_BATCH_INIT;
+    for (size_t i = 0; i < 16; i++)
+    {
+        threadpool_batch_add_task(&batch, count_task, &counter);
+    }
+    threadpool_batch_wait(&batch);
+    assert(16 == counter);
+    __atomic_add_fetch((size_t*)args, counter, __ATOMIC_RELAXED);
+}
+
+/*
+ * Waits on batches from a thread outside the pool
+ */
+void* foreign_thread(void* args)
+{
+    (void)args;
+    for (size_t j = 0; j < 64; j++)
+    {
+        size_t counter = 0;
+        threadpool_batch_t batch = THREADPOOL_BATCH_INIT;
+        for (size_t i = 0; i < 64; i++)
+        {
+            threadpool_batch_add_task(&batch, count_task, &counter);
+        }
+        threadpool_batch_wait(&batch);
+        assert(64 == counter);
+    }
+    return NULL;
+}
+
+static pthread_t MAIN_THREAD;
+static int RELEASED;
+
+/*
+ * Holds a worker until released
+ * The waiting main thread may pick it up itself, in which case it must not block on itself
+ */
+void blocking_task(void* args)
+{
+    (void)args;
+    if (pthread_equal(pthread_self(), MAIN_THREAD))
+    {
+        return;
+    }
+    while (!__atomic_load_n(&RELEASED, __ATOMIC_ACQUIRE))
+    {
+        sched_yield();
+    }
+}
+
+void stripe_task(void* args)
+{
+    struct distributed_tableau_op* op = (struct distributed_tableau_op*)args;
+    assert(op->start % CACHE_SIZE == 0);
+    assert(op->start <= op->stop);
+    for (size_t i = op->start; i < op->stop; i++)
+    {
+        ((uint8_t*)op->tab->slices_x[op->targ])[i] ^= ((uint8_t*)op->tab->slices_z[op->ctrl])[i];
+        ((uint8_t*)op->tab->phases)[i] += 1;
+    }
+}
+
+void test_tasks(const size_t n_workers, const uint32_t flags)
+{
+    threadpool_init(n_workers, flags);
+    assert(threadpool_n_workers() == n_workers);
+
+    size_t counter = 0;
+    for (size_t i = 0; i < N_TASKS; i++)
+    {
+        threadpool_add_task(count_task, &counter);
+    }
+    threadpool_barrier();
+    assert(counter == N_TASKS);
+
+    counter = 0;
+    for (size_t i = 0; i < N_TASKS / 16; i++)
+    {
+        threadpool_add_task(spawn_task, &counter);
+    }
+    threadpool_barrier();
+    assert(counter == N_TASKS);
+
+    threadpool_destroy();
+    assert(threadpool_n_workers() == 1);
+}
+
+void test_batches(const size_t n_workers)
+{
+    threadpool_init(n_workers, 0);
+
+    // Batches waited on inside pool jobs
+    size_t counter = 0;
+    for (size_t i = 0; i < N_TASKS / 16; i++)
+    {
+        threadpool_add_task(nested_batch_task, &counter);
+    }
+    threadpool_barrier();
+    assert(counter == N_TASKS);
+
+    // Batches waited on from several threads at once
+    pthread_t threads[4];
+    for (size_t i = 0; i < 4; i++)
+    {
+        pthread_create(threads + i, NULL, foreign_thread, NULL);
+    }
+    foreign_thread(NULL);
+    for (size_t i = 0; i < 4; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    // A batch does not wait on unrelated jobs
+    MAIN_THREAD = pthread_self();
+    __atomic_store_n(&RELEASED, 0, __ATOMIC_RELEASE);
+    threadpool_add_task(blocking_task, NULL);
+    counter = 0;
+    threadpool_batch_t batch = THREADPOOL_BATCH_INIT;
+    for (size_t i = 0; i < N_TASKS; i++)
+    {
+        threadpool_batch_add_task(&batch, count_task, &counter);
+    }
+    threadpool_batch_wait(&batch);
+    assert(counter == N_TASKS);
+    __atomic_store_n(&RELEASED, 1, __ATOMIC_RELEASE);
+
+    threadpool_destroy();
+}
+
+void test_distribute(const size_t n_workers, const size_t n_qubits)
+{
+    threadpool_init(n_workers, 0);
+
+    tableau_t* tab = tableau_random_create(n_qubits);
+    tableau_t* ref = tableau_copy(tab);
+    memset(tab->phases, 0, tab->slice_len);
+
+    const size_t ctrl = rand() % n_qubits;
+    const size_t targ = rand() % n_qubits;
+    threadpool_distribute_tableau_operation(tab, stripe_task, ctrl, targ);
+
+    // Every byte of the live region is touched exactly once
+    for (size_t i = 0; i < tab->slice_len; i++)
+    {
+        assert(((uint8_t*)tab->phases)[i] == (i < tab->active_len));
+    }
+
+    for (size_t i = 0; i < tab->slice_len; i++)
+    {
+        ((uint8_t*)ref->slices_x[targ])[i] ^= ((uint8_t*)ref->slices_z[ctrl])[i];
+    }
+    assert(0 == memcmp(tab->slices_x[targ], ref->slices_x[targ], tab->slice_len));
+
+    tableau_destroy(tab);
+    tableau_destroy(ref);
+    threadpool_destroy();
+}
+
+int main()
+{
+    // Pool is inert until initialised
+    size_t counter = 0;
+    threadpool_add_task(count_task, &counter);
+    threadpool_barrier();
+    assert(counter == 1);
+
+    for (size_t n_workers = 1; n_workers <= 8; n_workers++)
+    {
+        test_tasks(n_workers, 0);
+        test_tasks(n_workers, THREADPOOL_PIN_WORKERS);
+        test_batches(n_workers);
+    }
+
+    for (size_t n_qubits = 64; n_qubits <= 2048; n_qubits += 64)
+    {
+        test_distribute(1 + (n_qubits % 7), n_qubits);
+    }
+
+    // Restarting a live pool replaces it
+    threadpool_init(2, 0);
+    threadpool_init(3, 0);
+    assert(threadpool_n_workers() == 3);
+    threadpool_destroy();
+
+    return 0;
+}
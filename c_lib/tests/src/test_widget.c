@@ -1,11 +1,14 @@
 #include <assert.h>
 #include <stdlib.h>
+#include <string.h>
 
 #define INSTRUCTIONS_TABLE
 
 #include "widget.h"
 #include "input_stream.h"
 #include "instructions.h"
+#include "threadpool.h"
+#include "widget_binary.h"
 
 #define N_TEST_ITERATIONS (10)
 void test_widget_create()
@@ -51,10 +54,447 @@ void test_initial_cliffords()
 }
 
 
+/*
+ * test_widget_grow
+ * Runs the same random stream on a widget sized for it and on one that must grow
+ * :: n_qubits : const size_t :: Initial qubits, also the capacity of the growing widget
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: engine : const uint8_t :: Engine for both widgets
+ */
+void test_widget_grow(const size_t n_qubits, const size_t n_instructions, const uint8_t engine)
+{
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(n_instructions * sizeof(instruction_stream_u));
+    size_t n_rz = 0;
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        switch (rand() % 3)
+        {
+            case 0:
+                inst[i].single.opcode = _H_;
+                inst[i].single.arg = rand() % n_qubits;
+                break;
+            case 1:
+                inst[i].multi.opcode = (rand() % 2) ? _CNOT_ : _CZ_;
+                inst[i].multi.ctrl = rand() % n_qubits;
+                inst[i].multi.targ = (inst[i].multi.ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+                break;
+            default:
+                inst[i].rz.opcode = _RZ_;
+                inst[i].rz.arg = rand() % n_qubits;
+                inst[i].rz.tag = rand();
+                n_rz++;
+        }
+    }
+
+    widget_t* sized = widget_create_engine(n_qubits, 2 * n_qubits + n_rz, engine);
+    widget_t* grown = widget_create_engine(n_qubits, n_qubits, engine);
+
+    teleport_input(sized, n_qubits);
+    teleport_input(grown, n_qubits);
+    parse_instruction_block(sized, inst, n_instructions);
+    parse_instruction_block(grown, inst, n_instructions);
+
+    assert(grown->max_qubits >= grown->n_qubits);
+    assert(grown->max_qubits > n_qubits);
+    assert(sized->n_qubits == grown->n_qubits);
+    assert(0 == memcmp(sized->q_map, grown->q_map, n_qubits * sizeof(size_t)));
+    assert(0 == memcmp(sized->queue->table, grown->queue->table, sized->n_qubits));
+    assert(0 == memcmp(sized->queue->non_cliffords, grown->queue->non_cliffords, sized->n_qubits * sizeof(non_clifford_tag_t)));
+
+    if (WIDGET_ENGINE_GRAPH == engine)
+    {
+        assert(0 == memcmp(sized->graph->vops, grown->graph->vops, sized->n_qubits));
+        for (size_t i = 0; i < sized->n_qubits; i++)
+        {
+            assert(sized->graph->degree[i] == grown->graph->degree[i]);
+            assert(0 == memcmp(sized->graph->neighbours[i], grown->graph->neighbours[i], sized->graph->degree[i] * sizeof(uint32_t)));
+        }
+    }
+    else
+    {
+        const size_t active_len = sized->tableau->active_len;
+        assert(active_len == grown->tableau->active_len);
+        for (size_t i = 0; i < sized->n_qubits; i++)
+        {
+            assert(0 == memcmp(sized->tableau->slices_x[i], grown->tableau->slices_x[i], active_len));
+            assert(0 == memcmp(sized->tableau->slices_z[i], grown->tableau->slices_z[i], active_len));
+        }
+        assert(0 == memcmp(sized->tableau->phases, grown->tableau->phases, active_len));
+    }
+
+    widget_destroy(sized);
+    widget_destroy(grown);
+    free(inst);
+}
+
+
+/*
+ * assert_fresh
+ * Checks a widget against one straight from widget_create_engine
+ * :: wid : widget_t* :: Widget that was reset
+ * :: n_qubits : const size_t :: Initial qubits it was reset to
+ */
+void assert_fresh(widget_t* wid, const size_t n_qubits)
+{
+    widget_t* fresh = widget_create_engine(n_qubits, wid->max_qubits, wid->engine_stats.requested_engine);
+
+    assert(fresh->engine == wid->engine);
+    assert(fresh->n_qubits == wid->n_qubits);
+    assert(fresh->n_initial_qubits == wid->n_initial_qubits);
+    assert(0 == memcmp(fresh->q_map, wid->q_map, n_qubits * sizeof(size_t)));
+    assert(0 == memcmp(fresh->queue->table, wid->queue->table, fresh->queue->n_qubits));
+    assert(0 == memcmp(fresh->queue->non_cliffords, wid->queue->non_cliffords, fresh->queue->n_qubits * sizeof(non_clifford_tag_t)));
+    assert(0 == wid->engine_stats.n_gates);
+
+    if (WIDGET_ENGINE_GRAPH == wid->engine)
+    {
+        assert(0 == memcmp(fresh->graph->vops, wid->graph->vops, fresh->graph->n_qubits));
+        assert(0 == memcmp(fresh->graph->degree, wid->graph->degree, fresh->graph->n_qubits * sizeof(uint32_t)));
+        assert(0 == wid->graph->n_edges);
+    }
+    else
+    {
+        assert(fresh->tableau->active_len == wid->tableau->active_len);
+        assert(fresh->tableau->orientation == wid->tableau->orientation);
+        for (size_t i = 0; i < fresh->tableau->n_qubits; i++)
+        {
+            assert(0 == memcmp(fresh->tableau->slices_x[i], wid->tableau->slices_x[i], fresh->tableau->slice_len));
+            assert(0 == memcmp(fresh->tableau->slices_z[i], wid->tableau->slices_z[i], fresh->tableau->slice_len));
+        }
+        assert(0 == memcmp(fresh->tableau->phases, wid->tableau->phases, fresh->tableau->slice_len));
+    }
+    widget_destroy(fresh);
+}
+
+
+/*
+ * test_widget_reset
+ * Dirties a widget with a random stream, optionally decomposes it, then resets it
+ * :: n_qubits : const size_t :: Initial qubits
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: engine : const uint8_t :: Engine to use
+ */
+void test_widget_reset(const size_t n_qubits, const size_t n_instructions, const uint8_t engine)
+{
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(n_instructions * sizeof(instruction_stream_u));
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        switch (rand() % 3)
+        {
+            case 0:
+                inst[i].single.opcode = (rand() % 2) ? _H_ : _S_;
+                inst[i].single.arg = rand() % n_qubits;
+                break;
+            case 1:
+                inst[i].multi.opcode = (rand() % 2) ? _CNOT_ : _CZ_;
+                inst[i].multi.ctrl = rand() % n_qubits;
+                inst[i].multi.targ = (inst[i].multi.ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+                break;
+            default:
+                inst[i].rz.opcode = _RZ_;
+                inst[i].rz.arg = rand() % n_qubits;
+                inst[i].rz.tag = rand();
+        }
+    }
+
+    widget_t* wid = widget_create_engine(n_qubits, 2 * n_qubits, engine);
+    for (size_t round = 0; round < 3; round++)
+    {
+        teleport_input(wid, n_qubits);
+        parse_instruction_block(wid, inst, n_instructions);
+        if (round % 2)
+        {
+            widget_decompose(wid);
+        }
+        widget_reset(wid, n_qubits);
+        assert_fresh(wid, n_qubits);
+    }
+
+    widget_destroy(wid);
+    free(inst);
+}
+
+
+/*
+ * random_decomposed_widget
+ * Decomposed widget over a random stream of gates
+ * :: n_qubits : const size_t :: Width of the register
+ * :: n_instructions : const size_t :: Length of the random stream
+ * :: engine : const uint8_t :: Simulation engine
+ */
+widget_t* random_decomposed_widget(const size_t n_qubits, const size_t n_instructions, const uint8_t engine)
+{
+    widget_t* wid = widget_create_engine(n_qubits, 3 * n_qubits + n_instructions, engine);
+    teleport_input(wid, n_qubits);
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        instruction_stream_u inst;
+        switch (rand() % 3)
+        {
+            case 0:
+                inst.single.opcode = (rand() % 2) ? _H_ : _S_;
+                inst.single.arg = rand() % n_qubits;
+                break;
+            case 1:
+                inst.multi.opcode = (rand() % 2) ? _CNOT_ : _CZ_;
+                inst.multi.ctrl = rand() % n_qubits;
+                inst.multi.targ = (inst.multi.ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+                break;
+            default:
+                inst.rz.opcode = _RZ_;
+                inst.rz.arg = rand() % n_qubits;
+                inst.rz.tag = rand();
+        }
+        parse_instruction_block(wid, &inst, 1);
+    }
+    widget_decompose(wid);
+    return wid;
+}
+
+/*
+ * test_widget_graph_csr
+ * The graph export matches the per qubit adjacencies, and the upper triangle holds every edge once
+ * :: n_qubits : const size_t :: Width of the register, widths past 64 span several words per row
+ * :: n_instructions : const size_t :: Length of the random stream
+ * :: engine : const uint8_t :: Simulation engine
+ */
+void test_widget_graph_csr(const size_t n_qubits, const size_t n_instructions, const uint8_t engine)
+{
+    widget_t* wid = random_decomposed_widget(n_qubits, n_instructions, engine);
+
+    size_t* offsets = (size_t*)malloc((wid->n_qubits + 1) * sizeof(size_t));
+    const size_t n_entries = widget_get_graph_csr(wid, offsets, NULL, false);
+    uint32_t* neighbours = (uint32_t*)malloc((n_entries + 1) * sizeof(uint32_t));
+    assert(n_entries == widget_get_graph_csr(wid, offsets, neighbours, false));
+
+    size_t* upper_offsets = (size_t*)malloc((wid->n_qubits + 1) * sizeof(size_t));
+    const size_t n_edges = widget_get_graph_csr(wid, upper_offsets, NULL, true);
+    uint32_t* upper = (uint32_t*)malloc((n_edges + 1) * sizeof(uint32_t));
+    assert(n_edges == widget_get_graph_csr(wid, upper_offsets, upper, true));
+
+    size_t n_above = 0;
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        struct adjacency_obj adj = widget_get_adjacencies(wid, i);
+        assert(offsets[i + 1] - offsets[i] == adj.n_adjacent);
+        if (adj.n_adjacent > 0)
+        {
+            assert(0 == memcmp(neighbours + offsets[i], adj.adjacencies, adj.n_adjacent * sizeof(uint32_t)));
+        }
+
+        // The upper triangle is the tail of the full row
+        const size_t n_upper = upper_offsets[i + 1] - upper_offsets[i];
+        for (size_t j = 0; j < n_upper; j++)
+        {
+            assert(upper[upper_offsets[i] + j] == neighbours[offsets[i + 1] - n_upper + j]);
+            assert(upper[upper_offsets[i] + j] > i);
+        }
+        for (size_t j = offsets[i]; j < offsets[i + 1]; j++)
+        {
+            assert(neighbours[j] < wid->n_qubits);
+            assert(neighbours[j] != i);
+            n_above += (neighbours[j] > i);
+        }
+        free(adj.adjacencies);
+    }
+    assert(n_above == n_edges);
+    assert(2 * n_edges == n_entries);
+
+    free(offsets);
+    free(neighbours);
+    free(upper_offsets);
+    free(upper);
+    widget_destroy(wid);
+}
+
+/*
+ * graph_csr_task
+ * Exports a graph from inside a pool job, the export waits on its own blocks only
+ * :: args : void* :: size_t* width of the register
+ */
+void graph_csr_task(void* args)
+{
+    const size_t n_qubits = *(size_t*)args;
+    test_widget_graph_csr(n_qubits, 2 * n_qubits, WIDGET_ENGINE_TABLEAU);
+}
+
+/*
+ * test_widget_finalise
+ * A finalised widget drops its simulation state and reports the same graph and qubits
+ * :: n_qubits : const size_t :: Width of the register
+ * :: n_instructions : const size_t :: Length of the random stream
+ * :: engine : const uint8_t :: Simulation engine
+ */
+void test_widget_finalise(const size_t n_qubits, const size_t n_instructions, const uint8_t engine)
+{
+    widget_t* wid = random_decomposed_widget(n_qubits, n_instructions, engine);
+
+    size_t* offsets = (size_t*)malloc((wid->n_qubits + 1) * sizeof(size_t));
+    const size_t n_entries = widget_get_graph_csr(wid, offsets, NULL, false);
+    uint32_t* neighbours = (uint32_t*)malloc((n_entries + 1) * sizeof(uint32_t));
+    widget_get_graph_csr(wid, offsets, neighbours, false);
+    instruction_t* cliffords = (instruction_t*)malloc(wid->n_qubits);
+    memcpy(cliffords, wid->queue->table, wid->n_qubits);
+
+    widget_finalise(wid);
+    widget_finalise(wid);
+    assert(NULL == wid->tableau);
+    assert(NULL == wid->graph);
+    assert(NULL != wid->csr);
+    assert(0 == memcmp(cliffords, wid->queue->table, wid->n_qubits));
+
+    size_t* read_offsets = (size_t*)malloc((wid->n_qubits + 1) * sizeof(size_t));
+    assert(n_entries == widget_get_graph_csr(wid, read_offsets, NULL, false));
+    uint32_t* read_neighbours = (uint32_t*)malloc((n_entries + 1) * sizeof(uint32_t));
+    widget_get_graph_csr(wid, read_offsets, read_neighbours, false);
+    assert(0 == memcmp(offsets, read_offsets, (wid->n_qubits + 1) * sizeof(size_t)));
+    assert(0 == memcmp(neighbours, read_neighbours, n_entries * sizeof(uint32_t)));
+
+    // Each edge once from the compact form too
+    assert(2 * widget_get_graph_csr(wid, read_offsets, NULL, true) == n_entries);
+    for (size_t i = 0; i < wid->n_qubits; i++)
+    {
+        struct adjacency_obj adj = widget_get_adjacencies(wid, i);
+        assert(adj.n_adjacent == offsets[i + 1] - offsets[i]);
+        assert(0 == adj.n_adjacent || 0 == memcmp(adj.adjacencies, neighbours + offsets[i], adj.n_adjacent * sizeof(uint32_t)));
+        free(adj.adjacencies);
+    }
+
+    // Reset brings the simulation state back for reuse
+    widget_reset(wid, n_qubits);
+    assert(NULL == wid->csr);
+    assert_fresh(wid, n_qubits);
+
+    free(offsets);
+    free(neighbours);
+    free(read_offsets);
+    free(read_neighbours);
+    free(cliffords);
+    widget_destroy(wid);
+
+    // Destroying a finalised widget frees the compact graph
+    wid = random_decomposed_widget(n_qubits, n_instructions, engine);
+    widget_finalise(wid);
+    widget_destroy(wid);
+}
+
+/*
+ * test_widget_stats
+ * Stats count every parsed gate and each pivot of the elimination, and are cleared by widget_reset
+ * Without WIDGET_STATS they stay zeroed
+ * :: n_qubits : const size_t :: Width of the register
+ * :: n_instructions : const size_t :: Length of the random stream
+ */
+void test_widget_stats(const size_t n_qubits, const size_t n_instructions)
+{
+    size_t n_gates[N_INSTRUCTION_TYPES] = {0};
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(n_instructions * sizeof(instruction_stream_u));
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        switch (rand() % 3)
+        {
+            case 0:
+                inst[i].single.opcode = (rand() % 2) ? _H_ : _S_;
+                inst[i].single.arg = rand() % n_qubits;
+                break;
+            case 1:
+                inst[i].multi.opcode = (rand() % 2) ? _CNOT_ : _CZ_;
+                inst[i].multi.ctrl = rand() % n_qubits;
+                inst[i].multi.targ = (inst[i].multi.ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+                break;
+            default:
+                inst[i].rz.opcode = _RZ_;
+                inst[i].rz.arg = rand() % n_qubits;
+                inst[i].rz.tag = rand();
+        }
+        n_gates[INSTRUCTION_TYPE(inst[i].instruction)]++;
+    }
+
+    widget_t* wid = widget_create(n_qubits, 2 * n_qubits + n_instructions);
+    teleport_input(wid, n_qubits);
+    parse_instruction_block(wid, inst, n_instructions);
+    widget_decompose(wid);
+    widget_binary_schedule_destroy(widget_binary_schedule_create(wid));
+
+    struct widget_stats_t stats = widget_get_stats(wid);
+    struct widget_stats_t zero = {0};
+    assert(WIDGET_STATS_ENABLED == stats.enabled);
+    if (stats.enabled)
+    {
+        for (size_t i = 0; i < N_INSTRUCTION_TYPES; i++)
+        {
+            assert(n_gates[i] == stats.n_gates[i]);
+        }
+        assert(stats.elim_ns > 0);
+        assert(stats.n_local_elim + stats.n_local_search + stats.n_non_local_search + stats.n_hadamard + stats.n_z_search <= wid->n_qubits);
+    }
+    else
+    {
+        assert(0 == memcmp(&zero, &stats, sizeof(struct widget_stats_t)));
+    }
+
+    widget_reset(wid, n_qubits);
+    stats = widget_get_stats(wid);
+    zero.enabled = WIDGET_STATS_ENABLED;
+    assert(0 == memcmp(&zero, &stats, sizeof(struct widget_stats_t)));
+
+    widget_destroy(wid);
+    free(inst);
+}
+
+
 int main()
 {
     test_widget_create();
     test_initial_map();
     test_initial_cliffords();
+
+    for (size_t i = 0; i < N_TEST_ITERATIONS; i++)
+    {
+        test_widget_grow(2 + rand() % 100, 1 + rand() % 2000, WIDGET_ENGINE_TABLEAU);
+        test_widget_grow(2 + rand() % 100, 1 + rand() % 2000, WIDGET_ENGINE_GRAPH);
+    }
+
+    for (size_t i = 0; i < N_TEST_ITERATIONS; i++)
+    {
+        test_widget_reset(2 + rand() % 200, rand() % 2000, WIDGET_ENGINE_TABLEAU);
+        test_widget_reset(2 + rand() % 200, rand() % 2000, WIDGET_ENGINE_GRAPH);
+        test_widget_reset(2 + rand() % 200, rand() % 2000, WIDGET_ENGINE_AUTO);
+    }
+
+    for (size_t i = 0; i < N_TEST_ITERATIONS; i++)
+    {
+        test_widget_graph_csr(2 + rand() % 200, rand() % 2000, WIDGET_ENGINE_TABLEAU);
+        test_widget_graph_csr(2 + rand() % 200, rand() % 2000, WIDGET_ENGINE_GRAPH);
+    }
+
+    for (size_t i = 0; i < N_TEST_ITERATIONS; i++)
+    {
+        test_widget_finalise(2 + rand() % 200, rand() % 2000, WIDGET_ENGINE_TABLEAU);
+        test_widget_finalise(2 + rand() % 200, rand() % 2000, WIDGET_ENGINE_GRAPH);
+        test_widget_finalise(2 + rand() % 200, rand() % 2000, WIDGET_ENGINE_AUTO);
+    }
+
+    for (size_t i = 0; i < N_TEST_ITERATIONS; i++)
+    {
+        test_widget_stats(2 + rand() % 200, rand() % 2000);
+    }
+
+    threadpool_init(4, 0);
+    for (size_t i = 0; i < N_TEST_ITERATIONS; i++)
+    {
+        test_widget_graph_csr(300 + rand() % 1000, rand() % 4000, WIDGET_ENGINE_TABLEAU);
+        test_widget_graph_csr(300 + rand() % 1000, rand() % 4000, WIDGET_ENGINE_GRAPH);
+        test_widget_stats(300 + rand() % 1000, rand() % 4000);
+    }
+
+    size_t widths[8];
+    for (size_t i = 0; i < 8; i++)
+    {
+        widths[i] = 300 + rand() % 1000;
+        threadpool_add_task(graph_csr_task, widths + i);
+    }
+    threadpool_barrier();
+    threadpool_destroy();
     return 0;
 }
@@ -0,0 +1,464 @@
+#include <assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget.h"
+#include "widget_binary.h"
+#include "input_stream.h"
+#include "instructions.h"
+
+#define N_TEST_WIDGETS (8)
+
+/*
+ * random_widget
+ * Decomposed widget over a random stream
+ * :: n_qubits : const size_t :: Width of the register
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: engine : const uint8_t :: Simulation engine
+ */
+widget_t* random_widget(const size_t n_qubits, const size_t n_instructions, const uint8_t engine)
+{
+    widget_t* wid = widget_create_engine(n_qubits, 3 * n_qubits + n_instructions, engine);
+    teleport_input(wid, n_qubits);
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        instruction_stream_u inst;
+        switch (rand() % 3)
+        {
+            case 0:
+                inst.single.opcode = (rand() % 2) ? _H_ : _S_;
+                inst.single.arg = rand() % n_qubits;
+                break;
+            case 1:
+                inst.multi.opcode = (rand() % 2) ? _CNOT_ : _CZ_;
+                inst.multi.ctrl = rand() % n_qubits;
+                inst.multi.targ = (inst.multi.ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+                break;
+            default:
+                inst.rz.opcode = _RZ_;
+                inst.rz.arg = rand() % n_qubits;
+                inst.rz.tag = rand();
+        }
+        parse_instruction_block(wid, &inst, 1);
+    }
+    widget_decompose(wid);
+    return wid;
+}
+
+/*
+ * random_schedule
+ * Schedule and corrections with random contents
+ * :: n_qubits : const size_t :: Qubits to draw from
+ */
+widget_binary_schedule_t random_schedule(const size_t n_qubits)
+{
+    widget_binary_schedule_t sched;
+    sched.n_layers = rand() % 8;
+    sched.layer_offsets = (size_t*)malloc((sched.n_layers + 1) * sizeof(size_t));
+    sched.layer_offsets[0] = 0;
+    for (size_t i = 0; i < sched.n_layers; i++)
+    {
+        sched.layer_offsets[i + 1] = sched.layer_offsets[i] + rand() % 5;
+    }
+    sched.n_nodes = sched.layer_offsets[sched.n_layers];
+    sched.nodes = (uint32_t*)malloc((sched.n_nodes + 1) * sizeof(uint32_t));
+    sched.dep_offsets = (size_t*)malloc((sched.n_nodes + 1) * sizeof(size_t));
+    sched.dep_offsets[0] = 0;
+    for (size_t i = 0; i < sched.n_nodes; i++)
+    {
+        sched.nodes[i] = rand() % n_qubits;
+        sched.dep_offsets[i + 1] = sched.dep_offsets[i] + rand() % 4;
+    }
+    sched.n_deps = sched.dep_offsets[sched.n_nodes];
+    sched.deps = (uint32_t*)malloc((sched.n_deps + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < sched.n_deps; i++)
+    {
+        sched.deps[i] = rand() % n_qubits;
+    }
+
+    sched.n_corrections = rand() % 6;
+    sched.correction_width = rand() % 70;
+    sched.correction_qubits = (uint32_t*)malloc((sched.n_corrections + 1) * sizeof(uint32_t));
+    sched.paulis = (uint8_t*)malloc(sched.n_corrections * sched.correction_width + 1);
+    for (size_t i = 0; i < sched.n_corrections; i++)
+    {
+        sched.correction_qubits[i] = rand() % n_qubits;
+    }
+    for (size_t i = 0; i < sched.n_corrections * sched.correction_width; i++)
+    {
+        sched.paulis[i] = rand() % 4;
+    }
+    return sched;
+}
+
+void schedule_free(widget_binary_schedule_t* sched)
+{
+    free(sched->layer_offsets);
+    free(sched->nodes);
+    free(sched->dep_offsets);
+    free(sched->deps);
+    free(sched->correction_qubits);
+    free(sched->paulis);
+}
+
+/*
+ * test_widget_binary_graph
+ * Both forms of the stored graph match the widget
+ */
+void test_widget_binary_graph(const widget_binary_reader_t* reader, const size_t idx, const widget_t* wid)
+{
+    widget_binary_info_t info;
+    widget_binary_read_info(reader, idx, &info);
+
+    for (size_t upper = 0; upper < 2; upper++)
+    {
+        size_t* offsets = (size_t*)malloc((wid->n_qubits + 1) * sizeof(size_t));
+        const size_t n_entries = widget_get_graph_csr(wid, offsets, NULL, upper);
+        uint32_t* neighbours = (uint32_t*)malloc((n_entries + 1) * sizeof(uint32_t));
+        widget_get_graph_csr(wid, offsets, neighbours, upper);
+        assert(n_entries == (upper ? 1 : 2) * info.n_edges);
+
+        size_t* read_offsets = (size_t*)malloc((info.n_qubits + 1) * sizeof(size_t));
+        uint32_t* read_neighbours = (uint32_t*)malloc((n_entries + 1) * sizeof(uint32_t));
+        widget_binary_read_graph(reader, idx, read_offsets, read_neighbours, upper);
+        assert(0 == memcmp(offsets, read_offsets, (wid->n_qubits + 1) * sizeof(size_t)));
+        assert(0 == memcmp(neighbours, read_neighbours, n_entries * sizeof(uint32_t)));
+
+        free(offsets);
+        free(neighbours);
+        free(read_offsets);
+        free(read_neighbours);
+    }
+}
+
+/*
+ * test_widget_binary_round_trip
+ * Streams widgets to a file and reads every section back through the mapped reader
+ * :: engine : const uint8_t :: Simulation engine
+ */
+void test_widget_binary_round_trip(const uint8_t engine)
+{
+    char path[] = "/tmp/test_widget_binary_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+
+    widget_t* widgets[N_TEST_WIDGETS];
+    widget_binary_schedule_t schedules[N_TEST_WIDGETS];
+    widget_binary_writer_t* writer = widget_binary_writer_open(fd);
+    for (size_t i = 0; i < N_TEST_WIDGETS; i++)
+    {
+        widgets[i] = random_widget(2 + rand() % 150, rand() % 1500, engine);
+        schedules[i] = random_schedule(widgets[i]->n_qubits);
+        // The first widget carries no schedule at all
+        assert(widget_binary_write(writer, widgets[i], (0 == i) ? NULL : schedules + i) > 0);
+    }
+    assert(N_TEST_WIDGETS == writer->n_widgets);
+    assert((off_t)writer->n_bytes == lseek(fd, 0, SEEK_CUR));
+    widget_binary_writer_close(writer);
+    close(fd);
+
+    widget_binary_reader_t* reader = widget_binary_reader_open(path);
+    assert(NULL != reader);
+    assert(N_TEST_WIDGETS == widget_binary_n_widgets(reader));
+
+    for (size_t i = 0; i < N_TEST_WIDGETS; i++)
+    {
+        const widget_t* wid = widgets[i];
+        widget_binary_info_t info;
+        widget_binary_read_info(reader, i, &info);
+        assert(info.n_qubits == wid->n_qubits);
+        assert(info.n_initial_qubits == wid->n_initial_qubits);
+
+        test_widget_binary_graph(reader, i, wid);
+
+        instruction_t* cliffords = (instruction_t*)malloc(info.n_qubits + 1);
+        non_clifford_tag_t* tags = (non_clifford_tag_t*)malloc((info.n_qubits + 1) * sizeof(non_clifford_tag_t));
+        size_t* io_map = (size_t*)malloc(info.n_initial_qubits * sizeof(size_t));
+        widget_binary_read_qubits(reader, i, cliffords, tags, io_map);
+        assert(0 == memcmp(cliffords, wid->queue->table, info.n_qubits));
+        assert(0 == memcmp(tags, wid->queue->non_cliffords, info.n_qubits * sizeof(non_clifford_tag_t)));
+        assert(0 == memcmp(io_map, wid->q_map, info.n_initial_qubits * sizeof(size_t)));
+        free(cliffords);
+        free(tags);
+        free(io_map);
+
+        const widget_binary_schedule_t* sched = schedules + i;
+        if (0 == i)
+        {
+            assert(0 == info.n_layers && 0 == info.n_corrections);
+        }
+        else
+        {
+            assert(info.n_layers == sched->n_layers);
+            assert(info.n_nodes == sched->n_nodes);
+            assert(info.n_deps == sched->n_deps);
+            assert(info.n_corrections == sched->n_corrections);
+            assert(info.correction_width == sched->correction_width);
+
+            widget_binary_schedule_t read;
+            read.layer_offsets = (size_t*)malloc((info.n_layers + 1) * sizeof(size_t));
+            read.nodes = (uint32_t*)malloc((info.n_nodes + 1) * sizeof(uint32_t));
+            read.dep_offsets = (size_t*)malloc((info.n_nodes + 1) * sizeof(size_t));
+            read.deps = (uint32_t*)malloc((info.n_deps + 1) * sizeof(uint32_t));
+            read.correction_qubits = (uint32_t*)malloc((info.n_corrections + 1) * sizeof(uint32_t));
+            read.paulis = (uint8_t*)malloc(info.n_corrections * info.correction_width + 1);
+            widget_binary_read_schedule(reader, i, &read);
+
+            assert(0 == memcmp(read.layer_offsets, sched->layer_offsets, (info.n_layers + 1) * sizeof(size_t)));
+            assert(0 == memcmp(read.nodes, sched->nodes, info.n_nodes * sizeof(uint32_t)));
+            assert(0 == memcmp(read.dep_offsets, sched->dep_offsets, (info.n_nodes + 1) * sizeof(size_t)));
+            assert(0 == memcmp(read.deps, sched->deps, info.n_deps * sizeof(uint32_t)));
+            assert(0 == memcmp(read.correction_qubits, sched->correction_qubits, info.n_corrections * sizeof(uint32_t)));
+            assert(0 == memcmp(read.paulis, sched->paulis, info.n_corrections * info.correction_width));
+            schedule_free(&read);
+        }
+    }
+
+    widget_binary_reader_close(reader);
+
+    // A truncated record is rejected rather than read past the end of the map
+    struct stat st;
+    assert(0 == stat(path, &st));
+    assert(0 == truncate(path, st.st_size - 1));
+    assert(NULL == widget_binary_reader_open(path));
+    unlink(path);
+
+    for (size_t i = 0; i < N_TEST_WIDGETS; i++)
+    {
+        widget_destroy(widgets[i]);
+        schedule_free(schedules + i);
+    }
+}
+
+/*
+ * test_widget_binary_schedule_create
+ * Schedules built from the Pauli tracker are well formed and limited to the widget's qubits
+ * :: n_qubits : const size_t :: Width of the register
+ * :: n_instructions : const size_t :: Length of the stream
+ */
+void test_widget_binary_schedule_create(const size_t n_qubits, const size_t n_instructions)
+{
+    widget_t* wid = random_widget(n_qubits, n_instructions, WIDGET_ENGINE_TABLEAU);
+    widget_binary_schedule_t* sched = widget_binary_schedule_create(wid);
+
+    assert(0 == sched->layer_offsets[0]);
+    assert(sched->n_nodes == sched->layer_offsets[sched->n_layers]);
+    assert(sched->n_deps == sched->dep_offsets[sched->n_nodes]);
+    for (size_t i = 0; i < sched->n_layers; i++)
+    {
+        assert(sched->layer_offsets[i] <= sched->layer_offsets[i + 1]);
+    }
+    for (size_t i = 0; i < sched->n_nodes; i++)
+    {
+        assert(sched->nodes[i] < wid->n_qubits);
+        assert(sched->dep_offsets[i] <= sched->dep_offsets[i + 1]);
+    }
+    assert(sched->correction_width <= wid->n_qubits);
+    for (size_t i = 0; i < sched->n_corrections * sched->correction_width; i++)
+    {
+        assert(sched->paulis[i] < 4);
+    }
+
+    // Written as is
+    char path[] = "/tmp/test_widget_binary_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    widget_binary_writer_t* writer = widget_binary_writer_open(fd);
+    assert(widget_binary_write(writer, wid, sched) > 0);
+    widget_binary_writer_close(writer);
+    close(fd);
+
+    widget_binary_reader_t* reader = widget_binary_reader_open(path);
+    assert(NULL != reader);
+    widget_binary_info_t info;
+    widget_binary_read_info(reader, 0, &info);
+    assert(info.n_layers == sched->n_layers);
+    assert(info.n_nodes == sched->n_nodes);
+    assert(info.n_corrections == sched->n_corrections);
+    widget_binary_reader_close(reader);
+    unlink(path);
+
+    widget_binary_schedule_destroy(sched);
+    widget_destroy(wid);
+}
+
+/*
+ * test_widget_binary_header
+ * Empty containers are valid, foreign files are not
+ */
+void test_widget_binary_header()
+{
+    char path[] = "/tmp/test_widget_binary_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    widget_binary_writer_close(widget_binary_writer_open(fd));
+
+    widget_binary_reader_t* reader = widget_binary_reader_open(path);
+    assert(NULL != reader);
+    assert(0 == widget_binary_n_widgets(reader));
+    widget_binary_reader_close(reader);
+
+    assert(0 == lseek(fd, 0, SEEK_SET));
+    assert(4 == write(fd, "JSON", 4));
+    close(fd);
+    assert(NULL == widget_binary_reader_open(path));
+    unlink(path);
+
+    assert(NULL == widget_binary_reader_open("/tmp/test_widget_binary_missing"));
+}
+
+/*
+ * write_raw_record
+ * Writes a container holding one record with the given body
+ * :: path : const char* :: Output path
+ * :: body : const uint8_t* :: Record body
+ * :: body_len : const size_t :: Length of the body
+ */
+void write_raw_record(const char* path, const uint8_t* body, const size_t body_len)
+{
+    const int fd = open(path, O_WRONLY | O_TRUNC);
+    assert(fd >= 0);
+    widget_binary_writer_close(widget_binary_writer_open(fd));
+    const uint64_t len = body_len;
+    assert(sizeof(uint64_t) == write(fd, &len, sizeof(uint64_t)));
+    assert((ssize_t)body_len == write(fd, body, body_len));
+    close(fd);
+}
+
+/*
+ * raw_record_valid
+ * Whether a reader accepts a container holding one record with the given body
+ */
+bool raw_record_valid(const char* path, const uint8_t* body, const size_t body_len)
+{
+    write_raw_record(path, body, body_len);
+    widget_binary_reader_t* reader = widget_binary_reader_open(path);
+    if (NULL == reader)
+    {
+        return false;
+    }
+    widget_binary_reader_close(reader);
+    return true;
+}
+
+/*
+ * test_widget_binary_corrupt
+ * Records are checked when the reader opens, so decoding never leaves a record
+ */
+void test_widget_binary_corrupt()
+{
+    char path[] = "/tmp/test_widget_binary_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    close(fd);
+
+    // Two qubits joined by an edge: counts, section lengths, then graph, cliffords and tags
+    const uint8_t valid[] = {
+        2, 0, 1, 0, 0, 0, 0, 0,
+        3, 2, 2, 0, 0, 0,
+        1, 0, 0,
+        0, 0,
+        0, 0};
+    assert(raw_record_valid(path, valid, sizeof(valid)));
+
+    widget_binary_reader_t* reader = widget_binary_reader_open(path);
+    size_t offsets[3];
+    uint32_t neighbours[2];
+    widget_binary_read_graph(reader, 0, offsets, neighbours, false);
+    assert(1 == offsets[1] && 2 == offsets[2]);
+    assert(1 == neighbours[0] && 0 == neighbours[1]);
+    widget_binary_reader_close(reader);
+
+    uint8_t body[sizeof(valid) + 1];
+
+    // Stray bytes after the last record, too few to hold a length
+    write_raw_record(path, valid, sizeof(valid));
+    const int append = open(path, O_WRONLY | O_APPEND);
+    assert(append >= 0);
+    assert(3 == write(append, "\0\0\0", 3));
+    close(append);
+    assert(NULL == widget_binary_reader_open(path));
+
+    // Sections must fill the body exactly
+    memcpy(body, valid, sizeof(valid));
+    body[sizeof(valid)] = 0;
+    assert(!raw_record_valid(path, body, sizeof(valid) + 1));
+    assert(!raw_record_valid(path, valid, sizeof(valid) - 1));
+
+    // A section longer than the record
+    memcpy(body, valid, sizeof(valid));
+    body[8] = 0x7f;
+    assert(!raw_record_valid(path, body, sizeof(valid)));
+
+    // Neighbour past the last qubit
+    memcpy(body, valid, sizeof(valid));
+    body[15] = 1;
+    assert(!raw_record_valid(path, body, sizeof(valid)));
+
+    // Edge count disagreeing with the graph
+    memcpy(body, valid, sizeof(valid));
+    body[2] = 2;
+    assert(!raw_record_valid(path, body, sizeof(valid)));
+
+    // More qubits than rows in the graph section
+    memcpy(body, valid, sizeof(valid));
+    body[0] = 3;
+    assert(!raw_record_valid(path, body, sizeof(valid)));
+
+    // Varints that never terminate or overflow 64 bits
+    uint8_t unterminated[32];
+    memset(unterminated, 0x80, sizeof(unterminated));
+    assert(!raw_record_valid(path, unterminated, sizeof(unterminated)));
+    uint8_t overflow[32] = {0};
+    memset(overflow, 0xff, 9);
+    overflow[9] = 0x02;
+    assert(!raw_record_valid(path, overflow, sizeof(overflow)));
+
+    unlink(path);
+}
+
+/*
+ * test_widget_binary_write_failure
+ * Writes to a descriptor that refuses them are reported rather than asserted
+ */
+void test_widget_binary_write_failure()
+{
+    char path[] = "/tmp/test_widget_binary_XXXXXX";
+    const int fd = mkstemp(path);
+    assert(fd >= 0);
+    const int read_only = open(path, O_RDONLY);
+    assert(read_only >= 0);
+    assert(NULL == widget_binary_writer_open(read_only));
+
+    widget_t* wid = random_widget(8, 64, WIDGET_ENGINE_TABLEAU);
+    widget_binary_writer_t* writer = widget_binary_writer_open(fd);
+    assert(NULL != writer);
+    assert(fd == dup2(read_only, fd));
+    assert(0 == widget_binary_write(writer, wid, NULL));
+    assert(0 == writer->n_widgets);
+    widget_binary_writer_close(writer);
+    widget_destroy(wid);
+
+    close(read_only);
+    close(fd);
+    unlink(path);
+}
+
+int main()
+{
+    test_widget_binary_header();
+    test_widget_binary_corrupt();
+    test_widget_binary_write_failure();
+    test_widget_binary_round_trip(WIDGET_ENGINE_TABLEAU);
+    test_widget_binary_round_trip(WIDGET_ENGINE_GRAPH);
+    for (size_t i = 0; i < N_TEST_WIDGETS; i++)
+    {
+        test_widget_binary_schedule_create(2 + rand() % 100, rand() % 1000);
+    }
+    return 0;
+}
@@ -0,0 +1,195 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INSTRUCTIONS_TABLE
+
+#include "widget_sequence.h"
+#include "widget_pipeline.h"
+#include "threadpool.h"
+
+/*
+ * random_stream
+ * Random stream of local, non-local and rz gates over a register
+ * :: n_qubits : const size_t :: Width of the register
+ * :: n_instructions : const size_t :: Length of the stream
+ */
+instruction_stream_u* random_stream(const size_t n_qubits, const size_t n_instructions)
+{
+    instruction_stream_u* inst = (instruction_stream_u*)malloc(n_instructions * sizeof(instruction_stream_u));
+    for (size_t i = 0; i < n_instructions; i++)
+    {
+        switch (rand() % 3)
+        {
+            case 0:
+                inst[i].single.opcode = (rand() % 2) ? _H_ : _S_;
+                inst[i].single.arg = rand() % n_qubits;
+                break;
+            case 1:
+                inst[i].multi.opcode = (rand() % 2) ? _CNOT_ : _CZ_;
+                inst[i].multi.ctrl = rand() % n_qubits;
+                inst[i].multi.targ = (inst[i].multi.ctrl + 1 + rand() % (n_qubits - 1)) % n_qubits;
+                break;
+            default:
+                inst[i].rz.opcode = _RZ_;
+                inst[i].rz.arg = rand() % n_qubits;
+                inst[i].rz.tag = rand();
+        }
+    }
+    return inst;
+}
+
+void test_widget_sequence(const size_t n_qubits, const size_t max_qubits, const size_t n_instructions, const bool reuse)
+{
+    instruction_stream_u* inst = random_stream(n_qubits, n_instructions);
+    widget_sequence_t* seq = widget_sequence_create(inst, n_instructions, n_qubits, max_qubits, true);
+
+    size_t start = 0;
+    widget_t* wid = NULL;
+    widget_t* reused = NULL;
+    while (NULL != (wid = widget_sequence_next(seq, reused)))
+    {
+        const size_t stop = seq->position;
+        assert(stop > start || 0 == n_instructions);
+
+        // Every widget but the last spends its whole budget
+        size_t n_rz = 0;
+        for (size_t i = start; i < stop; i++)
+        {
+            n_rz += (INSTRUCTION_TYPE(RZ_MASK) == INSTRUCTION_TYPE(inst[i].instruction));
+        }
+        assert(n_rz <= seq->rz_budget);
+        assert(n_rz == seq->rz_budget || stop == n_instructions);
+        assert(wid->n_qubits == 2 * n_qubits + n_rz);
+        assert(wid->max_qubits == max_qubits);
+
+        // Same widget as one built by hand from the chunk
+        widget_t* cmp = widget_create(n_qubits, max_qubits);
+        teleport_input(cmp, n_qubits);
+        parse_instruction_block(cmp, inst + start, stop - start);
+        widget_decompose(cmp);
+
+        assert(cmp->n_qubits == wid->n_qubits);
+        assert(0 == memcmp(cmp->q_map, wid->q_map, n_qubits * sizeof(size_t)));
+        assert(0 == memcmp(cmp->queue->table, wid->queue->table, wid->n_qubits));
+        assert(0 == memcmp(cmp->queue->non_cliffords, wid->queue->non_cliffords, wid->n_qubits * sizeof(non_clifford_tag_t)));
+
+        widget_destroy(cmp);
+        if (reuse)
+        {
+            reused = wid;
+        }
+        else
+        {
+            widget_destroy(wid);
+        }
+        start = stop;
+    }
+    if (NULL != reused)
+    {
+        widget_destroy(reused);
+    }
+    assert(n_instructions == start);
+    assert(seq->n_widgets > 0);
+
+    widget_sequence_destroy(seq);
+    free(inst);
+}
+
+/*
+ * test_widget_pipeline
+ * The pipeline emits the same widgets as the sequencer, in the same order
+ * :: n_qubits : const size_t :: Width of the register
+ * :: max_qubits : const size_t :: Capacity of each widget
+ * :: n_instructions : const size_t :: Length of the stream
+ * :: depth : const size_t :: Widgets in flight
+ */
+void test_widget_pipeline(const size_t n_qubits, const size_t max_qubits, const size_t n_instructions, const size_t depth)
+{
+    instruction_stream_u* inst = random_stream(n_qubits, n_instructions);
+
+    // Reference run, only one stage touches the threadpool at a time
+    widget_sequence_t* seq = widget_sequence_create(inst, n_instructions, n_qubits, max_qubits, true);
+    widget_t** expected = (widget_t**)malloc((n_instructions + 1) * sizeof(widget_t*));
+    size_t n_expected = 0;
+    widget_t* wid = NULL;
+    while (NULL != (wid = widget_sequence_next(seq, NULL)))
+    {
+        expected[n_expected++] = wid;
+    }
+    widget_sequence_destroy(seq);
+
+    widget_pipeline_t* pipe = widget_pipeline_create(inst, n_instructions, n_qubits, max_qubits, true, depth);
+    size_t n_emitted = 0;
+    while (NULL != (wid = widget_pipeline_next(pipe)))
+    {
+        assert(n_emitted < n_expected);
+        widget_t* cmp = expected[n_emitted];
+        assert(cmp->n_qubits == wid->n_qubits);
+        assert(0 == memcmp(cmp->q_map, wid->q_map, n_qubits * sizeof(size_t)));
+        assert(0 == memcmp(cmp->queue->table, wid->queue->table, wid->n_qubits));
+        assert(0 == memcmp(cmp->queue->non_cliffords, wid->queue->non_cliffords, wid->n_qubits * sizeof(non_clifford_tag_t)));
+
+        widget_pipeline_release(pipe, wid);
+        n_emitted++;
+    }
+    assert(n_emitted == n_expected);
+    assert(pipe->n_widgets <= pipe->depth);
+    widget_pipeline_destroy(pipe);
+
+    for (size_t i = 0; i < n_expected; i++)
+    {
+        widget_destroy(expected[i]);
+    }
+    free(expected);
+    free(inst);
+}
+
+/*
+ * test_widget_pipeline_abandon
+ * Destroying a pipeline before it is exhausted stops both stages
+ */
+void test_widget_pipeline_abandon(const size_t n_qubits, const size_t max_qubits, const size_t n_instructions)
+{
+    instruction_stream_u* inst = random_stream(n_qubits, n_instructions);
+    widget_pipeline_t* pipe = widget_pipeline_create(inst, n_instructions, n_qubits, max_qubits, true, 2);
+    widget_t* wid = widget_pipeline_next(pipe);
+    assert(NULL != wid);
+    widget_pipeline_destroy(pipe);
+    free(inst);
+}
+
+int main()
+{
+    test_widget_sequence(4, 9, 0, false);
+    test_widget_sequence(4, 9, 1, false);
+    for (size_t i = 0; i < 10; i++)
+    {
+        const size_t n_qubits = 2 + rand() % 32;
+        const size_t max_qubits = 2 * n_qubits + 1 + rand() % 64;
+        const size_t n_instructions = rand() % 2000;
+        test_widget_sequence(n_qubits, max_qubits, n_instructions, false);
+        test_widget_sequence(n_qubits, max_qubits, n_instructions, true);
+        test_widget_pipeline(n_qubits, max_qubits, n_instructions, 1 + i % 4);
+    }
+    test_widget_pipeline(4, 9, 0, 0);
+    test_widget_pipeline_abandon(8, 20, 1000);
+
+    threadpool_init(4, 0);
+    for (size_t i = 0; i < 5; i++)
+    {
+        const size_t n_qubits = 2 + rand() % 32;
+        const size_t max_qubits = 2 * n_qubits + 1 + rand() % 64;
+        const size_t n_instructions = rand() % 2000;
+        test_widget_pipeline(n_qubits, max_qubits, n_instructions, 1 + i % 4);
+    }
+    // Wide enough for ingestion to replay over the pool while the previous widget decomposes
+    for (size_t i = 0; i < 3; i++)
+    {
+        const size_t n_qubits = 256 + rand() % 64;
+        const size_t max_qubits = 2 * n_qubits + 512 + rand() % 256;
+        test_widget_pipeline(n_qubits, max_qubits, 20000, 2 + i);
+    }
+    threadpool_destroy();
+    return 0;
+}
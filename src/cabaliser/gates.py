@@ -11,6 +11,7 @@ LOCAL_CLIFFORD_MASK: Final[c_int8] = 1 << 5
 NON_LOCAL_CLIFFORD_MASK: Final[c_int8] = 1 << 6
 RZ_MASK: Final[c_int8] = 1 << 7
 CONDITIONAL_OPERATION_MASK = (1 << 6) | (1 << 7)
+QUBIT_MAP_MASK = (1 << 5) | (1 << 6)
 
 # Set of legal gates
 I: Final[c_int8] = 0x00 | LOCAL_CLIFFORD_MASK
@@ -54,6 +55,9 @@ _SHR_: Final[c_int8] = 0x17 | LOCAL_CLIFFORD_MASK
 CNOT: Final[c_int8] = 0x00 | NON_LOCAL_CLIFFORD_MASK
 CZ: Final[c_int8] = 0x01 | NON_LOCAL_CLIFFORD_MASK
 
+# Relabels the two logical qubits, no tableau update
+SWAP: Final[c_int8] = 0x00 | QUBIT_MAP_MASK
+
 # Arbitrary rotation gate
 RZ: Final[c_int8] = RZ_MASK
 
@@ -75,6 +79,7 @@ SINGLE_QUBIT_GATES = {
 
 TWO_QUBIT_GATES = {CNOT, CZ}
 TWO_QUBIT_GATE_ARR = [CNOT, CZ]
+QUBIT_MAP_GATES = {SWAP}
 CONDITIONAL_OPERATION_GATES = {MCX, MCY, MCZ}
 
 MEASUREMENT_GATE = [MEAS]
@@ -0,0 +1,193 @@
+"""
+Packed instruction files
+Stores operation sequences as varint encoded blocks that the c_lib can stream without loading the whole circuit
+"""
+
+import os
+from ctypes import cast, c_void_p, c_char_p, c_size_t, c_int, c_bool
+
+import numpy as np
+
+from cabaliser.operation_sequence import OperationSequence
+from cabaliser.operations import OPERATION_DTYPE
+
+from cabaliser.lib_cabaliser import lib
+lib.instruction_file_writer_open.argtypes = [c_int, c_size_t]
+lib.instruction_file_writer_open.restype = c_void_p
+lib.instruction_file_write.argtypes = [c_void_p, c_void_p, c_size_t]
+lib.instruction_file_writer_close.argtypes = [c_void_p]
+lib.instruction_file_writer_close.restype = c_size_t
+lib.instruction_file_reader_open.argtypes = [c_char_p]
+lib.instruction_file_reader_open.restype = c_void_p
+lib.instruction_file_reader_close.argtypes = [c_void_p]
+lib.instruction_file_n_instructions.argtypes = [c_void_p]
+lib.instruction_file_n_instructions.restype = c_size_t
+lib.instruction_file_read.argtypes = [c_void_p, c_void_p]
+lib.instruction_file_read.restype = c_bool
+lib.instruction_file_parse.argtypes = [c_void_p, c_void_p, c_void_p]
+lib.instruction_file_parse.restype = c_bool
+lib.qasm_parser_open.argtypes = [c_char_p]
+lib.qasm_parser_open.restype = c_void_p
+lib.qasm_parser_destroy.argtypes = [c_void_p]
+lib.qasm_parser_error.argtypes = [c_void_p]
+lib.qasm_parser_error.restype = c_char_p
+lib.qasm_parser_line.argtypes = [c_void_p]
+lib.qasm_parser_line.restype = c_size_t
+lib.qasm_write_instruction_file.argtypes = [c_void_p, c_void_p]
+lib.qasm_write_instruction_file.restype = c_size_t
+lib.qasm_parser_read.argtypes = [c_void_p, c_void_p, c_size_t]
+lib.qasm_parser_read.restype = c_size_t
+
+QASM_CHECK_BLOCK = 1 << 16 # Operations decoded per read when checking a circuit
+
+
+class InstructionFileWriter:
+    """
+    Streams operations to a packed instruction file
+    Each operation is stored as its opcode then its qubits and tag as varints
+    """
+
+    def __init__(self, path: str, block_size: int = 0):
+        """
+        Opens an instruction file for writing, replacing any existing file
+        :: path : str :: Output path
+        :: block_size : int :: Operations per block, 0 for the c_lib default
+        """
+        self._file = open(path, 'wb')
+        self._writer = lib.instruction_file_writer_open(self._file.fileno(), block_size)
+        if not self._writer:
+            self._file.close()
+            raise OSError(f"Could not write to {path}")
+        self.n_bytes = 0
+
+    def write(self, operations):
+        """
+        Appends operations
+        :: operations : OperationSequence or buffer :: Operations, or any buffer of packed operations
+        """
+        if isinstance(operations, OperationSequence):
+            operations = operations.as_array()
+        ops = np.frombuffer(operations, dtype=OPERATION_DTYPE)
+        if not OperationSequence.VALID_OPCODES[ops['opcode']].all():
+            raise ValueError("Invalid Opcode")
+        if len(ops) > 0:
+            lib.instruction_file_write(self._writer, ops.ctypes.data, len(ops))
+
+    def write_qasm(self, path: str) -> int:
+        """
+        Appends an OpenQASM 2 circuit, parsed by the c_lib without loading the whole circuit
+        Supports id, h, s, sdg, x, y, z, t, tdg, rz, cx, cz, swap and measure
+        Registers are numbered in the order they are declared, rz angles are tagged as angle_to_tag does
+        :: path : str :: Circuit file
+        Returns the number of operations written
+        The circuit is parsed once to check it before anything is written,
+        so a malformed circuit raises ValueError and leaves the file as it was
+        """
+        self._parse_qasm(path, None)
+        return self._parse_qasm(path, self._writer)
+
+    @staticmethod
+    def _parse_qasm(path: str, writer):
+        """
+        Parses an OpenQASM 2 circuit
+        :: path : str :: Circuit file
+        :: writer : c_void_p :: Writer to append to, None to only check the circuit
+        Returns the number of operations parsed
+        """
+        parser = lib.qasm_parser_open(os.fsencode(path))
+        if not parser:
+            raise FileNotFoundError(path)
+        try:
+            if writer is None:
+                buffer = np.empty(QASM_CHECK_BLOCK, dtype=OPERATION_DTYPE)
+                n_operations = 0
+                n_read = lib.qasm_parser_read(parser, buffer.ctypes.data, len(buffer))
+                while n_read > 0:
+                    n_operations += n_read
+                    n_read = lib.qasm_parser_read(parser, buffer.ctypes.data, len(buffer))
+            else:
+                n_operations = int(lib.qasm_write_instruction_file(parser, writer))
+            error = lib.qasm_parser_error(parser)
+            if error is not None:
+                line = lib.qasm_parser_line(parser)
+                raise ValueError(f"{path}:{line}: {error.decode()}")
+        finally:
+            lib.qasm_parser_destroy(parser)
+        return n_operations
+
+    def close(self):
+        """
+        Writes the index, after which the file can be read
+        """
+        if self._writer is not None:
+            self.n_bytes = int(lib.instruction_file_writer_close(self._writer))
+            self._writer = None
+            self._file.close()
+            if 0 == self.n_bytes:
+                raise OSError(f"Could not write to {self._file.name}")
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __del__(self):
+        self.close()
+
+
+class InstructionFileReader:
+    """
+    Maps a packed instruction file read only
+    """
+
+    def __init__(self, path: str):
+        """
+        Maps an instruction file
+        :: path : str :: File path
+        """
+        self._reader = lib.instruction_file_reader_open(os.fsencode(path))
+        if not self._reader:
+            raise ValueError(f"{path} is not a closed instruction file")
+
+    def __len__(self):
+        return int(lib.instruction_file_n_instructions(self._reader))
+
+    def read(self) -> OperationSequence:
+        '''
+            Decodes the whole file into an operation sequence
+        '''
+        n_instructions = len(self)
+        ops = OperationSequence(n_instructions)
+        if not lib.instruction_file_read(self._reader, ops._view().ctypes.data):
+            raise ValueError("Corrupt instruction block")
+        ops.curr_instructions = n_instructions
+        ops._count_params()
+        return ops
+
+    def parse_into(self, widget):
+        '''
+            Parses every operation into a widget, one block at a time
+            :: widget : Widget :: Widget that has not been decomposed
+            Raises ValueError at the first block that is corrupt or addresses a qubit past the widget's initial qubits,
+            earlier blocks have already been parsed
+        '''
+        if not lib.instruction_file_parse(self._reader, widget.widget, cast(lib.parse_instruction_block_par, c_void_p)):
+            raise ValueError("Corrupt instruction block or qubit out of range")
+
+    def close(self):
+        '''
+            Unmaps the file
+        '''
+        if self._reader:
+            lib.instruction_file_reader_close(self._reader)
+            self._reader = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __del__(self):
+        self.close()
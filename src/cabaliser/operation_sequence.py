@@ -6,10 +6,13 @@
 from itertools import chain, repeat
 import ctypes
 
+import numpy as np
+
 from cabaliser.gates import SINGLE_QUBIT_GATES, TWO_QUBIT_GATES
 from cabaliser.gates import RZ_GATES, CONDITIONAL_OPERATION_GATES, RZ, MEASUREMENT_GATE
+from cabaliser.gates import QUBIT_MAP_GATES, OPCODE_TYPE_MASK, RZ_MASK
 from cabaliser.operations import (
-    OperationType, SingleQubitOperation,
+    OperationType, OPERATION_DTYPE, SingleQubitOperation,
     TwoQubitOperation, RzOperation,
     ConditionalOperation)
 
@@ -30,12 +33,21 @@ class OperationSequence():
     for idx, fn in chain(
             zip(SINGLE_QUBIT_GATES, repeat(SingleQubitOperation)),
             zip(TWO_QUBIT_GATES, repeat(TwoQubitOperation)),
+            zip(QUBIT_MAP_GATES, repeat(TwoQubitOperation)),
             zip(RZ_GATES, repeat(RzOperation)),
             zip(MEASUREMENT_GATE, repeat(SingleQubitOperation)),
             zip(CONDITIONAL_OPERATION_GATES, repeat(ConditionalOperation))
             ):
         CONSTRUCTOR_MAP[idx] = fn
 
+    # Vectorised forms of the constructor table
+    VALID_OPCODES = np.zeros(256, dtype=bool)
+    TWO_QUBIT_OPCODES = np.zeros(256, dtype=bool)
+    for idx in chain(SINGLE_QUBIT_GATES, TWO_QUBIT_GATES, QUBIT_MAP_GATES, RZ_GATES, MEASUREMENT_GATE, CONDITIONAL_OPERATION_GATES):
+        VALID_OPCODES[idx] = True
+    for idx in chain(TWO_QUBIT_GATES, QUBIT_MAP_GATES, CONDITIONAL_OPERATION_GATES):
+        TWO_QUBIT_OPCODES[idx] = True
+
     def __init__(self, n_instructions: int):
         '''
         Constructor for the operation sequence object
@@ -48,6 +60,73 @@ class OperationSequence():
         self.max_qubit_index = 0
         self.n_rz_operations = 0
 
+    @classmethod
+    def from_arrays(cls, opcodes, arg0, arg1=None, tags=None):
+        '''
+            from_arrays
+            Builds a sequence from parallel arrays in one vectorised pass
+            :: opcodes : array :: Opcode of each operation
+            :: arg0 : array :: Target of single qubit and rz operations, first qubit of two qubit operations
+            :: arg1 : array :: Second qubit of two qubit and conditional operations, optional if there are none
+            :: tags : array :: Optional, tag of rz operations
+            Entries of arg1 and tags that do not apply to an operation are ignored
+        '''
+        opcodes = np.asarray(opcodes, dtype=np.uint8)
+        n_instructions = len(opcodes)
+        if not cls.VALID_OPCODES[opcodes].all():
+            raise ValueError("Invalid Opcode")
+
+        two_qubit = cls.TWO_QUBIT_OPCODES[opcodes]
+        if arg1 is None and two_qubit.any():
+            raise ValueError("arg1 is required for two qubit and conditional operations")
+
+        seq = cls(n_instructions)
+        view = seq._view(n_instructions)
+        view['opcode'] = opcodes
+        view['arg0'] = arg0
+
+        # The second qubit and the rz tag share a field, as in append it stays zero otherwise
+        is_rz = RZ_MASK == (opcodes & OPCODE_TYPE_MASK)
+        if arg1 is not None:
+            view['arg1'] = np.where(two_qubit, arg1, 0)
+        if tags is not None:
+            view['arg1'] = np.where(is_rz, tags, view['arg1'])
+
+        seq.curr_instructions = n_instructions
+        seq._count_params()
+        return seq
+
+    def _count_params(self):
+        '''
+            _count_params
+            Recounts the rz operations and the largest qubit index from the operation array
+        '''
+        view = self.as_array()
+        opcodes = view['opcode']
+        self.n_rz_operations = int(np.count_nonzero(RZ_MASK == (opcodes & OPCODE_TYPE_MASK)))
+        self.max_qubit_index = 0
+        if len(view) > 0:
+            self.max_qubit_index = int(max(
+                view['arg0'].max(),
+                view['arg1'][self.TWO_QUBIT_OPCODES[opcodes]].max(initial=0)))
+
+    def _view(self, n_instructions=None):
+        '''
+            _view
+            Structured numpy view over the operation array, writes go straight to the array
+            :: n_instructions : int :: Optional, number of leading operations to view, defaults to all
+        '''
+        raw = (ctypes.c_char * ctypes.sizeof(self.ops)).from_buffer(self.ops)
+        return np.frombuffer(raw, dtype=OPERATION_DTYPE)[:n_instructions]
+
+    def as_array(self):
+        '''
+            as_array
+            Structured numpy view of the current operations with fields opcode, arg0 and arg1
+            No copy is made, the view shares memory with this sequence
+        '''
+        return self._view(self.curr_instructions)
+
     def __len__(self):
         return self.curr_instructions
 
@@ -120,11 +199,13 @@ class OperationSequence():
             Returns a new operation sequence containing lhs operations then rhs operations
         '''
         seq = OperationSequence(self.n_instructions + other.n_instructions)
-        # This could probably be done with a wrap around memcpy
-        for op in self:
-            seq._append(op)
-        for op in other:
-            seq._append(op)
+        op_size = ctypes.sizeof(OperationType)
+        ctypes.memmove(seq.ops, self.ops, self.curr_instructions * op_size)
+        ctypes.memmove(
+            ctypes.addressof(seq.ops) + self.curr_instructions * op_size,
+            other.ops,
+            other.curr_instructions * op_size)
+        seq.curr_instructions = self.curr_instructions + other.curr_instructions
 
         seq.max_qubit_index = max(self.max_qubit_index, other.max_qubit_index)
         seq.n_rz_operations = self.n_rz_operations + other.n_rz_operations
@@ -183,10 +264,10 @@ class OperationSequence():
         seq.curr_instructions = sequence_length
         seq.n_instructions = sequence_length
         seq.max_qubit_index = self.max_qubit_index
-        for j in range(sequence_length):
-            if self[start + j].is_rz():
-                seq.n_rz_operations += 1
-            seq[j] = self[start + j]
+        op_size = ctypes.sizeof(OperationType)
+        ctypes.memmove(seq.ops, ctypes.addressof(self.ops) + start * op_size, sequence_length * op_size)
+        opcodes = seq.as_array()['opcode']
+        seq.n_rz_operations = int(np.count_nonzero(RZ_MASK == (opcodes & OPCODE_TYPE_MASK)))
         return seq
 
     @staticmethod
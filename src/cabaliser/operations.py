@@ -3,8 +3,10 @@
 '''
 from itertools import chain, repeat
 
-from ctypes import Structure, Union, c_uint32, c_uint8
-from cabaliser.gates import SINGLE_QUBIT_GATES, TWO_QUBIT_GATES, LOCAL_CLIFFORD_MASK, NON_LOCAL_CLIFFORD_MASK, RZ_MASK, OPCODE_TYPE_MASK, RZ_GATES, CONDITIONAL_OPERATION_GATES, SINGLE_QUBIT_GATE_ARR
+from ctypes import Structure, Union, c_uint32, c_uint8, sizeof
+
+import numpy as np
+from cabaliser.gates import SINGLE_QUBIT_GATES, TWO_QUBIT_GATES, QUBIT_MAP_GATES, LOCAL_CLIFFORD_MASK, NON_LOCAL_CLIFFORD_MASK, RZ_MASK, OPCODE_TYPE_MASK, RZ_GATES, CONDITIONAL_OPERATION_GATES, SINGLE_QUBIT_GATE_ARR
 from cabaliser.utils import unbound_table_element
 
 OpcodeType = c_uint8
@@ -149,6 +151,7 @@ opcode_map = [unbound_table_element for _ in range(256)]
 for idx, fn in chain(
     zip(SINGLE_QUBIT_GATES, repeat(lambda x: x.single)),
     zip(TWO_QUBIT_GATES, repeat(lambda x: x.two_qubits)),
+    zip(QUBIT_MAP_GATES, repeat(lambda x: x.two_qubits)),
     zip(RZ_GATES, repeat(lambda x: x.rz)),
     zip(CONDITIONAL_OPERATION_GATES, repeat(lambda x: x.cond_op))
     ):
@@ -172,3 +175,13 @@ class OperationType(Union):
 
     def is_rz(self):
         return RZ_MASK == (self.opcode & OPCODE_TYPE_MASK)  
+
+
+# Structured numpy view of OperationType, as instruction_stream_u in the c_lib
+# arg0 is the target, control or rz qubit, arg1 is the second qubit or the rz tag
+OPERATION_DTYPE = np.dtype({
+    'names': ['opcode', 'arg0', 'arg1'],
+    'formats': [np.uint8, np.uint32, np.uint32],
+    'offsets': [0, TwoQubitOperationType.ctrl.offset, TwoQubitOperationType.targ.offset],
+    'itemsize': sizeof(OperationType)
+    })
@@ -17,6 +17,7 @@ lib.lib_pauli_n_dependents.restype = c_size_t
 lib.lib_pauli_graph_to_layer.restype = void_p
 
 lib.lib_pauli_tracker_partial_order_graph.restype = void_p  # Opaque Pointer
+lib.widget_partial_order_graph.restype = void_p  # Opaque Pointer
 lib.lib_pauli_layer_to_dependent_node.restype = POINTER(ScheduleDependencyType)
 
 lib.lib_pauli_tracker_create_pauli_corrections.restype = void_p  # Opaque Pointer
@@ -36,6 +37,7 @@ class PauliTracker:
             PauliTracker
             Wrapper for the rustlib pauli tracker object
         '''
+        self.widget_ptr = widget.widget
         self.pauli_tracker_ptr = widget.pauli_tracker_ptr
         self.corrections_ptr = None
         self.inv_mapper = None
@@ -66,10 +68,9 @@ class PauliTracker:
         '''
             widget_to_graph
             Gets a graph pointer from a widget pointer
+            Build time is added to the widget's stats
         '''
-        graph_ptr = lib.lib_pauli_tracker_partial_order_graph(
-            self.pauli_tracker_ptr
-            )
+        graph_ptr = lib.widget_partial_order_graph(self.widget_ptr)
         return graph_ptr
 
     @property
@@ -1,13 +1,14 @@
 '''
     C struct wrappers as type declarations
 '''
-from ctypes import Structure, POINTER, c_int32, c_byte, c_size_t
+from ctypes import Structure, POINTER, c_int32, c_byte, c_size_t, c_uint8, c_uint32, c_uint64
 
 LocalCliffordType = c_byte  # 1 byte
 MeasurementTagType = c_int32  # 4 bytes
 AdjacencyEdgeType = c_int32  # 4 bytes
 IOMapType = c_size_t  # 8 bytes
 PauliOperatorType = c_byte
+N_GATE_TYPES = 8  # Instruction types, the top three bits of an opcode
 
 
 class CliffordQueueType(Structure):
@@ -83,3 +84,79 @@ def const_vec_builder(arr_type):
 ScheduleDependencyType = const_vec_builder(c_size_t)
 PauliCorrectionType = const_vec_builder(PauliOperatorType)
 InvMapperType = const_vec_builder(c_size_t)
+
+
+class EngineStatsType(Structure):
+    '''
+        ctypes wrapper for widget engine stats
+    '''
+    _fields_ = [
+        ('requested_engine', c_uint8),
+        ('engine', c_uint8),
+        ('converted', c_uint8),
+        ('n_gates', c_size_t),
+        ('conversion_gate', c_size_t),
+        ('conversion_qubits', c_size_t),
+        ('n_edges', c_size_t),
+        ('max_degree', c_size_t),
+        ('n_toggles', c_size_t),
+    ]
+
+
+class StatsType(Structure):
+    '''
+        ctypes wrapper for widget phase timings and counters
+    '''
+    _fields_ = [
+        ('enabled', c_uint8),
+        ('ingestion_ns', c_uint64),
+        ('queue_flush_ns', c_uint64),
+        ('remove_zero_x_columns_ns', c_uint64),
+        ('transpose_ns', c_uint64),
+        ('elim_ns', c_uint64),
+        ('zero_diagonal_ns', c_uint64),
+        ('pauli_tracker_ns', c_uint64),
+        ('partial_order_ns', c_uint64),
+        ('n_gates', c_uint64 * N_GATE_TYPES),
+        ('n_rowsums', c_uint64),
+        ('n_local_elim', c_uint64),
+        ('n_local_search', c_uint64),
+        ('n_non_local_search', c_uint64),
+        ('n_hadamard', c_uint64),
+        ('n_z_search', c_uint64),
+    ]
+
+
+class WidgetBinaryScheduleType(Structure):
+    '''
+        ctypes wrapper for the schedule and corrections of a binary widget record
+    '''
+    _fields_ = [
+        ('n_layers', c_size_t),
+        ('n_nodes', c_size_t),
+        ('n_deps', c_size_t),
+        ('layer_offsets', POINTER(c_size_t)),
+        ('nodes', POINTER(c_uint32)),
+        ('dep_offsets', POINTER(c_size_t)),
+        ('deps', POINTER(c_uint32)),
+        ('n_corrections', c_size_t),
+        ('correction_width', c_size_t),
+        ('correction_qubits', POINTER(c_uint32)),
+        ('paulis', POINTER(c_uint8)),
+    ]
+
+
+class WidgetBinaryInfoType(Structure):
+    '''
+        ctypes wrapper for the counts of a binary widget record
+    '''
+    _fields_ = [
+        ('n_qubits', c_size_t),
+        ('n_initial_qubits', c_size_t),
+        ('n_edges', c_size_t),
+        ('n_layers', c_size_t),
+        ('n_nodes', c_size_t),
+        ('n_deps', c_size_t),
+        ('n_corrections', c_size_t),
+        ('correction_width', c_size_t),
+    ]
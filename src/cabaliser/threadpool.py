@@ -0,0 +1,38 @@
+'''
+    Threadpool controls
+    Exposes the c_lib's worker pool
+'''
+from ctypes import c_size_t, c_uint32
+
+from cabaliser.lib_cabaliser import lib
+
+THREADPOOL_PIN_WORKERS = 1 << 0
+
+lib.threadpool_n_workers.restype = c_size_t
+
+
+def set_threads(n_workers: int = 0, pin_workers: bool = False):
+    '''
+        set_threads
+        Starts or restarts the worker pool
+        :: n_workers : int :: Number of workers, 0 reads CABALISER_N_THREADS and falls back to the CPU count
+        :: pin_workers : bool :: Pin each worker to a CPU
+    '''
+    flags = THREADPOOL_PIN_WORKERS if pin_workers else 0
+    lib.threadpool_init(c_size_t(n_workers), c_uint32(flags))
+
+
+def get_threads() -> int:
+    '''
+        get_threads
+        Returns the number of workers, 1 if the pool is not running
+    '''
+    return lib.threadpool_n_workers()
+
+
+def stop_threads():
+    '''
+        stop_threads
+        Joins and releases the worker pool
+    '''
+    lib.threadpool_destroy()
@@ -2,10 +2,13 @@
     Widget object
     Exposes an API to the cabaliser c_lib's widget object
 '''
-from ctypes import POINTER, c_buffer
+from ctypes import POINTER, c_buffer, c_uint32, c_double, c_size_t, c_bool, c_void_p
+
+import numpy as np
 
 from cabaliser.operation_sequence import OperationSequence
-from cabaliser.structs import AdjacencyType, WidgetType
+from cabaliser.operations import OPERATION_DTYPE
+from cabaliser.structs import AdjacencyType, WidgetType, EngineStatsType, StatsType
 from cabaliser.structs import LocalCliffordType, MeasurementTagType, IOMapType
 from cabaliser.io_array_wrappers import MeasurementTags, LocalCliffords, IOMap
 from cabaliser.qubit_array import QubitArray
@@ -15,10 +18,28 @@ from cabaliser.utils import deref
 
 from cabaliser.exceptions import WidgetNotDecomposedException, WidgetDecomposedException
 from cabaliser import local_simulator
+from cabaliser import gates
 
 from cabaliser.lib_cabaliser import lib
 # Override return type
 lib.widget_create.restype = POINTER(WidgetType)
+lib.widget_create_engine.restype = POINTER(WidgetType)
+lib.widget_create_alloc.restype = POINTER(WidgetType)
+lib.widget_get_graph_csr.argtypes = [POINTER(WidgetType), c_void_p, c_void_p, c_bool]
+lib.widget_get_graph_csr.restype = c_size_t
+lib.widget_finalise.argtypes = [POINTER(WidgetType)]
+
+# Simulation engines, mirrors WIDGET_ENGINE_* in widget.h
+TABLEAU_ENGINE = 0
+GRAPH_ENGINE = 1
+AUTO_ENGINE = 2
+
+# Tableau allocation policies, mirrors TABLEAU_ALLOC_* in tableau.h
+ALLOC_ALIGNED = 0
+ALLOC_MMAP = 1
+ALLOC_HUGE = 2
+ALLOC_HUGETLB = 3
+ALLOC_FIRST_TOUCH = 4
 
 
 class Widget():
@@ -26,17 +47,21 @@ class Widget():
         Widget object
         Exposes an API to the cabaliser c_lib's widget object
     '''
-    def __init__(self, n_qubits: int, n_qubits_max: int, teleport_input: bool = True, n_inputs: int=None):
+    def __init__(self, n_qubits: int, n_qubits_max: int, teleport_input: bool = True, n_inputs: int=None, engine: int=TABLEAU_ENGINE, auto_threshold: float=None, alloc_policy: int=ALLOC_MMAP):
         '''
             __init__
             Constructor for the widget
             Allocates a large tableau
             :: n_qubits : int :: Initial number of qubits, "width" of the widget  
-            :: n_qubits_max : int :: Maximum size of the widget 
+            :: n_qubits_max : int :: Initial capacity of the widget, grown as rz gates need more qubits
             :: teleport_input : bool :: Whether the inputs should be teleported
             :: n_inputs : int :: Optional, If the number of inputs differs from the size of the register   
+            :: engine : int :: TABLEAU_ENGINE, GRAPH_ENGINE or AUTO_ENGINE, the graph engine skips the tableau and its decomposition
+            :: auto_threshold : float :: Optional, graph to tableau cost ratio at which AUTO_ENGINE converts
+            :: alloc_policy : int :: How the tableau is allocated, one of the ALLOC_* policies
         '''
         self.decomposed = False
+        self.finalised = False
 
         if n_inputs is None:
             n_inputs = n_qubits
@@ -45,7 +70,13 @@ class Widget():
 
         self.n_inputs = n_inputs
 
-        self.widget = lib.widget_create(n_qubits, n_qubits_max)
+        if engine not in (TABLEAU_ENGINE, GRAPH_ENGINE, AUTO_ENGINE):
+            raise ValueError("Unknown engine")
+        if alloc_policy not in (ALLOC_ALIGNED, ALLOC_MMAP, ALLOC_HUGE, ALLOC_HUGETLB, ALLOC_FIRST_TOUCH):
+            raise ValueError("Unknown allocation policy")
+        self.widget = lib.widget_create_alloc(n_qubits, n_qubits_max, engine, alloc_policy)
+        if auto_threshold is not None:
+            lib.widget_set_auto_threshold(self.widget, c_double(auto_threshold))
         self.teleport_input = teleport_input
 
         if self.teleport_input:
@@ -58,6 +89,59 @@ class Widget():
         self.io_map = None
         self.pauli_tracker = PauliTracker(self)
 
+    @classmethod
+    def from_decomposed(cls, widget_ptr, n_inputs: int, teleport_input: bool = True, owned: bool = True):
+        '''
+            from_decomposed
+            Wraps a widget that was built and decomposed in the c_lib
+            :: widget_ptr : POINTER(WidgetType) :: Widget
+            :: n_inputs : int :: Number of inputs
+            :: teleport_input : bool :: Whether the inputs were teleported
+            :: owned : bool :: Whether ownership passes to the wrapper, pipeline widgets stay with the pipeline
+        '''
+        wid = cls.__new__(cls)
+        wid.widget = widget_ptr
+        wid._owned = owned
+        wid.n_inputs = n_inputs
+        wid.teleport_input = teleport_input
+        wid.refresh_decomposed()
+        return wid
+
+    def refresh_decomposed(self):
+        '''
+            refresh_decomposed
+            Drops cached outputs after the c_lib has reset, refilled and decomposed this widget in place
+        '''
+        self.local_cliffords = None
+        self.measurement_tags = None
+        self.io_map = None
+        self.pauli_tracker = PauliTracker(self)
+        self.decomposed = True
+        self.finalised = False
+        self.__schedule()
+
+    def reset(self, n_qubits: int = None):
+        '''
+            reset
+            Returns the widget to its freshly constructed state, reusing its allocations
+            :: n_qubits : int :: Optional, new initial number of qubits, defaults to the current one
+        '''
+        if n_qubits is None:
+            n_qubits = self.n_initial_qubits
+        if self.n_inputs > n_qubits:
+            raise IndexError("More inputs than qubits")
+
+        lib.widget_reset(self.widget, n_qubits)
+        if self.teleport_input:
+            lib.teleport_input(self.widget, self.n_inputs)
+
+        self.local_cliffords = None
+        self.measurement_tags = None
+        self.io_map = None
+        self.pauli_tracker = PauliTracker(self)
+        self.decomposed = False
+        self.finalised = False
+
     def get_n_qubits(self) -> int:
         '''
             get_n_qubits
@@ -86,7 +170,7 @@ class Widget():
         '''
             get_max_qubits
             Getter method for the widget
-            Returns the maximum number of allocatable qubits on the widget
+            Returns the current capacity of the widget, this grows as qubits are allocated
         '''
         return lib.widget_get_max_qubits(self.widget)
 
@@ -113,16 +197,67 @@ class Widget():
         '''
         return self.get_n_initial_qubits()
 
-    def process_operations(self, operations: OperationSequence):
+    def process_operations(self, operations):
         '''
             Parses an array of operations
-            :: operations: Operations :: Wrapper around an array of operations
-            Acts in place on the widget
-        '''
-        lib.parse_instruction_block(
+            :: operations: OperationSequence or buffer :: Wrapper around an array of operations,
+             or any buffer of packed operations such as an OPERATION_DTYPE numpy array
+            Acts in place on the widget, buffers are read in place without copying
+        '''
+        if self.finalised:
+            raise WidgetDecomposedException("Finalised widgets have no tableau to apply operations to, reset first")
+        if isinstance(operations, OperationSequence):
+            lib.parse_instruction_block_par(
+                self.widget,
+                operations.ops,
+                operations.curr_instructions)
+            return
+
+        ops = np.frombuffer(operations, dtype=OPERATION_DTYPE)
+        if not OperationSequence.VALID_OPCODES[ops['opcode']].all():
+            raise ValueError("Invalid Opcode")
+        if len(ops) > 0:
+            lib.parse_instruction_block_par(self.widget, c_void_p(ops.ctypes.data), len(ops))
+
+    def engine_stats(self) -> dict:
+        '''
+            Reports the engine in use, where an AUTO_ENGINE widget converted and the graph density
+        '''
+        stats = EngineStatsType()
+        lib.widget_get_engine_stats_api(self.widget, POINTER(EngineStatsType)(stats))
+        return {field: getattr(stats, field) for field, _ in EngineStatsType._fields_}
+
+    def stats(self) -> dict:
+        '''
+            Reports time spent in each phase in nanoseconds and counts of the work done
+            Only recorded when the library is built with WIDGET_STATS, 'enabled' is otherwise False and everything else zero
+            Gate counts are keyed by instruction type
+        '''
+        stats = StatsType()
+        lib.widget_get_stats_api(self.widget, POINTER(StatsType)(stats))
+        report = {field: getattr(stats, field) for field, _ in StatsType._fields_}
+        report['enabled'] = bool(stats.enabled)
+        report['n_gates'] = {
+            name: stats.n_gates[opcode >> 5] for name, opcode in (
+                ('local_clifford', gates.LOCAL_CLIFFORD_MASK),
+                ('non_local_clifford', gates.NON_LOCAL_CLIFFORD_MASK),
+                ('qubit_map', gates.QUBIT_MAP_MASK),
+                ('rz', gates.RZ_MASK),
+                ('conditional', gates.CONDITIONAL_OPERATION_MASK),
+            )}
+        return report
+
+    def permute(self, perm):
+        '''
+            Permutes the logical qubits of the widget
+            :: perm : list[int] :: Logical qubit i moves to perm[i]
+            Only relabels qubits, equivalent to a sequence of SWAP operations
+        '''
+        if sorted(perm) != list(range(self.n_initial_qubits)):
+            raise ValueError("Not a permutation of the initial qubits")
+        lib.widget_permute_qubits(
             self.widget,
-            operations.ops,
-            operations.curr_instructions)
+            (c_uint32 * len(perm))(*perm))
 
     def __call__(self, *args, **kwargs):
         '''
@@ -136,16 +271,20 @@ class Widget():
             Explicit destructor for the widget
             Frees the underlying C object
         '''
-        lib.widget_destroy(self.widget)
+        if getattr(self, '_owned', True):
+            lib.widget_destroy(self.widget)
 
     def json(self, rz_to_float=False, local_clifford_to_string=True):
         '''
             Returns a dict object of all relevant properties
         '''
+        offsets, neighbours = self.get_graph_csr()
+        offsets = offsets.tolist()
+        neighbours = neighbours.tolist()
         obj = {
                'n_qubits': self.n_qubits,
                'statenodes': list(range(self.n_initial_qubits)),
-               'adjacencies': {i: self.get_adjacencies(i).to_list() for i in range(self.n_qubits)},
+               'adjacencies': {i: neighbours[offsets[i]:offsets[i + 1]] for i in range(self.n_qubits)},
                'local_cliffords': self.get_local_cliffords().to_list(
                     to_string=local_clifford_to_string),
                'consumptionschedule': self.pauli_tracker.to_list(),
@@ -258,11 +397,29 @@ class Widget():
 
         return adj
 
+    @require_decomposed
+    def get_graph_csr(self, upper_triangle: bool = False):
+        '''
+            Returns the whole graph in compressed sparse row form
+            The neighbours of qubit i are neighbours[offsets[i]:offsets[i + 1]], in ascending order
+            :: upper_triangle : bool :: Only report each edge from its lower qubit
+            The c_lib writes straight into both numpy arrays
+        '''
+        n_qubits = self.get_n_qubits()
+        offsets = np.empty(n_qubits + 1, dtype=np.uintp)
+        n_entries = lib.widget_get_graph_csr(self.widget, offsets.ctypes.data, None, upper_triangle)
+        neighbours = np.empty(n_entries, dtype=np.uint32)
+        if n_entries > 0:
+            lib.widget_get_graph_csr(self.widget, offsets.ctypes.data, neighbours.ctypes.data, upper_triangle)
+        return offsets, neighbours
+
     @require_not_decomposed
     def decompose(self):
         '''
             Decomposes the operation sequence into an algorithmically specific graph (asg)
         '''
+        if self.finalised:
+            raise WidgetDecomposedException("Finalised widgets have no tableau to decompose, reset first")
         lib.widget_decompose(self.widget)
 
         # Create the measurement schedule
@@ -271,6 +428,17 @@ class Widget():
         # Set the decomposed flag
         self.decomposed = True
 
+    @require_decomposed
+    def finalise(self):
+        '''
+            finalise
+            Frees the tableau, keeping the graph in compressed sparse row form
+            Local Cliffords, tags, the io map and the schedule are unchanged and remain readable
+            The widget can no longer be simulated on, reset restores it
+        '''
+        lib.widget_finalise(self.widget)
+        self.finalised = True
+
     def __schedule(self):
         '''
             Call through to the pauli tracker for
@@ -316,7 +484,9 @@ class Widget():
         '''
             Forces the resolution of the clifford queue
         '''
-        lib.apply_local_cliffords(self.widget)
+        if self.finalised:
+            raise WidgetDecomposedException("Finalised widgets have no tableau to apply local Cliffords to")
+        lib.apply_local_cliffords_par(self.widget)
 
 class Adjacency(QubitArray):
     '''
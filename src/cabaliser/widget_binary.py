@@ -0,0 +1,246 @@
+"""
+Binary widget containers
+Streams decomposed widgets to a compact versioned file and maps them back
+"""
+
+import os
+from ctypes import POINTER, c_void_p, c_char_p, c_size_t, c_bool, c_int, c_uint8, c_uint32
+
+import numpy as np
+
+from cabaliser.structs import WidgetType, WidgetBinaryScheduleType, WidgetBinaryInfoType
+from cabaliser.widget_from_binary import WidgetFromBinary
+
+from cabaliser.lib_cabaliser import lib
+lib.widget_binary_writer_open.argtypes = [c_int]
+lib.widget_binary_writer_open.restype = c_void_p
+lib.widget_binary_write.argtypes = [c_void_p, POINTER(WidgetType), POINTER(WidgetBinaryScheduleType)]
+lib.widget_binary_write.restype = c_size_t
+lib.widget_binary_writer_close.argtypes = [c_void_p]
+lib.widget_binary_reader_open.argtypes = [c_char_p]
+lib.widget_binary_reader_open.restype = c_void_p
+lib.widget_binary_reader_close.argtypes = [c_void_p]
+lib.widget_binary_n_widgets.argtypes = [c_void_p]
+lib.widget_binary_n_widgets.restype = c_size_t
+lib.widget_binary_read_info.argtypes = [c_void_p, c_size_t, POINTER(WidgetBinaryInfoType)]
+lib.widget_binary_read_graph.argtypes = [c_void_p, c_size_t, c_void_p, c_void_p, c_bool]
+lib.widget_binary_read_qubits.argtypes = [c_void_p, c_size_t, c_void_p, c_void_p, c_void_p]
+lib.widget_binary_read_schedule.argtypes = [c_void_p, c_size_t, POINTER(WidgetBinaryScheduleType)]
+
+# Pauli codes of the container, mirrors WIDGET_BINARY_PAULI_BITS in widget_binary.h
+PAULIS = 'IXYZ'
+_PAULI_CODES = np.zeros(256, dtype=np.uint8)
+for _code, _pauli in enumerate(PAULIS):
+    _PAULI_CODES[ord(_pauli)] = _code
+
+
+def _ptr(arr: np.ndarray, ctype):
+    '''
+        Pointer to the data of a numpy array
+    '''
+    return arr.ctypes.data_as(POINTER(ctype))
+
+
+class WidgetBinaryWriter:
+    """
+    Streams decomposed widgets to a binary container
+    Each write appends one self delimiting record, so the file is valid after every widget
+    """
+
+    def __init__(self, path: str):
+        """
+        Opens a container for writing, replacing any existing file
+        :: path : str :: Output path
+        """
+        self._file = open(path, 'wb')
+        self._writer = lib.widget_binary_writer_open(self._file.fileno())
+        if not self._writer:
+            self._file.close()
+            raise OSError(f"Could not write to {path}")
+        self.n_widgets = 0
+
+    def write(self, widget):
+        """
+        Appends a widget
+        :: widget : Widget :: Decomposed widget
+        Returns the number of bytes written
+        """
+        schedule, arrays = self._schedule(widget)
+        n_bytes = lib.widget_binary_write(self._writer, widget.widget, schedule)
+        del arrays
+        if 0 == n_bytes:
+            raise OSError(f"Could not write to {self._file.name}")
+        self.n_widgets += 1
+        return n_bytes
+
+    @staticmethod
+    def _schedule(widget):
+        '''
+            Flattens the measurement schedule and Pauli corrections of a widget
+            Returns the struct and the numpy arrays backing it, which must outlive the write
+        '''
+        layers = widget.get_schedule()
+        layer_offsets = np.zeros(len(layers) + 1, dtype=np.uintp)
+        nodes, dep_offsets, deps = [], [0], []
+        for i, layer in enumerate(layers):
+            for node in layer:
+                for qubit, dependencies in node.items():
+                    nodes.append(qubit)
+                    deps.extend(dependencies)
+                    dep_offsets.append(len(deps))
+            layer_offsets[i + 1] = len(nodes)
+
+        corrections = widget.get_pauli_corrections()
+        qubits = [next(iter(correction)) for correction in corrections]
+        strings = [next(iter(correction.values())) for correction in corrections]
+        width = max(map(len, strings), default=0)
+        paulis = np.frombuffer(
+            ''.join(string.ljust(width, 'I') for string in strings).encode('ascii'), dtype=np.uint8
+        )
+
+        arrays = [
+            layer_offsets,
+            np.array(nodes, dtype=np.uint32),
+            np.array(dep_offsets, dtype=np.uintp),
+            np.array(deps, dtype=np.uint32),
+            np.array(qubits, dtype=np.uint32),
+            _PAULI_CODES[paulis],
+        ]
+        schedule = WidgetBinaryScheduleType(
+            len(layers), len(nodes), len(deps),
+            _ptr(arrays[0], c_size_t), _ptr(arrays[1], c_uint32),
+            _ptr(arrays[2], c_size_t), _ptr(arrays[3], c_uint32),
+            len(corrections), width,
+            _ptr(arrays[4], c_uint32), _ptr(arrays[5], c_uint8)
+        )
+        return schedule, arrays
+
+    def close(self):
+        """
+        Finishes the container
+        """
+        if self._writer is not None:
+            lib.widget_binary_writer_close(self._writer)
+            self._writer = None
+            self._file.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __del__(self):
+        self.close()
+
+
+class WidgetBinaryReader:
+    """
+    Maps a binary container read only
+    Records are decoded on access into WidgetFromBinary objects
+    """
+
+    def __init__(self, path: str):
+        """
+        Maps a container
+        :: path : str :: Container path
+        """
+        self._reader = lib.widget_binary_reader_open(os.fsencode(path))
+        if not self._reader:
+            raise ValueError(f"{path} is not a binary widget container")
+
+    def __len__(self):
+        return int(lib.widget_binary_n_widgets(self._reader))
+
+    def __getitem__(self, idx: int) -> WidgetFromBinary:
+        if not 0 <= idx < len(self):
+            raise IndexError("Widget index out of range")
+        return WidgetFromBinary(self, idx)
+
+    def __iter__(self):
+        return (self[i] for i in range(len(self)))
+
+    def info(self, idx: int) -> WidgetBinaryInfoType:
+        '''
+            Counts of a record
+        '''
+        info = WidgetBinaryInfoType()
+        lib.widget_binary_read_info(self._reader, idx, info)
+        return info
+
+    def graph_csr(self, idx: int, upper_triangle: bool = False):
+        '''
+            Graph of a record as numpy offsets and neighbours, as Widget.get_graph_csr
+        '''
+        info = self.info(idx)
+        offsets = np.empty(info.n_qubits + 1, dtype=np.uintp)
+        neighbours = np.empty(info.n_edges * (1 if upper_triangle else 2), dtype=np.uint32)
+        lib.widget_binary_read_graph(self._reader, idx, offsets.ctypes.data, neighbours.ctypes.data, upper_triangle)
+        return offsets, neighbours
+
+    def qubits(self, idx: int):
+        '''
+            Local Cliffords, measurement tags and io map of a record as numpy arrays
+        '''
+        info = self.info(idx)
+        local_cliffords = np.empty(info.n_qubits, dtype=np.uint8)
+        measurement_tags = np.empty(info.n_qubits, dtype=np.uint32)
+        io_map = np.empty(info.n_initial_qubits, dtype=np.uintp)
+        lib.widget_binary_read_qubits(
+            self._reader, idx,
+            local_cliffords.ctypes.data, measurement_tags.ctypes.data, io_map.ctypes.data
+        )
+        return local_cliffords, measurement_tags, io_map
+
+    def schedule(self, idx: int):
+        '''
+            Measurement schedule and corrections of a record
+            Returns the schedule layers and the corrections in the same form as Widget.json
+        '''
+        info = self.info(idx)
+        layer_offsets = np.empty(info.n_layers + 1, dtype=np.uintp)
+        nodes = np.empty(info.n_nodes, dtype=np.uint32)
+        dep_offsets = np.empty(info.n_nodes + 1, dtype=np.uintp)
+        deps = np.empty(info.n_deps, dtype=np.uint32)
+        qubits = np.empty(info.n_corrections, dtype=np.uint32)
+        paulis = np.empty(info.n_corrections * info.correction_width, dtype=np.uint8)
+        schedule = WidgetBinaryScheduleType(
+            0, 0, 0,
+            _ptr(layer_offsets, c_size_t), _ptr(nodes, c_uint32),
+            _ptr(dep_offsets, c_size_t), _ptr(deps, c_uint32),
+            0, 0,
+            _ptr(qubits, c_uint32), _ptr(paulis, c_uint8)
+        )
+        lib.widget_binary_read_schedule(self._reader, idx, schedule)
+
+        layer_offsets, nodes, dep_offsets, deps = (
+            layer_offsets.tolist(), nodes.tolist(), dep_offsets.tolist(), deps.tolist()
+        )
+        layers = [
+            [{nodes[j]: deps[dep_offsets[j]:dep_offsets[j + 1]]} for j in range(layer_offsets[i], layer_offsets[i + 1])]
+            for i in range(info.n_layers)
+        ]
+
+        strings = np.frombuffer(PAULIS.encode('ascii'), dtype=np.uint8)[paulis].tobytes().decode('ascii')
+        width = info.correction_width
+        corrections = [
+            {qubit: strings[i * width:(i + 1) * width]} for i, qubit in enumerate(qubits.tolist())
+        ]
+        return layers, corrections
+
+    def close(self):
+        '''
+            Unmaps the container
+        '''
+        if self._reader:
+            lib.widget_binary_reader_close(self._reader)
+            self._reader = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def __del__(self):
+        self.close()
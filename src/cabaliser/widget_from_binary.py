@@ -0,0 +1,93 @@
+'''
+    Helper class
+    Duck typed Python class that can be used to instantiate a Widget-like object from a binary container record
+    The binary counterpart of WidgetFromJson, with the same fields
+'''
+
+from cabaliser.gates import SINGLE_QUBIT_GATE_ARR
+from cabaliser.io_array_wrappers import IOMap
+from cabaliser.schedule_footprint import schedule_footprint
+
+
+class WidgetFromBinary():
+    '''
+        Thin proxy of a widget object from a binary container record
+        This is mostly ducktyped to act like a regular widget
+    '''
+
+    def __init__(self, reader, idx: int):
+        '''
+            Decodes a record
+            :: reader : WidgetBinaryReader :: Mapped container
+            :: idx : int :: Record index
+        '''
+        info = reader.info(idx)
+        self.n_qubits = info.n_qubits
+
+        # Duplication of names for readability and backwards compatability
+        self.statenodes = list(range(info.n_initial_qubits))
+        self.state_nodes = self.statenodes
+
+        offsets, neighbours = reader.graph_csr(idx)
+        offsets = offsets.tolist()
+        neighbours = neighbours.tolist()
+        self.adjacencies = {i: neighbours[offsets[i]:offsets[i + 1]] for i in range(self.n_qubits)}
+
+        local_cliffords, measurement_tags, io_map = reader.qubits(idx)
+        self.local_cliffords = [SINGLE_QUBIT_GATE_ARR[op] for op in local_cliffords.tolist()]
+        self.measurement_tags = measurement_tags.tolist()
+
+        self.consumption_schedule, self.pauli_corrections = reader.schedule(idx)
+        self.consumptionschedule = self.consumption_schedule
+        self.paulicorrections = self.pauli_corrections
+
+        # Measured out qubits have no output, as in IOMap
+        self.outputnodes = [
+            qubit if self.measurement_tags[qubit] != IOMap.COND_MEASUREMENT_TAG else None
+            for qubit in io_map.tolist()
+        ]
+        self.output_nodes = self.outputnodes
+
+        self.time = len(self.consumption_schedule)
+        self.space = schedule_footprint(self.adjacencies, self.consumption_schedule)
+
+    def json(self) -> dict:
+        '''
+            Returns the same dict as Widget.json with its default arguments
+        '''
+        return {
+            'n_qubits': self.n_qubits,
+            'statenodes': self.statenodes,
+            'adjacencies': self.adjacencies,
+            'local_cliffords': self.local_cliffords,
+            'consumptionschedule': self.consumption_schedule,
+            'measurement_tags': self.measurement_tags,
+            'paulicorrections': self.pauli_corrections,
+            'outputnodes': self.outputnodes,
+            'time': self.time,
+            'space': self.space,
+        }
+
+    def get_input_nodes(self):
+        '''
+            Get ordered input indices
+        '''
+        return self.state_nodes
+
+    def get_n_qubits(self) -> int:
+        return self.n_qubits
+
+    def get_local_cliffords(self) -> list:
+        return self.local_cliffords
+
+    def get_consumption_schedule(self) -> list:
+        return self.consumption_schedule
+
+    def get_measurement_tags(self) -> list:
+        return self.measurement_tags
+
+    def get_adjacencies(self):
+        return self.adjacencies
+
+    def get_pauli_corrections(self):
+        return self.pauli_corrections
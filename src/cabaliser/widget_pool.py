@@ -0,0 +1,45 @@
+"""
+Widget Pool
+"""
+
+from cabaliser.widget import Widget
+
+
+class WidgetPool:
+    """
+    Keeps released widgets of one shape so that later widgets reuse their allocations
+    """
+
+    def __init__(self, n_qubits: int, n_qubits_max: int, **widget_args):
+        """
+        Initialiser for a widget pool
+        :: n_qubits : int :: Initial number of qubits of each widget
+        :: n_qubits_max : int :: Initial capacity of each widget
+        :: **widget_args :: Passed through to the Widget constructor
+        """
+        self.n_qubits = n_qubits
+        self.n_qubits_max = n_qubits_max
+        self.widget_args = widget_args
+        self._free = []
+
+    def __len__(self):
+        """
+        Number of widgets waiting to be reused
+        """
+        return len(self._free)
+
+    def acquire(self) -> Widget:
+        """
+        Returns a fresh widget, reusing a released one when available
+        """
+        if self._free:
+            return self._free.pop()
+        return Widget(self.n_qubits, self.n_qubits_max, **self.widget_args)
+
+    def release(self, wid: Widget):
+        """
+        Resets a widget and returns it to the pool
+        :: wid : Widget :: Widget from acquire, must not be used by the caller afterwards
+        """
+        wid.reset(self.n_qubits)
+        self._free.append(wid)
@@ -2,10 +2,31 @@
 Widget Sequence
 """
 
+from ctypes import POINTER, c_void_p, c_bool
+
 from cabaliser.widget import Widget
 from cabaliser.operation_sequence import OperationSequence
+from cabaliser.instruction_file import InstructionFileReader
+from cabaliser.structs import WidgetType
 from cabaliser import exceptions
 
+from cabaliser.lib_cabaliser import lib
+lib.widget_sequence_create.restype = c_void_p
+lib.widget_sequence_next.argtypes = [c_void_p, POINTER(WidgetType)]
+lib.widget_sequence_next.restype = POINTER(WidgetType)
+lib.widget_sequence_destroy.argtypes = [c_void_p]
+lib.widget_pipeline_create.restype = c_void_p
+lib.widget_pipeline_next.argtypes = [c_void_p]
+lib.widget_pipeline_next.restype = POINTER(WidgetType)
+lib.widget_pipeline_release.argtypes = [c_void_p, POINTER(WidgetType)]
+lib.widget_pipeline_destroy.argtypes = [c_void_p]
+lib.instruction_file_sequence_create.restype = c_void_p
+lib.instruction_file_sequence_next.argtypes = [c_void_p, POINTER(WidgetType)]
+lib.instruction_file_sequence_next.restype = POINTER(WidgetType)
+lib.instruction_file_sequence_failed.argtypes = [c_void_p]
+lib.instruction_file_sequence_failed.restype = c_bool
+lib.instruction_file_sequence_destroy.argtypes = [c_void_p]
+
 class WidgetSequence:
     """
     Creates a sequence of widget objects
@@ -53,6 +74,7 @@ class WidgetSequence:
         ops: OperationSequence,
         progress: bool = False,
         json_output: bool = False,
+        pipeline_depth: int = 2,
         **widget_args
     ):
         """
@@ -60,23 +82,121 @@ class WidgetSequence:
         :: ops : OperationSequence :: Sequence of operations to split and process
         :: progress : bool :: Simple progress printer
         :: json_output : bool :: Whether to yield json objects or widgets 
+        :: pipeline_depth : int :: Widgets in flight when producing json, 0 disables the pipeline
         :: **widget_args :: Args for the widget
             - rz_to_float=False
             - local_clifford_to_string=True 
         """
-        ops_sequence = ops.split(self.rz_threshold)
-        for i, seq in enumerate(ops_sequence):
-            if progress:
-                print(f"\r{i + 1} of {len(ops_sequence)}", flush=True, end="")
-
-            wid = Widget(self.qubit_width, self.max_qubits)
-            wid(seq)
-            wid.decompose()
-
-            if json_output:
-                yield self._json.append(wid.json(**widget_args))
-            else:
-                yield wid
+        if json_output and pipeline_depth > 0:
+            yield from self._pipeline_json_iter(ops, progress, pipeline_depth, **widget_args)
+            return
+
+        # Split and built in the c_lib, straight from the operation array
+        sequencer = lib.widget_sequence_create(
+            ops.ops, ops.curr_instructions, self.qubit_width, self.max_qubits, True
+        )
+        try:
+            i = 0
+            wid = None
+            while True:
+                # Json output is copied out, so the one widget can be reset and refilled
+                reused = wid.widget if (json_output and wid is not None) else None
+                widget_ptr = lib.widget_sequence_next(sequencer, reused)
+                if not widget_ptr:
+                    break
+                i += 1
+                if progress:
+                    print(f"\r{i} widgets", flush=True, end="")
+
+                if reused is None:
+                    wid = Widget.from_decomposed(widget_ptr, self.qubit_width)
+                else:
+                    wid.refresh_decomposed()
+
+                if json_output:
+                    yield self._json.append(wid.json(**widget_args))
+                else:
+                    # Callers may hold many of these, only the compact output is kept
+                    wid.finalise()
+                    yield wid
+        finally:
+            lib.widget_sequence_destroy(sequencer)
+
+    def _pipeline_json_iter(self, ops: OperationSequence, progress: bool, depth: int, **widget_args):
+        """
+        Json output through the c_lib pipeline
+        The next widget is parsed and decomposed on background threads while this one is serialised
+        :: ops : OperationSequence :: Sequence of operations to split and process
+        :: progress : bool :: Simple progress printer
+        :: depth : int :: Widgets in flight
+        :: **widget_args :: Args for the widget json
+        """
+        pipeline = lib.widget_pipeline_create(
+            ops.ops, ops.curr_instructions, self.qubit_width, self.max_qubits, True, depth
+        )
+        try:
+            i = 0
+            while True:
+                widget_ptr = lib.widget_pipeline_next(pipeline)
+                if not widget_ptr:
+                    break
+                i += 1
+                if progress:
+                    print(f"\r{i} widgets", flush=True, end="")
+
+                wid = Widget.from_decomposed(widget_ptr, self.qubit_width, owned=False)
+                obj = wid.json(**widget_args)
+                # Json is copied out, so the widget can go back to be refilled
+                lib.widget_pipeline_release(pipeline, widget_ptr)
+                yield self._json.append(obj)
+        finally:
+            lib.widget_pipeline_destroy(pipeline)
+
+    def widgetise_instruction_file(
+        self,
+        path: str,
+        progress: bool = False,
+        json_output: bool = False,
+        **widget_args
+    ):
+        """
+        Processes a packed instruction file, see InstructionFileWriter
+        The c_lib decodes one block at a time, so the circuit is never held in memory
+        :: path : str :: Instruction file
+        :: progress : bool :: Simple progress printer
+        :: json_output : bool :: Whether to yield json objects or widgets
+        :: **widget_args :: Args for the widget json
+        """
+        with InstructionFileReader(path) as reader:
+            sequencer = lib.instruction_file_sequence_create(
+                c_void_p(reader._reader), self.qubit_width, self.max_qubits, True
+            )
+            try:
+                i = 0
+                wid = None
+                while True:
+                    reused = wid.widget if (json_output and wid is not None) else None
+                    widget_ptr = lib.instruction_file_sequence_next(sequencer, reused)
+                    if not widget_ptr:
+                        if lib.instruction_file_sequence_failed(sequencer):
+                            raise ValueError(f"{path} is corrupt or addresses qubits past the width of {self.qubit_width}")
+                        break
+                    i += 1
+                    if progress:
+                        print(f"\r{i} widgets", flush=True, end="")
+
+                    if reused is None:
+                        wid = Widget.from_decomposed(widget_ptr, self.qubit_width)
+                    else:
+                        wid.refresh_decomposed()
+
+                    if json_output:
+                        yield self._json.append(wid.json(**widget_args))
+                    else:
+                        wid.finalise()
+                        yield wid
+            finally:
+                lib.instruction_file_sequence_destroy(sequencer)
 
     def __iter__(self, *args, **kwargs):
         """
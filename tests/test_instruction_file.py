@@ -0,0 +1,154 @@
+import os
+import math
+import tempfile
+import unittest
+
+from cabaliser import gates
+from cabaliser.gate_constructors import RZ_angle
+from cabaliser.instruction_file import InstructionFileWriter, InstructionFileReader
+from cabaliser.operation_sequence import OperationSequence
+from cabaliser.widget import Widget
+from cabaliser.widget_sequence import WidgetSequence
+
+from test_operation_sequence import random_operations
+
+N_QUBITS = 12
+N_OPERATIONS = 2000
+
+
+class InstructionFileTest(unittest.TestCase):
+
+    def setUp(self):
+        fd, self.path = tempfile.mkstemp()
+        os.close(fd)
+        self.ops = OperationSequence.from_arrays(*random_operations(N_QUBITS, N_OPERATIONS))
+
+    def tearDown(self):
+        os.unlink(self.path)
+
+    def write(self, block_size=0):
+        with InstructionFileWriter(self.path, block_size) as writer:
+            # Uneven writes, so blocks are split across calls
+            writer.write(self.ops._subsequence(0, 123))
+            writer.write(self.ops.as_array()[123:])
+        assert writer.n_bytes == os.path.getsize(self.path)
+        return writer.n_bytes
+
+    def test_round_trip(self):
+        n_bytes = self.write(block_size=100)
+        assert n_bytes < len(bytes(self.ops.as_array()))
+
+        with InstructionFileReader(self.path) as reader:
+            assert len(reader) == len(self.ops)
+            ops = reader.read()
+        assert (ops.as_array() == self.ops.as_array()).all()
+        assert ops.n_rz_operations == self.ops.n_rz_operations
+        assert ops.max_qubit_index == self.ops.max_qubit_index
+
+    def test_invalid_file(self):
+        with open(self.path, 'wb') as f:
+            f.write(b'not an instruction file')
+        with self.assertRaises(ValueError):
+            InstructionFileReader(self.path)
+
+    def test_invalid_opcode(self):
+        buffer = self.ops.as_array().copy()
+        buffer['opcode'][7] = 0xff
+        with InstructionFileWriter(self.path) as writer:
+            with self.assertRaises(ValueError):
+                writer.write(buffer)
+
+    def test_corrupt_block(self):
+        self.write(block_size=64)
+        # First opcode of the first block, after the magic and version
+        with open(self.path, 'r+b') as f:
+            f.seek(8)
+            f.write(bytes([0x3f]))
+        with InstructionFileReader(self.path) as reader:
+            with self.assertRaises(ValueError):
+                reader.read()
+            with self.assertRaises(ValueError):
+                reader.parse_into(Widget(N_QUBITS, 4 * N_OPERATIONS))
+        with self.assertRaises(ValueError):
+            list(WidgetSequence(N_QUBITS, 4 * N_QUBITS).widgetise_instruction_file(self.path))
+
+    def test_qubits_past_width(self):
+        self.write(block_size=64)
+        with InstructionFileReader(self.path) as reader:
+            with self.assertRaises(ValueError):
+                reader.parse_into(Widget(2, 4 * N_OPERATIONS))
+        with self.assertRaises(ValueError):
+            list(WidgetSequence(2, 64).widgetise_instruction_file(self.path))
+
+    def test_parse_into(self):
+        self.write(block_size=64)
+
+        wid = Widget(N_QUBITS, 4 * N_OPERATIONS)
+        with InstructionFileReader(self.path) as reader:
+            reader.parse_into(wid)
+        wid.decompose()
+
+        ref = Widget(N_QUBITS, 4 * N_OPERATIONS)
+        ref(self.ops)
+        ref.decompose()
+        assert wid.json() == ref.json()
+
+    def test_widget_sequence(self):
+        self.write(block_size=50)
+        n_qubits, max_qubits = N_QUBITS, 3 * N_QUBITS + 40
+
+        ref = WidgetSequence(n_qubits, max_qubits)
+        list(ref._widgetise_operation_sequence_iter(self.ops, json_output=True, pipeline_depth=0))
+
+        seq = WidgetSequence(n_qubits, max_qubits)
+        list(seq.widgetise_instruction_file(self.path, json_output=True))
+        assert len(seq.json()) > 1
+        assert seq.json() == ref.json()
+
+        widgets = list(WidgetSequence(n_qubits, max_qubits).widgetise_instruction_file(self.path))
+        assert [wid.n_qubits for wid in widgets] == [wid['n_qubits'] for wid in ref.json()]
+
+    def test_write_qasm(self):
+        qasm_fd, qasm_path = tempfile.mkstemp(suffix='.qasm')
+        with os.fdopen(qasm_fd, 'w') as f:
+            f.write(
+                'OPENQASM 2.0;\ninclude "qelib1.inc";\n'
+                'qreg a[2];\nqreg b[2];\ncreg c[4];\n'
+                'h a; sdg b[1];\n'
+                'cx a, b;\n'
+                'rz(-3*pi/4) b[0]; t a[1]; rz(0.1) a[0];\n'
+                'swap a[0], b[1];\n'
+                'measure b[0] -> c[0];\n'
+            )
+        ref = OperationSequence(12)
+        ref.append(gates.H, 0)
+        ref.append(gates.H, 1)
+        ref.append(gates.Sd, 3)
+        ref.append(gates.CNOT, 0, 2)
+        ref.append(gates.CNOT, 1, 3)
+        for opcode, args in (RZ_angle(2, -3 * math.pi / 4), RZ_angle(1, math.pi / 4), RZ_angle(0, 0.1)):
+            ref.append(opcode, *args)
+        ref.append(gates.SWAP, 0, 3)
+        ref.append(gates.MEAS, 2)
+
+        try:
+            with InstructionFileWriter(self.path) as writer:
+                assert writer.write_qasm(qasm_path) == len(ref)
+            with InstructionFileReader(self.path) as reader:
+                ops = reader.read()
+            assert (ops.as_array() == ref.as_array()).all()
+
+            with open(qasm_path, 'a') as f:
+                f.write('ccx a[0], a[1], b[0];\n')
+            with InstructionFileWriter(self.path) as writer:
+                with self.assertRaisesRegex(ValueError, ':11:'):
+                    writer.write_qasm(qasm_path)
+            # Nothing from the failed circuit reaches the file
+            with InstructionFileReader(self.path) as reader:
+                assert len(reader) == 0
+        finally:
+            os.unlink(qasm_path)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,109 @@
+import unittest
+import numpy as np
+
+from cabaliser import gates
+from cabaliser.operation_sequence import OperationSequence
+from cabaliser.operations import OPERATION_DTYPE
+from cabaliser.widget import Widget
+
+N_QUBITS = 12
+N_OPERATIONS = 500
+
+
+def random_operations(n_qubits, n_operations):
+    '''
+        Parallel arrays of random single qubit, two qubit and rz operations
+    '''
+    rng = np.random.default_rng(0)
+    single = np.array(sorted(gates.SINGLE_QUBIT_GATES), dtype=np.uint8)
+    two = np.array(sorted(gates.TWO_QUBIT_GATES), dtype=np.uint8)
+
+    kind = rng.integers(0, 3, n_operations)
+    opcodes = np.where(kind == 0, rng.choice(single, n_operations),
+              np.where(kind == 1, rng.choice(two, n_operations), gates.RZ)).astype(np.uint8)
+    arg0 = rng.integers(0, n_qubits, n_operations)
+    arg1 = (arg0 + rng.integers(1, n_qubits, n_operations)) % n_qubits
+    tags = rng.integers(1, 100, n_operations)
+    return opcodes, arg0, arg1, tags
+
+
+def appended(opcodes, arg0, arg1, tags):
+    '''
+        The same operations built one at a time
+    '''
+    ops = OperationSequence(len(opcodes))
+    for opcode, a, b, tag in zip(opcodes, arg0, arg1, tags):
+        if opcode in gates.TWO_QUBIT_GATES:
+            ops.append(opcode, a, b)
+        elif opcode == gates.RZ:
+            ops.append(opcode, a, tag)
+        else:
+            ops.append(opcode, a)
+    return ops
+
+
+class OperationSequenceTest(unittest.TestCase):
+
+    def test_from_arrays(self):
+        arrays = random_operations(N_QUBITS, N_OPERATIONS)
+        ops = OperationSequence.from_arrays(*arrays)
+        ref = appended(*arrays)
+
+        assert len(ops) == len(ref)
+        assert ops.n_rz_operations == ref.n_rz_operations
+        assert ops.max_qubit_index < N_QUBITS
+        assert bytes(ops.ops) == bytes(ref.ops)
+
+        view = ops.as_array()
+        assert view.dtype == OPERATION_DTYPE
+        assert (view['opcode'] == arrays[0]).all()
+
+    def test_invalid_opcode(self):
+        with self.assertRaises(ValueError):
+            OperationSequence.from_arrays([gates.H, 0xff], [0, 0])
+
+    def test_missing_arg1(self):
+        # Two qubit and conditional operations cannot default their second qubit
+        for opcode in (gates.CNOT, gates.CZ, gates.SWAP, gates.MCX):
+            with self.assertRaises(ValueError):
+                OperationSequence.from_arrays([gates.H, opcode], [0, 1])
+        ops = OperationSequence.from_arrays([gates.H, gates.RZ], [0, 1], tags=[0, 3])
+        assert len(ops) == 2
+
+    def test_add_and_subsequence(self):
+        arrays = random_operations(N_QUBITS, N_OPERATIONS)
+        ops = OperationSequence.from_arrays(*arrays)
+
+        joined = ops + ops
+        assert len(joined) == 2 * len(ops)
+        assert joined.n_rz_operations == 2 * ops.n_rz_operations
+        assert (joined.as_array()[len(ops):] == ops.as_array()).all()
+
+        part = ops._subsequence(10, 50)
+        assert (part.as_array() == ops.as_array()[10:50]).all()
+        assert part.n_rz_operations == sum(op.is_rz() for op in ops.ops[10:50])
+
+    def test_process_buffer(self):
+        arrays = random_operations(N_QUBITS, N_OPERATIONS)
+        ops = OperationSequence.from_arrays(*arrays)
+
+        wid = Widget(N_QUBITS, 4 * N_OPERATIONS)
+        wid(ops)
+        wid.decompose()
+
+        # A plain numpy array and raw bytes are both read in place
+        for buffer in (ops.as_array().copy(), bytes(ops.as_array())):
+            buffer_wid = Widget(N_QUBITS, 4 * N_OPERATIONS)
+            buffer_wid(buffer)
+            buffer_wid.decompose()
+            assert buffer_wid.json() == wid.json()
+
+        # Opcodes in a buffer are checked before the C library sees them
+        buffer = ops.as_array().copy()
+        buffer['opcode'][7] = 0xff
+        with self.assertRaises(ValueError):
+            Widget(N_QUBITS, 4 * N_OPERATIONS)(buffer)
+
+
+if __name__ == '__main__':
+    unittest.main()
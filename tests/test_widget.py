@@ -5,8 +5,11 @@ import unittest
 
 from cabaliser import gates
 from cabaliser.operation_sequence import OperationSequence 
-from cabaliser.widget import Widget
+from cabaliser.widget import Widget, TABLEAU_ENGINE, GRAPH_ENGINE, AUTO_ENGINE
+from cabaliser.widget_pool import WidgetPool
+from cabaliser.widget import ALLOC_ALIGNED, ALLOC_MMAP, ALLOC_HUGE, ALLOC_HUGETLB, ALLOC_FIRST_TOUCH
 from cabaliser.gate_constructors import RZ_angle, tag_to_angle
+from cabaliser.exceptions import WidgetDecomposedException
 
 
 class WidgetTest(unittest.TestCase):
@@ -97,6 +100,204 @@ class WidgetTest(unittest.TestCase):
         wid.decompose()
         wid.json()
 
+    def test_graph_engine(self):
+        _T_ = 1
+        _Tdag_ = 2
+
+        n_qubits = 2
+        max_qubits = 20
+
+        operation = [
+            (gates.RZ, (1, _Tdag_)),
+            (gates.CNOT, (1, 0)),
+            (gates.RZ, (0, _T_)),
+            (gates.RZ, (1, _Tdag_)),
+            (gates.CNOT, (1, 0)),
+            (gates.H, (1,))
+        ]
+        ops = OperationSequence(len(operation))
+        for opcode, args in operation:
+            ops.append(opcode, *args)
+
+        widgets = []
+        for engine in (TABLEAU_ENGINE, GRAPH_ENGINE, AUTO_ENGINE):
+            wid = Widget(n_qubits, max_qubits, engine=engine)
+            wid(ops)
+            wid.decompose()
+            wid.json()
+            widgets.append(wid)
+
+        # Same qubits and tags, the graph itself may differ by local complementation
+        tab_wid = widgets[0]
+        for wid in widgets[1:]:
+            assert tab_wid.n_qubits == wid.n_qubits
+            assert tab_wid.get_measurement_tags().to_list() == wid.get_measurement_tags().to_list()
+            assert tab_wid.get_io_map().to_list() == wid.get_io_map().to_list()
+
+        # Five two qubit gates are well short of a density check
+        stats = widgets[2].engine_stats()
+        assert stats['requested_engine'] == AUTO_ENGINE
+        assert stats['engine'] == GRAPH_ENGINE
+        assert stats['n_gates'] == 5
+        assert not stats['converted']
+
+    def test_grow(self):
+        _T_ = 1
+        n_qubits = 4
+
+        ops = OperationSequence(3 * 64)
+        for i in range(64):
+            ops.append(gates.RZ, i % n_qubits, _T_)
+            ops.append(gates.CNOT, i % n_qubits, (3 * i + 1) % n_qubits)
+            ops.append(gates.H, (7 * i) % n_qubits)
+
+        sized = Widget(n_qubits, 2 * n_qubits + 64)
+        grown = Widget(n_qubits, 2 * n_qubits)
+        for wid in (sized, grown):
+            wid(ops)
+            wid.decompose()
+
+        assert grown.max_qubits >= grown.n_qubits
+        assert sized.n_qubits == grown.n_qubits
+        assert sized.get_measurement_tags().to_list() == grown.get_measurement_tags().to_list()
+        assert sized.get_io_map().to_list() == grown.get_io_map().to_list()
+
+    def test_stats(self):
+        _T_ = 1
+        n_qubits = 4
+
+        ops = OperationSequence(3 * 16)
+        for i in range(16):
+            ops.append(gates.RZ, i % n_qubits, _T_)
+            ops.append(gates.CNOT, i % n_qubits, (i + 1) % n_qubits)
+            ops.append(gates.H, i % n_qubits)
+
+        wid = Widget(n_qubits, 2 * n_qubits + 16)
+        wid(ops)
+        wid.decompose()
+        stats = wid.stats()
+
+        if not stats['enabled']:
+            # Built without WIDGET_STATS
+            assert not any(stats['n_gates'].values())
+            assert not any(value for key, value in stats.items() if key not in ('enabled', 'n_gates'))
+            return
+
+        assert stats['n_gates'] == {
+            'local_clifford': 16, 'non_local_clifford': 16, 'qubit_map': 0, 'rz': 16, 'conditional': 0}
+        assert stats['elim_ns'] > 0
+        assert stats['ingestion_ns'] >= stats['pauli_tracker_ns']
+
+        wid.reset()
+        assert not any(wid.stats()['n_gates'].values())
+
+    def test_reset(self):
+        _T_ = 1
+        n_qubits = 4
+
+        ops = OperationSequence(3 * 16)
+        for i in range(16):
+            ops.append(gates.RZ, i % n_qubits, _T_)
+            ops.append(gates.CNOT, i % n_qubits, (i + 1) % n_qubits)
+            ops.append(gates.H, i % n_qubits)
+
+        pool = WidgetPool(n_qubits, 64)
+        outputs = []
+        for _ in range(3):
+            wid = pool.acquire()
+            assert not wid.decomposed
+            assert wid.n_qubits == 2 * n_qubits
+            wid(ops)
+            wid.decompose()
+            outputs.append(wid.json())
+            pool.release(wid)
+            assert len(pool) == 1
+
+        # Reused widgets give the same output as a fresh one
+        assert all(out == outputs[0] for out in outputs)
+
+    def test_graph_csr(self):
+        _T_ = 1
+        n_qubits = 40
+
+        ops = OperationSequence(3 * 100)
+        for i in range(100):
+            ops.append(gates.RZ, i % n_qubits, _T_)
+            ops.append(gates.CNOT, i % n_qubits, (3 * i + 1) % n_qubits)
+            ops.append(gates.H, (7 * i) % n_qubits)
+
+        for engine in (TABLEAU_ENGINE, GRAPH_ENGINE):
+            wid = Widget(n_qubits, 256, engine=engine)
+            wid(ops)
+            wid.decompose()
+
+            # Rows past the first 64 qubits read from later words of the tableau
+            assert wid.n_qubits > 64
+            offsets, neighbours = wid.get_graph_csr()
+            assert len(offsets) == wid.n_qubits + 1
+            for i in range(wid.n_qubits):
+                row = neighbours[offsets[i]:offsets[i + 1]].tolist()
+                assert row == wid.get_adjacencies(i).to_list()
+
+            upper_offsets, upper = wid.get_graph_csr(upper_triangle=True)
+            assert 2 * len(upper) == len(neighbours)
+            for i in range(wid.n_qubits):
+                assert all(j > i for j in upper[upper_offsets[i]:upper_offsets[i + 1]])
+
+    def test_finalise(self):
+        _T_ = 1
+        n_qubits = 40
+
+        ops = OperationSequence(3 * 100)
+        for i in range(100):
+            ops.append(gates.RZ, i % n_qubits, _T_)
+            ops.append(gates.CNOT, i % n_qubits, (3 * i + 1) % n_qubits)
+            ops.append(gates.H, (7 * i) % n_qubits)
+
+        for engine in (TABLEAU_ENGINE, GRAPH_ENGINE):
+            wid = Widget(n_qubits, 256, engine=engine)
+            wid(ops)
+            wid.decompose()
+            expected = wid.json()
+
+            wid.finalise()
+            assert wid.finalised
+            assert wid.json() == expected
+
+            # Nothing may touch the freed tableau
+            with self.assertRaises(WidgetDecomposedException):
+                wid(ops)
+            with self.assertRaises(WidgetDecomposedException):
+                wid.process_operations(bytes(ops.ops))
+            with self.assertRaises(WidgetDecomposedException):
+                wid.decompose()
+            with self.assertRaises(WidgetDecomposedException):
+                wid.apply_local_cliffords()
+
+            # Reset brings back the tableau
+            wid.reset()
+            assert not wid.finalised
+            wid(ops)
+            wid.decompose()
+            assert wid.json() == expected
+
+
+        n_qubits = 4
+        max_qubits = 200
+
+        ops = OperationSequence(3)
+        ops.append(gates.H, 0)
+        ops.append(gates.CNOT, 0, 1)
+        ops.append(gates.CZ, 1, 3)
+
+        adjacencies = []
+        for policy in (ALLOC_ALIGNED, ALLOC_MMAP, ALLOC_HUGE, ALLOC_HUGETLB, ALLOC_FIRST_TOUCH):
+            wid = Widget(n_qubits, max_qubits, alloc_policy=policy)
+            wid(ops)
+            wid.decompose()
+            adjacencies.append([list(wid.get_adjacencies(i)) for i in range(wid.n_qubits)])
+        assert all(adj == adjacencies[0] for adj in adjacencies)
+
     def test_tagging(self):
         # Rz tags
         _I_ = 0
@@ -0,0 +1,63 @@
+import os
+import tempfile
+import unittest
+
+from cabaliser import gates
+from cabaliser.operation_sequence import OperationSequence
+from cabaliser.widget import Widget
+from cabaliser.widget_binary import WidgetBinaryWriter, WidgetBinaryReader
+
+
+class TestWidgetBinary(unittest.TestCase):
+
+    def test_round_trip(self):
+        _T_ = 1
+        n_qubits = 8
+
+        ops = OperationSequence(3 * 40)
+        for i in range(40):
+            ops.append(gates.RZ, i % n_qubits, _T_)
+            ops.append(gates.CNOT, i % n_qubits, (3 * i + 1) % n_qubits)
+            ops.append(gates.H, (5 * i) % n_qubits)
+
+        widgets = []
+        for _ in range(3):
+            wid = Widget(n_qubits, 128)
+            wid(ops)
+            wid.decompose()
+            widgets.append(wid)
+
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, 'widgets.cabw')
+            with WidgetBinaryWriter(path) as writer:
+                for wid in widgets:
+                    assert writer.write(wid) > 0
+
+            # Every field decodes to what the json output would hold
+            with WidgetBinaryReader(path) as reader:
+                assert len(reader) == len(widgets)
+                for wid, read in zip(widgets, reader):
+                    assert read.json() == wid.json()
+
+    def test_not_a_container(self):
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, 'widgets.json')
+            with open(path, 'w') as f:
+                f.write('{}')
+            with self.assertRaises(ValueError):
+                WidgetBinaryReader(path)
+
+    def test_malformed_record(self):
+        # A record whose varints never terminate is rejected when the container opens
+        body = bytes([0x80] * 32)
+        with tempfile.TemporaryDirectory() as tmp:
+            path = os.path.join(tmp, 'widgets.cabw')
+            with open(path, 'wb') as f:
+                f.write(b'CABW' + (1).to_bytes(4, 'little'))
+                f.write(len(body).to_bytes(8, 'little') + body)
+            with self.assertRaises(ValueError):
+                WidgetBinaryReader(path)
+
+
+if __name__ == '__main__':
+    unittest.main()
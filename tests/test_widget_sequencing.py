@@ -15,6 +15,35 @@ class WidgetSequenceTest(unittest.TestCase):
     def test_large_qft(self):
         self.__test_qft(100, 2500)
 
+    def test_rz_budget(self):
+        n_qubits, max_qubits = 10, 30
+        ops = OperationSequence(len(qft(n_qubits)))
+        for opcode, args in qft(n_qubits):
+            ops.append(opcode, *args)
+
+        widget_seq = WidgetSequence(n_qubits, max_qubits)
+        widgets = widget_seq.widgetise_operation_sequence(ops, json_output=False)
+
+        # Every rz lands on exactly one widget, and only the last is short of the budget
+        n_rz = [wid.n_qubits - 2 * n_qubits for wid in widgets]
+        assert sum(n_rz) == ops.n_rz_operations
+        assert all(rz == widget_seq.rz_threshold for rz in n_rz[:-1])
+        assert 0 < n_rz[-1] <= widget_seq.rz_threshold
+
+    def test_pipeline(self):
+        n_qubits, max_qubits = 10, 30
+        ops = OperationSequence(len(qft(n_qubits)))
+        for opcode, args in qft(n_qubits):
+            ops.append(opcode, *args)
+
+        # Pipelined json matches the serial sequencer widget for widget
+        serial = WidgetSequence(n_qubits, max_qubits)
+        serial.widgetise_operation_sequence(ops, json_output=True, pipeline_depth=0)
+        for depth in (1, 2, 4):
+            piped = WidgetSequence(n_qubits, max_qubits)
+            piped.widgetise_operation_sequence(ops, json_output=True, pipeline_depth=depth)
+            assert piped.json() == serial.json()
+
     def __test_qft(self, n_qubits, max_qubits):
         qft_seq = qft(n_qubits)
         ops = OperationSequence(len(qft_seq))